@@ -148,6 +148,11 @@ OcMain (
     return;
   }
 
+  if (mOpenCoreConfiguration.Misc.Security.VaultPrefetch) {
+    DEBUG ((DEBUG_INFO, "OC: OcStoragePrefetchVault...\n"));
+    OcStoragePrefetchVault (Storage);
+  }
+
   OcCpuScanProcessor (&mOpenCoreCpuInfo);
 
   DEBUG ((DEBUG_INFO, "OC: OcLoadNvramSupport...\n"));
@@ -264,6 +269,7 @@ OcBootstrap (
              );
 
   if (!EFI_ERROR (Status)) {
+    OcStorageSetCacheSize (&mOpenCoreStorage, OC_STORAGE_CACHE_DEFAULT_SIZE);
     OcMain (&mOpenCoreStorage, LoadPath);
     OcStorageFree (&mOpenCoreStorage);
   } else {
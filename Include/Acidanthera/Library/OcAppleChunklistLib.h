@@ -26,6 +26,13 @@ typedef struct OC_APPLE_CHUNKLIST_CONTEXT_ {
   CONST APPLE_CHUNKLIST_CHUNK    *Chunks;
   APPLE_CHUNKLIST_SIG            *Signature;
   UINT8                          Hash[SHA256_DIGEST_SIZE];
+  //
+  // Incremental data verification state.
+  //
+  UINTN                          VerifyChunkIndex;
+  UINT32                         VerifyChunkOffset;
+  BOOLEAN                        VerifyFailed;
+  SHA256_CONTEXT                 VerifyHashContext;
 } OC_APPLE_CHUNKLIST_CONTEXT;
 
 //
@@ -74,4 +81,44 @@ OcAppleChunklistVerifyData (
   IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
   );
 
+/**
+  Start incremental verification of data against a chunklist context.
+  Data must then be supplied sequentially from the beginning.
+
+  @param[in,out] Context        The Context to verify against.
+**/
+VOID
+OcAppleChunklistVerifyDataStart (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context
+  );
+
+/**
+  Verify next portion of data against a chunklist context.
+  Data may be split arbitrarily, data past the last chunk is ignored.
+
+  @param[in,out] Context        The Context to verify against.
+  @param[in]     Data           Next portion of data.
+  @param[in]     DataSize       Size of Data.
+
+  @retval FALSE  The data failed verification.
+**/
+BOOLEAN
+OcAppleChunklistVerifyDataUpdate (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context,
+  IN     CONST VOID                  *Data,
+  IN     UINTN                       DataSize
+  );
+
+/**
+  Complete incremental verification of data against a chunklist context.
+
+  @param[in,out] Context        The Context to verify against.
+
+  @retval TRUE   All chunks were supplied and verified successfully.
+**/
+BOOLEAN
+OcAppleChunklistVerifyDataFinal (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context
+  );
+
 #endif // APPLE_CHUNKLIST_LIB_H
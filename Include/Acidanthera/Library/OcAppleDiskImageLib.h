@@ -20,16 +20,82 @@
 #include <Library/OcAppleChunklistLib.h>
 #include <Library/OcAppleRamDiskLib.h>
 
+//
+// Default maximum number of decompressed chunks kept in disk image context.
+//
+#define OC_APPLE_DISK_IMAGE_DEFAULT_CACHED_CHUNKS  8U
+
+//
+// Default number of chunks decompressed ahead of sequential reads.
+// Limited by the amount of cached chunks.
+//
+#define OC_APPLE_DISK_IMAGE_DEFAULT_READ_AHEAD_CHUNKS  4U
+
+//
+// Number of consecutive sequential reads enabling read-ahead.
+//
+#define OC_APPLE_DISK_IMAGE_SEQUENTIAL_READ_THRESHOLD  2U
+
+//
+// Decompressed disk image chunk.
+//
+typedef struct {
+  CONST APPLE_DISK_IMAGE_CHUNK    *Chunk;
+  UINT8                           *Data;
+  UINTN                           DataSize;
+  UINT64                          LastUsed;
+} OC_APPLE_DISK_IMAGE_CACHED_CHUNK;
+
+//
+// Disk image chunk with absolute start sector, chunks are sorted by it.
+//
+typedef struct {
+  UINT64                         SectorNumber;
+  APPLE_DISK_IMAGE_BLOCK_DATA    *Block;
+  APPLE_DISK_IMAGE_CHUNK         *Chunk;
+} OC_APPLE_DISK_IMAGE_SORTED_CHUNK;
+
 //
 // Disk image context.
 //
 typedef struct {
   CONST APPLE_RAM_DISK_EXTENT_TABLE    *ExtentTable;
+  OC_APPLE_RAM_DISK_EXTENT_INDEX       ExtentIndex;
 
   UINTN                                SectorCount;
 
   UINT32                               BlockCount;
   APPLE_DISK_IMAGE_BLOCK_DATA          **Blocks;
+
+  UINT32                               ChunkCount;
+  OC_APPLE_DISK_IMAGE_SORTED_CHUNK     *Chunks;
+  //
+  // Least recently used decompressed chunks are evicted once MaxCachedChunks
+  // is reached. May be changed prior to the first read, e.g. before
+  // installing Block I/O.
+  //
+  UINT32                               MaxCachedChunks;
+  UINT32                               CachedChunkCount;
+  OC_APPLE_DISK_IMAGE_CACHED_CHUNK     *CachedChunks;
+  UINT64                               ChunkCacheHits;
+  UINT64                               ChunkCacheMisses;
+  //
+  // Incremented on every cache access including read-ahead, LastUsed
+  // of cached chunks is set from it.
+  //
+  UINT64                               ChunkCacheClock;
+  //
+  // Sequential access detector state. Once enough reads continue where
+  // the previous one ended, up to ReadAheadChunks following chunks are
+  // queued for OcAppleDiskImageReadAhead. ReadAheadChunks may be changed
+  // at any time, 0 disables read-ahead.
+  //
+  UINT32                               ReadAheadChunks;
+  UINT32                               SequentialReads;
+  UINTN                                NextReadLba;
+  UINT32                               ReadAheadChunkIndex;
+  UINT32                               ReadAheadPending;
+  UINT64                               ChunkReadAheads;
 } OC_APPLE_DISK_IMAGE_CONTEXT;
 
 //
@@ -52,8 +118,9 @@ OcAppleDiskImageInitializeContext (
 
 BOOLEAN
 OcAppleDiskImageInitializeFromFile (
-  OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  EFI_FILE_PROTOCOL            *File
+  OUT    OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     EFI_FILE_PROTOCOL            *File,
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext  OPTIONAL
   );
 
 VOID
@@ -80,6 +147,19 @@ OcAppleDiskImageRead (
   OUT VOID                         *Buffer
   );
 
+/**
+  Decompress the next chunk queued by sequential read detection
+  into the chunk cache.
+
+  @param[in,out]  Context  Disk image context.
+
+  @retval TRUE when more chunks are queued for read-ahead.
+**/
+BOOLEAN
+OcAppleDiskImageReadAhead (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context
+  );
+
 EFI_HANDLE
 OcAppleDiskImageInstallBlockIo (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT     *Context,
@@ -173,6 +173,33 @@ typedef enum KERNEL_CACHE_TYPE_ {
 #define KERNEL_VERSION_VENTURA_MAX        (KERNEL_VERSION_SONOMA_MIN - 1)
 #define KERNEL_VERSION_SONOMA_MAX         (KERNEL_VERSION_SEQUOIA_MIN - 1)
 
+//
+// Maximum bootloader version size stored in link cache.
+//
+#define PRELINKED_LINK_CACHE_VERSION_SIZE  32
+
+//
+// Bundle identifier hash table entry of prelinked context.
+//
+typedef struct {
+  //
+  // Bundle identifier, NULL for free entries.
+  //
+  CONST CHAR8    *Identifier;
+  //
+  // Bundle identifier hash.
+  //
+  UINT32         Hash;
+  //
+  // Kext Info.plist in KextList, NULL for kexts without parsed Info.plist.
+  //
+  XML_NODE       *KextPlist;
+  //
+  // Cached kext (PRELINKED_KEXT), NULL when not cached yet.
+  //
+  VOID           *Kext;
+} PRELINKED_KEXT_IDENTIFIER;
+
 //
 // Prelinked context used for kernel modification.
 //
@@ -287,6 +314,28 @@ typedef struct {
   //
   XML_NODE                               *KextList;
   //
+  // Unmodified copy of PRELINK_INFO_SECTION taken before injection, used to
+  // only export injected kexts. NULL when not available.
+  // Freed upon context destruction.
+  //
+  CHAR8                                  *PrelinkedInfoOriginal;
+  //
+  // Length of PrelinkedInfoOriginal without trailing '\0'.
+  //
+  UINT32                                 PrelinkedInfoOriginalSize;
+  //
+  // Offset of KextList closing tag in PrelinkedInfoOriginal.
+  //
+  UINT32                                 KextListOriginalEnd;
+  //
+  // Number of KextList entries present in PrelinkedInfoOriginal.
+  //
+  UINT32                                 KextListOriginalCount;
+  //
+  // Set when KextList entries present in PrelinkedInfoOriginal are changed.
+  //
+  BOOLEAN                                KextListModified;
+  //
   // Plist scratch buffer used when updating values.
   //
   CHAR8                                  *KextScratchBuffer;
@@ -315,6 +364,31 @@ typedef struct {
   //
   LIST_ENTRY                             InjectedKexts;
   //
+  // Bundle identifier hash table with open addressing covering KextList
+  // and PrelinkedKexts, NULL when linear lookup is to be used.
+  //
+  PRELINKED_KEXT_IDENTIFIER              *KextIdentifiers;
+  //
+  // Bundle identifier hash table size minus one, size is a power of two.
+  //
+  UINT32                                 KextIdentifiersMask;
+  //
+  // Used bundle identifier hash table entries.
+  //
+  UINT32                                 KextIdentifiersCount;
+  //
+  // Imported link cache with dependency kext tables, may be NULL.
+  //
+  VOID                                   *LinkCache;
+  //
+  // Imported link cache size.
+  //
+  UINT32                                 LinkCacheSize;
+  //
+  // Dependency kexts scanned without link cache.
+  //
+  UINT32                                 LinkCacheMisses;
+  //
   // Whether this kernel is a kernel collection (used by macOS 11.0+).
   //
   BOOLEAN                                IsKernelCollection;
@@ -338,6 +412,11 @@ typedef struct {
   // Prelinked is 32-bit.
   //
   BOOLEAN                                Is32Bit;
+  //
+  // Do not build hash indices over dependency symbol tables and always
+  // look symbols up linearly. Only meant for debugging and profiling.
+  //
+  BOOLEAN                                LinearSymbolLookup;
 } PRELINKED_CONTEXT;
 
 //
@@ -837,6 +916,59 @@ PrelinkedInjectPrepare (
   IN     UINT32             ReservedExeSize
   );
 
+/**
+  Import link cache with dependency kext symbol and vtable tables, previously
+  produced by PrelinkedExportLinkCache for the same kernel. Cached tables are
+  used instead of scanning dependency kexts. Any mismatch of particular tables
+  with prelinked results in regular scanning. Rejected link cache is accounted
+  as a miss, so that PrelinkedExportLinkCache produces a new one.
+
+  @param[in,out] Context    Prelinked context.
+  @param[in]     Cache      Link cache, copied to context.
+  @param[in]     CacheSize  Link cache size.
+  @param[in]     Digest     SHA-384 digest of the original kernel.
+  @param[in]     Version    Bootloader version, at most PRELINKED_LINK_CACHE_VERSION_SIZE
+                            bytes including null terminator are compared.
+
+  @retval EFI_SUCCESS            Link cache was imported.
+  @retval EFI_NOT_FOUND          Link cache is for a different kernel or version.
+  @retval EFI_INVALID_PARAMETER  Link cache is malformed.
+  @retval EFI_COMPROMISED_DATA   Link cache payload digest mismatch.
+  @retval EFI_OUT_OF_RESOURCES   Memory allocation failure.
+**/
+EFI_STATUS
+PrelinkedImportLinkCache (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     CONST VOID         *Cache,
+  IN     UINT32             CacheSize,
+  IN     CONST UINT8        *Digest,
+  IN     CONST CHAR8        *Version
+  );
+
+/**
+  Export link cache with symbol and vtable tables of the dependency kexts
+  used during injection. Injected kexts are not exported.
+
+  @param[in]  Context    Prelinked context.
+  @param[in]  Digest     SHA-384 digest of the original kernel.
+  @param[in]  Version    Bootloader version.
+  @param[out] Cache      Link cache allocated from pool.
+  @param[out] CacheSize  Link cache size.
+
+  @retval EFI_SUCCESS            Link cache was exported.
+  @retval EFI_ALREADY_STARTED    Imported link cache covered all dependency kexts.
+  @retval EFI_INVALID_PARAMETER  Version is too long.
+  @retval EFI_OUT_OF_RESOURCES   Memory allocation failure.
+**/
+EFI_STATUS
+PrelinkedExportLinkCache (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  CONST UINT8        *Digest,
+  IN  CONST CHAR8        *Version,
+  OUT VOID               **Cache,
+  OUT UINT32             *CacheSize
+  );
+
 /**
   Insert current plist entry after kext injection.
 
@@ -1163,6 +1295,24 @@ PatcherApplyGenericPatch (
   IN     PATCHER_GENERIC_PATCH  *Patch
   );
 
+/**
+  Apply multiple generic patches in order, searching all Find patterns
+  with a single pass over the binary. The result is identical to calling
+  PatcherApplyGenericPatch for every patch in order.
+
+  @param[in,out] Context         Patcher context.
+  @param[in]     Patches         Patch descriptions.
+  @param[in]     PatchCount      Number of patches.
+  @param[out]    Results         Per-patch PatcherApplyGenericPatch status.
+**/
+VOID
+PatcherApplyGenericPatches (
+  IN OUT PATCHER_CONTEXT        *Context,
+  IN     PATCHER_GENERIC_PATCH  *Patches,
+  IN     UINT32                 PatchCount,
+  OUT    EFI_STATUS             *Results
+  );
+
 /**
   Exclude kext from prelinked.
 
@@ -18,6 +18,38 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Protocol/AppleRamDisk.h>
 #include <Protocol/SimpleFileSystem.h>
 
+/**
+  Lookup index over allocated extent table. Extent table layout is fixed
+  by the ABI, so cumulative extent offsets are kept separately to allow
+  binary search of the extent containing a RAM disk offset.
+**/
+typedef struct {
+  CONST APPLE_RAM_DISK_EXTENT_TABLE    *ExtentTable;
+  UINT32                               ExtentCount;
+  //
+  // ExtentOffsets[Index] is the RAM disk offset of extent Index,
+  // ExtentOffsets[ExtentCount] is the total RAM disk size.
+  //
+  UINTN                                ExtentOffsets[APPLE_RAM_DISK_MAX_EXTENTS + 1];
+} OC_APPLE_RAM_DISK_EXTENT_INDEX;
+
+/**
+  Observe RAM disk data while it is being loaded.
+
+  @param[in]  Context   Caller-provided context.
+  @param[in]  Data      Data loaded into RAM disk.
+  @param[in]  DataSize  Size of Data in bytes.
+
+  @retval TRUE to continue loading, FALSE to abort.
+**/
+typedef
+BOOLEAN
+(*OC_APPLE_RAM_DISK_LOAD_HOOK) (
+  IN VOID        *Context,
+  IN CONST VOID  *Data,
+  IN UINTN       DataSize
+  );
+
 /**
   Request allocation of Size bytes in extents table.
 
@@ -33,9 +65,21 @@ OcAppleRamDiskAllocate (
   );
 
 /**
-  Read RAM disk data.
+  Initialize extent lookup index.
 
+  @param[out] ExtentIndex Extent lookup index to initialize.
   @param[in]  ExtentTable Allocated extent table.
+**/
+VOID
+OcAppleRamDiskInitializeIndex (
+  OUT OC_APPLE_RAM_DISK_EXTENT_INDEX     *ExtentIndex,
+  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  );
+
+/**
+  Read RAM disk data.
+
+  @param[in]  ExtentIndex Extent lookup index.
   @param[in]  Offset      Offset in RAM disk.
   @param[in]  Size        Amount of data to read.
   @param[out] Buffer      Resulting data.
@@ -44,16 +88,16 @@ OcAppleRamDiskAllocate (
 **/
 BOOLEAN
 OcAppleRamDiskRead (
-  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
-  IN  UINTN                              Offset,
-  IN  UINTN                              Size,
-  OUT VOID                               *Buffer
+  IN  CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN  UINTN                                 Offset,
+  IN  UINTN                                 Size,
+  OUT VOID                                  *Buffer
   );
 
 /**
   Write RAM disk data.
 
-  @param[in]  ExtentTable Allocated extent table.
+  @param[in]  ExtentIndex Extent lookup index.
   @param[in]  Offset      Offset in RAM disk.
   @param[in]  Size        Amount of data to write.
   @param[in]  Buffer      Source data.
@@ -62,10 +106,10 @@ OcAppleRamDiskRead (
 **/
 BOOLEAN
 OcAppleRamDiskWrite (
-  IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
-  IN UINTN                              Offset,
-  IN UINTN                              Size,
-  IN CONST VOID                         *Buffer
+  IN CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN UINTN                                 Offset,
+  IN UINTN                                 Size,
+  IN CONST VOID                            *Buffer
   );
 
 /**
@@ -74,6 +118,9 @@ OcAppleRamDiskWrite (
   @param[in]  ExtentTable Allocated extent table.
   @param[in]  File        File protocol open for reading.
   @param[in]  FileSize    Amount of data to write.
+  @param[in]  Hook        Optional hook called sequentially for loaded data,
+                          e.g. to verify it without a second pass.
+  @param[in]  HookContext Context passed to Hook.
 
   @retval TRUE on success.
 **/
@@ -81,7 +128,9 @@ BOOLEAN
 OcAppleRamDiskLoadFile (
   IN OUT CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
   IN     EFI_FILE_PROTOCOL                  *File,
-  IN     UINTN                              FileSize
+  IN     UINTN                              FileSize,
+  IN     OC_APPLE_RAM_DISK_LOAD_HOOK        Hook         OPTIONAL,
+  IN     VOID                               *HookContext OPTIONAL
   );
 
 /**
@@ -81,6 +81,106 @@ DecompressLZVN (
   IN  UINTN        SrcLen
   );
 
+/**
+  Resumable LZSS decompression stream.
+**/
+typedef struct OC_LZSS_STREAM_ OC_LZSS_STREAM;
+
+/**
+  Resumable LZVN decompression stream.
+**/
+typedef struct OC_LZVN_STREAM_ OC_LZVN_STREAM;
+
+/**
+  Start LZSS decompression into a fixed destination buffer.
+  Compressed data may then be supplied in chunks of arbitrary size.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+
+  @return  Allocated stream on success otherwise NULL.
+**/
+OC_LZSS_STREAM *
+DecompressLZSSStreamInit (
+  OUT UINT8   *Dst,
+  IN  UINT32  DstLen
+  );
+
+/**
+  Decompress next chunk of LZSS data.
+  Bytes not consumed form an incomplete token and must be supplied again
+  at the beginning of the next chunk.
+
+  @param[in,out]  Stream      Decompression stream.
+  @param[in]      Src         Source buffer.
+  @param[in]      SrcLen      Source buffer size.
+  @param[out]     Consumed    Number of consumed source bytes.
+
+  @return  Total DecompressedLen so far.
+**/
+UINT32
+DecompressLZSSStreamFeed (
+  IN OUT OC_LZSS_STREAM  *Stream,
+  IN     CONST UINT8     *Src,
+  IN     UINT32          SrcLen,
+  OUT    UINT32          *Consumed
+  );
+
+/**
+  Free LZSS decompression stream.
+
+  @param[in]  Stream      Decompression stream.
+**/
+VOID
+DecompressLZSSStreamFree (
+  IN OC_LZSS_STREAM  *Stream
+  );
+
+/**
+  Start LZVN decompression into a fixed destination buffer.
+  Compressed data may then be supplied in chunks of arbitrary size.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+
+  @return  Allocated stream on success otherwise NULL.
+**/
+OC_LZVN_STREAM *
+DecompressLZVNStreamInit (
+  OUT UINT8  *Dst,
+  IN  UINTN  DstLen
+  );
+
+/**
+  Decompress next chunk of LZVN data.
+  Bytes not consumed form an incomplete instruction and must be supplied again
+  at the beginning of the next chunk.
+
+  @param[in,out]  Stream      Decompression stream.
+  @param[in]      Src         Source buffer.
+  @param[in]      SrcLen      Source buffer size.
+  @param[out]     Consumed    Number of consumed source bytes.
+
+  @return  Total DecompressedLen so far.
+**/
+UINTN
+DecompressLZVNStreamFeed (
+  IN OUT OC_LZVN_STREAM  *Stream,
+  IN     CONST UINT8     *Src,
+  IN     UINTN           SrcLen,
+  OUT    UINTN           *Consumed
+  );
+
+/**
+  Free LZVN decompression stream.
+
+  @param[in]  Stream      Decompression stream.
+**/
+VOID
+DecompressLZVNStreamFree (
+  IN OC_LZVN_STREAM  *Stream
+  );
+
 /**
   Compress buffer with ZLIB algorithm.
 
@@ -117,6 +217,63 @@ DecompressZLIB (
   IN  UINTN        SrcLen
   );
 
+/**
+  Decompress buffer with Apple Data Compression (ADC) algorithm.
+  This algorithm is used for ADC chunks in legacy DMG images.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressADC (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
+/**
+  Decompress buffer with BZIP2 algorithm.
+  Concatenated streams are supported, CRCs are verified.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressBZIP2 (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
+/**
+  Decompress buffer with LZFSE algorithm.
+  LZVN blocks are decoded with DecompressLZVN.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressLZFSE (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
 /**
   Decompress buffer with RLE24 algorithm and 8-bit alpha.
   This algorithm is used for encoding IT32/T8MK images in ICNS.
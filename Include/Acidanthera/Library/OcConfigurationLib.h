@@ -315,7 +315,8 @@ OC_DECLARE (OC_KERNEL_QUIRKS)
   _(OC_STRING                   , KernelArch       ,     , OC_STRING_CONSTR ("Auto", _, __), OC_DESTR (OC_STRING)) \
   _(OC_STRING                   , KernelCache      ,     , OC_STRING_CONSTR ("Auto", _, __), OC_DESTR (OC_STRING)) \
   _(BOOLEAN                     , CustomKernel     ,     , FALSE  , ()) \
-  _(BOOLEAN                     , FuzzyMatch       ,     , FALSE  , ())
+  _(BOOLEAN                     , FuzzyMatch       ,     , FALSE  , ()) \
+  _(BOOLEAN                     , LinkCache        ,     , FALSE  , ())
 OC_DECLARE (OC_KERNEL_SCHEME)
 
 #define OC_KERNEL_CONFIG_FIELDS(_, __) \
@@ -390,6 +391,7 @@ typedef enum {
   _(BOOLEAN                     , AuthRestart                 ,      , FALSE                   , ()) \
   _(BOOLEAN                     , BlacklistAppleUpdate        ,      , FALSE                   , ()) \
   _(BOOLEAN                     , EnablePassword              ,      , FALSE                   , ()) \
+  _(BOOLEAN                     , VaultPrefetch               ,      , FALSE                   , ()) \
   _(UINT8                       , PasswordHash                , [64] , {0}                     , ()) \
   _(OC_DATA                     , PasswordSalt                ,      , OC_EDATA_CONSTR (_, __) , OC_DESTR (OC_DATA)) \
   _(OC_STRING                   , SecureBootModel             ,      , OC_STRING_CONSTR ("Default", _, __), OC_DESTR (OC_STRING) ) \
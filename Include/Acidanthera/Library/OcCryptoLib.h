@@ -236,6 +236,19 @@ AesCtrXcryptBuffer (
   IN     UINT32       Len
   );
 
+/**
+  Enable or disable AES-NI implementation, enabled by default when supported.
+  Mainly intended for testing the software implementation on AES-NI capable CPUs.
+
+  @param[in] Enable  Use AES-NI when supported.
+
+  @retval TRUE when AES-NI implementation is used.
+**/
+BOOLEAN
+AesSetAccel (
+  IN BOOLEAN  Enable
+  );
+
 /**
   Setup ChaCha context (IETF variant).
 
@@ -425,17 +438,25 @@ SigVerifyShaHashBySize (
 #define RSA_MOD_MAX_SIZE  BASE_16KB
 
 /**
+  Signature and decrypted signature numbers, followed by the exponentiation
+  scratch of 7 numbers and one word.
+
   @param[in] ModulusSize  Modulus size in bytes. Must be at most
                           RSA_MOD_MAX_SIZE.
 **/
 #define RSA_SCRATCH_BUFFER_SIZE(ModulusSize) \
-  ((ModulusSize) * 3U)
+  ((ModulusSize) * 9U + sizeof (UINTN))
 
 STATIC_ASSERT (
-  RSA_MOD_MAX_SIZE <= MAX_UINTN / 3U,
+  RSA_MOD_MAX_SIZE <= (MAX_UINTN - sizeof (UINTN)) / 9U,
   "The definition of RSA_SCRATCH_BUFFER_SIZE may cause an overflow"
   );
 
+///
+/// RSA public key prepared for repeated signature verification.
+///
+typedef struct OC_RSA_KEY_HANDLE_ OC_RSA_KEY_HANDLE;
+
 /**
   Verify a RSA PKCS1.5 signature against an expected hash.
   The exponent is always 65537 as per the format specification.
@@ -446,7 +467,7 @@ STATIC_ASSERT (
   @param[in] Hash           The Hash digest of the signed data.
   @param[in] HashSize       Size, in bytes, of Hash.
   @param[in] Algorithm      The RSA algorithm used.
-  @param[in] Scratch        Scratch buffer 3xModulo.
+  @param[in] Scratch        Scratch buffer RSA_SCRATCH_BUFFER_SIZE(Modulus).
 
   @returns  Whether the signature has been successfully verified as valid.
 
@@ -502,7 +523,7 @@ RsaVerifySigHashFromKeyDynalloc (
   @param[in] Data           The signed data to verify.
   @param[in] DataSize       Size, in bytes, of Data.
   @param[in] Algorithm      The RSA algorithm used.
-  @param[in] Scratch        Scratch buffer 3xModulo.
+  @param[in] Scratch        Scratch buffer RSA_SCRATCH_BUFFER_SIZE(Modulus).
 
   @returns  Whether the signature has been successfully verified as valid.
 
@@ -552,6 +573,7 @@ RsaVerifySigDataFromKeyDynalloc (
   Verify RSA PKCS1.5 signed data against its signature.
   The modulus' size must be a multiple of the configured BIGNUM word size.
   This will be true for any conventional RSA, which use two's potencies.
+  Key handles of recently used moduli are cached for subsequent calls.
 
   @param[in] Modulus        The RSA modulus byte array.
   @param[in] ModulusSize    The size, in bytes, of Modulus.
@@ -577,6 +599,98 @@ RsaVerifySigDataFromData (
   IN OC_SIG_HASH_TYPE  Algorithm
   );
 
+/**
+  Create a key handle caching the modulus words, its Montgomery Inverse,
+  and Montgomery's R^2 mod N, together with the verification scratch buffer.
+  The modulus' size must be a multiple of the configured BIGNUM word size.
+  The exponent must be odd and at least 3.
+
+  @param[in] Modulus      The RSA modulus byte array.
+  @param[in] ModulusSize  The size, in bytes, of Modulus.
+  @param[in] Exponent     The RSA exponent.
+
+  @returns  Key handle to be freed with RsaFreeKeyHandle or NULL.
+
+**/
+OC_RSA_KEY_HANDLE *
+RsaCreateKeyHandleFromData (
+  IN CONST UINT8  *Modulus,
+  IN UINTN        ModulusSize,
+  IN UINT32       Exponent
+  );
+
+/**
+  Create a key handle from a preprocessed RSA Public Key.
+  The exponent is always 65537 as per the format specification.
+  Key is copied and does not need to outlive the handle.
+
+  @param[in] Key  The RSA Public Key.
+
+  @returns  Key handle to be freed with RsaFreeKeyHandle or NULL.
+
+**/
+OC_RSA_KEY_HANDLE *
+RsaCreateKeyHandleFromKey (
+  IN CONST OC_RSA_PUBLIC_KEY  *Key
+  );
+
+/**
+  Verify a RSA PKCS1.5 signature against an expected hash.
+
+  @param[in,out] Handle         The RSA key handle.
+  @param[in]     Signature      The RSA signature to be verified.
+  @param[in]     SignatureSize  Size, in bytes, of Signature.
+  @param[in]     Hash           The Hash digest of the signed data.
+  @param[in]     HashSize       Size, in bytes, of Hash.
+  @param[in]     Algorithm      The RSA algorithm used.
+
+  @returns  Whether the signature has been successfully verified as valid.
+
+**/
+BOOLEAN
+RsaVerifySigHashFromHandle (
+  IN OUT OC_RSA_KEY_HANDLE  *Handle,
+  IN     CONST UINT8        *Signature,
+  IN     UINTN              SignatureSize,
+  IN     CONST UINT8        *Hash,
+  IN     UINTN              HashSize,
+  IN     OC_SIG_HASH_TYPE   Algorithm
+  );
+
+/**
+  Verify RSA PKCS1.5 signed data against its signature.
+
+  @param[in,out] Handle         The RSA key handle.
+  @param[in]     Signature      The RSA signature to be verified.
+  @param[in]     SignatureSize  Size, in bytes, of Signature.
+  @param[in]     Data           The signed data to verify.
+  @param[in]     DataSize       Size, in bytes, of Data.
+  @param[in]     Algorithm      The RSA algorithm used.
+
+  @returns  Whether the signature has been successfully verified as valid.
+
+**/
+BOOLEAN
+RsaVerifySigDataFromHandle (
+  IN OUT OC_RSA_KEY_HANDLE  *Handle,
+  IN     CONST UINT8        *Signature,
+  IN     UINTN              SignatureSize,
+  IN     CONST UINT8        *Data,
+  IN     UINTN              DataSize,
+  IN     OC_SIG_HASH_TYPE   Algorithm
+  );
+
+/**
+  Free RSA key handle.
+
+  @param[in] Handle  The RSA key handle.
+
+**/
+VOID
+RsaFreeKeyHandle (
+  IN OC_RSA_KEY_HANDLE  *Handle
+  );
+
 /**
   Performs a cryptographically secure comparison of the contents of two
   buffers.
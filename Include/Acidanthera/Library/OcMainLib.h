@@ -125,6 +125,41 @@ OcLoadKernelSupport (
   IN OC_CPU_INFO         *CpuInfo
   );
 
+/**
+  Kernel processing profiling handler, called when a phase starts and completes.
+
+  @param[in]  Phase  Phase name.
+  @param[in]  Item   Item processed within the phase, e.g. kext bundle path. Optional.
+  @param[in]  Start  TRUE when the phase starts, FALSE when it completes.
+**/
+typedef
+VOID
+(*OC_KERNEL_PROFILE_HANDLER) (
+  IN CONST CHAR8  *Phase,
+  IN CONST CHAR8  *Item  OPTIONAL,
+  IN BOOLEAN      Start
+  );
+
+/**
+  Install kernel processing profiling handler, used by userspace utilities.
+
+  @param[in]  Handler  Handler to install or NULL to uninstall.
+**/
+VOID
+OcKernelSetProfileHandler (
+  IN OC_KERNEL_PROFILE_HANDLER  Handler  OPTIONAL
+  );
+
+/**
+  Report kernel processing phase to the profiling handler.
+**/
+VOID
+OcKernelProfile (
+  IN CONST CHAR8  *Phase,
+  IN CONST CHAR8  *Item  OPTIONAL,
+  IN BOOLEAN      Start
+  );
+
 /**
   Apply kernel quirk.
 **/
@@ -36,6 +36,90 @@
 #define SECONDS_TO_NANOSECONDS(x)  ((x) * 1000000000)
 #define MS_TO_NANOSECONDS(x)       ((x) * 1000000)
 
+//
+// Pattern prepared for repeated searches.
+//
+typedef struct {
+  //
+  // Pattern bytes, compared against data masked by PatternMask.
+  //
+  CONST UINT8    *Pattern;
+  //
+  // Pattern mask or NULL.
+  //
+  CONST UINT8    *PatternMask;
+  //
+  // Pattern size.
+  //
+  UINT32         PatternSize;
+  //
+  // Pattern prefix size used for shifting, ends with the longest unmasked run.
+  //
+  UINT32         ShiftSize;
+  //
+  // Horspool shift for each data byte at the end of the prefix.
+  //
+  UINT32         Shift[256];
+} OC_COMPILED_PATTERN;
+
+/**
+  Prepare pattern for repeated searches.
+
+  @param[in]  Pattern      Pattern bytes.
+  @param[in]  PatternMask  Pattern mask or NULL.
+  @param[in]  PatternSize  Pattern size, must not be 0.
+  @param[out] Compiled     Compiled pattern, references Pattern and PatternMask.
+**/
+VOID
+CompilePattern (
+  IN  CONST UINT8          *Pattern,
+  IN  CONST UINT8          *PatternMask OPTIONAL,
+  IN  CONST UINT32         PatternSize,
+  OUT OC_COMPILED_PATTERN  *Compiled
+  );
+
+/**
+  Find compiled pattern in data, same as FindPattern.
+
+  @param[in]     Compiled  Compiled pattern.
+  @param[in]     Data      Data to search.
+  @param[in]     DataSize  Data size.
+  @param[in,out] DataOff   Search start offset on input, found offset on output.
+
+  @retval TRUE when pattern was found.
+**/
+BOOLEAN
+FindCompiledPattern (
+  IN CONST OC_COMPILED_PATTERN  *Compiled,
+  IN CONST UINT8                *Data,
+  IN UINT32                     DataSize,
+  IN OUT UINT32                 *DataOff
+  );
+
+/**
+  Apply compiled pattern patch to data, same as ApplyPatch.
+
+  @param[in]     Compiled     Compiled pattern.
+  @param[in]     Replace      Replacement bytes.
+  @param[in]     ReplaceMask  Replacement mask or NULL.
+  @param[in,out] Data         Data to patch.
+  @param[in]     DataSize     Data size.
+  @param[in]     Count        Replacement count or 0 for all.
+  @param[in]     Skip         Number of occurrences to skip.
+
+  @return  Number of replacements performed.
+**/
+UINT32
+ApplyCompiledPatch (
+  IN CONST OC_COMPILED_PATTERN  *Compiled,
+  IN CONST UINT8                *Replace,
+  IN CONST UINT8                *ReplaceMask OPTIONAL,
+  IN UINT8                      *Data,
+  IN UINT32                     DataSize,
+  IN UINT32                     Count,
+  IN UINT32                     Skip
+  );
+
 BOOLEAN
 FindPattern (
   IN CONST UINT8   *Pattern,
@@ -59,6 +143,68 @@ ApplyPatch (
   IN UINT32        Skip
   );
 
+//
+// Pattern description for multi-pattern search.
+//
+typedef struct {
+  //
+  // Pattern bytes, compared against data masked by PatternMask.
+  //
+  CONST UINT8    *Pattern;
+  //
+  // Pattern mask or NULL.
+  //
+  CONST UINT8    *PatternMask;
+  //
+  // Pattern size.
+  //
+  UINT32         PatternSize;
+} OC_DATA_PATTERN;
+
+/**
+  Multi-pattern search callback, invoked for every found pattern occurrence.
+
+  @param[in] Context       Callback context.
+  @param[in] PatternIndex  Index of the found pattern.
+  @param[in] DataOff       Offset of the found pattern in data.
+
+  @retval TRUE to continue searching, FALSE to abort.
+**/
+typedef
+BOOLEAN
+(*OC_DATA_PATTERN_FOUND) (
+  IN VOID    *Context,
+  IN UINT32  PatternIndex,
+  IN UINT32  DataOff
+  );
+
+/**
+  Find all occurrences of multiple patterns in a single pass over data.
+  Unlike repeated FindPattern calls, overlapping occurrences are reported too.
+  Occurrences are reported in ascending offset order of their anchor bytes,
+  which is not necessarily ascending DataOff order across different patterns.
+
+  @param[in] Patterns      Patterns to look for.
+  @param[in] PatternCount  Number of patterns.
+  @param[in] Data          Data to search.
+  @param[in] DataSize      Data size.
+  @param[in] Callback      Callback invoked for every occurrence.
+  @param[in] Context       Callback context.
+
+  @retval EFI_SUCCESS           Data was searched.
+  @retval EFI_ABORTED           Callback requested abort.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failure.
+**/
+EFI_STATUS
+FindPatterns (
+  IN CONST OC_DATA_PATTERN  *Patterns,
+  IN UINT32                 PatternCount,
+  IN CONST UINT8            *Data,
+  IN UINT32                 DataSize,
+  IN OC_DATA_PATTERN_FOUND  Callback,
+  IN VOID                   *Context
+  );
+
 /**
   Obtain application arguments.
 
@@ -38,6 +38,28 @@ VOID
   IN  OUT  UINT32          *ErrorCount  OPTIONAL
   );
 
+//
+// Maximum nested schema list size of a dictionary.
+//
+#define OC_SCHEMA_DICT_MAX_SIZE  256
+
+//
+// Minimal perfect hash of a nested schema list, generated by CheckSchema.py.
+// Key name is hashed with 32-bit FNV-1a, the result modulo list size selects
+// the bucket displacement. The hash mixed with the displacement, modulo list
+// size, selects the slot with the index of the only candidate schema.
+//
+typedef struct {
+  //
+  // Displacement for every bucket.
+  //
+  CONST UINT8    *Displacements;
+  //
+  // Nested schema list index for every slot.
+  //
+  CONST UINT8    *Slots;
+} OC_SCHEMA_HASH;
+
 //
 // OC_SCHEMA_INFO for nested dictionaries
 //
@@ -45,11 +67,15 @@ typedef struct {
   //
   // Nested schema list.
   //
-  OC_SCHEMA    *Schema;
+  OC_SCHEMA               *Schema;
   //
   // Nested schema list size.
   //
-  UINT32       SchemaSize;
+  UINT32                  SchemaSize;
+  //
+  // Nested schema list perfect hash, binary search is used when NULL.
+  //
+  CONST OC_SCHEMA_HASH    *Hash;
 } OC_SCHEMA_DICT;
 
 //
@@ -223,7 +249,7 @@ ParseSerializedArray (
   );
 
 //
-// Main interface for parsing serialized data.
+// Main interface for parsing serialized data, XML and binary plists are accepted.
 // PlistBuffer will be modified during the execution.
 //
 BOOLEAN
@@ -263,13 +289,15 @@ ParseSerialized (
 // M prefix stands for Meta, which means meta data type casting is used.
 // F suffix stands for Fixed, which means fixed file size is assumed.
 //
+// Dict macros expect Schema##Hash perfect hash generated by CheckSchema.py.
+//
 #define OC_SCHEMA_DICT(Name, Schema)                                     \
   {(Name), PLIST_NODE_TYPE_DICT, FALSE, ParseSerializedDict,             \
-    {.Dict = {(Schema), ARRAY_SIZE (Schema)}}}
+    {.Dict = {(Schema), ARRAY_SIZE (Schema), &Schema##Hash}}}
 
 #define OC_SCHEMA_DICT_OPT(Name, Schema)                                 \
   {(Name), PLIST_NODE_TYPE_DICT, TRUE, ParseSerializedDict,              \
-    {.Dict = {(Schema), ARRAY_SIZE (Schema)}}}
+    {.Dict = {(Schema), ARRAY_SIZE (Schema), &Schema##Hash}}}
 
 #define OC_SCHEMA_BOOLEAN(Name)                                          \
   OC_SCHEMA_VALUE (Name, 0, BOOLEAN, OC_SCHEMA_VALUE_BOOLEAN)
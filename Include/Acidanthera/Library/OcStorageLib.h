@@ -40,6 +40,16 @@
 **/
 #define OC_STORAGE_SAFE_PATH_MAX  128
 
+/**
+  Default maximum total size of files kept in storage file cache.
+**/
+#define OC_STORAGE_CACHE_DEFAULT_SIZE  SIZE_8MB
+
+/**
+  Number of storage file cache buckets indexed by path hash, power of two.
+**/
+#define OC_STORAGE_CACHE_BUCKET_COUNT  64U
+
 /**
   Structure declaration for vault file.
 **/
@@ -56,6 +66,14 @@ OC_DECLARE (OC_STORAGE_VAULT_FILES)
   _(OC_STORAGE_VAULT_FILES      , Files    ,     , OC_CONSTR (OC_STORAGE_VAULT_FILES, _, __) , OC_DESTR (OC_STORAGE_VAULT_FILES))
 OC_DECLARE (OC_STORAGE_VAULT)
 
+/**
+  Vault file lookup index slot.
+**/
+typedef struct {
+  UINT32    Hash;  ///< hash of the vault file path
+  UINT32    Index; ///< index in vault files plus one, 0 for free slots
+} OC_STORAGE_VAULT_INDEX;
+
 /**
   Storage abstraction context
 **/
@@ -97,9 +115,48 @@ typedef struct {
   ///
   OC_STORAGE_VAULT                   Vault;
   ///
+  /// Open-addressing hash index over vault file paths.
+  /// May be NULL, in which case lookups fall back to linear scanning.
+  ///
+  OC_STORAGE_VAULT_INDEX             *VaultIndex;
+  ///
+  /// Number of VaultIndex slots minus one, slot count is a power of two.
+  ///
+  UINT32                             VaultIndexMask;
+  ///
   /// Vault status.
   ///
   BOOLEAN                            HasVault;
+  ///
+  /// Cached verified files, most recently used first.
+  /// Only valid when FileCacheMaxSize is not 0.
+  ///
+  LIST_ENTRY                         FileCache;
+  ///
+  /// Cached verified files grouped by path hash for lookup.
+  /// Only valid when FileCacheMaxSize is not 0.
+  ///
+  LIST_ENTRY                         FileCacheBuckets[OC_STORAGE_CACHE_BUCKET_COUNT];
+  ///
+  /// Total size of cached file data.
+  ///
+  UINTN                              FileCacheSize;
+  ///
+  /// Maximum total size of cached file data, 0 when caching is disabled.
+  ///
+  UINTN                              FileCacheMaxSize;
+  ///
+  /// Number of reads served from file cache.
+  ///
+  UINT32                             FileCacheHits;
+  ///
+  /// Number of reads not served from file cache.
+  ///
+  UINT32                             FileCacheMisses;
+  ///
+  /// Number of files evicted from file cache due to size limit.
+  ///
+  UINT32                             FileCacheEvictions;
 } OC_STORAGE_CONTEXT;
 
 /**
@@ -134,6 +191,55 @@ OcStorageFree (
   IN OUT OC_STORAGE_CONTEXT  *Context
   );
 
+/**
+  Enable, resize, or disable storage file cache. Files read by
+  OcStorageReadFileUnicode are kept after being read and verified,
+  so that subsequent reads of the same path return a copy without disk
+  access and hashing. Least recently used files are evicted to stay
+  within the size limit, and files larger than a quarter of it are
+  never cached.
+
+  @param[in,out]  Context      Storage context.
+  @param[in]      MaxSize      Maximum total size of cached files, 0 to disable.
+**/
+VOID
+OcStorageSetCacheSize (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     UINTN               MaxSize
+  );
+
+/**
+  Drop files from storage file cache.
+  Dropping all files also reports cache statistics.
+
+  @param[in,out]  Context      Storage context.
+  @param[in]      FilePath     The full path to the file to drop, optional.
+                               When NULL, all cached files are dropped.
+**/
+VOID
+OcStorageInvalidateCache (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath  OPTIONAL
+  );
+
+/**
+  Read and verify all vault files into storage file cache in a single
+  pass ordered by directory. Reads are asynchronous when the file system
+  supports EFI_FILE_PROTOCOL.ReadEx, so that each file is hashed while
+  the next one is being read. Files that do not fit in the remaining
+  cache space or fail verification are skipped and left for
+  OcStorageReadFileUnicode to handle.
+
+  @param[in,out]  Context     Storage context with vault and enabled file cache.
+
+  @retval EFI_SUCCESS on success.
+  @retval EFI_UNSUPPORTED when there is no vault or file cache is disabled.
+**/
+EFI_STATUS
+OcStoragePrefetchVault (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  );
+
 /**
   Check whether file exists.
 
@@ -153,7 +259,8 @@ OcStorageExistsFileUnicode (
   Null termination does not affect the returned file size.
   Depending on the implementation 0 byte files may return null.
   If storage context was created with valid storage key, then signature
-  checking will be performed
+  checking will be performed. With file cache enabled, repeated reads
+  are served from the cache. The caller must free the returned buffer.
 
   @param[in]  Context      Storage context.
   @param[in]  FilePath     The full path to the file on the device.
@@ -132,22 +132,65 @@ XmlDocumentParse (
   IN      BOOLEAN  WithRefs
   );
 
+/**
+  Parse the XML fragment in buffer lazily. Children of nodes at LazyLevel
+  nesting or deeper, with root being at level 0, are only located and get
+  parsed on first access. Unaccessed nodes are exported unchanged.
+
+  @param[in,out]  Buffer     Chunk to be parsed.
+  @param[in]      Length     Size of the buffer.
+  @param[in]      WithRef    TRUE to enable reference lookup support.
+  @param[in]      LazyLevel  Nesting level to start lazy parsing from.
+
+  @warning Same restrictions as for XmlDocumentParse apply.
+  @warning Errors in lazy nodes are only reported on their access. Malformed
+           lazy nodes have no children and make the document non-exportable.
+
+  @return The parsed xml fragment or NULL.
+**/
+XML_DOCUMENT *
+XmlDocumentParseLazy (
+  IN OUT  CHAR8    *Buffer,
+  IN      UINT32   Length,
+  IN      BOOLEAN  WithRefs,
+  IN      UINT32   LazyLevel
+  );
+
+/**
+  Locate the closing tag of a node in an unparsed XML buffer.
+
+  @param[in]  Buffer  Buffer starting right after the opening tag of the node.
+  @param[in]  Length  Size of the buffer.
+  @param[out] Offset  Offset of the closing tag in the buffer.
+
+  @retval TRUE if the closing tag was found.
+**/
+BOOLEAN
+XmlLocateClosingTag (
+  IN  CONST CHAR8  *Buffer,
+  IN  UINT32       Length,
+  OUT UINT32       *Offset
+  );
+
 /**
   Export parsed document into the buffer.
 
-  @param[in]  Document          XML_DOCUMENT to export.
-  @param[out] Length            Resulting length of the buffer without trailing '\0'. Optional.
-  @param[in]  Skip              Number of root levels to be skipped before exporting, normally 0.
-  @param[in]  PrependPlistInfo  TRUE to prepend XML plist doc info to exported document.
+  @param[in,out]  Document          XML_DOCUMENT to export.
+  @param[out]     Length            Resulting length of the buffer without trailing '\0'. Optional.
+  @param[in]      Skip              Number of root levels to be skipped before exporting, normally 0.
+  @param[in]      PrependPlistInfo  TRUE to prepend XML plist doc info to exported document.
+
+  @warning Lazy nodes within skipped levels are parsed, documents with malformed
+           lazy nodes are not exported.
 
   @return The exported buffer allocated from pool or NULL.
 **/
 CHAR8 *
 XmlDocumentExport (
-  IN   CONST XML_DOCUMENT  *Document,
-  OUT  UINT32              *Length  OPTIONAL,
-  IN   UINT32              Skip,
-  IN   BOOLEAN             PrependPlistInfo
+  IN OUT  XML_DOCUMENT  *Document,
+  OUT     UINT32        *Length  OPTIONAL,
+  IN      UINT32        Skip,
+  IN      BOOLEAN       PrependPlistInfo
   );
 
 /**
@@ -191,6 +234,8 @@ XmlNodeName (
   @param[in]  Node  A pointer to the XML node.
 
   @return The string content of the XML node or NULL.
+
+  @warning Data and integer nodes of binary plists have no string content.
 **/
 CONST CHAR8 *
 XmlNodeContent (
@@ -214,27 +259,28 @@ XmlNodeChangeContent (
 /**
   Get the number of child nodes under an XML node.
 
-  @param[in]  Node  A pointer to the XML node.
+  @param[in,out]  Node  A pointer to the XML node, lazy children are parsed.
 
-  @return Number of child nodes.
+  @return Number of child nodes, 0 when lazy children are malformed.
 **/
 UINT32
 XmlNodeChildren (
-  IN  CONST XML_NODE  *Node
+  IN OUT  XML_NODE  *Node
   );
 
 /**
   Get the specific child node.
 
-  @param[in]  Node   A pointer to the XML node.
-  @param[in]  Child  Index of children of Node.
+  @param[in,out]  Node   A pointer to the XML node, lazy children are parsed.
+  @param[in]      Child  Index of children of Node.
 
-  @return The n-th child, behaviour is undefined if out of range.
+  @return The n-th child, NULL when lazy children are malformed,
+          behaviour is undefined if out of range.
 **/
 XML_NODE *
 XmlNodeChild (
-  IN  CONST XML_NODE  *Node,
-  IN  UINT32          Child
+  IN OUT  XML_NODE  *Node,
+  IN      UINT32    Child
   );
 
 /**
@@ -333,6 +379,68 @@ XmlUnescapeString (
   IN      CONST CHAR8  *String
   );
 
+/**
+  Binary plist signature.
+**/
+#define PLIST_BINARY_SIGNATURE  "bplist00"
+
+/**
+  Check whether the buffer contains a binary plist.
+
+  @param[in]  Buffer  Plist buffer.
+  @param[in]  Length  Size of the buffer.
+
+  @return TRUE if the buffer starts with binary plist signature.
+**/
+BOOLEAN
+PlistIsBinary (
+  IN  CONST VOID  *Buffer,
+  IN  UINT32      Length
+  );
+
+/**
+  Parse the binary plist (bplist00) in buffer. The resulting document is
+  accessed with the same functions as the parsed XML plist. Data, integer,
+  and ASCII string nodes refer to the buffer directly. String and key
+  content is XML escaped like in XML plists, so strings containing `&',
+  `<', or `>' are copied, and XmlUnescapeString gives the same results
+  for both formats.
+
+  @param[in,out]  Buffer  Chunk to be parsed.
+  @param[in]      Length  Size of the buffer.
+
+  @warning `Buffer` will be referenced by the document, it may not be freed
+           until XML_DOCUMENT is freed.
+  @warning XmlDocumentFree should be called after completion.
+  @warning `Buffer` contents are permanently modified during parsing.
+  @warning Real, date, UID, and set objects are not supported.
+
+  @return The parsed plist document or NULL.
+**/
+XML_DOCUMENT *
+PlistDocumentParseBinary (
+  IN OUT  UINT8   *Buffer,
+  IN      UINT32  Length
+  );
+
+/**
+  Export the plist document in binary plist (bplist00) format.
+  Shared objects are not deduplicated.
+
+  @param[in]   Document  A pointer to the plist document.
+  @param[out]  Length    Size of the exported binary plist.
+
+  @warning Real and date nodes are not supported.
+  @warning Lazy nodes are parsed, documents with malformed lazy nodes are not exported.
+
+  @return Exported binary plist that must be freed manually or NULL.
+**/
+UINT8 *
+PlistDocumentExportBinary (
+  IN OUT  XML_DOCUMENT  *Document,
+  OUT     UINT32        *Length
+  );
+
 /**
   Get the root node of the plist document.
 
@@ -377,7 +485,7 @@ PlistNodeCast (
 **/
 UINT32
 PlistDictChildren (
-  IN  CONST XML_NODE  *Node
+  IN OUT  XML_NODE  *Node
   );
 
 /**
@@ -391,9 +499,9 @@ PlistDictChildren (
 **/
 XML_NODE *
 PlistDictChild (
-  IN   CONST XML_NODE  *Node,
-  IN   UINT32          Child,
-  OUT  XML_NODE        **Value OPTIONAL
+  IN OUT  XML_NODE  *Node,
+  IN      UINT32    Child,
+  OUT     XML_NODE  **Value OPTIONAL
   );
 
 /**
@@ -129,56 +129,55 @@ OcAppleChunklistVerifySignature (
   return Result;
 }
 
-BOOLEAN
-OcAppleChunklistVerifyData (
-  IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
-  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+VOID
+OcAppleChunklistVerifyDataStart (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context
   )
 {
-  BOOLEAN  Result;
-
-  UINTN                        Index;
-  UINT8                        ChunkHash[SHA256_DIGEST_SIZE];
-  CONST APPLE_CHUNKLIST_CHUNK  *CurrentChunk;
-  UINTN                        CurrentOffset;
-
-  UINT32  ChunkDataSize;
-  VOID    *ChunkData;
-
   ASSERT (Context != NULL);
   ASSERT (Context->Chunks != NULL);
-  ASSERT (ExtentTable != NULL);
 
   DEBUG_CODE (
     ASSERT (Context->Signature == NULL);
     );
 
-  ChunkDataSize = 0;
-  for (Index = 0; Index < Context->ChunkCount; ++Index) {
-    CurrentChunk = &Context->Chunks[Index];
-    if (ChunkDataSize < CurrentChunk->Length) {
-      ChunkDataSize = CurrentChunk->Length;
-    }
-  }
+  Context->VerifyChunkIndex  = 0;
+  Context->VerifyChunkOffset = 0;
+  Context->VerifyFailed      = FALSE;
+  Sha256Init (&Context->VerifyHashContext);
+}
 
-  ChunkData = AllocatePool (ChunkDataSize);
-  if (ChunkData == NULL) {
-    return FALSE;
-  }
+BOOLEAN
+OcAppleChunklistVerifyDataUpdate (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context,
+  IN     CONST VOID                  *Data,
+  IN     UINTN                       DataSize
+  )
+{
+  CONST UINT8                  *DataBytes;
+  CONST APPLE_CHUNKLIST_CHUNK  *CurrentChunk;
+  UINT8                        ChunkHash[SHA256_DIGEST_SIZE];
+  UINTN                        UpdateSize;
 
-  CurrentOffset = 0;
-  for (Index = 0; Index < Context->ChunkCount; Index++) {
-    CurrentChunk = &Context->Chunks[Index];
-
-    Result = OcAppleRamDiskRead (
-               ExtentTable,
-               CurrentOffset,
-               CurrentChunk->Length,
-               ChunkData
-               );
-    if (!Result) {
-      FreePool (ChunkData);
-      return FALSE;
+  ASSERT (Context != NULL);
+  ASSERT ((Data != NULL) || (DataSize == 0));
+
+  DataBytes = Data;
+
+  while (!Context->VerifyFailed && (Context->VerifyChunkIndex < Context->ChunkCount)) {
+    CurrentChunk = &Context->Chunks[Context->VerifyChunkIndex];
+    UpdateSize   = MIN (DataSize, CurrentChunk->Length - Context->VerifyChunkOffset);
+
+    if (UpdateSize > 0) {
+      Sha256Update (&Context->VerifyHashContext, DataBytes, UpdateSize);
+
+      Context->VerifyChunkOffset += (UINT32)UpdateSize;
+      DataBytes                  += UpdateSize;
+      DataSize                   -= UpdateSize;
+    }
+
+    if (Context->VerifyChunkOffset < CurrentChunk->Length) {
+      break;
     }
 
     //
@@ -187,18 +186,69 @@ OcAppleChunklistVerifyData (
     DEBUG ((
       DEBUG_VERBOSE,
       "OCCL: Validating chunk %lu of %lu\n",
-      (UINT64)Index + 1,
+      (UINT64)Context->VerifyChunkIndex + 1,
       (UINT64)Context->ChunkCount
       ));
-    Sha256 (ChunkHash, ChunkData, CurrentChunk->Length);
+    Sha256Final (&Context->VerifyHashContext, ChunkHash);
     if (CompareMem (ChunkHash, CurrentChunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
-      FreePool (ChunkData);
-      return FALSE;
+      Context->VerifyFailed = TRUE;
+      break;
     }
 
-    CurrentOffset += CurrentChunk->Length;
+    ++Context->VerifyChunkIndex;
+    Context->VerifyChunkOffset = 0;
+    Sha256Init (&Context->VerifyHashContext);
   }
 
-  FreePool (ChunkData);
-  return TRUE;
+  return !Context->VerifyFailed;
+}
+
+BOOLEAN
+OcAppleChunklistVerifyDataFinal (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT  *Context
+  )
+{
+  ASSERT (Context != NULL);
+
+  if (Context->VerifyFailed) {
+    return FALSE;
+  }
+
+  //
+  // Complete trailing empty chunks, if any.
+  //
+  OcAppleChunklistVerifyDataUpdate (Context, NULL, 0);
+
+  return Context->VerifyChunkIndex == Context->ChunkCount;
+}
+
+BOOLEAN
+OcAppleChunklistVerifyData (
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
+  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  )
+{
+  UINT32                       Index;
+  CONST APPLE_RAM_DISK_EXTENT  *Extent;
+
+  ASSERT (Context != NULL);
+  ASSERT (Context->Chunks != NULL);
+  ASSERT (ExtentTable != NULL);
+
+  //
+  // Hash the data in place, chunks may span extent boundaries.
+  //
+  OcAppleChunklistVerifyDataStart (Context);
+
+  for (Index = 0; Index < ExtentTable->ExtentCount; ++Index) {
+    Extent = &ExtentTable->Extents[Index];
+    ASSERT (Extent->Start <= MAX_UINTN);
+    ASSERT (Extent->Length <= MAX_UINTN);
+
+    if (!OcAppleChunklistVerifyDataUpdate (Context, (VOID *)(UINTN)Extent->Start, (UINTN)Extent->Length)) {
+      return FALSE;
+    }
+  }
+
+  return OcAppleChunklistVerifyDataFinal (Context);
 }
@@ -15,7 +15,9 @@
 #include <Protocol/AppleDiskImage.h>
 #include <Protocol/AppleRamDisk.h>
 #include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
 
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
@@ -64,16 +66,173 @@ typedef PACKED struct {
     BlockIo                                               \
     )
 
+#define OC_APPLE_DISK_IMAGE_MOUNTED_DATA_FROM_THIS2(This)  \
+  BASE_CR (                                                \
+    (This),                                                \
+    OC_APPLE_DISK_IMAGE_MOUNTED_DATA,                      \
+    BlockIo2                                               \
+    )
+
+//
+// Background work timer period in 100 ns units, 1 ms.
+//
+#define DMG_BACKGROUND_WORK_PERIOD  10000U
+
 typedef struct {
   UINT32                         Signature;
 
   EFI_BLOCK_IO_PROTOCOL          BlockIo;
+  EFI_BLOCK_IO2_PROTOCOL         BlockIo2;
   EFI_BLOCK_IO_MEDIA             BlockIoMedia;
   DMG_DEVICE_PATH                DevicePath;
 
   OC_APPLE_DISK_IMAGE_CONTEXT    *ImageContext;
+  //
+  // Asynchronous reads and read-ahead are done from a timer callback
+  // at TPL_CALLBACK, image context is accessed at this TPL only.
+  //
+  EFI_EVENT                      BackgroundWorkEvent;
+  BOOLEAN                        BackgroundWorkActive;
+  LIST_ENTRY                     AsyncRequests;
 } OC_APPLE_DISK_IMAGE_MOUNTED_DATA;
 
+#define DMG_ASYNC_REQUEST_FROM_LINK(Link)  \
+  BASE_CR (                                \
+    (Link),                                \
+    DMG_ASYNC_REQUEST,                     \
+    Link                                   \
+    )
+
+typedef struct {
+  LIST_ENTRY             Link;
+  EFI_LBA                Lba;
+  UINTN                  BufferSize;
+  VOID                   *Buffer;
+  EFI_BLOCK_IO2_TOKEN    *Token;
+} DMG_ASYNC_REQUEST;
+
+/**
+  Start background work timer unless it is already running.
+  Must be called at TPL_CALLBACK.
+**/
+STATIC
+VOID
+InternalStartBackgroundWork (
+  IN OUT OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData
+  )
+{
+  EFI_STATUS  Status;
+
+  if (DiskImageData->BackgroundWorkActive || (DiskImageData->BackgroundWorkEvent == NULL)) {
+    return;
+  }
+
+  Status = gBS->SetTimer (
+                  DiskImageData->BackgroundWorkEvent,
+                  TimerPeriodic,
+                  DMG_BACKGROUND_WORK_PERIOD
+                  );
+  if (!EFI_ERROR (Status)) {
+    DiskImageData->BackgroundWorkActive = TRUE;
+  }
+}
+
+/**
+  Read blocks from disk image with validated parameters.
+  Must be called at TPL_CALLBACK.
+**/
+STATIC
+EFI_STATUS
+InternalReadBlocks (
+  IN  OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData,
+  IN  EFI_LBA                           Lba,
+  IN  UINTN                             BufferSize,
+  OUT VOID                              *Buffer
+  )
+{
+  BOOLEAN  Result;
+
+  Result = OcAppleDiskImageRead (
+             DiskImageData->ImageContext,
+             (UINTN)Lba,
+             BufferSize,
+             Buffer
+             );
+  if (!Result) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (DiskImageData->ImageContext->ReadAheadPending > 0) {
+    InternalStartBackgroundWork (DiskImageData);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Complete one queued asynchronous read, or decompress one chunk ahead
+  of sequential reads when there is none. The timer is stopped when
+  there is nothing left to do.
+**/
+STATIC
+VOID
+EFIAPI
+InternalBackgroundWork (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData;
+  DMG_ASYNC_REQUEST                 *Request;
+  BOOLEAN                           HasWork;
+
+  DiskImageData = Context;
+
+  if (!IsListEmpty (&DiskImageData->AsyncRequests)) {
+    Request = DMG_ASYNC_REQUEST_FROM_LINK (GetFirstNode (&DiskImageData->AsyncRequests));
+    RemoveEntryList (&Request->Link);
+
+    Request->Token->TransactionStatus = InternalReadBlocks (
+                                          DiskImageData,
+                                          Request->Lba,
+                                          Request->BufferSize,
+                                          Request->Buffer
+                                          );
+    gBS->SignalEvent (Request->Token->Event);
+    FreePool (Request);
+    HasWork = TRUE;
+  } else {
+    HasWork = OcAppleDiskImageReadAhead (DiskImageData->ImageContext);
+  }
+
+  if (!HasWork && IsListEmpty (&DiskImageData->AsyncRequests)) {
+    gBS->SetTimer (DiskImageData->BackgroundWorkEvent, TimerCancel, 0);
+    DiskImageData->BackgroundWorkActive = FALSE;
+  }
+}
+
+/**
+  Abort all queued asynchronous reads.
+  Must be called at TPL_CALLBACK.
+**/
+STATIC
+VOID
+InternalAbortAsyncRequests (
+  IN OUT OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData
+  )
+{
+  DMG_ASYNC_REQUEST  *Request;
+
+  while (!IsListEmpty (&DiskImageData->AsyncRequests)) {
+    Request = DMG_ASYNC_REQUEST_FROM_LINK (GetFirstNode (&DiskImageData->AsyncRequests));
+    RemoveEntryList (&Request->Link);
+
+    Request->Token->TransactionStatus = EFI_ABORTED;
+    gBS->SignalEvent (Request->Token->Event);
+    FreePool (Request);
+  }
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -96,8 +255,9 @@ DiskImageBlockIoReadBlocks (
   OUT VOID                  *Buffer
   )
 {
+  EFI_STATUS                        Status;
+  EFI_TPL                           OldTpl;
   OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData;
-  BOOLEAN                           Result;
 
   if ((This == NULL) || (Buffer == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -118,17 +278,11 @@ DiskImageBlockIoReadBlocks (
     return EFI_INVALID_PARAMETER;
   }
 
-  Result = OcAppleDiskImageRead (
-             DiskImageData->ImageContext,
-             (UINTN)Lba,
-             BufferSize,
-             Buffer
-             );
-  if (!Result) {
-    return EFI_DEVICE_ERROR;
-  }
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  Status = InternalReadBlocks (DiskImageData, Lba, BufferSize, Buffer);
+  gBS->RestoreTPL (OldTpl);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -155,6 +309,141 @@ DiskImageBlockIoFlushBlocks (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+DiskImageBlockIo2Reset (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  )
+{
+  OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData;
+  EFI_TPL                           OldTpl;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  DiskImageData = OC_APPLE_DISK_IMAGE_MOUNTED_DATA_FROM_THIS2 (This);
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  InternalAbortAsyncRequests (DiskImageData);
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+DiskImageBlockIo2ReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
+  )
+{
+  EFI_STATUS                        Status;
+  EFI_TPL                           OldTpl;
+  OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData;
+  DMG_ASYNC_REQUEST                 *Request;
+
+  if ((This == NULL) || (Buffer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((BufferSize % APPLE_DISK_IMAGE_SECTOR_SIZE) != 0) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  DiskImageData = OC_APPLE_DISK_IMAGE_MOUNTED_DATA_FROM_THIS2 (This);
+  if (DiskImageData->Signature == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  ASSERT (DiskImageData->Signature == OC_APPLE_DISK_IMAGE_MOUNTED_DATA_SIGNATURE);
+
+  if (Lba >= DiskImageData->ImageContext->SectorCount) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Blocking request when no token event is provided.
+  //
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    Status = InternalReadBlocks (DiskImageData, Lba, BufferSize, Buffer);
+    gBS->RestoreTPL (OldTpl);
+    return Status;
+  }
+
+  if (BufferSize == 0) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    gBS->SignalEvent (Token->Event);
+    return EFI_SUCCESS;
+  }
+
+  Request = AllocatePool (sizeof (*Request));
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Lba        = Lba;
+  Request->BufferSize = BufferSize;
+  Request->Buffer     = Buffer;
+  Request->Token      = Token;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  if (DiskImageData->BackgroundWorkEvent == NULL) {
+    //
+    // No background work is possible, complete the request immediately.
+    //
+    Token->TransactionStatus = InternalReadBlocks (DiskImageData, Lba, BufferSize, Buffer);
+    gBS->SignalEvent (Token->Event);
+    FreePool (Request);
+  } else {
+    InsertTailList (&DiskImageData->AsyncRequests, &Request->Link);
+    InternalStartBackgroundWork (DiskImageData);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+DiskImageBlockIo2WriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  )
+{
+  return EFI_WRITE_PROTECTED;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+DiskImageBlockIo2FlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
+  )
+{
+  if ((Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    gBS->SignalEvent (Token->Event);
+  }
+
+  return EFI_SUCCESS;
+}
+
 STATIC UINT32  mDmgCounter; ///< FIXME: This should exist on a protocol basis!
 
 STATIC
@@ -238,6 +527,49 @@ STATIC CONST EFI_BLOCK_IO_PROTOCOL  mDiskImageBlockIo = {
   DiskImageBlockIoFlushBlocks
 };
 
+STATIC CONST EFI_BLOCK_IO2_PROTOCOL  mDiskImageBlockIo2 = {
+  NULL,
+  DiskImageBlockIo2Reset,
+  DiskImageBlockIo2ReadBlocksEx,
+  DiskImageBlockIo2WriteBlocksEx,
+  DiskImageBlockIo2FlushBlocksEx
+};
+
+/**
+  Stop background work, aborting pending asynchronous reads.
+**/
+STATIC
+VOID
+InternalStopBackgroundWork (
+  IN OUT OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData
+  )
+{
+  EFI_TPL  OldTpl;
+
+  if (DiskImageData->BackgroundWorkEvent != NULL) {
+    gBS->CloseEvent (DiskImageData->BackgroundWorkEvent);
+    DiskImageData->BackgroundWorkEvent  = NULL;
+    DiskImageData->BackgroundWorkActive = FALSE;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  InternalAbortAsyncRequests (DiskImageData);
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Release mounted disk image data.
+**/
+STATIC
+VOID
+InternalFreeMountedData (
+  IN OC_APPLE_DISK_IMAGE_MOUNTED_DATA  *DiskImageData
+  )
+{
+  InternalStopBackgroundWork (DiskImageData);
+  FreePool (DiskImageData);
+}
+
 EFI_HANDLE
 OcAppleDiskImageInstallBlockIo (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT     *Context,
@@ -268,12 +600,37 @@ OcAppleDiskImageInstallBlockIo (
     sizeof (DiskImageData->BlockIo)
     );
 
+  CopyMem (
+    &DiskImageData->BlockIo2,
+    &mDiskImageBlockIo2,
+    sizeof (DiskImageData->BlockIo2)
+    );
+
   DiskImageData->BlockIo.Media             = &DiskImageData->BlockIoMedia;
+  DiskImageData->BlockIo2.Media            = &DiskImageData->BlockIoMedia;
   DiskImageData->BlockIoMedia.MediaPresent = TRUE;
   DiskImageData->BlockIoMedia.ReadOnly     = TRUE;
   DiskImageData->BlockIoMedia.BlockSize    = APPLE_DISK_IMAGE_SECTOR_SIZE;
   DiskImageData->BlockIoMedia.LastBlock    = (Context->SectorCount - 1);
 
+  InitializeListHead (&DiskImageData->AsyncRequests);
+
+  //
+  // Without the timer, asynchronous reads complete immediately and
+  // no read-ahead is done.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  InternalBackgroundWork,
+                  DiskImageData,
+                  &DiskImageData->BackgroundWorkEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCDI: Failed to create background work event %r\n", Status));
+    DiskImageData->BackgroundWorkEvent = NULL;
+  }
+
   InternalConstructDmgDevicePath (DiskImageData, FileSize);
 
   BlockIoHandle = NULL;
@@ -283,11 +640,13 @@ OcAppleDiskImageInstallBlockIo (
                          &DiskImageData->DevicePath,
                          &gEfiBlockIoProtocolGuid,
                          &DiskImageData->BlockIo,
+                         &gEfiBlockIo2ProtocolGuid,
+                         &DiskImageData->BlockIo2,
                          NULL
                          );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "OCDI: Failed to install protocols %r\n", Status));
-    FreePool (DiskImageData);
+    InternalFreeMountedData (DiskImageData);
     return NULL;
   }
 
@@ -303,12 +662,15 @@ OcAppleDiskImageInstallBlockIo (
                     &DiskImageData->DevicePath,
                     &gEfiBlockIoProtocolGuid,
                     &DiskImageData->BlockIo,
+                    &gEfiBlockIo2ProtocolGuid,
+                    &DiskImageData->BlockIo2,
                     NULL
                     );
     if (!EFI_ERROR (Status)) {
-      FreePool (DiskImageData);
+      InternalFreeMountedData (DiskImageData);
     } else {
       DEBUG ((DEBUG_INFO, "OCDI: Failed to uninstall protocols %r\n", Status));
+      InternalStopBackgroundWork (DiskImageData);
       DiskImageData->Signature = 0;
     }
 
@@ -351,22 +713,33 @@ OcAppleDiskImageUninstallBlockIo (
 
   DiskImageData = OC_APPLE_DISK_IMAGE_MOUNTED_DATA_FROM_THIS (BlockIo);
 
+  DEBUG ((
+    DEBUG_INFO,
+    "OCDI: DMG chunk cache hits %Lu misses %Lu read-ahead %Lu\n",
+    Context->ChunkCacheHits,
+    Context->ChunkCacheMisses,
+    Context->ChunkReadAheads
+    ));
+
   Status  = gBS->DisconnectController (BlockIoHandle, NULL, NULL);
   Status |= gBS->UninstallMultipleProtocolInterfaces (
                    BlockIoHandle,
                    &gEfiBlockIoProtocolGuid,
                    &DiskImageData->BlockIo,
+                   &gEfiBlockIo2ProtocolGuid,
+                   &DiskImageData->BlockIo2,
                    &gEfiDevicePathProtocolGuid,
                    &DiskImageData->DevicePath,
                    NULL
                    );
   if (!EFI_ERROR (Status)) {
-    FreePool (DiskImageData);
+    InternalFreeMountedData (DiskImageData);
   } else {
     DEBUG ((
       DEBUG_INFO,
       "OCDI: Failed to disconnect DMG controller or uninstal protocols\n"
       ));
+    InternalStopBackgroundWork (DiskImageData);
     DiskImageData->Signature = 0;
   }
 }
@@ -33,13 +33,15 @@ OcAppleDiskImageInitializeContext (
   IN  UINTN                              FileSize
   )
 {
-  BOOLEAN                      Result;
-  UINTN                        TrailerOffset;
-  APPLE_DISK_IMAGE_TRAILER     Trailer;
-  UINT32                       DmgBlockCount;
-  APPLE_DISK_IMAGE_BLOCK_DATA  **DmgBlocks;
-  UINT32                       SwappedSig;
-  UINT64                       OffsetTop;
+  BOOLEAN                           Result;
+  UINTN                             TrailerOffset;
+  APPLE_DISK_IMAGE_TRAILER          Trailer;
+  UINT32                            DmgBlockCount;
+  APPLE_DISK_IMAGE_BLOCK_DATA       **DmgBlocks;
+  UINT32                            DmgChunkCount;
+  OC_APPLE_DISK_IMAGE_SORTED_CHUNK  *DmgChunks;
+  UINT32                            SwappedSig;
+  UINT64                            OffsetTop;
 
   UINT32                     HeaderSize;
   UINT64                     DataForkOffset;
@@ -66,12 +68,14 @@ OcAppleDiskImageInitializeContext (
     return FALSE;
   }
 
+  OcAppleRamDiskInitializeIndex (&Context->ExtentIndex, ExtentTable);
+
   SwappedSig = SwapBytes32 (APPLE_DISK_IMAGE_MAGIC);
 
   TrailerOffset = (FileSize - sizeof (Trailer));
 
   Result = OcAppleRamDiskRead (
-             ExtentTable,
+             &Context->ExtentIndex,
              TrailerOffset,
              sizeof (Trailer),
              &Trailer
@@ -157,7 +161,7 @@ OcAppleDiskImageInitializeContext (
   }
 
   Result = OcAppleRamDiskRead (
-             ExtentTable,
+             &Context->ExtentIndex,
              (UINTN)XmlOffset,
              (UINTN)XmlLength,
              PlistData
@@ -175,7 +179,9 @@ OcAppleDiskImageInitializeContext (
              (UINTN)DataForkOffset,
              (UINTN)DataForkLength,
              &DmgBlockCount,
-             &DmgBlocks
+             &DmgBlocks,
+             &DmgChunkCount,
+             &DmgChunks
              );
 
   FreePool (PlistData);
@@ -185,18 +191,48 @@ OcAppleDiskImageInitializeContext (
     return FALSE;
   }
 
-  Context->ExtentTable = ExtentTable;
-  Context->BlockCount  = DmgBlockCount;
-  Context->Blocks      = DmgBlocks;
-  Context->SectorCount = (UINTN)SectorCount;
+  Context->ExtentTable      = ExtentTable;
+  Context->BlockCount       = DmgBlockCount;
+  Context->Blocks           = DmgBlocks;
+  Context->ChunkCount       = DmgChunkCount;
+  Context->Chunks           = DmgChunks;
+  Context->SectorCount      = (UINTN)SectorCount;
+  Context->MaxCachedChunks  = OC_APPLE_DISK_IMAGE_DEFAULT_CACHED_CHUNKS;
+  Context->CachedChunkCount = 0;
+  Context->CachedChunks     = NULL;
+  Context->ChunkCacheHits   = 0;
+  Context->ChunkCacheMisses = 0;
+  Context->ChunkCacheClock  = 0;
+
+  Context->ReadAheadChunks     = OC_APPLE_DISK_IMAGE_DEFAULT_READ_AHEAD_CHUNKS;
+  Context->SequentialReads     = 0;
+  Context->NextReadLba         = 0;
+  Context->ReadAheadChunkIndex = 0;
+  Context->ReadAheadPending    = 0;
+  Context->ChunkReadAheads     = 0;
 
   return TRUE;
 }
 
+/**
+  Verify DMG data against the chunklist while it is being loaded.
+**/
+STATIC
+BOOLEAN
+InternalVerifyLoadedData (
+  IN VOID        *Context,
+  IN CONST VOID  *Data,
+  IN UINTN       DataSize
+  )
+{
+  return OcAppleChunklistVerifyDataUpdate (Context, Data, DataSize);
+}
+
 BOOLEAN
 OcAppleDiskImageInitializeFromFile (
-  OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  EFI_FILE_PROTOCOL            *File
+  OUT    OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     EFI_FILE_PROTOCOL            *File,
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext  OPTIONAL
   )
 {
   EFI_STATUS  Status;
@@ -220,7 +256,24 @@ OcAppleDiskImageInitializeFromFile (
     return FALSE;
   }
 
-  Result = OcAppleRamDiskLoadFile (ExtentTable, File, FileSize);
+  if (ChunklistContext != NULL) {
+    OcAppleChunklistVerifyDataStart (ChunklistContext);
+  }
+
+  Result = OcAppleRamDiskLoadFile (
+             ExtentTable,
+             File,
+             FileSize,
+             ChunklistContext != NULL ? InternalVerifyLoadedData : NULL,
+             ChunklistContext
+             );
+  if (Result && (ChunklistContext != NULL)) {
+    Result = OcAppleChunklistVerifyDataFinal (ChunklistContext);
+    if (!Result) {
+      DEBUG ((DEBUG_WARN, "OCDI: DMG file has been altered\n"));
+    }
+  }
+
   if (!Result) {
     DEBUG ((DEBUG_INFO, "OCDI: Failed to load DMG file\n"));
 
@@ -268,6 +321,18 @@ OcAppleDiskImageFreeContext (
   }
 
   FreePool (Context->Blocks);
+  FreePool (Context->Chunks);
+
+  if (Context->CachedChunks != NULL) {
+    for (Index = 0; Index < Context->CachedChunkCount; ++Index) {
+      if (Context->CachedChunks[Index].Data != NULL) {
+        FreePool (Context->CachedChunks[Index].Data);
+      }
+    }
+
+    FreePool (Context->CachedChunks);
+    Context->CachedChunks = NULL;
+  }
 }
 
 VOID
@@ -279,6 +344,201 @@ OcAppleDiskImageFreeFile (
   OcAppleDiskImageFreeContext (Context);
 }
 
+/**
+  Get decompressed chunk data from the chunk cache, decompressing it on miss.
+
+  @param[in,out]  Context      Disk image context.
+  @param[in]      Chunk        Compressed chunk.
+  @param[in]      ChunkLength  Decompressed chunk length.
+  @param[in]      ReadAhead    Chunk is requested ahead of actual read.
+
+  @return  Decompressed chunk data owned by the cache or NULL.
+**/
+STATIC
+UINT8 *
+InternalGetCachedChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN     CONST APPLE_DISK_IMAGE_CHUNK  *Chunk,
+  IN     UINTN                         ChunkLength,
+  IN     BOOLEAN                       ReadAhead
+  )
+{
+  BOOLEAN                           Result;
+  UINT32                            Index;
+  OC_APPLE_DISK_IMAGE_CACHED_CHUNK  *Entry;
+  UINT8                             *ChunkDataCompressed;
+  UINTN                             OutSize;
+
+  //
+  // Cache is allocated on first read, later MaxCachedChunks changes are ignored.
+  //
+  if (Context->CachedChunks == NULL) {
+    Context->CachedChunks = AllocateZeroPool (MAX (Context->MaxCachedChunks, 1) * sizeof (*Context->CachedChunks));
+    if (Context->CachedChunks == NULL) {
+      return NULL;
+    }
+
+    Context->CachedChunkCount = MAX (Context->MaxCachedChunks, 1);
+  }
+
+  ++Context->ChunkCacheClock;
+
+  Entry = &Context->CachedChunks[0];
+  for (Index = 0; Index < Context->CachedChunkCount; ++Index) {
+    if (Context->CachedChunks[Index].Chunk == Chunk) {
+      if (!ReadAhead) {
+        ++Context->ChunkCacheHits;
+      }
+
+      Context->CachedChunks[Index].LastUsed = Context->ChunkCacheClock;
+      return Context->CachedChunks[Index].Data;
+    }
+
+    if (Context->CachedChunks[Index].LastUsed < Entry->LastUsed) {
+      Entry = &Context->CachedChunks[Index];
+    }
+  }
+
+  if (ReadAhead) {
+    ++Context->ChunkReadAheads;
+  } else {
+    ++Context->ChunkCacheMisses;
+  }
+
+  //
+  // Evict least recently used chunk, reusing its buffer when large enough.
+  //
+  Entry->Chunk    = NULL;
+  Entry->LastUsed = 0;
+  if ((Entry->Data != NULL) && (Entry->DataSize < ChunkLength)) {
+    FreePool (Entry->Data);
+    Entry->Data = NULL;
+  }
+
+  if (Entry->Data == NULL) {
+    Entry->Data = AllocatePool (ChunkLength);
+    if (Entry->Data == NULL) {
+      return NULL;
+    }
+
+    Entry->DataSize = ChunkLength;
+  }
+
+  ChunkDataCompressed = AllocatePool ((UINTN)Chunk->CompressedLength);
+  if (ChunkDataCompressed == NULL) {
+    return NULL;
+  }
+
+  Result = OcAppleRamDiskRead (
+             &Context->ExtentIndex,
+             (UINTN)Chunk->CompressedOffset,
+             (UINTN)Chunk->CompressedLength,
+             ChunkDataCompressed
+             );
+  if (!Result) {
+    FreePool (ChunkDataCompressed);
+    return NULL;
+  }
+
+  switch (Chunk->Type) {
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_ADC:
+      OutSize = DecompressADC (
+                  Entry->Data,
+                  ChunkLength,
+                  ChunkDataCompressed,
+                  (UINTN)Chunk->CompressedLength
+                  );
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB:
+      OutSize = DecompressZLIB (
+                  Entry->Data,
+                  ChunkLength,
+                  ChunkDataCompressed,
+                  (UINTN)Chunk->CompressedLength
+                  );
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_BZ2:
+      OutSize = DecompressBZIP2 (
+                  Entry->Data,
+                  ChunkLength,
+                  ChunkDataCompressed,
+                  (UINTN)Chunk->CompressedLength
+                  );
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE:
+      OutSize = DecompressLZFSE (
+                  Entry->Data,
+                  ChunkLength,
+                  ChunkDataCompressed,
+                  (UINTN)Chunk->CompressedLength
+                  );
+      break;
+
+    default:
+      ASSERT (FALSE);
+      OutSize = 0;
+      break;
+  }
+
+  FreePool (ChunkDataCompressed);
+  if (OutSize != ChunkLength) {
+    return NULL;
+  }
+
+  Entry->Chunk    = Chunk;
+  Entry->LastUsed = Context->ChunkCacheClock;
+
+  return Entry->Data;
+}
+
+/**
+  Update sequential access detector after a successful read and queue
+  the chunks following it for read-ahead.
+
+  @param[in,out]  Context         Disk image context.
+  @param[in]      Lba             First read sector.
+  @param[in]      BufferSize      Read size in bytes.
+  @param[in]      NextChunkIndex  Index of the chunk following the read.
+**/
+STATIC
+VOID
+InternalDetectSequentialRead (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Lba,
+  IN     UINTN                        BufferSize,
+  IN     UINT32                       NextChunkIndex
+  )
+{
+  UINT32  CacheSize;
+
+  if (Lba == Context->NextReadLba) {
+    if (Context->SequentialReads < MAX_UINT32) {
+      ++Context->SequentialReads;
+    }
+  } else {
+    Context->SequentialReads = 0;
+  }
+
+  Context->NextReadLba = Lba + BufferSize / APPLE_DISK_IMAGE_SECTOR_SIZE;
+
+  if (Context->SequentialReads < OC_APPLE_DISK_IMAGE_SEQUENTIAL_READ_THRESHOLD) {
+    Context->ReadAheadPending = 0;
+    return;
+  }
+
+  //
+  // Leave room in the cache for the chunk being consumed.
+  //
+  CacheSize = Context->CachedChunks != NULL
+              ? Context->CachedChunkCount : MAX (Context->MaxCachedChunks, 1);
+
+  Context->ReadAheadChunkIndex = NextChunkIndex;
+  Context->ReadAheadPending    = MIN (Context->ReadAheadChunks, CacheSize - 1);
+}
+
 BOOLEAN
 OcAppleDiskImageRead (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
@@ -295,16 +555,14 @@ OcAppleDiskImageRead (
   UINT64                       ChunkLength;
   UINT64                       ChunkOffset;
   UINT8                        *ChunkData;
-  UINT8                        *ChunkDataCompressed;
-
-  UINTN  LbaCurrent;
-  UINTN  LbaOffset;
-  UINTN  LbaLength;
-  UINTN  RemainingBufferSize;
-  UINTN  BufferChunkSize;
-  UINT8  *BufferCurrent;
 
-  UINTN  OutSize;
+  UINT32  ChunkIndex;
+  UINTN   LbaCurrent;
+  UINTN   LbaOffset;
+  UINTN   LbaLength;
+  UINTN   RemainingBufferSize;
+  UINTN   BufferChunkSize;
+  UINT8   *BufferCurrent;
 
   ASSERT (Context != NULL);
   ASSERT (Buffer != NULL);
@@ -313,9 +571,10 @@ OcAppleDiskImageRead (
   LbaCurrent          = Lba;
   RemainingBufferSize = BufferSize;
   BufferCurrent       = Buffer;
+  ChunkIndex          = MAX_UINT32;
 
   while (RemainingBufferSize > 0) {
-    Result = InternalGetBlockChunk (Context, LbaCurrent, &BlockData, &Chunk);
+    Result = InternalGetBlockChunk (Context, LbaCurrent, &ChunkIndex, &BlockData, &Chunk);
     if (!Result) {
       return FALSE;
     }
@@ -356,7 +615,7 @@ OcAppleDiskImageRead (
       case APPLE_DISK_IMAGE_CHUNK_TYPE_RAW:
       {
         Result = OcAppleRamDiskRead (
-                   Context->ExtentTable,
+                   &Context->ExtentIndex,
                    (UINTN)(Chunk->CompressedOffset + ChunkOffset),
                    BufferChunkSize,
                    BufferCurrent
@@ -368,38 +627,17 @@ OcAppleDiskImageRead (
         break;
       }
 
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_ADC:
       case APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB:
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_BZ2:
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE:
       {
-        ChunkData = AllocatePool ((UINTN)(ChunkTotalLength + Chunk->CompressedLength));
+        ChunkData = InternalGetCachedChunk (Context, Chunk, (UINTN)ChunkTotalLength, FALSE);
         if (ChunkData == NULL) {
           return FALSE;
         }
 
-        ChunkDataCompressed = (ChunkData + (UINTN)ChunkTotalLength);
-        Result              = OcAppleRamDiskRead (
-                                Context->ExtentTable,
-                                (UINTN)Chunk->CompressedOffset,
-                                (UINTN)Chunk->CompressedLength,
-                                ChunkDataCompressed
-                                );
-        if (!Result) {
-          FreePool (ChunkData);
-          return FALSE;
-        }
-
-        OutSize = DecompressZLIB (
-                    ChunkData,
-                    (UINTN)ChunkTotalLength,
-                    ChunkDataCompressed,
-                    (UINTN)Chunk->CompressedLength
-                    );
-        if (OutSize != (UINTN)ChunkTotalLength) {
-          FreePool (ChunkData);
-          return FALSE;
-        }
-
         CopyMem (BufferCurrent, (ChunkData + ChunkOffset), BufferChunkSize);
-        FreePool (ChunkData);
         break;
       }
 
@@ -417,7 +655,56 @@ OcAppleDiskImageRead (
     RemainingBufferSize -= BufferChunkSize;
     BufferCurrent       += BufferChunkSize;
     LbaCurrent          += LbaLength;
+    ++ChunkIndex;
   }
 
+  InternalDetectSequentialRead (Context, Lba, BufferSize, ChunkIndex);
+
   return TRUE;
 }
+
+BOOLEAN
+OcAppleDiskImageReadAhead (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context
+  )
+{
+  BOOLEAN                 Result;
+  APPLE_DISK_IMAGE_CHUNK  *Chunk;
+  UINT64                  ChunkTotalLength;
+
+  ASSERT (Context != NULL);
+
+  while (Context->ReadAheadPending > 0 && Context->ReadAheadChunkIndex < Context->ChunkCount) {
+    Chunk = Context->Chunks[Context->ReadAheadChunkIndex].Chunk;
+    ++Context->ReadAheadChunkIndex;
+    --Context->ReadAheadPending;
+
+    if (  (Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_ADC)
+       && (Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB)
+       && (Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_BZ2)
+       && (Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE))
+    {
+      continue;
+    }
+
+    Result = BaseOverflowMulU64 (
+               Chunk->SectorCount,
+               APPLE_DISK_IMAGE_SECTOR_SIZE,
+               &ChunkTotalLength
+               );
+    if (!Result) {
+      //
+      // Failures are reported by the actual read of this chunk.
+      //
+      InternalGetCachedChunk (Context, Chunk, (UINTN)ChunkTotalLength, TRUE);
+    }
+
+    break;
+  }
+
+  if (Context->ReadAheadChunkIndex >= Context->ChunkCount) {
+    Context->ReadAheadPending = 0;
+  }
+
+  return Context->ReadAheadPending > 0;
+}
@@ -161,15 +161,97 @@ InternalSwapBlockData (
   return TRUE;
 }
 
+STATIC
+INTN
+EFIAPI
+InternalCompareSortedChunks (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST OC_APPLE_DISK_IMAGE_SORTED_CHUNK  *Chunk1;
+  CONST OC_APPLE_DISK_IMAGE_SORTED_CHUNK  *Chunk2;
+
+  Chunk1 = Buffer1;
+  Chunk2 = Buffer2;
+
+  if (Chunk1->SectorNumber != Chunk2->SectorNumber) {
+    return Chunk1->SectorNumber < Chunk2->SectorNumber ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+  Collect chunks of all blocks into a single array sorted by absolute start sector.
+  Chunks without sectors (comments and terminators) are skipped.
+**/
+STATIC
+BOOLEAN
+InternalSortChunks (
+  IN  APPLE_DISK_IMAGE_BLOCK_DATA       **Blocks,
+  IN  UINT32                            BlockCount,
+  OUT UINT32                            *ChunkCount,
+  OUT OC_APPLE_DISK_IMAGE_SORTED_CHUNK  **Chunks
+  )
+{
+  UINT32                            BlockIndex;
+  UINT32                            ChunkIndex;
+  UINT32                            NumChunks;
+  UINT32                            ChunksSize;
+  OC_APPLE_DISK_IMAGE_SORTED_CHUNK  *SortedChunks;
+  OC_APPLE_DISK_IMAGE_SORTED_CHUNK  Scratch;
+
+  NumChunks = 0;
+  for (BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex) {
+    if (BaseOverflowAddU32 (NumChunks, Blocks[BlockIndex]->ChunkCount, &NumChunks)) {
+      return FALSE;
+    }
+  }
+
+  if (  (NumChunks == 0)
+     || BaseOverflowMulU32 (NumChunks, sizeof (*SortedChunks), &ChunksSize))
+  {
+    return FALSE;
+  }
+
+  SortedChunks = AllocatePool (ChunksSize);
+  if (SortedChunks == NULL) {
+    return FALSE;
+  }
+
+  NumChunks = 0;
+  for (BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex) {
+    for (ChunkIndex = 0; ChunkIndex < Blocks[BlockIndex]->ChunkCount; ++ChunkIndex) {
+      if (Blocks[BlockIndex]->Chunks[ChunkIndex].SectorCount == 0) {
+        continue;
+      }
+
+      SortedChunks[NumChunks].SectorNumber = DMG_SECTOR_START_ABS (Blocks[BlockIndex], &Blocks[BlockIndex]->Chunks[ChunkIndex]);
+      SortedChunks[NumChunks].Block        = Blocks[BlockIndex];
+      SortedChunks[NumChunks].Chunk        = &Blocks[BlockIndex]->Chunks[ChunkIndex];
+      ++NumChunks;
+    }
+  }
+
+  QuickSort (SortedChunks, NumChunks, sizeof (*SortedChunks), InternalCompareSortedChunks, &Scratch);
+
+  *ChunkCount = NumChunks;
+  *Chunks     = SortedChunks;
+  return TRUE;
+}
+
 BOOLEAN
 InternalParsePlist (
-  IN  CHAR8                        *Plist,
-  IN  UINT32                       PlistSize,
-  IN  UINTN                        SectorCount,
-  IN  UINTN                        DataForkOffset,
-  IN  UINTN                        DataForkSize,
-  OUT UINT32                       *BlockCount,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  ***Blocks
+  IN  CHAR8                             *Plist,
+  IN  UINT32                            PlistSize,
+  IN  UINTN                             SectorCount,
+  IN  UINTN                             DataForkOffset,
+  IN  UINTN                             DataForkSize,
+  OUT UINT32                            *BlockCount,
+  OUT APPLE_DISK_IMAGE_BLOCK_DATA       ***Blocks,
+  OUT UINT32                            *ChunkCount,
+  OUT OC_APPLE_DISK_IMAGE_SORTED_CHUNK  **Chunks
   )
 {
   BOOLEAN  Result;
@@ -197,6 +279,8 @@ InternalParsePlist (
   ASSERT (PlistSize > 0);
   ASSERT (BlockCount != NULL);
   ASSERT (Blocks != NULL);
+  ASSERT (ChunkCount != NULL);
+  ASSERT (Chunks != NULL);
 
   DmgBlocks = NULL;
 
@@ -302,9 +386,13 @@ InternalParsePlist (
     }
   }
 
+  Result = InternalSortChunks (DmgBlocks, NumDmgBlocks, ChunkCount, Chunks);
+  if (!Result) {
+    goto DONE_ERROR;
+  }
+
   *BlockCount = NumDmgBlocks;
   *Blocks     = DmgBlocks;
-  Result      = TRUE;
 
 DONE_ERROR:
   if (!Result && (DmgBlocks != NULL)) {
@@ -324,36 +412,52 @@ DONE_ERROR:
 
 BOOLEAN
 InternalGetBlockChunk (
-  IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  UINTN                        Lba,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
-  OUT APPLE_DISK_IMAGE_CHUNK       **Chunk
+  IN     OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Lba,
+  IN OUT UINT32                       *ChunkIndex,
+  OUT    APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
+  OUT    APPLE_DISK_IMAGE_CHUNK       **Chunk
   )
 {
-  UINT32                       BlockIndex;
-  UINT32                       ChunkIndex;
-  APPLE_DISK_IMAGE_BLOCK_DATA  *BlockData;
-  APPLE_DISK_IMAGE_CHUNK       *BlockChunk;
-
-  for (BlockIndex = 0; BlockIndex < Context->BlockCount; ++BlockIndex) {
-    BlockData = Context->Blocks[BlockIndex];
-
-    if (  (Lba >= BlockData->SectorNumber)
-       && (Lba < (BlockData->SectorNumber + BlockData->SectorCount)))
-    {
-      for (ChunkIndex = 0; ChunkIndex < BlockData->ChunkCount; ++ChunkIndex) {
-        BlockChunk = &BlockData->Chunks[ChunkIndex];
-
-        if (  (Lba >= DMG_SECTOR_START_ABS (BlockData, BlockChunk))
-           && (Lba < (DMG_SECTOR_START_ABS (BlockData, BlockChunk) + BlockChunk->SectorCount)))
-        {
-          *Data  = BlockData;
-          *Chunk = BlockChunk;
-          return TRUE;
-        }
+  UINT32                            Start;
+  UINT32                            End;
+  UINT32                            Middle;
+  OC_APPLE_DISK_IMAGE_SORTED_CHUNK  *SortedChunk;
+
+  //
+  // Try the suggested chunk first, sequential reads continue into the next one.
+  //
+  if (  (*ChunkIndex >= Context->ChunkCount)
+     || (Lba < Context->Chunks[*ChunkIndex].SectorNumber)
+     || (Lba >= Context->Chunks[*ChunkIndex].SectorNumber + Context->Chunks[*ChunkIndex].Chunk->SectorCount))
+  {
+    //
+    // Find the last chunk starting at or before Lba.
+    //
+    Start = 0;
+    End   = Context->ChunkCount;
+    while (Start < End) {
+      Middle = Start + (End - Start) / 2;
+      if (Context->Chunks[Middle].SectorNumber <= Lba) {
+        Start = Middle + 1;
+      } else {
+        End = Middle;
       }
     }
+
+    if (Start == 0) {
+      return FALSE;
+    }
+
+    SortedChunk = &Context->Chunks[Start - 1];
+    if (Lba >= SortedChunk->SectorNumber + SortedChunk->Chunk->SectorCount) {
+      return FALSE;
+    }
+
+    *ChunkIndex = Start - 1;
   }
 
-  return FALSE;
+  *Data  = Context->Chunks[*ChunkIndex].Block;
+  *Chunk = Context->Chunks[*ChunkIndex].Chunk;
+  return TRUE;
 }
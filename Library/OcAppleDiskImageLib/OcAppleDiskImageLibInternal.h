@@ -28,21 +28,37 @@
 
 BOOLEAN
 InternalParsePlist (
-  IN  CHAR8                        *Plist,
-  IN  UINT32                       PlistSize,
-  IN  UINTN                        SectorCount,
-  IN  UINTN                        DataForkOffset,
-  IN  UINTN                        DataForkSize,
-  OUT UINT32                       *BlockCount,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  ***Blocks
+  IN  CHAR8                             *Plist,
+  IN  UINT32                            PlistSize,
+  IN  UINTN                             SectorCount,
+  IN  UINTN                             DataForkOffset,
+  IN  UINTN                             DataForkSize,
+  OUT UINT32                            *BlockCount,
+  OUT APPLE_DISK_IMAGE_BLOCK_DATA       ***Blocks,
+  OUT UINT32                            *ChunkCount,
+  OUT OC_APPLE_DISK_IMAGE_SORTED_CHUNK  **Chunks
   );
 
+/**
+  Find chunk containing the sector.
+
+  @param[in]      Context     Disk image context.
+  @param[in]      Lba         Sector to look up.
+  @param[in,out]  ChunkIndex  On input, index of the chunk to try first, e.g.
+                              the one following previous lookup result, or
+                              MAX_UINT32. On output, index of the found chunk.
+  @param[out]     Data        Block containing the chunk.
+  @param[out]     Chunk       Found chunk.
+
+  @retval TRUE on success.
+**/
 BOOLEAN
 InternalGetBlockChunk (
-  IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  UINTN                        Lba,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
-  OUT APPLE_DISK_IMAGE_CHUNK       **Chunk
+  IN     OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Lba,
+  IN OUT UINT32                       *ChunkIndex,
+  OUT    APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
+  OUT    APPLE_DISK_IMAGE_CHUNK       **Chunk
   );
 
 #endif // APPLE_DISK_IMAGE_LIB_INTERNAL_H
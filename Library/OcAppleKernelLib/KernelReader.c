@@ -18,6 +18,7 @@
 #include <IndustryStandard/AppleFatBinaryImage.h>
 
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -31,6 +32,11 @@
 //
 #define KERNEL_HEADER_SIZE  (EFI_PAGE_SIZE * 2)
 
+//
+// Compressed kernel is read and decompressed in chunks of this size.
+//
+#define KERNEL_COMPRESSED_CHUNK_SIZE  BASE_1MB
+
 STATIC SHA384_CONTEXT  mKernelDigestContext;
 STATIC UINT32          mKernelDigestPosition;
 STATIC BOOLEAN         mNeedKernelDigest;
@@ -207,6 +213,14 @@ ParseCompressedHeader (
   UINT32            CompressedSize;
   UINT32            DecompressedSize;
   UINT32            DecompressedHash;
+  OC_LZSS_STREAM    *LzssStream;
+  OC_LZVN_STREAM    *LzvnStream;
+  UINT32            Position;
+  UINT32            RemainingSize;
+  UINT32            PendingSize;
+  UINT32            ChunkSize;
+  UINT32            Consumed;
+  UINTN             LzvnConsumed;
 
   CompHeader       = (MACH_COMP_HEADER *)*Buffer;
   CompressionType  = CompHeader->Compression;
@@ -225,29 +239,85 @@ ParseCompressedHeader (
     return KernelSize;
   }
 
+  if (  (CompressionType != MACH_COMPRESSED_BINARY_INVERT_LZVN)
+     && (CompressionType != MACH_COMPRESSED_BINARY_INVERT_LZSS))
+  {
+    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel unsupported compression %08X at %08X\n", CompressionType, Offset));
+    return KernelSize;
+  }
+
   Status = ReplaceBuffer (DecompressedSize, Buffer, AllocatedSize, ReservedSize);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "OCAK: Decomp kernel (%u bytes) cannot be allocated at %08X\n", DecompressedSize, Offset));
     return KernelSize;
   }
 
-  CompressedBuffer = AllocatePool (CompressedSize);
+  //
+  // Compressed data is read in chunks and decompressed directly into the final buffer,
+  // so that only a single copy of the kernel is kept in memory.
+  //
+  CompressedBuffer = AllocatePool (MIN (CompressedSize, KERNEL_COMPRESSED_CHUNK_SIZE));
   if (CompressedBuffer == NULL) {
     DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be allocated at %08X\n", CompressedSize, Offset));
     return KernelSize;
   }
 
-  Status = KernelGetFileData (File, Offset + sizeof (MACH_COMP_HEADER), CompressedSize, CompressedBuffer);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be read at %08X\n", CompressedSize, Offset));
+  LzssStream = NULL;
+  LzvnStream = NULL;
+  if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN) {
+    LzvnStream = DecompressLZVNStreamInit (*Buffer, DecompressedSize);
+  } else {
+    LzssStream = DecompressLZSSStreamInit (*Buffer, DecompressedSize);
+  }
+
+  if ((LzvnStream == NULL) && (LzssStream == NULL)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Comp kernel stream cannot be allocated at %08X\n", Offset));
     FreePool (CompressedBuffer);
     return KernelSize;
   }
 
-  if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZVN) {
-    KernelSize = (UINT32)DecompressLZVN (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
-  } else if (CompressionType == MACH_COMPRESSED_BINARY_INVERT_LZSS) {
-    KernelSize = (UINT32)DecompressLZSS (*Buffer, DecompressedSize, CompressedBuffer, CompressedSize);
+  Position      = Offset + sizeof (MACH_COMP_HEADER);
+  RemainingSize = CompressedSize;
+  PendingSize   = 0;
+
+  while ((RemainingSize > 0) && (KernelSize < DecompressedSize)) {
+    ChunkSize = MIN (RemainingSize, KERNEL_COMPRESSED_CHUNK_SIZE - PendingSize);
+    if (ChunkSize == 0) {
+      //
+      // Incomplete instruction cannot be larger than the chunk.
+      //
+      DEBUG ((DEBUG_INFO, "OCAK: Comp kernel is corrupted at %08X\n", Offset));
+      break;
+    }
+
+    Status = KernelGetFileData (File, Position, ChunkSize, CompressedBuffer + PendingSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "OCAK: Comp kernel (%u bytes) cannot be read at %08X\n", CompressedSize, Offset));
+      break;
+    }
+
+    Position      += ChunkSize;
+    RemainingSize -= ChunkSize;
+    PendingSize   += ChunkSize;
+
+    if (LzvnStream != NULL) {
+      KernelSize = (UINT32)DecompressLZVNStreamFeed (LzvnStream, CompressedBuffer, PendingSize, &LzvnConsumed);
+      Consumed   = (UINT32)LzvnConsumed;
+    } else {
+      KernelSize = DecompressLZSSStreamFeed (LzssStream, CompressedBuffer, PendingSize, &Consumed);
+    }
+
+    //
+    // Keep incomplete instruction for the next chunk.
+    //
+    PendingSize -= Consumed;
+    CopyMem (CompressedBuffer, CompressedBuffer + Consumed, PendingSize);
+  }
+
+  if (LzvnStream != NULL) {
+    DecompressLZVNStreamFree (LzvnStream);
+  } else {
+    DecompressLZSSStreamFree (LzssStream);
   }
 
   if (KernelSize != DecompressedSize) {
@@ -306,6 +306,40 @@ PatcherGetSymbolAddressValue (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+InternalReportGenericPatch (
+  IN PATCHER_CONTEXT        *Context,
+  IN PATCHER_GENERIC_PATCH  *Patch,
+  IN UINT32                 ReplaceCount
+  )
+{
+  DEBUG ((
+    DEBUG_INFO,
+    "OCAK: %a-bit %a replace count - %u\n",
+    Context->Is32Bit ? "32" : "64",
+    Patch->Comment != NULL ? Patch->Comment : "Patch",
+    ReplaceCount
+    ));
+
+  if ((ReplaceCount > 0) && (Patch->Count > 0) && (ReplaceCount != Patch->Count)) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCAK: %a-bit %a performed only %u replacements out of %u\n",
+      Context->Is32Bit ? "32" : "64",
+      Patch->Comment != NULL ? Patch->Comment : "Patch",
+      ReplaceCount,
+      Patch->Count
+      ));
+  }
+
+  if (ReplaceCount > 0) {
+    return EFI_SUCCESS;
+  }
+
+  return EFI_NOT_FOUND;
+}
+
 EFI_STATUS
 PatcherApplyGenericPatch (
   IN OUT PATCHER_CONTEXT        *Context,
@@ -366,30 +400,445 @@ PatcherApplyGenericPatch (
                    Patch->Skip
                    );
 
-  DEBUG ((
-    DEBUG_INFO,
-    "OCAK: %a-bit %a replace count - %u\n",
-    Context->Is32Bit ? "32" : "64",
-    Patch->Comment != NULL ? Patch->Comment : "Patch",
-    ReplaceCount
-    ));
+  return InternalReportGenericPatch (Context, Patch, ReplaceCount);
+}
 
-  if ((ReplaceCount > 0) && (Patch->Count > 0) && (ReplaceCount != Patch->Count)) {
-    DEBUG ((
-      DEBUG_INFO,
-      "OCAK: %a-bit %a performed only %u replacements out of %u\n",
-      Context->Is32Bit ? "32" : "64",
-      Patch->Comment != NULL ? Patch->Comment : "Patch",
-      ReplaceCount,
-      Patch->Count
-      ));
+//
+// Patch area or patch occurrence in the patched binary.
+//
+typedef struct {
+  UINT32    Offset;
+  UINT32    Size;
+} PATCHER_PATCH_RANGE;
+
+//
+// Batched patch application state.
+//
+typedef struct {
+  //
+  // Patch search ranges, Size is 0 for patches applied individually.
+  //
+  PATCHER_PATCH_RANGE    *Ranges;
+  //
+  // Original Find occurrences, Size is the index of the patch.
+  //
+  PATCHER_PATCH_RANGE    *Matches;
+  UINT32                 MatchCount;
+  UINT32                 MatchAllocCount;
+  //
+  // Areas modified by previously applied patches.
+  //
+  PATCHER_PATCH_RANGE    *Modified;
+  UINT32                 ModifiedCount;
+  UINT32                 ModifiedAllocCount;
+} PATCHER_PATCH_BATCH;
+
+STATIC
+BOOLEAN
+InternalAppendPatchRange (
+  IN OUT PATCHER_PATCH_RANGE  **Ranges,
+  IN OUT UINT32               *Count,
+  IN OUT UINT32               *AllocCount,
+  IN     UINT32               Offset,
+  IN     UINT32               Size
+  )
+{
+  PATCHER_PATCH_RANGE  *NewRanges;
+  UINT32               NewAllocCount;
+
+  if (*Count == *AllocCount) {
+    NewAllocCount = *AllocCount > 0 ? *AllocCount * 2 : 64;
+    if (NewAllocCount < *AllocCount) {
+      return FALSE;
+    }
+
+    NewRanges = ReallocatePool (
+                  *AllocCount * sizeof (**Ranges),
+                  NewAllocCount * sizeof (**Ranges),
+                  *Ranges
+                  );
+    if (NewRanges == NULL) {
+      return FALSE;
+    }
+
+    *Ranges     = NewRanges;
+    *AllocCount = NewAllocCount;
   }
 
-  if (ReplaceCount > 0) {
+  (*Ranges)[*Count].Offset = Offset;
+  (*Ranges)[*Count].Size   = Size;
+  ++(*Count);
+  return TRUE;
+}
+
+STATIC
+BOOLEAN
+InternalCollectPatchMatch (
+  IN VOID    *Context,
+  IN UINT32  PatternIndex,
+  IN UINT32  DataOff
+  )
+{
+  PATCHER_PATCH_BATCH  *Batch;
+  PATCHER_PATCH_RANGE  *Range;
+
+  Batch = Context;
+  Range = &Batch->Ranges[PatternIndex];
+
+  //
+  // Ignore occurrences outside of patch Base and Limit.
+  //
+  if ((DataOff < Range->Offset) || (DataOff - Range->Offset >= Range->Size)) {
+    return TRUE;
+  }
+
+  return InternalAppendPatchRange (
+           &Batch->Matches,
+           &Batch->MatchCount,
+           &Batch->MatchAllocCount,
+           DataOff,
+           PatternIndex
+           );
+}
+
+STATIC
+INTN
+EFIAPI
+InternalCompareOffsets (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  UINT32  Offset1;
+  UINT32  Offset2;
+
+  Offset1 = *(CONST UINT32 *)Buffer1;
+  Offset2 = *(CONST UINT32 *)Buffer2;
+
+  if (Offset1 != Offset2) {
+    return Offset1 < Offset2 ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+  Apply one batched patch with Find pattern.
+  Candidates are original occurrences of the pattern and every offset overlapping
+  areas modified by previous patches, the latter may contain new occurrences.
+  Candidates are rechecked against current data, so the result matches ApplyPatch.
+
+  @param[in,out] Batch         Batched patch application state.
+  @param[in]     PatchIndex    Patch index.
+  @param[in]     Patch         Patch description.
+  @param[in,out] Data          Patched binary.
+  @param[out]    ReplaceCount  Number of replacements performed.
+
+  @retval EFI_SUCCESS           Patch was applied.
+  @retval EFI_BUFFER_TOO_SMALL  Patch was applied, but its changes were not tracked.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failure, data is unchanged.
+**/
+STATIC
+EFI_STATUS
+InternalApplyBatchedPatch (
+  IN OUT PATCHER_PATCH_BATCH    *Batch,
+  IN     UINT32                 PatchIndex,
+  IN     PATCHER_GENERIC_PATCH  *Patch,
+  IN OUT UINT8                  *Data,
+  OUT    UINT32                 *ReplaceCount
+  )
+{
+  PATCHER_PATCH_RANGE  *Range;
+  UINT32               *Candidates;
+  UINT32               CandidateCount;
+  UINT32               Scratch;
+  UINT32               Index;
+  UINT32               Offset;
+  UINT32               First;
+  UINT32               End;
+  UINT32               Last;
+  UINT32               DataOff;
+  UINT32               MatchOff;
+  UINT32               Count;
+  UINT32               Skip;
+  UINTN                ByteIndex;
+
+  Range         = &Batch->Ranges[PatchIndex];
+  *ReplaceCount = 0;
+
+  if (Range->Size < Patch->Size) {
     return EFI_SUCCESS;
   }
 
-  return EFI_NOT_FOUND;
+  //
+  // Last offset where the pattern may start within the range.
+  //
+  Last = Range->Offset + Range->Size - Patch->Size;
+
+  CandidateCount = 0;
+  for (Index = 0; Index < Batch->MatchCount; ++Index) {
+    if (Batch->Matches[Index].Size == PatchIndex) {
+      ++CandidateCount;
+    }
+  }
+
+  for (Index = 0; Index < Batch->ModifiedCount; ++Index) {
+    CandidateCount += Batch->Modified[Index].Size + Patch->Size - 1;
+  }
+
+  if (CandidateCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Candidates = AllocatePool (CandidateCount * sizeof (*Candidates));
+  if (Candidates == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CandidateCount = 0;
+  for (Index = 0; Index < Batch->MatchCount; ++Index) {
+    if (Batch->Matches[Index].Size == PatchIndex) {
+      Candidates[CandidateCount++] = Batch->Matches[Index].Offset;
+    }
+  }
+
+  for (Index = 0; Index < Batch->ModifiedCount; ++Index) {
+    First = 0;
+    if (Batch->Modified[Index].Offset > Patch->Size - 1) {
+      First = Batch->Modified[Index].Offset - (Patch->Size - 1);
+    }
+
+    First = MAX (First, Range->Offset);
+    End   = Batch->Modified[Index].Offset + Batch->Modified[Index].Size;
+
+    for (Offset = First; (Offset < End) && (Offset <= Last); ++Offset) {
+      Candidates[CandidateCount++] = Offset;
+    }
+  }
+
+  if (Batch->ModifiedCount > 0) {
+    QuickSort (Candidates, CandidateCount, sizeof (*Candidates), InternalCompareOffsets, &Scratch);
+  }
+
+  DataOff = Range->Offset;
+  Count   = Patch->Count;
+  Skip    = Patch->Skip;
+
+  for (Index = 0; Index < CandidateCount; ++Index) {
+    if ((Candidates[Index] < DataOff) || (Candidates[Index] > Last)) {
+      continue;
+    }
+
+    MatchOff = 0;
+    if (!FindPattern (Patch->Find, Patch->Mask, Patch->Size, &Data[Candidates[Index]], Patch->Size, &MatchOff)) {
+      continue;
+    }
+
+    DataOff = Candidates[Index] + Patch->Size;
+
+    if (Skip > 0) {
+      --Skip;
+      continue;
+    }
+
+    if (Patch->ReplaceMask == NULL) {
+      CopyMem (&Data[Candidates[Index]], Patch->Replace, Patch->Size);
+    } else {
+      for (ByteIndex = 0; ByteIndex < Patch->Size; ++ByteIndex) {
+        Data[Candidates[Index] + ByteIndex] = (Data[Candidates[Index] + ByteIndex] & ~Patch->ReplaceMask[ByteIndex])
+                                              | (Patch->Replace[ByteIndex] & Patch->ReplaceMask[ByteIndex]);
+      }
+    }
+
+    ++(*ReplaceCount);
+
+    //
+    // Tracking failure is not fatal, but later patches must fall back then.
+    //
+    if (!InternalAppendPatchRange (
+           &Batch->Modified,
+           &Batch->ModifiedCount,
+           &Batch->ModifiedAllocCount,
+           Candidates[Index],
+           Patch->Size
+           ))
+    {
+      FreePool (Candidates);
+      return EFI_BUFFER_TOO_SMALL;
+    }
+
+    if (Count > 0) {
+      --Count;
+      if (Count == 0) {
+        break;
+      }
+    }
+  }
+
+  FreePool (Candidates);
+  return EFI_SUCCESS;
+}
+
+VOID
+PatcherApplyGenericPatches (
+  IN OUT PATCHER_CONTEXT        *Context,
+  IN     PATCHER_GENERIC_PATCH  *Patches,
+  IN     UINT32                 PatchCount,
+  OUT    EFI_STATUS             *Results
+  )
+{
+  EFI_STATUS             Status;
+  PATCHER_PATCH_BATCH    Batch;
+  OC_DATA_PATTERN        *Patterns;
+  PATCHER_GENERIC_PATCH  *Patch;
+  UINT8                  *Header;
+  UINT8                  *Base;
+  UINT32                 InnerSize;
+  UINT32                 ReplaceCount;
+  UINT32                 Index;
+  BOOLEAN                Batched;
+
+  ASSERT (Context != NULL);
+  ASSERT ((Patches != NULL) || (PatchCount == 0));
+  ASSERT ((Results != NULL) || (PatchCount == 0));
+
+  ZeroMem (&Batch, sizeof (Batch));
+
+  Header    = (UINT8 *)MachoGetMachHeader (&Context->MachContext);
+  InnerSize = MachoGetInnerSize (&Context->MachContext);
+
+  Batch.Ranges = AllocateZeroPool (PatchCount * sizeof (*Batch.Ranges));
+  Patterns     = AllocateZeroPool (PatchCount * sizeof (*Patterns));
+  Batched      = (Batch.Ranges != NULL) && (Patterns != NULL);
+
+  //
+  // Resolve patch areas and search all Find patterns at once.
+  //
+  for (Index = 0; (Index < PatchCount) && Batched; ++Index) {
+    Patch          = &Patches[Index];
+    Results[Index] = EFI_SUCCESS;
+
+    if (Patch->Find == NULL) {
+      continue;
+    }
+
+    Base = Header;
+    if (Patch->Base != NULL) {
+      Status = PatcherGetSymbolAddress (Context, Patch->Base, &Base);
+      if (EFI_ERROR (Status)) {
+        //
+        // Reported when applying the patch individually.
+        //
+        continue;
+      }
+
+      //
+      // Areas outside of the inner binary are also handled individually.
+      //
+      if ((Base < Header) || ((UINTN)(Base - Header) > InnerSize)) {
+        continue;
+      }
+    }
+
+    Batch.Ranges[Index].Offset = (UINT32)(Base - Header);
+    Batch.Ranges[Index].Size   = InnerSize - Batch.Ranges[Index].Offset;
+    if ((Patch->Limit > 0) && (Patch->Limit < Batch.Ranges[Index].Size)) {
+      Batch.Ranges[Index].Size = Patch->Limit;
+    }
+
+    Patterns[Index].Pattern     = Patch->Find;
+    Patterns[Index].PatternMask = Patch->Mask;
+    Patterns[Index].PatternSize = Patch->Size;
+  }
+
+  if (Batched) {
+    Status = FindPatterns (
+               Patterns,
+               PatchCount,
+               Header,
+               InnerSize,
+               InternalCollectPatchMatch,
+               &Batch
+               );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "OCAK: Batched patch search failure - %r\n", Status));
+      Batched = FALSE;
+    }
+  }
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    Patch = &Patches[Index];
+
+    if (Batched && (Patterns[Index].PatternSize > 0)) {
+      Status = InternalApplyBatchedPatch (&Batch, Index, Patch, Header, &ReplaceCount);
+      if (Status == EFI_SUCCESS) {
+        Results[Index] = InternalReportGenericPatch (Context, Patch, ReplaceCount);
+        continue;
+      }
+
+      if (Status == EFI_BUFFER_TOO_SMALL) {
+        //
+        // The patch is applied, but its changes cannot be tracked for further patches.
+        //
+        Results[Index] = InternalReportGenericPatch (Context, Patch, ReplaceCount);
+        Batched        = FALSE;
+        continue;
+      }
+
+      Batched = FALSE;
+    }
+
+    Results[Index] = PatcherApplyGenericPatch (Context, Patch);
+
+    if (!Batched || EFI_ERROR (Results[Index])) {
+      continue;
+    }
+
+    //
+    // Untracked replacements may create new occurrences for further patches.
+    //
+    if (Patch->Find != NULL) {
+      Batched = FALSE;
+      continue;
+    }
+
+    //
+    // Direct writes are tracked like replacements.
+    //
+    Base = Header;
+    if (Patch->Base != NULL) {
+      PatcherGetSymbolAddress (Context, Patch->Base, &Base);
+    }
+
+    if (  (Base < Header)
+       || ((UINTN)(Base - Header) > InnerSize)
+       || !InternalAppendPatchRange (
+             &Batch.Modified,
+             &Batch.ModifiedCount,
+             &Batch.ModifiedAllocCount,
+             (UINT32)(Base - Header),
+             Patch->Size
+             ))
+    {
+      Batched = FALSE;
+    }
+  }
+
+  if (Batch.Ranges != NULL) {
+    FreePool (Batch.Ranges);
+  }
+
+  if (Batch.Matches != NULL) {
+    FreePool (Batch.Matches);
+  }
+
+  if (Batch.Modified != NULL) {
+    FreePool (Batch.Modified);
+  }
+
+  if (Patterns != NULL) {
+    FreePool (Patterns);
+  }
 }
 
 EFI_STATUS
@@ -532,7 +981,8 @@ PatcherExcludePrelinkedKext (
             KextPlist,
             Index
             ));
-          XmlNodeRemoveByIndex (PrelinkedContext->KextList, Index);
+          InternalRemovePrelinkedKextPlist (PrelinkedContext, Identifier, Index);
+          PrelinkedContext->KextListModified = TRUE;
           return EFI_SUCCESS;
         }
       }
@@ -285,6 +285,8 @@ InternalKxldStateBuildLinkedSymbolTable (
   Kext->NumberOfCxxSymbols = NumCxxSymbols;
   Kext->LinkedSymbolTable  = SymbolTable;
 
+  InternalBuildLinkedSymbolHash (Kext, Context);
+
   return EFI_SUCCESS;
 }
 
@@ -447,6 +449,7 @@ InternalKxldStateRebasePlist (
         }
 
         XmlNodeChangeContent (KextPlistValue, ScratchWalker);
+        Context->KextListModified = TRUE;
         ScratchWalker += AsciiStrSize (ScratchWalker);
       }
     }
@@ -21,6 +21,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/BaseMemoryLib.h>
 #include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcMachoLib.h>
 
@@ -35,12 +36,147 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 // Symbols
 //
 
+UINT32
+InternalHashName (
+  IN CONST CHAR8  *Name,
+  IN UINT32       Length
+  )
+{
+  UINT32  Hash;
+  UINT32  Index;
+
+  Hash = 0x811C9DC5U;
+  for (Index = 0; Index < Length; ++Index) {
+    Hash ^= (UINT8)Name[Index];
+    Hash *= 0x01000193U;
+  }
+
+  return Hash;
+}
+
+VOID
+InternalBuildLinkedSymbolHash (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN     PRELINKED_CONTEXT  *Context
+  )
+{
+  PRELINKED_KEXT_SYMBOL_HASH   *HashTable;
+  CONST PRELINKED_KEXT_SYMBOL  *Symbol;
+  CONST PRELINKED_KEXT_SYMBOL  *Existing;
+  UINT32                       HashSize;
+  UINT32                       Hash;
+  UINT32                       Slot;
+  UINT32                       Index;
+
+  ASSERT (Kext->LinkedSymbolTable != NULL);
+
+  if (  Context->LinearSymbolLookup
+     || (Kext->LinkedSymbolHash != NULL)
+     || (Kext->NumberOfSymbols == 0))
+  {
+    return;
+  }
+
+  //
+  // Keep the load factor at or below 50% to make probe sequences short.
+  //
+  if (Kext->NumberOfSymbols > MAX_UINT32 / 4) {
+    return;
+  }
+
+  HashSize = GetPowerOfTwo32 (Kext->NumberOfSymbols * 2);
+  if (HashSize < Kext->NumberOfSymbols * 2) {
+    HashSize <<= 1U;
+  }
+
+  HashTable = AllocateZeroPool (HashSize * sizeof (*HashTable));
+  if (HashTable == NULL) {
+    DEBUG ((DEBUG_INFO, "OCAK: No memory for %a symbol hash, using linear lookup\n", Kext->Identifier));
+    return;
+  }
+
+  for (Index = 0; Index < Kext->NumberOfSymbols; ++Index) {
+    Symbol = &Kext->LinkedSymbolTable[Index];
+    Hash   = InternalHashName (Symbol->Name, Symbol->Length);
+    Slot   = Hash & (HashSize - 1);
+
+    while (HashTable[Slot].Index != 0) {
+      //
+      // Keep the first occurrence of duplicate symbols to match linear lookup.
+      //
+      if (HashTable[Slot].Hash == Hash) {
+        Existing = &Kext->LinkedSymbolTable[HashTable[Slot].Index - 1];
+        if (  (Existing->Length == Symbol->Length)
+           && (CompareMem (Existing->Name, Symbol->Name, Symbol->Length) == 0))
+        {
+          break;
+        }
+      }
+
+      Slot = (Slot + 1) & (HashSize - 1);
+    }
+
+    if (HashTable[Slot].Index == 0) {
+      HashTable[Slot].Hash  = Hash;
+      HashTable[Slot].Index = Index + 1;
+    }
+  }
+
+  Kext->LinkedSymbolHash     = HashTable;
+  Kext->LinkedSymbolHashMask = HashSize - 1;
+}
+
+STATIC
+CONST PRELINKED_KEXT_SYMBOL *
+InternalOcGetSymbolHashedName (
+  IN PRELINKED_KEXT       *Kext,
+  IN CONST CHAR8          *LookupValue,
+  IN UINT32               LookupValueLength,
+  IN UINT32               LookupValueHash,
+  IN OC_GET_SYMBOL_LEVEL  SymbolLevel
+  )
+{
+  CONST PRELINKED_KEXT_SYMBOL_HASH  *Entry;
+  CONST PRELINKED_KEXT_SYMBOL       *Symbol;
+  UINT32                            Slot;
+
+  Slot = LookupValueHash & Kext->LinkedSymbolHashMask;
+
+  while (TRUE) {
+    Entry = &Kext->LinkedSymbolHash[Slot];
+    if (Entry->Index == 0) {
+      return NULL;
+    }
+
+    if (Entry->Hash == LookupValueHash) {
+      Symbol = &Kext->LinkedSymbolTable[Entry->Index - 1];
+      if (  (Symbol->Length == LookupValueLength)
+         && (CompareMem (Symbol->Name, LookupValue, LookupValueLength) == 0))
+      {
+        //
+        // C++ symbols are at the end of the table, C symbols cannot have C++ names.
+        //
+        if (  (SymbolLevel == OcGetSymbolOnlyCxx)
+           && (Entry->Index - 1 < Kext->NumberOfSymbols - Kext->NumberOfCxxSymbols))
+        {
+          return NULL;
+        }
+
+        return Symbol;
+      }
+    }
+
+    Slot = (Slot + 1) & Kext->LinkedSymbolHashMask;
+  }
+}
+
 STATIC
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolWorkerName (
   IN PRELINKED_KEXT       *Kext,
   IN CONST CHAR8          *LookupValue,
   IN UINT32               LookupValueLength,
+  IN UINT32               LookupValueHash,
   IN OC_GET_SYMBOL_LEVEL  SymbolLevel
   )
 {
@@ -55,7 +191,18 @@ InternalOcGetSymbolWorkerName (
   //
   Kext->Processed = TRUE;
 
-  if (Kext->LinkedSymbolTable != NULL) {
+  if (Kext->LinkedSymbolHash != NULL) {
+    Symbols = InternalOcGetSymbolHashedName (
+                Kext,
+                LookupValue,
+                LookupValueLength,
+                LookupValueHash,
+                SymbolLevel
+                );
+    if (Symbols != NULL) {
+      return Symbols;
+    }
+  } else if (Kext->LinkedSymbolTable != NULL) {
     NumSymbols = Kext->NumberOfSymbols;
     Symbols    = Kext->LinkedSymbolTable;
 
@@ -106,6 +253,7 @@ InternalOcGetSymbolWorkerName (
                   Dependency,
                   LookupValue,
                   LookupValueLength,
+                  LookupValueHash,
                   OcGetSymbolOnlyCxx
                   );
       if (Symbols != NULL) {
@@ -117,9 +265,133 @@ InternalOcGetSymbolWorkerName (
   return NULL;
 }
 
+STATIC
+INTN
+EFIAPI
+InternalCompareSymbolValues (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST PRELINKED_KEXT_SYMBOL_VALUE  *Value1;
+  CONST PRELINKED_KEXT_SYMBOL_VALUE  *Value2;
+
+  Value1 = Buffer1;
+  Value2 = Buffer2;
+
+  if (Value1->Value != Value2->Value) {
+    return Value1->Value < Value2->Value ? -1 : 1;
+  }
+
+  //
+  // Keep table order for equal values to match linear lookup.
+  //
+  if (Value1->Index != Value2->Index) {
+    return Value1->Index < Value2->Index ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+  Build LinkedSymbolValues for value lookup.
+
+  @param[in,out] Kext      Kext dependency with LinkedSymbolTable.
+  @param[in]     Context   Prelinking context.
+**/
+STATIC
+VOID
+InternalBuildLinkedSymbolValues (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN     PRELINKED_CONTEXT  *Context
+  )
+{
+  PRELINKED_KEXT_SYMBOL_VALUE  *Values;
+  PRELINKED_KEXT_SYMBOL_VALUE  Scratch;
+  UINT32                       Index;
+
+  ASSERT (Kext->LinkedSymbolTable != NULL);
+
+  if (Context->LinearSymbolLookup || (Kext->NumberOfSymbols == 0)) {
+    return;
+  }
+
+  Values = AllocatePool (Kext->NumberOfSymbols * sizeof (*Values));
+  if (Values == NULL) {
+    DEBUG ((DEBUG_INFO, "OCAK: No memory for %a symbol values, using linear lookup\n", Kext->Identifier));
+    Kext->LinkedSymbolValuesFailed = TRUE;
+    return;
+  }
+
+  for (Index = 0; Index < Kext->NumberOfSymbols; ++Index) {
+    Values[Index].Value = Kext->LinkedSymbolTable[Index].Value;
+    Values[Index].Index = Index;
+  }
+
+  QuickSort (
+    Values,
+    Kext->NumberOfSymbols,
+    sizeof (*Values),
+    InternalCompareSymbolValues,
+    &Scratch
+    );
+
+  Kext->LinkedSymbolValues = Values;
+}
+
+STATIC
+CONST PRELINKED_KEXT_SYMBOL *
+InternalOcGetSymbolSortedValue (
+  IN PRELINKED_KEXT       *Kext,
+  IN UINT64               LookupValue,
+  IN OC_GET_SYMBOL_LEVEL  SymbolLevel
+  )
+{
+  CONST PRELINKED_KEXT_SYMBOL_VALUE  *Values;
+  UINT32                             Low;
+  UINT32                             High;
+  UINT32                             Middle;
+  UINT32                             MinIndex;
+
+  Values = Kext->LinkedSymbolValues;
+
+  //
+  // Find the first entry not less than LookupValue.
+  //
+  Low  = 0;
+  High = Kext->NumberOfSymbols;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (Values[Middle].Value < LookupValue) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  MinIndex = 0;
+  if (SymbolLevel == OcGetSymbolOnlyCxx) {
+    MinIndex = Kext->NumberOfSymbols - Kext->NumberOfCxxSymbols;
+  }
+
+  //
+  // Equal values are ordered by table index, pick the first one allowed.
+  //
+  while ((Low < Kext->NumberOfSymbols) && (Values[Low].Value == LookupValue)) {
+    if (Values[Low].Index >= MinIndex) {
+      return &Kext->LinkedSymbolTable[Values[Low].Index];
+    }
+
+    ++Low;
+  }
+
+  return NULL;
+}
+
 STATIC
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolWorkerValue (
+  IN PRELINKED_CONTEXT    *Context,
   IN PRELINKED_KEXT       *Kext,
   IN UINT64               LookupValue,
   IN OC_GET_SYMBOL_LEVEL  SymbolLevel
@@ -136,7 +408,19 @@ InternalOcGetSymbolWorkerValue (
   //
   Kext->Processed = TRUE;
 
-  if (Kext->LinkedSymbolTable != NULL) {
+  if (  (Kext->LinkedSymbolTable != NULL)
+     && (Kext->LinkedSymbolValues == NULL)
+     && !Kext->LinkedSymbolValuesFailed)
+  {
+    InternalBuildLinkedSymbolValues (Kext, Context);
+  }
+
+  if (Kext->LinkedSymbolValues != NULL) {
+    Symbols = InternalOcGetSymbolSortedValue (Kext, LookupValue, SymbolLevel);
+    if (Symbols != NULL) {
+      return Symbols;
+    }
+  } else if (Kext->LinkedSymbolTable != NULL) {
     NumSymbols = Kext->NumberOfSymbols;
     Symbols    = Kext->LinkedSymbolTable;
 
@@ -174,6 +458,7 @@ InternalOcGetSymbolWorkerValue (
       }
 
       Symbols = InternalOcGetSymbolWorkerValue (
+                  Context,
                   Dependency,
                   LookupValue,
                   OcGetSymbolOnlyCxx
@@ -200,6 +485,7 @@ InternalOcGetSymbolName (
   PRELINKED_KEXT              *Dependency;
   UINT32                      Index;
   UINT32                      LookupValueLength;
+  UINT32                      LookupValueHash;
 
   Symbol            = NULL;
   LookupValueLength = (UINT32)AsciiStrLen (LookupValue);
@@ -211,11 +497,14 @@ InternalOcGetSymbolName (
     return NULL;
   }
 
+  LookupValueHash = InternalHashName (LookupValue, LookupValueLength);
+
   if ((SymbolLevel == OcGetSymbolOnlyCxx) && (Kext->LinkedSymbolTable != NULL)) {
     Symbol = InternalOcGetSymbolWorkerName (
                Kext,
                LookupValue,
                LookupValueLength,
+               LookupValueHash,
                SymbolLevel
                );
   } else {
@@ -229,6 +518,7 @@ InternalOcGetSymbolName (
                  Dependency,
                  LookupValue,
                  LookupValueLength,
+                 LookupValueHash,
                  SymbolLevel
                  );
       if (Symbol != NULL) {
@@ -258,7 +548,7 @@ InternalOcGetSymbolValue (
   Symbol = NULL;
 
   if ((SymbolLevel == OcGetSymbolOnlyCxx) && (Kext->LinkedSymbolTable != NULL)) {
-    Symbol = InternalOcGetSymbolWorkerValue (Kext, LookupValue, SymbolLevel);
+    Symbol = InternalOcGetSymbolWorkerValue (Context, Kext, LookupValue, SymbolLevel);
   } else {
     for (Index = 0; Index < ARRAY_SIZE (Kext->Dependencies); ++Index) {
       Dependency = Kext->Dependencies[Index];
@@ -267,6 +557,7 @@ InternalOcGetSymbolValue (
       }
 
       Symbol = InternalOcGetSymbolWorkerValue (
+                 Context,
                  Dependency,
                  LookupValue,
                  SymbolLevel
@@ -0,0 +1,686 @@
+/** @file
+  Link cache for dependency kext symbol and vtable tables.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Base.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseOverflowLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcAppleKernelLib.h>
+#include <Library/OcCryptoLib.h>
+#include <Library/OcMachoLib.h>
+#include <Library/OcStringLib.h>
+
+#include "PrelinkedInternal.h"
+
+//
+// Link cache layout. The cache is bound to the kernel by its digest and
+// to the bootloader by its version, and the payload following the header
+// is covered by SHA-256, so that a damaged cache is rejected as a whole.
+// Symbol values and vtable entry addresses are trusted once the payload is
+// verified. All names are referenced by their offset in prelinked and are
+// checked to be valid strings in prelinked upon use.
+// All structures are 8-byte aligned within the cache.
+//
+#define LINK_CACHE_SIGNATURE  SIGNATURE_32 ('O', 'C', 'L', 'C')
+#define LINK_CACHE_VERSION    2U
+#define LINK_CACHE_NO_NAME    MAX_UINT32
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    Version;
+  UINT32    Size;
+  UINT32    NumberOfKexts;
+  UINT8     Digest[SHA384_DIGEST_SIZE];
+  UINT8     PayloadDigest[SHA256_DIGEST_SIZE];
+  CHAR8     OcVersion[PRELINKED_LINK_CACHE_VERSION_SIZE];
+} LINK_CACHE_HEADER;
+
+//
+// Followed by identifier (padded to 8 bytes), symbols, and vtables
+// with their entries.
+//
+typedef struct {
+  UINT32    Size;
+  UINT32    IdentifierSize;
+  UINT32    NumberOfSymbols;
+  UINT32    NumberOfCxxSymbols;
+  UINT32    NumberOfVtables;
+  UINT32    NumberOfVtableEntries;
+} LINK_CACHE_KEXT;
+
+typedef struct {
+  UINT64    Value;
+  UINT32    NameOffset;
+  UINT32    NameLength;
+} LINK_CACHE_SYMBOL;
+
+typedef struct {
+  UINT32    NameOffset;
+  UINT32    NameLength;
+  UINT32    NumberOfEntries;
+  UINT32    Reserved;
+} LINK_CACHE_VTABLE;
+
+typedef struct {
+  UINT64    Address;
+  UINT32    NameOffset;
+  UINT32    NameLength;
+} LINK_CACHE_VTABLE_ENTRY;
+
+STATIC_ASSERT (sizeof (LINK_CACHE_HEADER) % sizeof (UINT64) == 0, "Unaligned link cache header");
+STATIC_ASSERT (sizeof (LINK_CACHE_KEXT) % sizeof (UINT64) == 0, "Unaligned link cache kext");
+
+/**
+  Check whether kext was injected by us. Such kexts are never cached.
+
+  @param[in] Kext  Kext to check.
+
+  @return  TRUE for injected kexts.
+**/
+STATIC
+BOOLEAN
+InternalIsInjectedKext (
+  IN PRELINKED_KEXT  *Kext
+  )
+{
+  //
+  // InjectedLink is only initialised for kexts in InjectedKexts list.
+  //
+  return Kext->InjectedLink.ForwardLink != NULL;
+}
+
+/**
+  Calculate link cache kext record size.
+
+  @param[in]  Kext  Link cache kext record.
+  @param[out] Size  Record size.
+
+  @return  FALSE on overflow.
+**/
+STATIC
+BOOLEAN
+InternalGetLinkCacheKextSize (
+  IN  CONST LINK_CACHE_KEXT  *Kext,
+  OUT UINT32                 *Size
+  )
+{
+  UINT32  Result;
+
+  if (Kext->IdentifierSize > MAX_UINT32 - sizeof (UINT64)) {
+    return FALSE;
+  }
+
+  if (  BaseOverflowAddU32 (sizeof (*Kext), ALIGN_VALUE (Kext->IdentifierSize, sizeof (UINT64)), &Result)
+     || BaseOverflowMulAddU32 (Kext->NumberOfSymbols, sizeof (LINK_CACHE_SYMBOL), Result, &Result)
+     || BaseOverflowMulAddU32 (Kext->NumberOfVtables, sizeof (LINK_CACHE_VTABLE), Result, &Result)
+     || BaseOverflowMulAddU32 (Kext->NumberOfVtableEntries, sizeof (LINK_CACHE_VTABLE_ENTRY), Result, &Result))
+  {
+    return FALSE;
+  }
+
+  *Size = Result;
+  return TRUE;
+}
+
+/**
+  Convert name pointer to link cache name reference.
+
+  @param[in]  Context     Prelinked context.
+  @param[in]  Name        Name pointer, optional.
+  @param[out] NameOffset  Name offset in prelinked.
+  @param[out] NameLength  Name length.
+
+  @return  FALSE when name is not within prelinked.
+**/
+STATIC
+BOOLEAN
+InternalExportLinkCacheName (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  CONST CHAR8        *Name OPTIONAL,
+  OUT UINT32             *NameOffset,
+  OUT UINT32             *NameLength
+  )
+{
+  UINTN  Offset;
+  UINTN  Length;
+
+  if (Name == NULL) {
+    *NameOffset = LINK_CACHE_NO_NAME;
+    *NameLength = 0;
+    return TRUE;
+  }
+
+  if (  ((UINTN)Name < (UINTN)Context->Prelinked)
+     || ((UINTN)Name >= (UINTN)Context->Prelinked + Context->PrelinkedSize))
+  {
+    return FALSE;
+  }
+
+  Offset = (UINTN)Name - (UINTN)Context->Prelinked;
+  Length = AsciiStrnLenS (Name, Context->PrelinkedSize - Offset);
+  if (Offset + Length >= Context->PrelinkedSize) {
+    return FALSE;
+  }
+
+  *NameOffset = (UINT32)Offset;
+  *NameLength = (UINT32)Length;
+  return TRUE;
+}
+
+/**
+  Convert link cache name reference to name pointer.
+
+  @param[in]  Context     Prelinked context.
+  @param[in]  NameOffset  Name offset in prelinked.
+  @param[in]  NameLength  Name length.
+  @param[out] Name        Name pointer.
+
+  @return  FALSE when name does not match prelinked.
+**/
+STATIC
+BOOLEAN
+InternalImportLinkCacheName (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  UINT32             NameOffset,
+  IN  UINT32             NameLength,
+  OUT CONST CHAR8        **Name
+  )
+{
+  if (NameOffset == LINK_CACHE_NO_NAME) {
+    *Name = NULL;
+    return TRUE;
+  }
+
+  if (  (NameOffset >= Context->PrelinkedSize)
+     || (NameLength >= Context->PrelinkedSize - NameOffset)
+     || (Context->Prelinked[NameOffset + NameLength] != '\0'))
+  {
+    return FALSE;
+  }
+
+  *Name = (CONST CHAR8 *)&Context->Prelinked[NameOffset];
+  return TRUE;
+}
+
+/**
+  Check whether kext tables can be exported to link cache.
+
+  @param[in]  Context  Prelinked context.
+  @param[in]  Kext     Kext to check.
+  @param[out] Size     Link cache kext record size.
+
+  @return  TRUE when kext can be exported.
+**/
+STATIC
+BOOLEAN
+InternalGetExportedKextSize (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  PRELINKED_KEXT     *Kext,
+  OUT UINT32             *Size
+  )
+{
+  LINK_CACHE_KEXT   CacheKext;
+  PRELINKED_VTABLE  *Vtable;
+  UINT32            Index;
+  UINT32            NameOffset;
+  UINT32            NameLength;
+
+  if (  (Kext->LinkedSymbolTable == NULL)
+     || (Kext->LinkedVtables == NULL)
+     || (Kext->Context.KxldState != NULL)
+     || InternalIsInjectedKext (Kext))
+  {
+    return FALSE;
+  }
+
+  CacheKext.IdentifierSize        = (UINT32)AsciiStrSize (Kext->Identifier);
+  CacheKext.NumberOfSymbols       = Kext->NumberOfSymbols;
+  CacheKext.NumberOfVtables       = Kext->NumberOfVtables;
+  CacheKext.NumberOfVtableEntries = 0;
+
+  Vtable = Kext->LinkedVtables;
+  for (Index = 0; Index < Kext->NumberOfVtables; ++Index) {
+    if (  !InternalExportLinkCacheName (Context, Vtable->Name, &NameOffset, &NameLength)
+       || BaseOverflowAddU32 (CacheKext.NumberOfVtableEntries, Vtable->NumEntries, &CacheKext.NumberOfVtableEntries))
+    {
+      return FALSE;
+    }
+
+    Vtable = GET_NEXT_PRELINKED_VTABLE (Vtable);
+  }
+
+  return InternalGetLinkCacheKextSize (&CacheKext, Size);
+}
+
+/**
+  Export kext tables to link cache.
+
+  @param[in]  Context  Prelinked context.
+  @param[in]  Kext     Kext to export.
+  @param[out] Buffer   Link cache kext record of at least Size bytes.
+  @param[in]  Size     Link cache kext record size.
+
+  @return  FALSE when some names are not within prelinked.
+**/
+STATIC
+BOOLEAN
+InternalExportLinkCacheKext (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  PRELINKED_KEXT     *Kext,
+  OUT UINT8              *Buffer,
+  IN  UINT32             Size
+  )
+{
+  LINK_CACHE_KEXT          *CacheKext;
+  LINK_CACHE_SYMBOL        *CacheSymbol;
+  LINK_CACHE_VTABLE        *CacheVtable;
+  LINK_CACHE_VTABLE_ENTRY  *CacheEntry;
+  PRELINKED_VTABLE         *Vtable;
+  UINT32                   Index;
+  UINT32                   EntryIndex;
+
+  CacheKext                     = (LINK_CACHE_KEXT *)Buffer;
+  CacheKext->Size               = Size;
+  CacheKext->IdentifierSize     = (UINT32)AsciiStrSize (Kext->Identifier);
+  CacheKext->NumberOfSymbols    = Kext->NumberOfSymbols;
+  CacheKext->NumberOfCxxSymbols = Kext->NumberOfCxxSymbols;
+  CacheKext->NumberOfVtables    = Kext->NumberOfVtables;
+
+  CopyMem (CacheKext + 1, Kext->Identifier, CacheKext->IdentifierSize);
+
+  CacheSymbol = (LINK_CACHE_SYMBOL *)(
+                                      (UINT8 *)(CacheKext + 1)
+                                      + ALIGN_VALUE (CacheKext->IdentifierSize, sizeof (UINT64))
+                                      );
+  for (Index = 0; Index < Kext->NumberOfSymbols; ++Index) {
+    CacheSymbol[Index].Value = Kext->LinkedSymbolTable[Index].Value;
+    if (!InternalExportLinkCacheName (
+           Context,
+           Kext->LinkedSymbolTable[Index].Name,
+           &CacheSymbol[Index].NameOffset,
+           &CacheSymbol[Index].NameLength
+           ))
+    {
+      return FALSE;
+    }
+  }
+
+  CacheVtable = (LINK_CACHE_VTABLE *)&CacheSymbol[Kext->NumberOfSymbols];
+  Vtable      = Kext->LinkedVtables;
+  for (Index = 0; Index < Kext->NumberOfVtables; ++Index) {
+    InternalExportLinkCacheName (Context, Vtable->Name, &CacheVtable->NameOffset, &CacheVtable->NameLength);
+    CacheVtable->NumberOfEntries = Vtable->NumEntries;
+    CacheVtable->Reserved        = 0;
+
+    CacheEntry = (LINK_CACHE_VTABLE_ENTRY *)(CacheVtable + 1);
+    for (EntryIndex = 0; EntryIndex < Vtable->NumEntries; ++EntryIndex) {
+      CacheEntry[EntryIndex].Address = Vtable->Entries[EntryIndex].Address;
+      if (!InternalExportLinkCacheName (
+             Context,
+             Vtable->Entries[EntryIndex].Name,
+             &CacheEntry[EntryIndex].NameOffset,
+             &CacheEntry[EntryIndex].NameLength
+             ))
+      {
+        return FALSE;
+      }
+    }
+
+    CacheKext->NumberOfVtableEntries += Vtable->NumEntries;
+    CacheVtable                       = (LINK_CACHE_VTABLE *)&CacheEntry[Vtable->NumEntries];
+    Vtable                            = GET_NEXT_PRELINKED_VTABLE (Vtable);
+  }
+
+  return TRUE;
+}
+
+/**
+  Find kext record in imported link cache.
+
+  @param[in] Context     Prelinked context with imported link cache.
+  @param[in] Identifier  Kext bundle identifier.
+
+  @return  Link cache kext record or NULL.
+**/
+STATIC
+CONST LINK_CACHE_KEXT *
+InternalFindLinkCacheKext (
+  IN PRELINKED_CONTEXT  *Context,
+  IN CONST CHAR8        *Identifier
+  )
+{
+  CONST LINK_CACHE_HEADER  *Header;
+  CONST LINK_CACHE_KEXT    *CacheKext;
+  UINT32                   Index;
+
+  if (Context->LinkCache == NULL) {
+    return NULL;
+  }
+
+  Header    = Context->LinkCache;
+  CacheKext = (CONST LINK_CACHE_KEXT *)(Header + 1);
+
+  for (Index = 0; Index < Header->NumberOfKexts; ++Index) {
+    if (AsciiStrCmp ((CONST CHAR8 *)(CacheKext + 1), Identifier) == 0) {
+      return CacheKext;
+    }
+
+    CacheKext = (CONST LINK_CACHE_KEXT *)((CONST UINT8 *)CacheKext + CacheKext->Size);
+  }
+
+  return NULL;
+}
+
+BOOLEAN
+InternalRestoreLinkCache (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN OUT PRELINKED_CONTEXT  *Context
+  )
+{
+  CONST LINK_CACHE_KEXT          *CacheKext;
+  CONST LINK_CACHE_SYMBOL        *CacheSymbol;
+  CONST LINK_CACHE_VTABLE        *CacheVtable;
+  CONST LINK_CACHE_VTABLE_ENTRY  *CacheEntry;
+  PRELINKED_KEXT_SYMBOL          *SymbolTable;
+  PRELINKED_VTABLE               *LinkedVtables;
+  PRELINKED_VTABLE               *Vtable;
+  UINT32                         VtablesSize;
+  UINT32                         NumEntries;
+  UINT32                         Index;
+  UINT32                         EntryIndex;
+  BOOLEAN                        Result;
+
+  if (  (Kext->LinkedSymbolTable != NULL)
+     || (Kext->LinkedVtables != NULL)
+     || InternalIsInjectedKext (Kext))
+  {
+    return FALSE;
+  }
+
+  CacheKext = InternalFindLinkCacheKext (Context, Kext->Identifier);
+  if (CacheKext == NULL) {
+    ++Context->LinkCacheMisses;
+    return FALSE;
+  }
+
+  if (  BaseOverflowMulU32 (CacheKext->NumberOfVtables, sizeof (*LinkedVtables), &VtablesSize)
+     || BaseOverflowMulAddU32 (CacheKext->NumberOfVtableEntries, sizeof (*LinkedVtables->Entries), VtablesSize, &VtablesSize))
+  {
+    ++Context->LinkCacheMisses;
+    return FALSE;
+  }
+
+  SymbolTable   = AllocatePool (CacheKext->NumberOfSymbols * sizeof (*SymbolTable));
+  LinkedVtables = AllocatePool (VtablesSize);
+  if ((SymbolTable == NULL) || (LinkedVtables == NULL)) {
+    if (SymbolTable != NULL) {
+      FreePool (SymbolTable);
+    }
+
+    if (LinkedVtables != NULL) {
+      FreePool (LinkedVtables);
+    }
+
+    ++Context->LinkCacheMisses;
+    return FALSE;
+  }
+
+  Result      = TRUE;
+  CacheSymbol = (CONST LINK_CACHE_SYMBOL *)(
+                                            (CONST UINT8 *)(CacheKext + 1)
+                                            + ALIGN_VALUE (CacheKext->IdentifierSize, sizeof (UINT64))
+                                            );
+  for (Index = 0; (Index < CacheKext->NumberOfSymbols) && Result; ++Index) {
+    SymbolTable[Index].Value  = CacheSymbol[Index].Value;
+    SymbolTable[Index].Length = CacheSymbol[Index].NameLength;
+    Result                    = InternalImportLinkCacheName (
+                                  Context,
+                                  CacheSymbol[Index].NameOffset,
+                                  CacheSymbol[Index].NameLength,
+                                  &SymbolTable[Index].Name
+                                  ) && (SymbolTable[Index].Name != NULL);
+  }
+
+  NumEntries  = 0;
+  CacheVtable = (CONST LINK_CACHE_VTABLE *)&CacheSymbol[CacheKext->NumberOfSymbols];
+  Vtable      = LinkedVtables;
+  for (Index = 0; (Index < CacheKext->NumberOfVtables) && Result; ++Index) {
+    //
+    // Entry counts were not validated on import, check them against the total.
+    //
+    if (  BaseOverflowAddU32 (NumEntries, CacheVtable->NumberOfEntries, &NumEntries)
+       || (NumEntries > CacheKext->NumberOfVtableEntries)
+       || !InternalImportLinkCacheName (Context, CacheVtable->NameOffset, CacheVtable->NameLength, &Vtable->Name))
+    {
+      Result = FALSE;
+      break;
+    }
+
+    Vtable->NumEntries = CacheVtable->NumberOfEntries;
+    CacheEntry         = (CONST LINK_CACHE_VTABLE_ENTRY *)(CacheVtable + 1);
+    for (EntryIndex = 0; (EntryIndex < CacheVtable->NumberOfEntries) && Result; ++EntryIndex) {
+      Vtable->Entries[EntryIndex].Address = CacheEntry[EntryIndex].Address;
+      Result                              = InternalImportLinkCacheName (
+                                              Context,
+                                              CacheEntry[EntryIndex].NameOffset,
+                                              CacheEntry[EntryIndex].NameLength,
+                                              &Vtable->Entries[EntryIndex].Name
+                                              );
+    }
+
+    CacheVtable = (CONST LINK_CACHE_VTABLE *)&CacheEntry[CacheVtable->NumberOfEntries];
+    Vtable      = GET_NEXT_PRELINKED_VTABLE (Vtable);
+  }
+
+  if (!Result || (NumEntries != CacheKext->NumberOfVtableEntries)) {
+    DEBUG ((DEBUG_INFO, "OCAK: Link cache for %a does not match prelinked\n", Kext->Identifier));
+    FreePool (SymbolTable);
+    FreePool (LinkedVtables);
+    ++Context->LinkCacheMisses;
+    return FALSE;
+  }
+
+  Kext->NumberOfSymbols    = CacheKext->NumberOfSymbols;
+  Kext->NumberOfCxxSymbols = CacheKext->NumberOfCxxSymbols;
+  Kext->LinkedSymbolTable  = SymbolTable;
+  Kext->NumberOfVtables    = CacheKext->NumberOfVtables;
+  Kext->LinkedVtables      = LinkedVtables;
+
+  InternalBuildLinkedSymbolHash (Kext, Context);
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCAK: Restored %u symbols and %u vtables for %a from link cache\n",
+    Kext->NumberOfSymbols,
+    Kext->NumberOfVtables,
+    Kext->Identifier
+    ));
+
+  return TRUE;
+}
+
+EFI_STATUS
+PrelinkedImportLinkCache (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN     CONST VOID         *Cache,
+  IN     UINT32             CacheSize,
+  IN     CONST UINT8        *Digest,
+  IN     CONST CHAR8        *Version
+  )
+{
+  CONST LINK_CACHE_HEADER  *Header;
+  CONST LINK_CACHE_KEXT    *CacheKext;
+  UINT32                   Offset;
+  UINT32                   Index;
+  UINT32                   Size;
+  UINT8                    PayloadDigest[SHA256_DIGEST_SIZE];
+
+  ASSERT (Context != NULL);
+  ASSERT (Cache != NULL);
+  ASSERT (Digest != NULL);
+  ASSERT (Version != NULL);
+  ASSERT (Context->LinkCache == NULL);
+
+  Header = Cache;
+
+  //
+  // Any rejected cache is a miss for all kexts, so that it gets rewritten.
+  //
+  ++Context->LinkCacheMisses;
+
+  if (  (CacheSize < sizeof (*Header))
+     || (Header->Signature != LINK_CACHE_SIGNATURE)
+     || (Header->Version != LINK_CACHE_VERSION)
+     || (Header->Size != CacheSize))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (  (CompareMem (Header->Digest, Digest, sizeof (Header->Digest)) != 0)
+     || (AsciiStrnCmp (Header->OcVersion, Version, sizeof (Header->OcVersion)) != 0))
+  {
+    return EFI_NOT_FOUND;
+  }
+
+  Sha256 (PayloadDigest, (CONST UINT8 *)(Header + 1), CacheSize - sizeof (*Header));
+  if (CompareMem (Header->PayloadDigest, PayloadDigest, sizeof (PayloadDigest)) != 0) {
+    DEBUG ((DEBUG_INFO, "OCAK: Link cache payload is corrupted\n"));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  //
+  // Validate record bounds once, names are validated upon use.
+  //
+  Offset = sizeof (*Header);
+  for (Index = 0; Index < Header->NumberOfKexts; ++Index) {
+    if (CacheSize - Offset < sizeof (*CacheKext)) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    CacheKext = (CONST LINK_CACHE_KEXT *)((CONST UINT8 *)Cache + Offset);
+    if (  !InternalGetLinkCacheKextSize (CacheKext, &Size)
+       || (Size != CacheKext->Size)
+       || (Size > CacheSize - Offset)
+       || (CacheKext->IdentifierSize == 0)
+       || (CacheKext->NumberOfCxxSymbols > CacheKext->NumberOfSymbols)
+       || (((CONST CHAR8 *)(CacheKext + 1))[CacheKext->IdentifierSize - 1] != '\0'))
+    {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    Offset += Size;
+  }
+
+  if (Offset != CacheSize) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Context->LinkCache = AllocateCopyPool (CacheSize, Cache);
+  if (Context->LinkCache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Context->LinkCacheSize = CacheSize;
+  --Context->LinkCacheMisses;
+
+  DEBUG ((DEBUG_INFO, "OCAK: Imported link cache with %u kexts\n", Header->NumberOfKexts));
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+PrelinkedExportLinkCache (
+  IN  PRELINKED_CONTEXT  *Context,
+  IN  CONST UINT8        *Digest,
+  IN  CONST CHAR8        *Version,
+  OUT VOID               **Cache,
+  OUT UINT32             *CacheSize
+  )
+{
+  LINK_CACHE_HEADER  *Header;
+  LIST_ENTRY         *Link;
+  PRELINKED_KEXT     *Kext;
+  UINT32             Size;
+  UINT32             KextSize;
+  UINT32             Offset;
+
+  ASSERT (Context != NULL);
+  ASSERT (Digest != NULL);
+  ASSERT (Version != NULL);
+  ASSERT (Cache != NULL);
+  ASSERT (CacheSize != NULL);
+
+  if (Context->LinkCacheMisses == 0) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  if (AsciiStrSize (Version) > sizeof (Header->OcVersion)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Size = sizeof (*Header);
+  Link = GetFirstNode (&Context->PrelinkedKexts);
+  while (!IsNull (&Context->PrelinkedKexts, Link)) {
+    Kext = GET_PRELINKED_KEXT_FROM_LINK (Link);
+    if (  InternalGetExportedKextSize (Context, Kext, &KextSize)
+       && BaseOverflowAddU32 (Size, KextSize, &Size))
+    {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Link = GetNextNode (&Context->PrelinkedKexts, Link);
+  }
+
+  Header = AllocateZeroPool (Size);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Header->Signature = LINK_CACHE_SIGNATURE;
+  Header->Version   = LINK_CACHE_VERSION;
+  CopyMem (Header->Digest, Digest, sizeof (Header->Digest));
+  AsciiStrCpyS (Header->OcVersion, sizeof (Header->OcVersion), Version);
+
+  Offset = sizeof (*Header);
+  Link   = GetFirstNode (&Context->PrelinkedKexts);
+  while (!IsNull (&Context->PrelinkedKexts, Link)) {
+    Kext = GET_PRELINKED_KEXT_FROM_LINK (Link);
+    if (InternalGetExportedKextSize (Context, Kext, &KextSize)) {
+      if (InternalExportLinkCacheKext (Context, Kext, (UINT8 *)Header + Offset, KextSize)) {
+        Offset += KextSize;
+        ++Header->NumberOfKexts;
+      } else {
+        //
+        // Kexts with names outside of prelinked are dropped, reuse their space.
+        //
+        ZeroMem ((UINT8 *)Header + Offset, KextSize);
+      }
+    }
+
+    Link = GetNextNode (&Context->PrelinkedKexts, Link);
+  }
+
+  Header->Size = Offset;
+  Sha256 (Header->PayloadDigest, (CONST UINT8 *)(Header + 1), Offset - sizeof (*Header));
+
+  *Cache     = Header;
+  *CacheSize = Offset;
+
+  DEBUG ((DEBUG_INFO, "OCAK: Exported link cache with %u kexts, %u bytes\n", Header->NumberOfKexts, Offset));
+
+  return EFI_SUCCESS;
+}
@@ -353,11 +353,17 @@ PrelinkedContextInit (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Context->PrelinkedInfoDocument = XmlDocumentParse (
+  //
+  // Only top-level kext properties are parsed immediately, nested values like
+  // IOKitPersonalities are parsed on first access. Kernel collection info
+  // has an extra <plist> root node.
+  //
+  Context->PrelinkedInfoDocument = XmlDocumentParseLazy (
                                      Context->PrelinkedInfo,
                                      (UINT32)(Context->Is32Bit ?
                                               Context->PrelinkedInfoSection->Section32.Size : Context->PrelinkedInfoSection->Section64.Size),
-                                     TRUE
+                                     TRUE,
+                                     Context->IsKernelCollection ? PRELINK_INFO_LAZY_LEVEL + 1 : PRELINK_INFO_LAZY_LEVEL
                                      );
   if (Context->PrelinkedInfoDocument == NULL) {
     PrelinkedContextFree (Context);
@@ -411,6 +417,7 @@ PrelinkedContextInit (
         }
 
         if (Context->PrelinkedLastLoadAddress != 0) {
+          InternalBuildPrelinkedKextIdentifiers (Context);
           return EFI_SUCCESS;
         }
       }
@@ -447,6 +454,11 @@ PrelinkedContextFree (
     Context->PrelinkedInfo = NULL;
   }
 
+  if (Context->PrelinkedInfoOriginal != NULL) {
+    FreePool (Context->PrelinkedInfoOriginal);
+    Context->PrelinkedInfoOriginal = NULL;
+  }
+
   if (Context->PooledBuffers != NULL) {
     for (Index = 0; Index < Context->PooledBuffersCount; ++Index) {
       FreePool (Context->PooledBuffers[Index]);
@@ -472,6 +484,16 @@ PrelinkedContextFree (
     Context->PrelinkedStateKexts = NULL;
   }
 
+  if (Context->KextIdentifiers != NULL) {
+    FreePool (Context->KextIdentifiers);
+    Context->KextIdentifiers = NULL;
+  }
+
+  if (Context->LinkCache != NULL) {
+    FreePool (Context->LinkCache);
+    Context->LinkCache = NULL;
+  }
+
   while (!IsListEmpty (&Context->PrelinkedKexts)) {
     Link = GetFirstNode (&Context->PrelinkedKexts);
     Kext = GET_PRELINKED_KEXT_FROM_LINK (Link);
@@ -522,6 +544,167 @@ PrelinkedDependencyInsert (
   return EFI_SUCCESS;
 }
 
+/**
+  Save unmodified prelinked info before it may get overwritten by injected
+  kexts, so that only injected kexts need to be exported afterwards.
+
+  @param[in,out]  Context  Prelinked context.
+**/
+STATIC
+VOID
+PrelinkedSaveOriginalInfo (
+  IN OUT PRELINKED_CONTEXT  *Context
+  )
+{
+  CONST CHAR8  *Info;
+  CONST CHAR8  *KextListTagEnd;
+  UINT32       InfoSize;
+  UINTN        KextListStart;
+  UINT32       KextListEnd;
+
+  if (Context->KextListModified || (Context->PrelinkedInfoOriginal != NULL)) {
+    return;
+  }
+
+  if (Context->Is32Bit) {
+    Info     = (CONST CHAR8 *)&Context->Prelinked[Context->PrelinkedInfoSection->Section32.Offset];
+    InfoSize = Context->PrelinkedInfoSection->Section32.Size;
+  } else {
+    Info     = (CONST CHAR8 *)&Context->Prelinked[Context->PrelinkedInfoSection->Section64.Offset];
+    InfoSize = (UINT32)Context->PrelinkedInfoSection->Section64.Size;
+  }
+
+  InfoSize = (UINT32)AsciiStrnLenS (Info, InfoSize);
+
+  //
+  // KextList was parsed from the copy of the same data, so its name points
+  // right after the opening `<' at the same offset.
+  //
+  KextListStart = XmlNodeName (Context->KextList) - Context->PrelinkedInfo;
+  if ((KextListStart == 0) || (KextListStart >= InfoSize)) {
+    return;
+  }
+
+  KextListTagEnd = ScanMem8 (&Info[KextListStart], InfoSize - KextListStart, '>');
+  if ((KextListTagEnd == NULL) || (*(KextListTagEnd - 1) == '/')) {
+    return;
+  }
+
+  KextListStart = KextListTagEnd - Info + 1;
+  if (!XmlLocateClosingTag (&Info[KextListStart], InfoSize - (UINT32)KextListStart, &KextListEnd)) {
+    return;
+  }
+
+  Context->PrelinkedInfoOriginal = AllocateCopyPool (InfoSize, Info);
+  if (Context->PrelinkedInfoOriginal == NULL) {
+    return;
+  }
+
+  Context->PrelinkedInfoOriginalSize = InfoSize;
+  Context->KextListOriginalEnd       = (UINT32)KextListStart + KextListEnd;
+  Context->KextListOriginalCount     = XmlNodeChildren (Context->KextList);
+}
+
+/**
+  Export prelinked info by inserting injected kexts into the original one.
+  Falls back to full document export when original kexts were modified.
+
+  @param[in]   Context           Prelinked context.
+  @param[out]  ExportedInfoSize  Exported info size without trailing '\0'.
+
+  @return The exported buffer allocated from pool or NULL.
+**/
+STATIC
+CHAR8 *
+PrelinkedExportInfo (
+  IN  PRELINKED_CONTEXT  *Context,
+  OUT UINT32             *ExportedInfoSize
+  )
+{
+  CHAR8        *ExportedInfo;
+  UINT32       ExportedSize;
+  UINT32       KextCount;
+  UINT32       Index;
+  XML_NODE     *KextPlist;
+  CONST CHAR8  *KextName;
+  CONST CHAR8  *KextContent;
+  UINT32       KextNameLength;
+  UINT32       KextContentLength;
+  UINT32       Offset;
+
+  KextCount = XmlNodeChildren (Context->KextList);
+
+  if (  (Context->PrelinkedInfoOriginal == NULL)
+     || Context->KextListModified
+     || (KextCount < Context->KextListOriginalCount))
+  {
+    return XmlDocumentExport (Context->PrelinkedInfoDocument, ExportedInfoSize, 0, FALSE);
+  }
+
+  //
+  // Injected kexts only have their plist contents set, see PrelinkedInjectKext.
+  //
+  ExportedSize = Context->PrelinkedInfoOriginalSize;
+  for (Index = Context->KextListOriginalCount; Index < KextCount; ++Index) {
+    KextPlist   = XmlNodeChild (Context->KextList, Index);
+    KextContent = XmlNodeContent (KextPlist);
+    if ((KextContent == NULL) || (XmlNodeChildren (KextPlist) != 0)) {
+      return XmlDocumentExport (Context->PrelinkedInfoDocument, ExportedInfoSize, 0, FALSE);
+    }
+
+    if (  BaseOverflowTriAddU32 (
+            ExportedSize,
+            (UINT32)AsciiStrLen (KextContent),
+            2 * (UINT32)AsciiStrLen (XmlNodeName (KextPlist)),
+            &ExportedSize
+            )
+       || BaseOverflowAddU32 (ExportedSize, L_STR_LEN ("<></>"), &ExportedSize))
+    {
+      return NULL;
+    }
+  }
+
+  ExportedInfo = AllocatePool (ExportedSize + 1);
+  if (ExportedInfo == NULL) {
+    return NULL;
+  }
+
+  CopyMem (ExportedInfo, Context->PrelinkedInfoOriginal, Context->KextListOriginalEnd);
+  Offset = Context->KextListOriginalEnd;
+
+  for (Index = Context->KextListOriginalCount; Index < KextCount; ++Index) {
+    KextPlist         = XmlNodeChild (Context->KextList, Index);
+    KextName          = XmlNodeName (KextPlist);
+    KextNameLength    = (UINT32)AsciiStrLen (KextName);
+    KextContent       = XmlNodeContent (KextPlist);
+    KextContentLength = (UINT32)AsciiStrLen (KextContent);
+
+    ExportedInfo[Offset++] = '<';
+    CopyMem (&ExportedInfo[Offset], KextName, KextNameLength);
+    Offset                += KextNameLength;
+    ExportedInfo[Offset++] = '>';
+    CopyMem (&ExportedInfo[Offset], KextContent, KextContentLength);
+    Offset                += KextContentLength;
+    ExportedInfo[Offset++] = '<';
+    ExportedInfo[Offset++] = '/';
+    CopyMem (&ExportedInfo[Offset], KextName, KextNameLength);
+    Offset                += KextNameLength;
+    ExportedInfo[Offset++] = '>';
+  }
+
+  CopyMem (
+    &ExportedInfo[Offset],
+    &Context->PrelinkedInfoOriginal[Context->KextListOriginalEnd],
+    Context->PrelinkedInfoOriginalSize - Context->KextListOriginalEnd
+    );
+
+  ASSERT (Offset + Context->PrelinkedInfoOriginalSize - Context->KextListOriginalEnd == ExportedSize);
+
+  ExportedInfo[ExportedSize] = '\0';
+  *ExportedInfoSize          = ExportedSize;
+  return ExportedInfo;
+}
+
 EFI_STATUS
 PrelinkedInjectPrepare (
   IN OUT PRELINKED_CONTEXT  *Context,
@@ -533,6 +716,8 @@ PrelinkedInjectPrepare (
   UINT64      SegmentEndOffset;
   UINT32      AlignedExpansion;
 
+  PrelinkedSaveOriginalInfo (Context);
+
   if (Context->IsKernelCollection) {
     //
     // For newer variant (KC mode) __LINKEDIT is last, and we need to expand it to enable
@@ -793,7 +978,7 @@ PrelinkedInjectComplete (
     }
   }
 
-  ExportedInfo = XmlDocumentExport (Context->PrelinkedInfoDocument, &ExportedInfoSize, 0, FALSE);
+  ExportedInfo = PrelinkedExportInfo (Context, &ExportedInfoSize);
   if (ExportedInfo == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -1251,6 +1436,7 @@ PrelinkedInjectKext (
     // for KernelCollection support.
     //
     InsertTailList (&Context->InjectedKexts, &PrelinkedKext->InjectedLink);
+    InternalInsertPrelinkedKextIdentifier (Context, PrelinkedKext->Identifier, NULL, PrelinkedKext);
   }
 
   return EFI_SUCCESS;
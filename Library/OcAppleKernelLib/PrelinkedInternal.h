@@ -48,6 +48,16 @@ typedef struct {
   UINT32         Length;
 } PRELINKED_KEXT_SYMBOL;
 
+typedef struct {
+  UINT32    Hash;  ///< hash of the symbol name
+  UINT32    Index; ///< index in LinkedSymbolTable plus one, 0 for free slots
+} PRELINKED_KEXT_SYMBOL_HASH;
+
+typedef struct {
+  UINT64    Value; ///< value of the symbol
+  UINT32    Index; ///< index in LinkedSymbolTable
+} PRELINKED_KEXT_SYMBOL_VALUE;
+
 typedef struct {
   CONST CHAR8    *Name;   ///< The symbol's name.
   UINT64         Address; ///< The symbol's address.
@@ -127,6 +137,24 @@ struct PRELINKED_KEXT_ {
   //
   PRELINKED_KEXT_SYMBOL       *LinkedSymbolTable;
   //
+  // Open-addressing hash index over LinkedSymbolTable names.
+  // May be NULL, in which case lookups fall back to linear scanning.
+  //
+  PRELINKED_KEXT_SYMBOL_HASH  *LinkedSymbolHash;
+  //
+  // Number of LinkedSymbolHash slots minus one, slot count is a power of two.
+  //
+  UINT32                      LinkedSymbolHashMask;
+  //
+  // LinkedSymbolTable values sorted by address for value lookup.
+  // Built lazily on first value lookup, may be NULL.
+  //
+  PRELINKED_KEXT_SYMBOL_VALUE  *LinkedSymbolValues;
+  //
+  // LinkedSymbolValues allocation failed, value lookups stay linear.
+  //
+  BOOLEAN                     LinkedSymbolValuesFailed;
+  //
   // A flag set during dependency walk BFS to avoid going through the same path.
   //
   BOOLEAN                     Processed;
@@ -145,6 +173,12 @@ struct PRELINKED_KEXT_ {
 //
 #define PRELINKED_KEXT_SIGNATURE  SIGNATURE_32 ('P', 'K', 'X', 'T')
 
+//
+// Nesting level of kext property values in legacy prelinked info:
+// <dict> root, _PrelinkInfoDictionary <array>, kext <dict>, value.
+//
+#define PRELINK_INFO_LAZY_LEVEL  3U
+
 /**
   Gets the next element in PrelinkedKexts list of PRELINKED_KEXT.
 
@@ -206,6 +240,63 @@ InternalDropCachedPrelinkedKext (
   IN     CONST CHAR8        *Identifier
   );
 
+/**
+  Restores LinkedSymbolTable and LinkedVtables of a dependency kext from
+  imported link cache. Counts a link cache miss on failure.
+
+  @param[in,out] Kext     Dependency kext without linked tables.
+  @param[in,out] Context  Prelinked context.
+
+  @return  TRUE when linked tables were restored.
+**/
+BOOLEAN
+InternalRestoreLinkCache (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN OUT PRELINKED_CONTEXT  *Context
+  );
+
+/**
+  Builds bundle identifier hash table for PRELINKED_CONTEXT from KextList
+  and already cached kexts. Failure to build the table is not fatal,
+  linear lookup is used then.
+**/
+VOID
+InternalBuildPrelinkedKextIdentifiers (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  );
+
+/**
+  Registers bundle identifier in PRELINKED_CONTEXT hash table.
+  Either KextPlist or Kext are to be provided.
+**/
+VOID
+InternalInsertPrelinkedKextIdentifier (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier,
+  IN     XML_NODE           *KextPlist  OPTIONAL,
+  IN     PRELINKED_KEXT     *Kext       OPTIONAL
+  );
+
+/**
+  Unregisters bundle identifier from PRELINKED_CONTEXT hash table.
+**/
+VOID
+InternalRemovePrelinkedKextIdentifier (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier
+  );
+
+/**
+  Removes Info.plist at Index from PRELINKED_CONTEXT kext list. Bundle identifier
+  is updated to refer to the next Info.plist with the same identifier if any.
+**/
+VOID
+InternalRemovePrelinkedKextPlist (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier,
+  IN     UINT32             Index
+  );
+
 /**
   Gets cached kernel PRELINKED_KEXT from PRELINKED_CONTEXT.
 **/
@@ -406,6 +497,33 @@ typedef enum {
   OcGetSymbolOnlyCxx
 } OC_GET_SYMBOL_LEVEL;
 
+/**
+  Hash symbol name or bundle identifier for hash table lookup (FNV-1a).
+
+  @param[in] Name    Name to hash.
+  @param[in] Length  Name length.
+
+  @return  Name hash.
+**/
+UINT32
+InternalHashName (
+  IN CONST CHAR8  *Name,
+  IN UINT32       Length
+  );
+
+/**
+  Build hash index over LinkedSymbolTable of a dependency kext.
+  Failure to build the index is not fatal, linear lookup is used then.
+
+  @param[in,out] Kext      Kext dependency with LinkedSymbolTable.
+  @param[in]     Context   Prelinking context.
+**/
+VOID
+InternalBuildLinkedSymbolHash (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN     PRELINKED_CONTEXT  *Context
+  );
+
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolName (
   IN PRELINKED_CONTEXT    *Context,
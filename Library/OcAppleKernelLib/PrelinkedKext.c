@@ -472,6 +472,8 @@ InternalScanBuildLinkedSymbolTable (
   Kext->NumberOfCxxSymbols = NumCxxSymbols;
   Kext->LinkedSymbolTable  = SymbolTable;
 
+  InternalBuildLinkedSymbolHash (Kext, Context);
+
   return EFI_SUCCESS;
 }
 
@@ -688,6 +690,16 @@ InternalFreePrelinkedKext (
     Kext->LinkedSymbolTable = NULL;
   }
 
+  if (Kext->LinkedSymbolHash != NULL) {
+    FreePool (Kext->LinkedSymbolHash);
+    Kext->LinkedSymbolHash = NULL;
+  }
+
+  if (Kext->LinkedSymbolValues != NULL) {
+    FreePool (Kext->LinkedSymbolValues);
+    Kext->LinkedSymbolValues = NULL;
+  }
+
   if (Kext->LinkedVtables != NULL) {
     FreePool (Kext->LinkedVtables);
     Kext->LinkedVtables = NULL;
@@ -696,17 +708,383 @@ InternalFreePrelinkedKext (
   FreePool (Kext);
 }
 
-PRELINKED_KEXT *
-InternalCachedPrelinkedKext (
+/**
+  Get CFBundleIdentifier from kext Info.plist.
+
+  @param[in] KextPlist  Kext Info.plist dictionary.
+
+  @return  Bundle identifier or NULL.
+**/
+STATIC
+CONST CHAR8 *
+InternalGetKextPlistIdentifier (
+  IN XML_NODE  *KextPlist
+  )
+{
+  UINT32       FieldIndex;
+  UINT32       FieldCount;
+  CONST CHAR8  *KextPlistKey;
+  XML_NODE     *KextPlistValue;
+
+  FieldCount = PlistDictChildren (KextPlist);
+  for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
+    KextPlistKey = PlistKeyValue (PlistDictChild (KextPlist, FieldIndex, &KextPlistValue));
+    if ((KextPlistKey != NULL) && (AsciiStrCmp (KextPlistKey, INFO_BUNDLE_IDENTIFIER_KEY) == 0)) {
+      if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_STRING) == NULL) {
+        return NULL;
+      }
+
+      return XmlNodeContent (KextPlistValue);
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Find bundle identifier entry in hash table.
+
+  @param[in] Prelinked   Prelinked context with hash table.
+  @param[in] Identifier  Bundle identifier.
+  @param[in] Hash        Bundle identifier hash.
+
+  @return  Matching entry or free entry, where it is to be inserted.
+**/
+STATIC
+PRELINKED_KEXT_IDENTIFIER *
+InternalLookupPrelinkedKextIdentifier (
+  IN PRELINKED_CONTEXT  *Prelinked,
+  IN CONST CHAR8        *Identifier,
+  IN UINT32             Hash
+  )
+{
+  PRELINKED_KEXT_IDENTIFIER  *Entries;
+  UINT32                     Slot;
+
+  ASSERT (Prelinked->KextIdentifiers != NULL);
+
+  Entries = Prelinked->KextIdentifiers;
+  Slot    = Hash & Prelinked->KextIdentifiersMask;
+
+  while (Entries[Slot].Identifier != NULL) {
+    if ((Entries[Slot].Hash == Hash) && (AsciiStrCmp (Entries[Slot].Identifier, Identifier) == 0)) {
+      break;
+    }
+
+    Slot = (Slot + 1) & Prelinked->KextIdentifiersMask;
+  }
+
+  return &Entries[Slot];
+}
+
+/**
+  Resize bundle identifier hash table.
+
+  @param[in,out] Prelinked  Prelinked context with hash table.
+  @param[in]     Size       New hash table size, power of two.
+
+  @return  FALSE on memory allocation failure.
+**/
+STATIC
+BOOLEAN
+InternalResizePrelinkedKextIdentifiers (
   IN OUT PRELINKED_CONTEXT  *Prelinked,
-  IN     CONST CHAR8        *Identifier
+  IN     UINT32             Size
   )
 {
-  PRELINKED_KEXT  *NewKext;
-  LIST_ENTRY      *Kext;
+  PRELINKED_KEXT_IDENTIFIER  *OldEntries;
+  UINT32                     OldSize;
+  UINT32                     Index;
+  UINT32                     Slot;
+
+  ASSERT (Size > 0);
+  ASSERT ((Size & (Size - 1)) == 0);
+
+  OldEntries = Prelinked->KextIdentifiers;
+  OldSize    = OldEntries != NULL ? Prelinked->KextIdentifiersMask + 1 : 0;
+
+  Prelinked->KextIdentifiers = AllocateZeroPool (Size * sizeof (*Prelinked->KextIdentifiers));
+  if (Prelinked->KextIdentifiers == NULL) {
+    Prelinked->KextIdentifiers = OldEntries;
+    return FALSE;
+  }
+
+  Prelinked->KextIdentifiersMask = Size - 1;
+
+  for (Index = 0; Index < OldSize; ++Index) {
+    if (OldEntries[Index].Identifier != NULL) {
+      Slot = OldEntries[Index].Hash & Prelinked->KextIdentifiersMask;
+      while (Prelinked->KextIdentifiers[Slot].Identifier != NULL) {
+        Slot = (Slot + 1) & Prelinked->KextIdentifiersMask;
+      }
+
+      CopyMem (&Prelinked->KextIdentifiers[Slot], &OldEntries[Index], sizeof (OldEntries[Index]));
+    }
+  }
+
+  if (OldEntries != NULL) {
+    FreePool (OldEntries);
+  }
+
+  return TRUE;
+}
+
+VOID
+InternalBuildPrelinkedKextIdentifiers (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  )
+{
+  LIST_ENTRY      *Link;
+  PRELINKED_KEXT  *Kext;
   UINT32          Index;
   UINT32          KextCount;
+  UINT32          Size;
   XML_NODE        *KextPlist;
+  CONST CHAR8     *Identifier;
+
+  ASSERT (Prelinked->KextIdentifiers == NULL);
+
+  //
+  // Keep load factor under 50% with some room for injected kexts.
+  //
+  KextCount = XmlNodeChildren (Prelinked->KextList);
+  Size      = GetPowerOfTwo32 ((KextCount + 64) * 2);
+  if (Size < (KextCount + 64) * 2) {
+    Size <<= 1U;
+  }
+
+  if (!InternalResizePrelinkedKextIdentifiers (Prelinked, Size)) {
+    DEBUG ((DEBUG_INFO, "OCAK: No memory for kext identifier table, using linear lookup\n"));
+    return;
+  }
+
+  Prelinked->KextIdentifiersCount = 0;
+
+  //
+  // Cached kexts go first, as they take precedence in lookup.
+  //
+  Link = GetFirstNode (&Prelinked->PrelinkedKexts);
+  while (!IsNull (&Prelinked->PrelinkedKexts, Link)) {
+    Kext = GET_PRELINKED_KEXT_FROM_LINK (Link);
+    InternalInsertPrelinkedKextIdentifier (Prelinked, Kext->Identifier, NULL, Kext);
+    Link = GetNextNode (&Prelinked->PrelinkedKexts, Link);
+  }
+
+  for (Index = 0; (Index < KextCount) && (Prelinked->KextIdentifiers != NULL); ++Index) {
+    KextPlist = PlistNodeCast (XmlNodeChild (Prelinked->KextList, Index), PLIST_NODE_TYPE_DICT);
+    if (KextPlist == NULL) {
+      continue;
+    }
+
+    Identifier = InternalGetKextPlistIdentifier (KextPlist);
+    if (Identifier != NULL) {
+      InternalInsertPrelinkedKextIdentifier (Prelinked, Identifier, KextPlist, NULL);
+    }
+  }
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCAK: Indexed %u kext identifiers from %u plist entries\n",
+    Prelinked->KextIdentifiersCount,
+    KextCount
+    ));
+}
+
+VOID
+InternalInsertPrelinkedKextIdentifier (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier,
+  IN     XML_NODE           *KextPlist  OPTIONAL,
+  IN     PRELINKED_KEXT     *Kext       OPTIONAL
+  )
+{
+  PRELINKED_KEXT_IDENTIFIER  *Entry;
+  UINT32                     Hash;
+
+  ASSERT (Identifier != NULL);
+  ASSERT ((KextPlist != NULL) || (Kext != NULL));
+
+  if (Prelinked->KextIdentifiers == NULL) {
+    return;
+  }
+
+  if (  ((Prelinked->KextIdentifiersCount + 1) * 2 > Prelinked->KextIdentifiersMask + 1)
+     && !InternalResizePrelinkedKextIdentifiers (Prelinked, (Prelinked->KextIdentifiersMask + 1) * 2))
+  {
+    //
+    // Incomplete table cannot be used, fallback to linear lookup.
+    //
+    DEBUG ((DEBUG_INFO, "OCAK: No memory for kext identifier table, using linear lookup\n"));
+    FreePool (Prelinked->KextIdentifiers);
+    Prelinked->KextIdentifiers      = NULL;
+    Prelinked->KextIdentifiersMask  = 0;
+    Prelinked->KextIdentifiersCount = 0;
+    return;
+  }
+
+  Hash  = InternalHashName (Identifier, (UINT32)AsciiStrLen (Identifier));
+  Entry = InternalLookupPrelinkedKextIdentifier (Prelinked, Identifier, Hash);
+
+  if (Entry->Identifier == NULL) {
+    Entry->Identifier = Identifier;
+    Entry->Hash       = Hash;
+    ++Prelinked->KextIdentifiersCount;
+  }
+
+  //
+  // Keep the first Info.plist and the first cached kext to match linear lookup.
+  //
+  if (Entry->KextPlist == NULL) {
+    Entry->KextPlist = KextPlist;
+  }
+
+  if (Entry->Kext == NULL) {
+    Entry->Kext = Kext;
+  }
+}
+
+VOID
+InternalRemovePrelinkedKextIdentifier (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier
+  )
+{
+  PRELINKED_KEXT_IDENTIFIER  *Entries;
+  UINT32                     Mask;
+  UINT32                     Slot;
+  UINT32                     Next;
+  UINT32                     Home;
+
+  if (Prelinked->KextIdentifiers == NULL) {
+    return;
+  }
+
+  Entries = Prelinked->KextIdentifiers;
+  Mask    = Prelinked->KextIdentifiersMask;
+  Slot    = (UINT32)(InternalLookupPrelinkedKextIdentifier (
+                       Prelinked,
+                       Identifier,
+                       InternalHashName (Identifier, (UINT32)AsciiStrLen (Identifier))
+                       ) - Entries);
+
+  if (Entries[Slot].Identifier == NULL) {
+    return;
+  }
+
+  //
+  // Shift following entries of the probe sequence back to avoid tombstones.
+  // An entry can take the free slot unless its home slot is between the two.
+  //
+  Next = Slot;
+  while (TRUE) {
+    Next = (Next + 1) & Mask;
+    if (Entries[Next].Identifier == NULL) {
+      break;
+    }
+
+    Home = Entries[Next].Hash & Mask;
+    if (((Next - Home) & Mask) >= ((Next - Slot) & Mask)) {
+      CopyMem (&Entries[Slot], &Entries[Next], sizeof (Entries[Slot]));
+      Slot = Next;
+    }
+  }
+
+  ZeroMem (&Entries[Slot], sizeof (Entries[Slot]));
+  --Prelinked->KextIdentifiersCount;
+}
+
+VOID
+InternalRemovePrelinkedKextPlist (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier,
+  IN     UINT32             Index
+  )
+{
+  PRELINKED_KEXT_IDENTIFIER  *Entry;
+  UINT32                     KextCount;
+  XML_NODE                   *KextPlist;
+  CONST CHAR8                *KextIdentifier;
+
+  XmlNodeRemoveByIndex (Prelinked->KextList, Index);
+
+  if (Prelinked->KextIdentifiers == NULL) {
+    return;
+  }
+
+  Entry = InternalLookupPrelinkedKextIdentifier (
+            Prelinked,
+            Identifier,
+            InternalHashName (Identifier, (UINT32)AsciiStrLen (Identifier))
+            );
+  if (Entry->Identifier == NULL) {
+    return;
+  }
+
+  //
+  // Linear lookup finds the next Info.plist with the same identifier, if any.
+  // Earlier entries are not matching, as the removed one was the first.
+  //
+  Entry->KextPlist = NULL;
+  KextCount        = XmlNodeChildren (Prelinked->KextList);
+  for (; Index < KextCount; ++Index) {
+    KextPlist = PlistNodeCast (XmlNodeChild (Prelinked->KextList, Index), PLIST_NODE_TYPE_DICT);
+    if (KextPlist == NULL) {
+      continue;
+    }
+
+    KextIdentifier = InternalGetKextPlistIdentifier (KextPlist);
+    if ((KextIdentifier != NULL) && (AsciiStrCmp (KextIdentifier, Identifier) == 0)) {
+      Entry->KextPlist = KextPlist;
+      if (Entry->Kext == NULL) {
+        Entry->Identifier = KextIdentifier;
+      }
+
+      return;
+    }
+  }
+
+  if (Entry->Kext == NULL) {
+    InternalRemovePrelinkedKextIdentifier (Prelinked, Identifier);
+  }
+}
+
+PRELINKED_KEXT *
+InternalCachedPrelinkedKext (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier
+  )
+{
+  PRELINKED_KEXT             *NewKext;
+  LIST_ENTRY                 *Kext;
+  UINT32                     Index;
+  UINT32                     KextCount;
+  XML_NODE                   *KextPlist;
+  PRELINKED_KEXT_IDENTIFIER  *Entry;
+
+  if (Prelinked->KextIdentifiers != NULL) {
+    Entry = InternalLookupPrelinkedKextIdentifier (
+              Prelinked,
+              Identifier,
+              InternalHashName (Identifier, (UINT32)AsciiStrLen (Identifier))
+              );
+    if (Entry->Kext != NULL) {
+      return Entry->Kext;
+    }
+
+    if (Entry->KextPlist == NULL) {
+      return NULL;
+    }
+
+    NewKext = InternalCreatePrelinkedKext (Prelinked, Entry->KextPlist, Identifier, Prelinked->Is32Bit);
+    if (NewKext == NULL) {
+      return NULL;
+    }
+
+    InsertTailList (&Prelinked->PrelinkedKexts, &NewKext->Link);
+    InternalInsertPrelinkedKextIdentifier (Prelinked, NewKext->Identifier, NULL, NewKext);
+
+    return NewKext;
+  }
 
   //
   // Find cached entry if any.
@@ -753,9 +1131,10 @@ InternalDropCachedPrelinkedKext (
   IN     CONST CHAR8        *Identifier
   )
 {
-  LIST_ENTRY      *Link;
-  BOOLEAN         Found;
-  PRELINKED_KEXT  *Kext;
+  LIST_ENTRY                 *Link;
+  BOOLEAN                    Found;
+  PRELINKED_KEXT             *Kext;
+  PRELINKED_KEXT_IDENTIFIER  *Entry;
 
   //
   // Find kext identifier.
@@ -788,6 +1167,21 @@ InternalDropCachedPrelinkedKext (
     ));
 
   RemoveEntryList (Link);
+
+  if (Prelinked->KextIdentifiers != NULL) {
+    Entry = InternalLookupPrelinkedKextIdentifier (
+              Prelinked,
+              Identifier,
+              InternalHashName (Identifier, (UINT32)AsciiStrLen (Identifier))
+              );
+    if (Entry->Kext == Kext) {
+      Entry->Kext = NULL;
+      if (Entry->KextPlist == NULL) {
+        InternalRemovePrelinkedKextIdentifier (Prelinked, Identifier);
+      }
+    }
+  }
+
   InternalFreePrelinkedKext (Kext);
 
   return EFI_SUCCESS;
@@ -938,6 +1332,7 @@ InternalCachedPrelinkedKernel (
   }
 
   InsertTailList (&Prelinked->PrelinkedKexts, &NewKext->Link);
+  InternalInsertPrelinkedKextIdentifier (Prelinked, NewKext->Identifier, NULL, NewKext);
 
   return NewKext;
 }
@@ -1109,9 +1504,10 @@ InternalScanPrelinkedKext (
       if (EFI_ERROR (Status)) {
         return Status;
       }
-    } else {
+    } else if (!InternalRestoreLinkCache (Kext, Context)) {
       //
-      // Use normal LINKEDIT building for newer kernels and all kexts.
+      // Use normal LINKEDIT building for newer kernels and all kexts,
+      // unless the tables were restored from link cache.
       //
       Status = InternalScanBuildLinkedSymbolTable (Kext, Context);
       if (EFI_ERROR (Status)) {
@@ -91,6 +91,59 @@ InternalAddAllocatedArea (
   ++Table->ExtentCount;
 }
 
+/**
+  Merge adjacent free memory descriptors to let allocation prefer
+  a few large extents over many small ones. Requires sorted memory map.
+  Descriptors are not merged across BASE_4GB, as high memory allocation
+  skips descriptors starting below it.
+
+  @param[in,out] MemoryMapSize  Memory map size in bytes, updated on merge.
+  @param[in,out] MemoryMap      Memory map to merge.
+  @param[in]     DescriptorSize Memory map descriptor size in bytes.
+**/
+STATIC
+VOID
+InternalMergeFreeDescriptors (
+  IN OUT UINTN                  *MemoryMapSize,
+  IN OUT EFI_MEMORY_DESCRIPTOR  *MemoryMap,
+  IN     UINTN                  DescriptorSize
+  )
+{
+  EFI_MEMORY_DESCRIPTOR  *PrevDesc;
+  EFI_MEMORY_DESCRIPTOR  *Desc;
+  EFI_MEMORY_DESCRIPTOR  *MemoryMapEnd;
+
+  if (*MemoryMapSize <= DescriptorSize) {
+    return;
+  }
+
+  MemoryMapEnd = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)MemoryMap + *MemoryMapSize);
+  PrevDesc     = MemoryMap;
+
+  for (
+       Desc = NEXT_MEMORY_DESCRIPTOR (MemoryMap, DescriptorSize);
+       Desc < MemoryMapEnd;
+       Desc = NEXT_MEMORY_DESCRIPTOR (Desc, DescriptorSize))
+  {
+    if (  (PrevDesc->Type == EfiConventionalMemory)
+       && (Desc->Type == EfiConventionalMemory)
+       && (PrevDesc->Attribute == Desc->Attribute)
+       && (Desc->PhysicalStart != BASE_4GB)
+       && (PrevDesc->PhysicalStart + EFI_PAGES_TO_SIZE (PrevDesc->NumberOfPages) == Desc->PhysicalStart))
+    {
+      PrevDesc->NumberOfPages += Desc->NumberOfPages;
+      continue;
+    }
+
+    PrevDesc = NEXT_MEMORY_DESCRIPTOR (PrevDesc, DescriptorSize);
+    if (PrevDesc != Desc) {
+      CopyMem (PrevDesc, Desc, DescriptorSize);
+    }
+  }
+
+  *MemoryMapSize = (UINTN)((UINT8 *)NEXT_MEMORY_DESCRIPTOR (PrevDesc, DescriptorSize) - (UINT8 *)MemoryMap);
+}
+
 /**
   Perform allocation of RemainingSize data with biggest contiguous area
   first strategy. Allocation extent map is put to the first allocated
@@ -204,14 +257,19 @@ InternalAllocateRemainingSize (
         (UINT64)RemainingSize,
         Status
         ));
-      return RemainingSize;
+      //
+      // Merged descriptors may not be allocatable at once on some firmware,
+      // skip this area and try the next biggest one.
+      //
+      BiggestEntry->Type = EfiReservedMemoryType;
+      continue;
     }
 
     InternalAddAllocatedArea (ExtentTable, AllocatedArea, FinalUsedSize);
 
     RemainingSize -= FinalUsedSize;
 
-    BiggestEntry->PhysicalStart += EFI_SIZE_TO_PAGES (FinalUsedSize);
+    BiggestEntry->PhysicalStart += EFI_PAGES_TO_SIZE (EFI_SIZE_TO_PAGES (FinalUsedSize));
     BiggestEntry->NumberOfPages -= EFI_SIZE_TO_PAGES (FinalUsedSize);
   }
 
@@ -252,6 +310,13 @@ InternalAppleRamDiskAllocate (
     return NULL;
   }
 
+  //
+  // Firmware memory maps are often fragmented into many adjacent free
+  // descriptors. Merge them to reduce the amount of extents.
+  //
+  OcSortMemoryMap (MemoryMapSize, MemoryMap, DescriptorSize);
+  InternalMergeFreeDescriptors (&MemoryMapSize, MemoryMap, DescriptorSize);
+
   STATIC_ASSERT (
     sizeof (APPLE_RAM_DISK_EXTENT_TABLE) == EFI_PAGE_SIZE,
     "Extent table different from EFI_PAGE_SIZE is unsupported!"
@@ -259,6 +324,7 @@ InternalAppleRamDiskAllocate (
 
   Result = BaseOverflowAddUN (Size, EFI_PAGE_SIZE, &RemainingSize);
   if (Result) {
+    FreePool (MemoryMap);
     return NULL;
   }
 
@@ -309,6 +375,8 @@ InternalAppleRamDiskAllocate (
                     &ExtentTable
                     );
 
+  FreePool (MemoryMap);
+
   if ((RemainingSize > 0) && (ExtentTable != NULL)) {
     OcAppleRamDiskFree (ExtentTable);
 
@@ -350,129 +418,190 @@ OcAppleRamDiskAllocate (
   return ExtentTable;
 }
 
-BOOLEAN
-OcAppleRamDiskRead (
-  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
-  IN  UINTN                              Offset,
-  IN  UINTN                              Size,
-  OUT VOID                               *Buffer
+VOID
+OcAppleRamDiskInitializeIndex (
+  OUT OC_APPLE_RAM_DISK_EXTENT_INDEX     *ExtentIndex,
+  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
   )
 {
-  UINT8  *BufferBytes;
-
-  UINT32                       Index;
-  CONST APPLE_RAM_DISK_EXTENT  *Extent;
-
-  UINTN  CurrentOffset;
-  UINTN  LocalOffset;
-  UINTN  LocalSize;
+  UINT32  Index;
+  UINTN   CurrentOffset;
 
+  ASSERT (ExtentIndex != NULL);
   ASSERT (ExtentTable != NULL);
   INTERNAL_ASSERT_EXTENT_TABLE_VALID (ExtentTable);
-  ASSERT (Size > 0);
-  ASSERT (Buffer != NULL);
 
-  BufferBytes = Buffer;
-  //
-  // As per the allocation algorithm, the sum over all Extent->Length must be
-  // smaller than MAX_UINTN.
-  //
-  for (
-       Index = 0, CurrentOffset = 0;
-       Index < ExtentTable->ExtentCount;
-       ++Index, CurrentOffset += (UINTN)Extent->Length
-       )
-  {
-    Extent = &ExtentTable->Extents[Index];
-    ASSERT (Extent->Start <= MAX_UINTN);
-    ASSERT (Extent->Length <= MAX_UINTN);
-
-    if ((Offset >= CurrentOffset) && ((Offset - CurrentOffset) < Extent->Length)) {
-      LocalOffset = (Offset - CurrentOffset);
-      LocalSize   = (UINTN)MIN ((Extent->Length - LocalOffset), Size);
-      CopyMem (
-        BufferBytes,
-        (VOID *)((UINTN)Extent->Start + LocalOffset),
-        LocalSize
-        );
-
-      Size -= LocalSize;
-      if (Size == 0) {
-        return TRUE;
-      }
+  ExtentIndex->ExtentTable      = ExtentTable;
+  ExtentIndex->ExtentOffsets[0] = 0;
+
+  for (Index = 0; Index < ExtentTable->ExtentCount; ++Index) {
+    ASSERT (ExtentTable->Extents[Index].Start <= MAX_UINTN);
+    ASSERT (ExtentTable->Extents[Index].Length <= MAX_UINTN);
 
-      BufferBytes += LocalSize;
-      Offset      += LocalSize;
+    //
+    // As per the allocation algorithm, the sum over all Extent->Length must be
+    // smaller than MAX_UINTN. Ignore the extents past the limit otherwise.
+    //
+    if (  (ExtentTable->Extents[Index].Length > MAX_UINTN)
+       || BaseOverflowAddUN (
+            ExtentIndex->ExtentOffsets[Index],
+            (UINTN)ExtentTable->Extents[Index].Length,
+            &CurrentOffset
+            ))
+    {
+      break;
     }
+
+    ExtentIndex->ExtentOffsets[Index + 1] = CurrentOffset;
   }
 
-  return FALSE;
+  ExtentIndex->ExtentCount = Index;
 }
 
+/**
+  Find the extent containing RAM disk offset.
+
+  @param[in]  ExtentIndex  Extent lookup index.
+  @param[in]  Offset       Offset in RAM disk.
+  @param[out] ExtentNumber Index of the extent containing Offset.
+
+  @retval TRUE on success.
+**/
+STATIC
 BOOLEAN
-OcAppleRamDiskWrite (
-  IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
-  IN UINTN                              Offset,
-  IN UINTN                              Size,
-  IN CONST VOID                         *Buffer
+InternalFindExtent (
+  IN  CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN  UINTN                                 Offset,
+  OUT UINT32                                *ExtentNumber
   )
 {
-  CONST UINT8  *BufferBytes;
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Middle;
 
+  if (  (ExtentIndex->ExtentCount == 0)
+     || (Offset >= ExtentIndex->ExtentOffsets[ExtentIndex->ExtentCount]))
+  {
+    return FALSE;
+  }
+
+  //
+  // Find the last extent starting at or before Offset. Zero-sized extents
+  // share their offset with the next one and are thus skipped.
+  //
+  Low  = 0;
+  High = ExtentIndex->ExtentCount - 1;
+
+  while (Low < High) {
+    Middle = Low + (High - Low + 1) / 2;
+    if (ExtentIndex->ExtentOffsets[Middle] <= Offset) {
+      Low = Middle;
+    } else {
+      High = Middle - 1;
+    }
+  }
+
+  *ExtentNumber = Low;
+  return TRUE;
+}
+
+/**
+  Copy data between RAM disk and buffer.
+
+  @param[in]     ExtentIndex  Extent lookup index.
+  @param[in]     Offset       Offset in RAM disk.
+  @param[in]     Size         Amount of data to copy.
+  @param[in,out] Buffer       Buffer to read to or write from.
+  @param[in]     Write        TRUE to write Buffer to RAM disk.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalCopyExtents (
+  IN     CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN     UINTN                                 Offset,
+  IN     UINTN                                 Size,
+  IN OUT UINT8                                 *Buffer,
+  IN     BOOLEAN                               Write
+  )
+{
   UINT32                       Index;
   CONST APPLE_RAM_DISK_EXTENT  *Extent;
+  UINTN                        LocalOffset;
+  UINTN                        LocalSize;
+  UINT8                        *ExtentData;
 
-  UINTN  CurrentOffset;
-  UINTN  LocalOffset;
-  UINTN  LocalSize;
+  if (!InternalFindExtent (ExtentIndex, Offset, &Index)) {
+    return FALSE;
+  }
 
-  ASSERT (ExtentTable != NULL);
-  INTERNAL_ASSERT_EXTENT_TABLE_VALID (ExtentTable);
-  ASSERT (Size > 0);
-  ASSERT (Buffer != NULL);
+  LocalOffset = Offset - ExtentIndex->ExtentOffsets[Index];
 
-  BufferBytes = Buffer;
-  //
-  // As per the allocation algorithm, the sum over all Extent->Length must be
-  // smaller than MAX_UINTN.
-  //
-  for (
-       Index = 0, CurrentOffset = 0;
-       Index < ExtentTable->ExtentCount;
-       ++Index, CurrentOffset += (UINTN)Extent->Length
-       )
-  {
-    Extent = &ExtentTable->Extents[Index];
-    ASSERT (Extent->Start <= MAX_UINTN);
-    ASSERT (Extent->Length <= MAX_UINTN);
-
-    if ((Offset >= CurrentOffset) && ((Offset - CurrentOffset) < Extent->Length)) {
-      LocalOffset = (Offset - CurrentOffset);
-      LocalSize   = (UINTN)MIN ((Extent->Length - LocalOffset), Size);
-      CopyMem (
-        (VOID *)((UINTN)Extent->Start + LocalOffset),
-        BufferBytes,
-        LocalSize
-        );
-
-      Size -= LocalSize;
-      if (Size == 0) {
-        return TRUE;
-      }
+  for ( ; Index < ExtentIndex->ExtentCount; ++Index) {
+    Extent     = &ExtentIndex->ExtentTable->Extents[Index];
+    LocalSize  = MIN ((UINTN)Extent->Length - LocalOffset, Size);
+    ExtentData = (UINT8 *)(UINTN)Extent->Start + LocalOffset;
 
-      BufferBytes += LocalSize;
-      Offset      += LocalSize;
+    if (Write) {
+      CopyMem (ExtentData, Buffer, LocalSize);
+    } else {
+      CopyMem (Buffer, ExtentData, LocalSize);
     }
+
+    Size -= LocalSize;
+    if (Size == 0) {
+      return TRUE;
+    }
+
+    Buffer     += LocalSize;
+    LocalOffset = 0;
   }
 
   return FALSE;
 }
 
+BOOLEAN
+OcAppleRamDiskRead (
+  IN  CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN  UINTN                                 Offset,
+  IN  UINTN                                 Size,
+  OUT VOID                                  *Buffer
+  )
+{
+  ASSERT (ExtentIndex != NULL);
+  ASSERT (ExtentIndex->ExtentTable != NULL);
+  INTERNAL_ASSERT_EXTENT_TABLE_VALID (ExtentIndex->ExtentTable);
+  ASSERT (Size > 0);
+  ASSERT (Buffer != NULL);
+
+  return InternalCopyExtents (ExtentIndex, Offset, Size, Buffer, FALSE);
+}
+
+BOOLEAN
+OcAppleRamDiskWrite (
+  IN CONST OC_APPLE_RAM_DISK_EXTENT_INDEX  *ExtentIndex,
+  IN UINTN                                 Offset,
+  IN UINTN                                 Size,
+  IN CONST VOID                            *Buffer
+  )
+{
+  ASSERT (ExtentIndex != NULL);
+  ASSERT (ExtentIndex->ExtentTable != NULL);
+  INTERNAL_ASSERT_EXTENT_TABLE_VALID (ExtentIndex->ExtentTable);
+  ASSERT (Size > 0);
+  ASSERT (Buffer != NULL);
+
+  return InternalCopyExtents (ExtentIndex, Offset, Size, (UINT8 *)Buffer, TRUE);
+}
+
 BOOLEAN
 OcAppleRamDiskLoadFile (
   IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
   IN EFI_FILE_PROTOCOL                  *File,
-  IN UINTN                              FileSize
+  IN UINTN                              FileSize,
+  IN OC_APPLE_RAM_DISK_LOAD_HOOK        Hook         OPTIONAL,
+  IN VOID                               *HookContext OPTIONAL
   )
 {
   EFI_STATUS      Status;
@@ -538,6 +667,11 @@ OcAppleRamDiskLoadFile (
       Sha256Update (&Ctx, TmpBuffer, ReadSize);
       DEBUG_CODE_END ();
 
+      if ((Hook != NULL) && !Hook (HookContext, TmpBuffer, ReadSize)) {
+        FreePool (TmpBuffer);
+        return FALSE;
+      }
+
       CopyMem (ExtentBuffer, TmpBuffer, ReadSize);
 
       FilePosition += ReadSize;
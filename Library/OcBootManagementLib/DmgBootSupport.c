@@ -107,77 +107,84 @@ InternalGetFirstDeviceBootFilePath (
   return BootDevicePath;
 }
 
+/**
+  Initialise DMG chunklist context and verify its signature when required.
+  Chunklist data is verified separately, preferably while loading the DMG.
+**/
 STATIC
-EFI_DEVICE_PATH_PROTOCOL *
-InternalGetDiskImageBootFile (
-  OUT INTERNAL_DMG_LOAD_CONTEXT  *Context,
-  IN  OC_DMG_LOADING_SUPPORT     DmgLoading,
-  IN  UINTN                      DmgFileSize,
-  IN  VOID                       *ChunklistBuffer OPTIONAL,
-  IN  UINT32                     ChunklistBufferSize OPTIONAL
+BOOLEAN
+InternalInitializeDmgChunklist (
+  OUT OC_APPLE_CHUNKLIST_CONTEXT  *ChunklistContext,
+  IN  OC_DMG_LOADING_SUPPORT      DmgLoading,
+  IN  VOID                        *ChunklistBuffer OPTIONAL,
+  IN  UINT32                      ChunklistBufferSize OPTIONAL
   )
 {
-  EFI_DEVICE_PATH_PROTOCOL  *DevPath;
+  BOOLEAN  Result;
 
-  BOOLEAN                     Result;
-  OC_APPLE_CHUNKLIST_CONTEXT  ChunklistContext;
-
-  CONST EFI_DEVICE_PATH_PROTOCOL  *DmgDevicePath;
-  UINTN                           DmgDevicePathSize;
+  ASSERT (ChunklistContext != NULL);
 
-  ASSERT (Context != NULL);
-  ASSERT (DmgFileSize > 0);
+  if (DmgLoading != OcDmgLoadingAppleSigned) {
+    return TRUE;
+  }
 
-  if (DmgLoading == OcDmgLoadingAppleSigned) {
-    if (ChunklistBuffer == NULL) {
-      DEBUG ((DEBUG_WARN, "OCB: Missing DMG signature, aborting\n"));
-      return NULL;
-    }
+  if (ChunklistBuffer == NULL) {
+    DEBUG ((DEBUG_WARN, "OCB: Missing DMG signature, aborting\n"));
+    return FALSE;
+  }
 
-    ASSERT (ChunklistBufferSize > 0);
+  ASSERT (ChunklistBufferSize > 0);
+
+  Result = OcAppleChunklistInitializeContext (
+             ChunklistContext,
+             ChunklistBuffer,
+             ChunklistBufferSize
+             );
+  if (!Result) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCB: Failed to initialise DMG Chunklist context\n"
+      ));
+    return FALSE;
+  }
 
-    Result = OcAppleChunklistInitializeContext (
-               &ChunklistContext,
-               ChunklistBuffer,
-               ChunklistBufferSize
-               );
-    if (!Result) {
-      DEBUG ((
-        DEBUG_INFO,
-        "OCB: Failed to initialise DMG Chunklist context\n"
-        ));
-      return NULL;
-    }
+  //
+  // FIXME: Properly abstract OcAppleKeysLib.
+  //
+  Result = OcAppleChunklistVerifySignature (
+             ChunklistContext,
+             PkDataBase[0].PublicKey
+             );
 
-    //
-    // FIXME: Properly abstract OcAppleKeysLib.
-    //
+  if (!Result) {
     Result = OcAppleChunklistVerifySignature (
-               &ChunklistContext,
-               PkDataBase[0].PublicKey
+               ChunklistContext,
+               PkDataBase[1].PublicKey
                );
+  }
 
-    if (!Result) {
-      Result = OcAppleChunklistVerifySignature (
-                 &ChunklistContext,
-                 PkDataBase[1].PublicKey
-                 );
-    }
+  if (!Result) {
+    DEBUG ((DEBUG_WARN, "OCB: DMG is not trusted, aborting\n"));
+    return FALSE;
+  }
 
-    if (!Result) {
-      DEBUG ((DEBUG_WARN, "OCB: DMG is not trusted, aborting\n"));
-      return NULL;
-    }
+  return TRUE;
+}
 
-    Result = OcAppleDiskImageVerifyData (
-               Context->DmgContext,
-               &ChunklistContext
-               );
-    if (!Result) {
-      DEBUG ((DEBUG_WARN, "OCB: DMG has been altered\n"));
-      return NULL;
-    }
-  }
+STATIC
+EFI_DEVICE_PATH_PROTOCOL *
+InternalGetDiskImageBootFile (
+  OUT INTERNAL_DMG_LOAD_CONTEXT  *Context,
+  IN  UINTN                      DmgFileSize
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL  *DevPath;
+
+  CONST EFI_DEVICE_PATH_PROTOCOL  *DmgDevicePath;
+  UINTN                           DmgDevicePathSize;
+
+  ASSERT (Context != NULL);
+  ASSERT (DmgFileSize > 0);
 
   Context->BlockIoHandle = OcAppleDiskImageInstallBlockIo (
                              Context->DmgContext,
@@ -334,120 +341,93 @@ InternalLoadDmg (
   EFI_FILE_PROTOCOL  *DmgFile;
   UINT32             DmgFileSize;
 
-  EFI_FILE_INFO      *ChunklistFileInfo;
-  EFI_FILE_PROTOCOL  *ChunklistFile;
-  UINT32             ChunklistFileSize;
-  VOID               *ChunklistBuffer;
+  EFI_FILE_INFO               *ChunklistFileInfo;
+  EFI_FILE_PROTOCOL           *ChunklistFile;
+  UINT32                      ChunklistFileSize;
+  VOID                        *ChunklistBuffer;
+  OC_APPLE_CHUNKLIST_CONTEXT  ChunklistContext;
 
   CHAR16  *DevPathText;
 
   ASSERT (Context != NULL);
 
+  DmgFile           = NULL;
+  ChunklistBuffer   = NULL;
+  ChunklistFileSize = 0;
+
   if (DmgPreloadContext->DmgContext != NULL) {
     Context->DmgContext = DmgPreloadContext->DmgContext;
     DmgFileSize         = DmgPreloadContext->DmgFileSize;
+  } else if (DmgPreloadContext->DmgFile != NULL) {
+    DmgFile     = DmgPreloadContext->DmgFile;
+    DmgFileSize = DmgPreloadContext->DmgFileSize;
   } else {
-    if (DmgPreloadContext->DmgFile != NULL) {
-      DmgFile     = DmgPreloadContext->DmgFile;
-      DmgFileSize = DmgPreloadContext->DmgFileSize;
-    } else {
-      DevPath = Context->DevicePath;
-      Status  = OcOpenFileByDevicePath (
-                  &DevPath,
-                  &DmgDir,
-                  EFI_FILE_MODE_READ,
-                  EFI_FILE_DIRECTORY
-                  );
-      if (EFI_ERROR (Status)) {
-        DevPathText = ConvertDevicePathToText (Context->DevicePath, FALSE, FALSE);
-        DEBUG ((DEBUG_INFO, "OCB: Failed to open DMG directory %s\n", DevPathText));
-        if (DevPathText != NULL) {
-          FreePool (DevPathText);
-        }
-
-        return NULL;
-      }
-
-      DmgFileInfo = InternalFindFirstDmgFileName (DmgDir, &DmgFileNameLen);
-      if (DmgFileInfo == NULL) {
-        DevPathText = ConvertDevicePathToText (Context->DevicePath, FALSE, FALSE);
-        DEBUG ((DEBUG_INFO, "OCB: Unable to find any DMG at %s\n"));
-        if (DevPathText != NULL) {
-          FreePool (DevPathText);
-        }
-
-        DmgDir->Close (DmgDir);
-        return NULL;
+    DevPath = Context->DevicePath;
+    Status  = OcOpenFileByDevicePath (
+                &DevPath,
+                &DmgDir,
+                EFI_FILE_MODE_READ,
+                EFI_FILE_DIRECTORY
+                );
+    if (EFI_ERROR (Status)) {
+      DevPathText = ConvertDevicePathToText (Context->DevicePath, FALSE, FALSE);
+      DEBUG ((DEBUG_INFO, "OCB: Failed to open DMG directory %s\n", DevPathText));
+      if (DevPathText != NULL) {
+        FreePool (DevPathText);
       }
 
-      Status = OcSafeFileOpen (
-                 DmgDir,
-                 &DmgFile,
-                 DmgFileInfo->FileName,
-                 EFI_FILE_MODE_READ,
-                 0
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((
-          DEBUG_INFO,
-          "OCB: Failed to open DMG file %s - %r\n",
-          DmgFileInfo->FileName,
-          Status
-          ));
-
-        FreePool (DmgFileInfo);
-        DmgDir->Close (DmgDir);
-        return NULL;
-      }
+      return NULL;
+    }
 
-      Status = OcGetFileSize (DmgFile, &DmgFileSize);
-      if (EFI_ERROR (Status)) {
-        DEBUG ((
-          DEBUG_INFO,
-          "OCB: Failed to retrieve DMG file size - %r\n",
-          Status
-          ));
-
-        FreePool (DmgFileInfo);
-        DmgDir->Close (DmgDir);
-        DmgFile->Close (DmgFile);
-        return NULL;
+    DmgFileInfo = InternalFindFirstDmgFileName (DmgDir, &DmgFileNameLen);
+    if (DmgFileInfo == NULL) {
+      DevPathText = ConvertDevicePathToText (Context->DevicePath, FALSE, FALSE);
+      DEBUG ((DEBUG_INFO, "OCB: Unable to find any DMG at %s\n"));
+      if (DevPathText != NULL) {
+        FreePool (DevPathText);
       }
-    }
 
-    Context->DmgContext = AllocatePool (sizeof (*Context->DmgContext));
-    if (Context->DmgContext == NULL) {
-      DEBUG ((DEBUG_INFO, "OCB: Failed to allocate DMG context\n"));
+      DmgDir->Close (DmgDir);
       return NULL;
     }
 
-    Result = OcAppleDiskImageInitializeFromFile (Context->DmgContext, DmgFile);
-
-    DmgFile->Close (DmgFile);
+    Status = OcSafeFileOpen (
+               DmgDir,
+               &DmgFile,
+               DmgFileInfo->FileName,
+               EFI_FILE_MODE_READ,
+               0
+               );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((
+        DEBUG_INFO,
+        "OCB: Failed to open DMG file %s - %r\n",
+        DmgFileInfo->FileName,
+        Status
+        ));
 
-    if (!Result) {
-      DEBUG ((DEBUG_INFO, "OCB: Failed to initialise DMG from file\n"));
+      FreePool (DmgFileInfo);
+      DmgDir->Close (DmgDir);
+      return NULL;
+    }
 
-      if (DmgPreloadContext->DmgFile == NULL) {
-        FreePool (DmgFileInfo);
-        DmgDir->Close (DmgDir);
-      }
+    Status = OcGetFileSize (DmgFile, &DmgFileSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((
+        DEBUG_INFO,
+        "OCB: Failed to retrieve DMG file size - %r\n",
+        Status
+        ));
 
-      FreePool (Context->DmgContext);
+      FreePool (DmgFileInfo);
+      DmgDir->Close (DmgDir);
+      DmgFile->Close (DmgFile);
       return NULL;
     }
-  }
 
-  ChunklistBuffer   = NULL;
-  ChunklistFileSize = 0;
-  if (  (DmgPreloadContext->DmgFile != NULL)
-     || (DmgPreloadContext->DmgContext != NULL))
-  {
-    if (DmgPreloadContext->ChunklistBuffer != NULL) {
-      ChunklistBuffer   = DmgPreloadContext->ChunklistBuffer;
-      ChunklistFileSize = DmgPreloadContext->ChunklistFileSize;
-    }
-  } else {
+    //
+    // Chunklist is read before the DMG itself to verify the DMG while loading.
+    //
     ChunklistFileInfo = InternalFindDmgChunklist (
                           DmgDir,
                           DmgFileInfo->FileName,
@@ -483,22 +463,82 @@ InternalLoadDmg (
 
       FreePool (ChunklistFileInfo);
     }
-  }
 
-  if (  (DmgPreloadContext->DmgFile == NULL)
-     && (DmgPreloadContext->DmgContext == NULL))
-  {
     FreePool (DmgFileInfo);
     DmgDir->Close (DmgDir);
   }
 
-  DevPath = InternalGetDiskImageBootFile (
-              Context,
-              DmgLoading,
-              DmgFileSize,
-              ChunklistBuffer,
-              ChunklistFileSize
-              );
+  if (  (DmgPreloadContext->DmgFile != NULL)
+     || (DmgPreloadContext->DmgContext != NULL))
+  {
+    if (DmgPreloadContext->ChunklistBuffer != NULL) {
+      ChunklistBuffer   = DmgPreloadContext->ChunklistBuffer;
+      ChunklistFileSize = DmgPreloadContext->ChunklistFileSize;
+    }
+  }
+
+  //
+  // Chunklist context references ChunklistBuffer, which must stay allocated
+  // until DMG data is verified.
+  //
+  Result = InternalInitializeDmgChunklist (
+             &ChunklistContext,
+             DmgLoading,
+             ChunklistBuffer,
+             ChunklistFileSize
+             );
+
+  if (DmgFile != NULL) {
+    if (Result) {
+      Context->DmgContext = AllocatePool (sizeof (*Context->DmgContext));
+      if (Context->DmgContext == NULL) {
+        DEBUG ((DEBUG_INFO, "OCB: Failed to allocate DMG context\n"));
+        Result = FALSE;
+      }
+    }
+
+    if (Result) {
+      Result = OcAppleDiskImageInitializeFromFile (
+                 Context->DmgContext,
+                 DmgFile,
+                 DmgLoading == OcDmgLoadingAppleSigned ? &ChunklistContext : NULL
+                 );
+      if (!Result) {
+        DEBUG ((DEBUG_INFO, "OCB: Failed to initialise DMG from file\n"));
+        FreePool (Context->DmgContext);
+      }
+    }
+
+    DmgFile->Close (DmgFile);
+
+    if (!Result) {
+      if (ChunklistBuffer != NULL) {
+        FreePool (ChunklistBuffer);
+      }
+
+      return NULL;
+    }
+  } else if (Result && (DmgLoading == OcDmgLoadingAppleSigned)) {
+    //
+    // Preloaded DMG data is verified in place.
+    //
+    Result = OcAppleDiskImageVerifyData (
+               Context->DmgContext,
+               &ChunklistContext
+               );
+    if (!Result) {
+      DEBUG ((DEBUG_WARN, "OCB: DMG has been altered\n"));
+    }
+  }
+
+  DevPath = NULL;
+  if (Result) {
+    DevPath = InternalGetDiskImageBootFile (
+                Context,
+                DmgFileSize
+                );
+  }
+
   Context->DevicePath = DevPath;
 
   if (DevPath != NULL) {
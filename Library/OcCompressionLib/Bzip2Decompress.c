@@ -0,0 +1,635 @@
+/** @file
+  BZIP2 decompressor for DMG chunks.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+#define BZIP2_BLOCK_MAGIC_HI    0x314159U
+#define BZIP2_BLOCK_MAGIC_LO    0x265359U
+#define BZIP2_STREAM_MAGIC_HI   0x177245U
+#define BZIP2_STREAM_MAGIC_LO   0x385090U
+#define BZIP2_BLOCK_SIZE_UNIT   100000U
+#define BZIP2_MAX_GROUPS        6U
+#define BZIP2_MIN_GROUPS        2U
+#define BZIP2_GROUP_SIZE        50U
+#define BZIP2_MAX_ALPHA_SIZE    258U
+#define BZIP2_MAX_CODE_LEN      20U
+#define BZIP2_MAX_SELECTORS     18002U
+#define BZIP2_RUNA              0U
+#define BZIP2_RUNB              1U
+#define BZIP2_MAX_RUN           (2U * 1024U * 1024U)
+
+typedef struct {
+  CONST UINT8  *Src;
+  CONST UINT8  *SrcEnd;
+  UINT64       BitBuffer;
+  UINT32       BitCount;
+  BOOLEAN      Overrun;
+} BZIP2_BIT_READER;
+
+typedef struct {
+  INT32   Limit[BZIP2_MAX_CODE_LEN + 2];
+  INT32   Base[BZIP2_MAX_CODE_LEN + 2];
+  UINT16  Perm[BZIP2_MAX_ALPHA_SIZE];
+  UINT8   MinLen;
+} BZIP2_HUFFMAN_TABLE;
+
+typedef struct {
+  BZIP2_HUFFMAN_TABLE  Tables[BZIP2_MAX_GROUPS];
+  UINT8                Selectors[BZIP2_MAX_SELECTORS];
+  UINT8                Lengths[BZIP2_MAX_ALPHA_SIZE];
+  UINT8                SeqToUnseq[256];
+  UINT8                Mtf[256];
+  UINT32               CharCount[256];
+  UINT32               *Tt;
+  UINT32               TtSize;
+  UINT32               BlockCrc;
+} BZIP2_DECODER;
+
+STATIC UINT32   mBzip2CrcTable[256];
+STATIC BOOLEAN  mBzip2CrcTableReady;
+
+/**
+  Initialise non-reflected CRC32 table used by BZIP2.
+**/
+STATIC
+VOID
+Bzip2InitCrcTable (
+  VOID
+  )
+{
+  UINT32  Index;
+  UINT32  Bit;
+  UINT32  Crc;
+
+  if (mBzip2CrcTableReady) {
+    return;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mBzip2CrcTable); ++Index) {
+    Crc = Index << 24U;
+    for (Bit = 0; Bit < 8; ++Bit) {
+      Crc = (Crc & BIT31) != 0 ? (Crc << 1U) ^ 0x04C11DB7U : Crc << 1U;
+    }
+
+    mBzip2CrcTable[Index] = Crc;
+  }
+
+  mBzip2CrcTableReady = TRUE;
+}
+
+/**
+  Read up to 24 bits from the MSB-first bit stream.
+  Reading past the end of the stream sets Overrun and returns 0.
+**/
+STATIC
+UINT32
+Bzip2ReadBits (
+  IN OUT BZIP2_BIT_READER  *Reader,
+  IN     UINT32            Count
+  )
+{
+  UINT32  Value;
+
+  ASSERT (Count <= 24);
+
+  while (Reader->BitCount < Count) {
+    if (Reader->Src == Reader->SrcEnd) {
+      Reader->Overrun = TRUE;
+      return 0;
+    }
+
+    Reader->BitBuffer = (Reader->BitBuffer << 8U) | *Reader->Src++;
+    Reader->BitCount += 8;
+  }
+
+  Reader->BitCount -= Count;
+  Value             = (UINT32)(Reader->BitBuffer >> Reader->BitCount) & ((1U << Count) - 1);
+
+  return Value;
+}
+
+/**
+  Build canonical Huffman decoding table from code lengths.
+**/
+STATIC
+VOID
+Bzip2CreateTable (
+  OUT BZIP2_HUFFMAN_TABLE  *Table,
+  IN  CONST UINT8          *Lengths,
+  IN  UINT32               AlphaSize
+  )
+{
+  UINT32  Index;
+  UINT32  Symbol;
+  UINT32  PermIndex;
+  UINT8   MinLen;
+  UINT8   MaxLen;
+  INT32   Vector;
+
+  MinLen = BZIP2_MAX_CODE_LEN;
+  MaxLen = 0;
+  for (Symbol = 0; Symbol < AlphaSize; ++Symbol) {
+    MinLen = MIN (MinLen, Lengths[Symbol]);
+    MaxLen = MAX (MaxLen, Lengths[Symbol]);
+  }
+
+  PermIndex = 0;
+  for (Index = MinLen; Index <= MaxLen; ++Index) {
+    for (Symbol = 0; Symbol < AlphaSize; ++Symbol) {
+      if (Lengths[Symbol] == Index) {
+        Table->Perm[PermIndex++] = (UINT16)Symbol;
+      }
+    }
+  }
+
+  ZeroMem (Table->Base, sizeof (Table->Base));
+  for (Symbol = 0; Symbol < AlphaSize; ++Symbol) {
+    ++Table->Base[Lengths[Symbol] + 1];
+  }
+
+  for (Index = 1; Index < ARRAY_SIZE (Table->Base); ++Index) {
+    Table->Base[Index] += Table->Base[Index - 1];
+  }
+
+  //
+  // Limit is left at -1 for unused lengths, so they never match.
+  //
+  SetMem (Table->Limit, sizeof (Table->Limit), 0xFF);
+  Vector = 0;
+  for (Index = MinLen; Index <= MaxLen; ++Index) {
+    Vector            += Table->Base[Index + 1] - Table->Base[Index];
+    Table->Limit[Index] = Vector - 1;
+    Vector           <<= 1;
+  }
+
+  for (Index = MinLen + 1U; Index <= MaxLen; ++Index) {
+    Table->Base[Index] = ((Table->Limit[Index - 1] + 1) << 1) - Table->Base[Index];
+  }
+
+  Table->MinLen = MinLen;
+}
+
+/**
+  Decode next Huffman symbol, returns MAX_UINT32 on error.
+**/
+STATIC
+UINT32
+Bzip2DecodeSymbol (
+  IN OUT BZIP2_BIT_READER     *Reader,
+  IN     BZIP2_HUFFMAN_TABLE  *Table,
+  IN     UINT32               AlphaSize
+  )
+{
+  UINT32  Length;
+  INT32   Code;
+
+  Length = Table->MinLen;
+  Code   = (INT32)Bzip2ReadBits (Reader, Length);
+
+  while (Length <= BZIP2_MAX_CODE_LEN && Code > Table->Limit[Length]) {
+    ++Length;
+    Code = (Code << 1) | (INT32)Bzip2ReadBits (Reader, 1);
+  }
+
+  if (  Reader->Overrun
+     || (Length > BZIP2_MAX_CODE_LEN)
+     || (Code - Table->Base[Length] < 0)
+     || ((UINT32)(Code - Table->Base[Length]) >= AlphaSize))
+  {
+    return MAX_UINT32;
+  }
+
+  return Table->Perm[Code - Table->Base[Length]];
+}
+
+/**
+  Decode single BZIP2 block into Dst.
+
+  @param[in,out]  Reader      Bit reader positioned after block magic.
+  @param[in,out]  Decoder     Decoder state with allocated Tt.
+  @param[in]      BlockSize   Maximum block size from stream header.
+  @param[out]     Dst         Destination buffer.
+  @param[in]      DstLen      Remaining destination buffer size.
+  @param[out]     Written     Number of bytes written.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+Bzip2DecodeBlock (
+  IN OUT BZIP2_BIT_READER  *Reader,
+  IN OUT BZIP2_DECODER     *Decoder,
+  IN     UINT32            BlockSize,
+  OUT    UINT8             *Dst,
+  IN     UINTN             DstLen,
+  OUT    UINTN             *Written
+  )
+{
+  UINT32               Crc;
+  UINT32               OrigPtr;
+  UINT32               InUse16;
+  UINT32               InUse;
+  UINT32               InUseCount;
+  UINT32               AlphaSize;
+  UINT32               GroupCount;
+  UINT32               SelectorCount;
+  UINT32               Index;
+  UINT32               Index2;
+  UINT32               Group;
+  UINT32               GroupPos;
+  UINT32               GroupIndex;
+  UINT32               Length;
+  UINT32               Symbol;
+  UINT32               RunLength;
+  UINT32               RunWeight;
+  UINT32               BlockLength;
+  UINT32               Sum;
+  UINT32               Position;
+  UINT8                Value;
+  UINT8                SelectorMtf[BZIP2_MAX_GROUPS];
+  UINT8                LastByte;
+  UINT32               RepeatCount;
+  UINTN                DstPos;
+  BZIP2_HUFFMAN_TABLE  *Table;
+
+  Decoder->BlockCrc  = Bzip2ReadBits (Reader, 16) << 16U;
+  Decoder->BlockCrc |= Bzip2ReadBits (Reader, 16);
+
+  //
+  // Randomised blocks were deprecated in bzip2 0.9.5 and are not produced by hdiutil.
+  //
+  if (Bzip2ReadBits (Reader, 1) != 0) {
+    return FALSE;
+  }
+
+  OrigPtr = Bzip2ReadBits (Reader, 24);
+
+  //
+  // Symbol map is stored as 16 ranges of 16 bytes each.
+  //
+  InUseCount = 0;
+  InUse16    = Bzip2ReadBits (Reader, 16);
+  for (Index = 0; Index < 16; ++Index) {
+    if ((InUse16 & (BIT15 >> Index)) == 0) {
+      continue;
+    }
+
+    InUse = Bzip2ReadBits (Reader, 16);
+    for (Index2 = 0; Index2 < 16; ++Index2) {
+      if ((InUse & (BIT15 >> Index2)) != 0) {
+        Decoder->SeqToUnseq[InUseCount++] = (UINT8)(Index * 16 + Index2);
+      }
+    }
+  }
+
+  if (Reader->Overrun || (InUseCount == 0)) {
+    return FALSE;
+  }
+
+  AlphaSize = InUseCount + 2;
+
+  GroupCount = Bzip2ReadBits (Reader, 3);
+  if ((GroupCount < BZIP2_MIN_GROUPS) || (GroupCount > BZIP2_MAX_GROUPS)) {
+    return FALSE;
+  }
+
+  //
+  // Selectors are MTF coded in unary. Some encoders emit more selectors
+  // than allowed, the excess ones are never used and are ignored.
+  //
+  SelectorCount = Bzip2ReadBits (Reader, 15);
+  if (SelectorCount == 0) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < GroupCount; ++Index) {
+    SelectorMtf[Index] = (UINT8)Index;
+  }
+
+  for (Index = 0; Index < SelectorCount; ++Index) {
+    Group = 0;
+    while (Bzip2ReadBits (Reader, 1) != 0) {
+      ++Group;
+      if (Group >= GroupCount) {
+        return FALSE;
+      }
+    }
+
+    if (Reader->Overrun) {
+      return FALSE;
+    }
+
+    if (Index < BZIP2_MAX_SELECTORS) {
+      Value = SelectorMtf[Group];
+      while (Group > 0) {
+        SelectorMtf[Group] = SelectorMtf[Group - 1];
+        --Group;
+      }
+
+      SelectorMtf[0]             = Value;
+      Decoder->Selectors[Index] = Value;
+    }
+  }
+
+  SelectorCount = MIN (SelectorCount, BZIP2_MAX_SELECTORS);
+
+  //
+  // Code lengths are delta coded per group.
+  //
+  for (Group = 0; Group < GroupCount; ++Group) {
+    Length = Bzip2ReadBits (Reader, 5);
+    for (Symbol = 0; Symbol < AlphaSize; ++Symbol) {
+      while (TRUE) {
+        if ((Length < 1) || (Length > BZIP2_MAX_CODE_LEN) || Reader->Overrun) {
+          return FALSE;
+        }
+
+        if (Bzip2ReadBits (Reader, 1) == 0) {
+          break;
+        }
+
+        if (Bzip2ReadBits (Reader, 1) == 0) {
+          ++Length;
+        } else {
+          --Length;
+        }
+      }
+
+      Decoder->Lengths[Symbol] = (UINT8)Length;
+    }
+
+    Bzip2CreateTable (&Decoder->Tables[Group], Decoder->Lengths, AlphaSize);
+  }
+
+  //
+  // Decode Huffman coded MTF values with RUNA/RUNB zero runs into Tt.
+  //
+  for (Index = 0; Index < ARRAY_SIZE (Decoder->Mtf); ++Index) {
+    Decoder->Mtf[Index] = (UINT8)Index;
+  }
+
+  ZeroMem (Decoder->CharCount, sizeof (Decoder->CharCount));
+
+  BlockLength = 0;
+  GroupIndex  = 0;
+  GroupPos    = 0;
+  Table       = NULL;
+  RunLength   = 0;
+  RunWeight   = 1;
+
+  while (TRUE) {
+    if (GroupPos == 0) {
+      if (GroupIndex >= SelectorCount) {
+        return FALSE;
+      }
+
+      Table    = &Decoder->Tables[Decoder->Selectors[GroupIndex++]];
+      GroupPos = BZIP2_GROUP_SIZE;
+    }
+
+    --GroupPos;
+
+    Symbol = Bzip2DecodeSymbol (Reader, Table, AlphaSize);
+    if (Symbol == MAX_UINT32) {
+      return FALSE;
+    }
+
+    if ((Symbol == BZIP2_RUNA) || (Symbol == BZIP2_RUNB)) {
+      if (RunWeight >= BZIP2_MAX_RUN) {
+        return FALSE;
+      }
+
+      RunLength += RunWeight << Symbol;
+      RunWeight <<= 1;
+      continue;
+    }
+
+    if (RunLength > 0) {
+      if (RunLength > BlockSize - BlockLength) {
+        return FALSE;
+      }
+
+      Value                       = Decoder->SeqToUnseq[Decoder->Mtf[0]];
+      Decoder->CharCount[Value] += RunLength;
+      while (RunLength > 0) {
+        Decoder->Tt[BlockLength++] = Value;
+        --RunLength;
+      }
+
+      RunWeight = 1;
+    }
+
+    if (Symbol == AlphaSize - 1) {
+      break;
+    }
+
+    if (BlockLength >= BlockSize) {
+      return FALSE;
+    }
+
+    Index = Symbol - 1;
+    Value = Decoder->Mtf[Index];
+    CopyMem (&Decoder->Mtf[1], &Decoder->Mtf[0], Index);
+    Decoder->Mtf[0] = Value;
+
+    Value = Decoder->SeqToUnseq[Value];
+    ++Decoder->CharCount[Value];
+    Decoder->Tt[BlockLength++] = Value;
+  }
+
+  if (OrigPtr >= BlockLength) {
+    return FALSE;
+  }
+
+  //
+  // Inverse Burrows-Wheeler transform, storing next positions in upper Tt bits.
+  //
+  Sum = 0;
+  for (Index = 0; Index < ARRAY_SIZE (Decoder->CharCount); ++Index) {
+    Length                    = Decoder->CharCount[Index];
+    Decoder->CharCount[Index] = Sum;
+    Sum                      += Length;
+  }
+
+  for (Index = 0; Index < BlockLength; ++Index) {
+    Value                                        = (UINT8)Decoder->Tt[Index];
+    Decoder->Tt[Decoder->CharCount[Value]++] |= Index << 8U;
+  }
+
+  //
+  // Undo initial run length encoding, where 4 equal bytes are followed by repeat count.
+  //
+  Crc         = MAX_UINT32;
+  DstPos      = 0;
+  LastByte    = 0;
+  RepeatCount = 0;
+  Position    = Decoder->Tt[OrigPtr] >> 8U;
+
+  for (Index = 0; Index < BlockLength; ++Index) {
+    Position = Decoder->Tt[Position];
+    Value    = (UINT8)Position;
+    Position >>= 8U;
+
+    if (RepeatCount == 4) {
+      if (Value > DstLen - DstPos) {
+        return FALSE;
+      }
+
+      while (Value > 0) {
+        Crc           = (Crc << 8U) ^ mBzip2CrcTable[(Crc >> 24U) ^ LastByte];
+        Dst[DstPos++] = LastByte;
+        --Value;
+      }
+
+      RepeatCount = 0;
+      continue;
+    }
+
+    if (DstPos == DstLen) {
+      return FALSE;
+    }
+
+    if ((RepeatCount == 0) || (Value != LastByte)) {
+      RepeatCount = 1;
+      LastByte    = Value;
+    } else {
+      ++RepeatCount;
+    }
+
+    Crc           = (Crc << 8U) ^ mBzip2CrcTable[(Crc >> 24U) ^ Value];
+    Dst[DstPos++] = Value;
+  }
+
+  if (~Crc != Decoder->BlockCrc) {
+    return FALSE;
+  }
+
+  *Written = DstPos;
+  return TRUE;
+}
+
+UINTN
+DecompressBZIP2 (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  BZIP2_BIT_READER  Reader;
+  BZIP2_DECODER     *Decoder;
+  UINT32            BlockSize;
+  UINT32            MagicHi;
+  UINT32            MagicLo;
+  UINT32            StreamCrc;
+  UINT32            CombinedCrc;
+  UINTN             DstPos;
+  UINTN             Written;
+  BOOLEAN           Result;
+
+  if ((DstLen > OC_COMPRESSION_MAX_LENGTH) || (SrcLen > OC_COMPRESSION_MAX_LENGTH)) {
+    return 0;
+  }
+
+  Bzip2InitCrcTable ();
+
+  Decoder = AllocateZeroPool (sizeof (*Decoder));
+  if (Decoder == NULL) {
+    return 0;
+  }
+
+  ZeroMem (&Reader, sizeof (Reader));
+  Reader.Src    = Src;
+  Reader.SrcEnd = Src + SrcLen;
+
+  DstPos = 0;
+  Result = FALSE;
+
+  //
+  // Multiple streams may be concatenated, e.g. by parallel compressors.
+  //
+  do {
+    if (  (Reader.SrcEnd - Reader.Src < 4)
+       || (Reader.Src[0] != 'B')
+       || (Reader.Src[1] != 'Z')
+       || (Reader.Src[2] != 'h')
+       || (Reader.Src[3] < '1')
+       || (Reader.Src[3] > '9'))
+    {
+      break;
+    }
+
+    BlockSize   = (Reader.Src[3] - '0') * BZIP2_BLOCK_SIZE_UNIT;
+    Reader.Src += 4;
+
+    if (Decoder->TtSize < BlockSize) {
+      if (Decoder->Tt != NULL) {
+        FreePool (Decoder->Tt);
+      }
+
+      Decoder->Tt = AllocatePool (BlockSize * sizeof (*Decoder->Tt));
+      if (Decoder->Tt == NULL) {
+        Decoder->TtSize = 0;
+        break;
+      }
+
+      Decoder->TtSize = BlockSize;
+    }
+
+    CombinedCrc = 0;
+    Result      = FALSE;
+
+    while (TRUE) {
+      MagicHi = Bzip2ReadBits (&Reader, 24);
+      MagicLo = Bzip2ReadBits (&Reader, 24);
+      if (Reader.Overrun) {
+        break;
+      }
+
+      if ((MagicHi == BZIP2_STREAM_MAGIC_HI) && (MagicLo == BZIP2_STREAM_MAGIC_LO)) {
+        StreamCrc  = Bzip2ReadBits (&Reader, 16) << 16U;
+        StreamCrc |= Bzip2ReadBits (&Reader, 16);
+        Result     = !Reader.Overrun && StreamCrc == CombinedCrc;
+        break;
+      }
+
+      if ((MagicHi != BZIP2_BLOCK_MAGIC_HI) || (MagicLo != BZIP2_BLOCK_MAGIC_LO)) {
+        break;
+      }
+
+      if (!Bzip2DecodeBlock (&Reader, Decoder, BlockSize, &Dst[DstPos], DstLen - DstPos, &Written)) {
+        break;
+      }
+
+      CombinedCrc = ((CombinedCrc << 1U) | (CombinedCrc >> 31U)) ^ Decoder->BlockCrc;
+      DstPos     += Written;
+    }
+
+    //
+    // Streams are byte aligned.
+    //
+    Reader.BitCount = 0;
+  } while (Result && (Reader.Src < Reader.SrcEnd));
+
+  if (Decoder->Tt != NULL) {
+    FreePool (Decoder->Tt);
+  }
+
+  FreePool (Decoder);
+
+  return Result ? DstPos : 0;
+}
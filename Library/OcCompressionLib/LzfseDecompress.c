@@ -0,0 +1,734 @@
+/** @file
+  LZFSE decompressor for DMG chunks.
+
+  Ported from lzfse_decode_base.c and lzfse_fse.c of the LZFSE
+  reference implementation.
+
+  Copyright (c) 2015-2016, Apple Inc. All rights reserved.
+  Copyright (C) 2026, agent. All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+  1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+  2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+      in the documentation and/or other materials provided with the distribution.
+
+  3.  Neither the name of the copyright holder(s) nor the names of any contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+//
+// Block magic values, 'bvx-', 'bvx1', 'bvx2', 'bvxn', 'bvx$'.
+//
+#define LZFSE_UNCOMPRESSED_BLOCK_MAGIC    0x2D787662U
+#define LZFSE_COMPRESSEDV1_BLOCK_MAGIC    0x31787662U
+#define LZFSE_COMPRESSEDV2_BLOCK_MAGIC    0x32787662U
+#define LZFSE_COMPRESSEDLZVN_BLOCK_MAGIC  0x6E787662U
+#define LZFSE_ENDOFSTREAM_BLOCK_MAGIC     0x24787662U
+
+#define LZFSE_ENCODE_L_SYMBOLS        20U
+#define LZFSE_ENCODE_M_SYMBOLS        20U
+#define LZFSE_ENCODE_D_SYMBOLS        64U
+#define LZFSE_ENCODE_LITERAL_SYMBOLS  256U
+#define LZFSE_ENCODE_L_STATES         64U
+#define LZFSE_ENCODE_M_STATES         64U
+#define LZFSE_ENCODE_D_STATES         256U
+#define LZFSE_ENCODE_LITERAL_STATES   1024U
+#define LZFSE_MATCHES_PER_BLOCK       10000U
+#define LZFSE_LITERALS_PER_BLOCK      (4U * LZFSE_MATCHES_PER_BLOCK)
+
+#define LZFSE_FREQ_COUNT  (LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS \
+                           + LZFSE_ENCODE_D_SYMBOLS + LZFSE_ENCODE_LITERAL_SYMBOLS)
+
+//
+// Fixed part of V2 block header: magic, raw size and three packed fields.
+//
+#define LZFSE_V2_HEADER_SIZE  (2U * sizeof (UINT32) + 3U * sizeof (UINT64))
+
+typedef struct {
+  UINT8    Symbol;
+  UINT8    Bits;
+  INT16    Delta;
+} LZFSE_DECODER_ENTRY;
+
+typedef struct {
+  UINT8    TotalBits;
+  UINT8    ValueBits;
+  INT16    Delta;
+  INT32    ValueBase;
+} LZFSE_VALUE_DECODER_ENTRY;
+
+typedef struct {
+  UINT64    Accum;
+  INT32     AccumBits;
+} LZFSE_IN_STREAM;
+
+typedef struct {
+  UINT32                       LiteralCount;
+  UINT32                       MatchCount;
+  UINT32                       LiteralPayloadSize;
+  UINT32                       LmdPayloadSize;
+  UINT32                       HeaderSize;
+  INT32                        LiteralBits;
+  INT32                        LmdBits;
+  UINT16                       LiteralState[4];
+  UINT16                       LState;
+  UINT16                       MState;
+  UINT16                       DState;
+  UINT16                       Freq[LZFSE_FREQ_COUNT];
+  LZFSE_DECODER_ENTRY          LiteralTable[LZFSE_ENCODE_LITERAL_STATES];
+  LZFSE_VALUE_DECODER_ENTRY    LTable[LZFSE_ENCODE_L_STATES];
+  LZFSE_VALUE_DECODER_ENTRY    MTable[LZFSE_ENCODE_M_STATES];
+  LZFSE_VALUE_DECODER_ENTRY    DTable[LZFSE_ENCODE_D_STATES];
+  UINT8                        Literals[LZFSE_LITERALS_PER_BLOCK + 4];
+} LZFSE_BLOCK_DECODER;
+
+STATIC CONST UINT8  mLzfseLExtraBits[LZFSE_ENCODE_L_SYMBOLS] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 5, 8
+};
+
+STATIC CONST INT32  mLzfseLBaseValue[LZFSE_ENCODE_L_SYMBOLS] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20, 28, 60
+};
+
+STATIC CONST UINT8  mLzfseMExtraBits[LZFSE_ENCODE_M_SYMBOLS] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 5, 8, 11
+};
+
+STATIC CONST INT32  mLzfseMBaseValue[LZFSE_ENCODE_M_SYMBOLS] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 24, 56, 312
+};
+
+STATIC CONST UINT8  mLzfseDExtraBits[LZFSE_ENCODE_D_SYMBOLS] = {
+  0,  0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,
+  4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,
+  8,  8,  8,  8,  9,  9,  9,  9,  10, 10, 10, 10, 11, 11, 11, 11,
+  12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+};
+
+STATIC CONST INT32  mLzfseDBaseValue[LZFSE_ENCODE_D_SYMBOLS] = {
+  0,      1,      2,      3,     4,     6,     8,     10,    12,    16,
+  20,     24,     28,     36,    44,    52,    60,    76,    92,    108,
+  124,    156,    188,    220,   252,   316,   380,   444,   508,   636,
+  764,    892,    1020,   1276,  1532,  1788,  2044,  2556,  3068,  3580,
+  4092,   5116,   6140,   7164,  8188,  10236, 12284, 14332, 16380, 20476,
+  24572,  28668,  32764,  40956, 49148, 57340, 65532, 81916, 98300, 114684,
+  131068, 163836, 196604, 229372
+};
+
+/**
+  Extract bit field from packed V2 header value.
+**/
+STATIC
+UINT32
+LzfseGetField (
+  IN UINT64  Value,
+  IN UINT32  Offset,
+  IN UINT32  Bits
+  )
+{
+  return (UINT32)((Value >> Offset) & ((1ULL << Bits) - 1));
+}
+
+/**
+  Decode V2 header frequency value, variable-length coded in 2 to 14 bits.
+**/
+STATIC
+UINT32
+LzfseDecodeFreqValue (
+  IN  UINT32  Bits,
+  OUT UINT32  *BitCount
+  )
+{
+  STATIC CONST UINT8  mFreqBitCount[32] = {
+    2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14,
+    2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14
+  };
+  STATIC CONST UINT8  mFreqValue[32] = {
+    0, 2, 1, 4, 0, 3, 1, 0, 0, 2, 1, 5, 0, 3, 1, 0,
+    0, 2, 1, 6, 0, 3, 1, 0, 0, 2, 1, 7, 0, 3, 1, 0
+  };
+
+  *BitCount = mFreqBitCount[Bits & 0x1FU];
+
+  if (*BitCount == 8) {
+    return 8 + ((Bits >> 4U) & 0xFU);
+  }
+
+  if (*BitCount == 14) {
+    return 24 + ((Bits >> 4U) & 0x3FFU);
+  }
+
+  return mFreqValue[Bits & 0x1FU];
+}
+
+/**
+  Decode V2 block header into decoder state.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+LzfseDecodeV2Header (
+  OUT LZFSE_BLOCK_DECODER  *Decoder,
+  IN  CONST UINT8          *Src,
+  IN  UINTN                SrcLen
+  )
+{
+  UINT64       Fields[3];
+  CONST UINT8  *FreqSrc;
+  CONST UINT8  *FreqEnd;
+  UINT32       Accum;
+  UINT32       AccumBits;
+  UINT32       BitCount;
+  UINT32       Index;
+
+  if (SrcLen < LZFSE_V2_HEADER_SIZE) {
+    return FALSE;
+  }
+
+  CopyMem (Fields, &Src[2 * sizeof (UINT32)], sizeof (Fields));
+
+  Decoder->LiteralCount       = LzfseGetField (Fields[0], 0, 20);
+  Decoder->LiteralPayloadSize = LzfseGetField (Fields[0], 20, 20);
+  Decoder->MatchCount         = LzfseGetField (Fields[0], 40, 20);
+  Decoder->LiteralBits        = (INT32)LzfseGetField (Fields[0], 60, 3) - 7;
+  Decoder->LiteralState[0]    = (UINT16)LzfseGetField (Fields[1], 0, 10);
+  Decoder->LiteralState[1]    = (UINT16)LzfseGetField (Fields[1], 10, 10);
+  Decoder->LiteralState[2]    = (UINT16)LzfseGetField (Fields[1], 20, 10);
+  Decoder->LiteralState[3]    = (UINT16)LzfseGetField (Fields[1], 30, 10);
+  Decoder->LmdPayloadSize     = LzfseGetField (Fields[1], 40, 20);
+  Decoder->LmdBits            = (INT32)LzfseGetField (Fields[1], 60, 3) - 7;
+  Decoder->HeaderSize         = LzfseGetField (Fields[2], 0, 32);
+  Decoder->LState             = (UINT16)LzfseGetField (Fields[2], 32, 10);
+  Decoder->MState             = (UINT16)LzfseGetField (Fields[2], 42, 10);
+  Decoder->DState             = (UINT16)LzfseGetField (Fields[2], 52, 10);
+
+  if (  (Decoder->HeaderSize < LZFSE_V2_HEADER_SIZE)
+     || (Decoder->HeaderSize > SrcLen)
+     || (Decoder->LiteralCount > LZFSE_LITERALS_PER_BLOCK)
+     || (Decoder->MatchCount > LZFSE_MATCHES_PER_BLOCK)
+     || (Decoder->LState >= LZFSE_ENCODE_L_STATES)
+     || (Decoder->MState >= LZFSE_ENCODE_M_STATES)
+     || (Decoder->DState >= LZFSE_ENCODE_D_STATES))
+  {
+    return FALSE;
+  }
+
+  ZeroMem (Decoder->Freq, sizeof (Decoder->Freq));
+
+  FreqSrc = &Src[LZFSE_V2_HEADER_SIZE];
+  FreqEnd = &Src[Decoder->HeaderSize];
+
+  //
+  // Frequency tables may be omitted.
+  //
+  if (FreqSrc == FreqEnd) {
+    return TRUE;
+  }
+
+  Accum     = 0;
+  AccumBits = 0;
+  for (Index = 0; Index < ARRAY_SIZE (Decoder->Freq); ++Index) {
+    while (FreqSrc < FreqEnd && AccumBits + 8 <= 32) {
+      Accum     |= (UINT32)*FreqSrc << AccumBits;
+      AccumBits += 8;
+      ++FreqSrc;
+    }
+
+    Decoder->Freq[Index] = (UINT16)LzfseDecodeFreqValue (Accum, &BitCount);
+    if (BitCount > AccumBits) {
+      return FALSE;
+    }
+
+    Accum    >>= BitCount;
+    AccumBits -= BitCount;
+  }
+
+  return AccumBits < 8 && FreqSrc == FreqEnd;
+}
+
+/**
+  Check frequencies do not exceed state count.
+**/
+STATIC
+BOOLEAN
+LzfseCheckFreq (
+  IN CONST UINT16  *Freq,
+  IN UINT32        SymbolCount,
+  IN UINT32        StateCount
+  )
+{
+  UINT32  Index;
+  UINT32  Sum;
+
+  Sum = 0;
+  for (Index = 0; Index < SymbolCount; ++Index) {
+    Sum += Freq[Index];
+  }
+
+  return Sum <= StateCount;
+}
+
+/**
+  Initialise FSE literal decoding table. Frequencies must be checked.
+**/
+STATIC
+VOID
+LzfseInitDecoderTable (
+  IN  UINT32               StateCount,
+  IN  UINT32               SymbolCount,
+  IN  CONST UINT16         *Freq,
+  OUT LZFSE_DECODER_ENTRY  *Table
+  )
+{
+  UINT32  Symbol;
+  UINT32  Index;
+  UINT32  Frequency;
+  INT32   Shift;
+  UINT32  Threshold;
+
+  ZeroMem (Table, StateCount * sizeof (*Table));
+
+  for (Symbol = 0; Symbol < SymbolCount; ++Symbol) {
+    Frequency = Freq[Symbol];
+    if (Frequency == 0) {
+      continue;
+    }
+
+    //
+    // Shift ensures StateCount <= (Frequency << Shift) < 2 * StateCount.
+    //
+    Shift     = (INT32)HighBitSet32 (StateCount) - HighBitSet32 (Frequency);
+    Threshold = ((2 * StateCount) >> Shift) - Frequency;
+
+    for (Index = 0; Index < Frequency; ++Index, ++Table) {
+      Table->Symbol = (UINT8)Symbol;
+      if (Index < Threshold) {
+        Table->Bits  = (UINT8)Shift;
+        Table->Delta = (INT16)(((Frequency + Index) << Shift) - StateCount);
+      } else {
+        Table->Bits  = (UINT8)(Shift - 1);
+        Table->Delta = (INT16)((Index - Threshold) << (Shift - 1));
+      }
+    }
+  }
+}
+
+/**
+  Initialise FSE value decoding table. Frequencies must be checked.
+**/
+STATIC
+VOID
+LzfseInitValueDecoderTable (
+  IN  UINT32                     StateCount,
+  IN  UINT32                     SymbolCount,
+  IN  CONST UINT16               *Freq,
+  IN  CONST UINT8                *ExtraBits,
+  IN  CONST INT32                *BaseValue,
+  OUT LZFSE_VALUE_DECODER_ENTRY  *Table
+  )
+{
+  UINT32  Symbol;
+  UINT32  Index;
+  UINT32  Frequency;
+  INT32   Shift;
+  UINT32  Threshold;
+
+  ZeroMem (Table, StateCount * sizeof (*Table));
+
+  for (Symbol = 0; Symbol < SymbolCount; ++Symbol) {
+    Frequency = Freq[Symbol];
+    if (Frequency == 0) {
+      continue;
+    }
+
+    Shift     = (INT32)HighBitSet32 (StateCount) - HighBitSet32 (Frequency);
+    Threshold = ((2 * StateCount) >> Shift) - Frequency;
+
+    for (Index = 0; Index < Frequency; ++Index, ++Table) {
+      Table->ValueBits = ExtraBits[Symbol];
+      Table->ValueBase = BaseValue[Symbol];
+      if (Index < Threshold) {
+        Table->TotalBits = (UINT8)(Shift + ExtraBits[Symbol]);
+        Table->Delta     = (INT16)(((Frequency + Index) << Shift) - StateCount);
+      } else {
+        Table->TotalBits = (UINT8)(Shift - 1 + ExtraBits[Symbol]);
+        Table->Delta     = (INT16)((Index - Threshold) << (Shift - 1));
+      }
+    }
+  }
+}
+
+/**
+  Initialise backward bit stream ending at *Buffer.
+  Bits in [-7, 0] is the number of unused bits in the last byte, negated.
+**/
+STATIC
+BOOLEAN
+LzfseInInit (
+  OUT    LZFSE_IN_STREAM  *Stream,
+  IN     INT32            Bits,
+  IN OUT CONST UINT8      **Buffer,
+  IN     CONST UINT8      *BufferStart
+  )
+{
+  if (Bits != 0) {
+    if ((UINTN)(*Buffer - BufferStart) < sizeof (UINT64)) {
+      return FALSE;
+    }
+
+    *Buffer          -= sizeof (UINT64);
+    Stream->Accum     = ReadUnaligned64 ((CONST UINT64 *)*Buffer);
+    Stream->AccumBits = Bits + 64;
+  } else {
+    if ((UINTN)(*Buffer - BufferStart) < sizeof (UINT64) - 1) {
+      return FALSE;
+    }
+
+    *Buffer      -= sizeof (UINT64) - 1;
+    Stream->Accum = 0;
+    CopyMem (&Stream->Accum, *Buffer, sizeof (UINT64) - 1);
+    Stream->AccumBits = 56;
+  }
+
+  return (Stream->AccumBits >= 56) && (Stream->AccumBits < 64)
+         && ((Stream->Accum >> Stream->AccumBits) == 0);
+}
+
+/**
+  Refill backward bit stream to at least 56 bits.
+**/
+STATIC
+BOOLEAN
+LzfseInFlush (
+  IN OUT LZFSE_IN_STREAM  *Stream,
+  IN OUT CONST UINT8      **Buffer,
+  IN     CONST UINT8      *BufferStart
+  )
+{
+  UINT32  Bits;
+  UINT64  Incoming;
+
+  Bits = (UINT32)(63 - Stream->AccumBits) & ~7U;
+  if (Bits == 0) {
+    return TRUE;
+  }
+
+  if ((UINTN)(*Buffer - BufferStart) < (Bits >> 3U)) {
+    return FALSE;
+  }
+
+  *Buffer          -= Bits >> 3U;
+  Incoming          = ReadUnaligned64 ((CONST UINT64 *)*Buffer);
+  Stream->Accum     = (Stream->Accum << Bits) | (Incoming & ((1ULL << Bits) - 1));
+  Stream->AccumBits += (INT32)Bits;
+
+  return TRUE;
+}
+
+/**
+  Pull Bits from backward bit stream, Bits must be available.
+**/
+STATIC
+UINT64
+LzfseInPull (
+  IN OUT LZFSE_IN_STREAM  *Stream,
+  IN     UINT32           Bits
+  )
+{
+  UINT64  Result;
+
+  Stream->AccumBits -= (INT32)Bits;
+  Result             = Stream->Accum >> Stream->AccumBits;
+  Stream->Accum     &= (1ULL << Stream->AccumBits) - 1;
+
+  return Result;
+}
+
+/**
+  Decode literal symbol and update state.
+**/
+STATIC
+UINT8
+LzfseDecode (
+  IN OUT UINT16                     *State,
+  IN     CONST LZFSE_DECODER_ENTRY  *Table,
+  IN OUT LZFSE_IN_STREAM            *Stream
+  )
+{
+  CONST LZFSE_DECODER_ENTRY  *Entry;
+
+  Entry  = &Table[*State];
+  *State = (UINT16)(Entry->Delta + LzfseInPull (Stream, Entry->Bits));
+
+  return Entry->Symbol;
+}
+
+/**
+  Decode L, M or D value and update state.
+**/
+STATIC
+UINT32
+LzfseDecodeValue (
+  IN OUT UINT16                           *State,
+  IN     CONST LZFSE_VALUE_DECODER_ENTRY  *Table,
+  IN OUT LZFSE_IN_STREAM                  *Stream
+  )
+{
+  CONST LZFSE_VALUE_DECODER_ENTRY  *Entry;
+  UINT64                           Bits;
+
+  Entry  = &Table[*State];
+  Bits   = LzfseInPull (Stream, Entry->TotalBits);
+  *State = (UINT16)(Entry->Delta + (Bits >> Entry->ValueBits));
+
+  return (UINT32)(Entry->ValueBase + (Bits & ((1ULL << Entry->ValueBits) - 1)));
+}
+
+/**
+  Decode V2 compressed block.
+
+  @param[in,out]  Decoder   Decoder state with decoded block header.
+  @param[in]      Payload   Block payload following the header.
+  @param[in]      DstBegin  Beginning of the output, matches may refer to previous blocks.
+  @param[in]      Dst       Block output.
+  @param[in]      DstLen    Block output size.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+LzfseDecodeV2Block (
+  IN OUT LZFSE_BLOCK_DECODER  *Decoder,
+  IN     CONST UINT8          *Payload,
+  IN     UINT8                *DstBegin,
+  IN     UINT8                *Dst,
+  IN     UINTN                DstLen
+  )
+{
+  LZFSE_IN_STREAM  Stream;
+  CONST UINT8      *Buffer;
+  CONST UINT8      *Literal;
+  CONST UINT8      *LiteralEnd;
+  UINT8            *DstEnd;
+  UINT16           *Freq;
+  UINT32           Index;
+  UINT32           LValue;
+  UINT32           MValue;
+  UINT32           DValue;
+  UINT32           Distance;
+
+  Freq = Decoder->Freq;
+  if (  !LzfseCheckFreq (Freq, LZFSE_ENCODE_L_SYMBOLS, LZFSE_ENCODE_L_STATES)
+     || !LzfseCheckFreq (Freq + LZFSE_ENCODE_L_SYMBOLS, LZFSE_ENCODE_M_SYMBOLS, LZFSE_ENCODE_M_STATES)
+     || !LzfseCheckFreq (Freq + LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS, LZFSE_ENCODE_D_SYMBOLS, LZFSE_ENCODE_D_STATES)
+     || !LzfseCheckFreq (Freq + LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS + LZFSE_ENCODE_D_SYMBOLS, LZFSE_ENCODE_LITERAL_SYMBOLS, LZFSE_ENCODE_LITERAL_STATES))
+  {
+    return FALSE;
+  }
+
+  LzfseInitValueDecoderTable (LZFSE_ENCODE_L_STATES, LZFSE_ENCODE_L_SYMBOLS, Freq, mLzfseLExtraBits, mLzfseLBaseValue, Decoder->LTable);
+  Freq += LZFSE_ENCODE_L_SYMBOLS;
+  LzfseInitValueDecoderTable (LZFSE_ENCODE_M_STATES, LZFSE_ENCODE_M_SYMBOLS, Freq, mLzfseMExtraBits, mLzfseMBaseValue, Decoder->MTable);
+  Freq += LZFSE_ENCODE_M_SYMBOLS;
+  LzfseInitValueDecoderTable (LZFSE_ENCODE_D_STATES, LZFSE_ENCODE_D_SYMBOLS, Freq, mLzfseDExtraBits, mLzfseDBaseValue, Decoder->DTable);
+  Freq += LZFSE_ENCODE_D_SYMBOLS;
+  LzfseInitDecoderTable (LZFSE_ENCODE_LITERAL_STATES, LZFSE_ENCODE_LITERAL_SYMBOLS, Freq, Decoder->LiteralTable);
+
+  //
+  // Literals are interleaved over four FSE states and read backwards.
+  // Each flush provides at least 56 bits, enough for 4 literals of up to 10 bits.
+  //
+  Buffer = Payload + Decoder->LiteralPayloadSize;
+  if (!LzfseInInit (&Stream, Decoder->LiteralBits, &Buffer, Payload)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < Decoder->LiteralCount; Index += 4) {
+    if (!LzfseInFlush (&Stream, &Buffer, Payload)) {
+      return FALSE;
+    }
+
+    Decoder->Literals[Index + 0] = LzfseDecode (&Decoder->LiteralState[0], Decoder->LiteralTable, &Stream);
+    Decoder->Literals[Index + 1] = LzfseDecode (&Decoder->LiteralState[1], Decoder->LiteralTable, &Stream);
+    Decoder->Literals[Index + 2] = LzfseDecode (&Decoder->LiteralState[2], Decoder->LiteralTable, &Stream);
+    Decoder->Literals[Index + 3] = LzfseDecode (&Decoder->LiteralState[3], Decoder->LiteralTable, &Stream);
+  }
+
+  //
+  // L, M, D triples follow the literals, one flush covers the 54 bits of a triple.
+  //
+  Payload += Decoder->LiteralPayloadSize;
+  Buffer   = Payload + Decoder->LmdPayloadSize;
+  if (!LzfseInInit (&Stream, Decoder->LmdBits, &Buffer, Payload)) {
+    return FALSE;
+  }
+
+  Literal    = Decoder->Literals;
+  LiteralEnd = Decoder->Literals + Decoder->LiteralCount;
+  DstEnd     = Dst + DstLen;
+
+  //
+  // Distance is initialised to an invalid value, so the first match cannot reuse it.
+  //
+  Distance = 0;
+
+  for (Index = 0; Index < Decoder->MatchCount; ++Index) {
+    if (!LzfseInFlush (&Stream, &Buffer, Payload)) {
+      return FALSE;
+    }
+
+    LValue = LzfseDecodeValue (&Decoder->LState, Decoder->LTable, &Stream);
+    MValue = LzfseDecodeValue (&Decoder->MState, Decoder->MTable, &Stream);
+    DValue = LzfseDecodeValue (&Decoder->DState, Decoder->DTable, &Stream);
+    if (DValue != 0) {
+      Distance = DValue;
+    }
+
+    if (  (LValue > (UINTN)(LiteralEnd - Literal))
+       || (LValue > (UINTN)(DstEnd - Dst))
+       || (MValue > (UINTN)(DstEnd - Dst) - LValue))
+    {
+      return FALSE;
+    }
+
+    CopyMem (Dst, Literal, LValue);
+    Dst     += LValue;
+    Literal += LValue;
+
+    if (MValue == 0) {
+      continue;
+    }
+
+    if ((Distance == 0) || (Distance > (UINTN)(Dst - DstBegin))) {
+      return FALSE;
+    }
+
+    //
+    // Matches may overlap the output, copy byte by byte.
+    //
+    while (MValue > 0) {
+      *Dst = *(Dst - Distance);
+      ++Dst;
+      --MValue;
+    }
+  }
+
+  return Dst == DstEnd;
+}
+
+UINTN
+DecompressLZFSE (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  LZFSE_BLOCK_DECODER  *Decoder;
+  CONST UINT8          *SrcEnd;
+  UINT8                *DstCur;
+  UINT32               Magic;
+  UINT32               RawSize;
+  UINT32               PayloadSize;
+  UINTN                BlockSize;
+  BOOLEAN              Result;
+
+  if ((DstLen > OC_COMPRESSION_MAX_LENGTH) || (SrcLen > OC_COMPRESSION_MAX_LENGTH)) {
+    return 0;
+  }
+
+  Decoder = NULL;
+  SrcEnd  = Src + SrcLen;
+  DstCur  = Dst;
+  Result  = FALSE;
+
+  while ((UINTN)(SrcEnd - Src) >= sizeof (UINT32)) {
+    Magic = ReadUnaligned32 ((CONST UINT32 *)Src);
+
+    if (Magic == LZFSE_ENDOFSTREAM_BLOCK_MAGIC) {
+      Result = TRUE;
+      break;
+    }
+
+    if ((UINTN)(SrcEnd - Src) < 2 * sizeof (UINT32)) {
+      break;
+    }
+
+    RawSize = ReadUnaligned32 ((CONST UINT32 *)&Src[sizeof (UINT32)]);
+    if (RawSize > (UINTN)(Dst + DstLen - DstCur)) {
+      break;
+    }
+
+    if (Magic == LZFSE_UNCOMPRESSED_BLOCK_MAGIC) {
+      BlockSize = 2 * sizeof (UINT32) + (UINTN)RawSize;
+      if (BlockSize > (UINTN)(SrcEnd - Src)) {
+        break;
+      }
+
+      CopyMem (DstCur, &Src[2 * sizeof (UINT32)], RawSize);
+    } else if (Magic == LZFSE_COMPRESSEDLZVN_BLOCK_MAGIC) {
+      if ((UINTN)(SrcEnd - Src) < 3 * sizeof (UINT32)) {
+        break;
+      }
+
+      PayloadSize = ReadUnaligned32 ((CONST UINT32 *)&Src[2 * sizeof (UINT32)]);
+      BlockSize   = 3 * sizeof (UINT32) + (UINTN)PayloadSize;
+      if (BlockSize > (UINTN)(SrcEnd - Src)) {
+        break;
+      }
+
+      if (DecompressLZVN (DstCur, RawSize, &Src[3 * sizeof (UINT32)], PayloadSize) != RawSize) {
+        break;
+      }
+    } else if (Magic == LZFSE_COMPRESSEDV2_BLOCK_MAGIC) {
+      if (Decoder == NULL) {
+        Decoder = AllocatePool (sizeof (*Decoder));
+        if (Decoder == NULL) {
+          break;
+        }
+      }
+
+      if (!LzfseDecodeV2Header (Decoder, Src, (UINTN)(SrcEnd - Src))) {
+        break;
+      }
+
+      BlockSize = (UINTN)Decoder->HeaderSize + Decoder->LiteralPayloadSize + Decoder->LmdPayloadSize;
+      if (BlockSize > (UINTN)(SrcEnd - Src)) {
+        break;
+      }
+
+      if (!LzfseDecodeV2Block (Decoder, &Src[Decoder->HeaderSize], Dst, DstCur, RawSize)) {
+        break;
+      }
+    } else {
+      //
+      // V1 blocks are a legacy format not produced by current encoders.
+      //
+      break;
+    }
+
+    Src    += BlockSize;
+    DstCur += RawSize;
+  }
+
+  if (Decoder != NULL) {
+    FreePool (Decoder);
+  }
+
+  return Result ? (UINTN)(DstCur - Dst) : 0;
+}
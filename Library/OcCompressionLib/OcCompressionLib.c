@@ -12,6 +12,7 @@
   WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 **/
 
+#include <Library/BaseMemoryLib.h>
 #include <Library/OcCompressionLib.h>
 
 UINT32
@@ -138,3 +139,86 @@ DecompressMaskedRLE24 (
 
   return MaskLen * sizeof (UINT32);
 }
+
+UINTN
+DecompressADC (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  //
+  // Apple Data Compression is a simple LZ77 variant with three opcodes:
+  //  1. <C> & BIT7 != 0 is a literal run of (<C> & 0x7F) + 1 bytes.
+  //  2. <C> & BIT6 != 0 is a match of (<C> & 0x3F) + 4 bytes with
+  //     16-bit big endian distance in the next two bytes.
+  //  3. Otherwise it is a match of ((<C> >> 2) & 0x0F) + 3 bytes with
+  //     10-bit distance formed by <C> & 0x03 and the next byte.
+  // Match distance is stored minus one.
+  //
+
+  CONST UINT8  *SrcEnd;
+  UINT8        *DstCur;
+  UINT8        *DstEnd;
+  UINT8        ControlValue;
+  UINTN        Length;
+  UINTN        Distance;
+
+  if ((DstLen > OC_COMPRESSION_MAX_LENGTH) || (SrcLen > OC_COMPRESSION_MAX_LENGTH)) {
+    return 0;
+  }
+
+  SrcEnd = Src + SrcLen;
+  DstCur = Dst;
+  DstEnd = Dst + DstLen;
+
+  while (Src < SrcEnd && DstCur < DstEnd) {
+    ControlValue = *Src++;
+
+    if ((ControlValue & BIT7) != 0) {
+      Length = (ControlValue & 0x7FU) + 1;
+      if (((UINTN)(SrcEnd - Src) < Length) || ((UINTN)(DstEnd - DstCur) < Length)) {
+        return 0;
+      }
+
+      CopyMem (DstCur, Src, Length);
+      Src    += Length;
+      DstCur += Length;
+      continue;
+    }
+
+    if ((ControlValue & BIT6) != 0) {
+      if ((UINTN)(SrcEnd - Src) < 2) {
+        return 0;
+      }
+
+      Length   = (ControlValue & 0x3FU) + 4;
+      Distance = (((UINTN)Src[0] << 8U) | Src[1]) + 1;
+      Src     += 2;
+    } else {
+      if (Src == SrcEnd) {
+        return 0;
+      }
+
+      Length   = ((ControlValue >> 2U) & 0x0FU) + 3;
+      Distance = (((UINTN)(ControlValue & 0x03U) << 8U) | Src[0]) + 1;
+      Src     += 1;
+    }
+
+    if (((UINTN)(DstCur - Dst) < Distance) || ((UINTN)(DstEnd - DstCur) < Length)) {
+      return 0;
+    }
+
+    //
+    // Matches may overlap the output, copy byte by byte.
+    //
+    while (Length > 0) {
+      *DstCur = *(DstCur - Distance);
+      ++DstCur;
+      --Length;
+    }
+  }
+
+  return (UINTN)(DstCur - Dst);
+}
@@ -137,6 +137,106 @@ u_int32_t decompress_lzss(
     return (u_int32_t)(dst - dststart);
 }
 
+/*
+ * Resumable variant of decompress_lzss writing to a flat destination buffer.
+ * The stream only advances over complete tokens, so a token split between
+ * source chunks is left unconsumed and is expected at the next chunk start.
+ */
+struct lzss_stream {
+    /* ring buffer of size N, with extra F-1 bytes to aid string comparison */
+    u_int8_t text_buf[N + F - 1];
+    u_int8_t *dststart;
+    u_int8_t *dst;
+    const u_int8_t *dstend;
+    int r;
+    unsigned int flags;
+};
+
+/*******************************************************************************
+*******************************************************************************/
+struct lzss_stream *lzss_stream_init(
+    u_int8_t       * dst,
+    u_int32_t        dstlen)
+{
+    struct lzss_stream *sp;
+
+    if (dstlen > OC_COMPRESSION_MAX_LENGTH) {
+        return NULL;
+    }
+
+    sp = malloc(sizeof(*sp));
+    if (sp == NULL) {
+        return NULL;
+    }
+
+    memset(sp->text_buf, ' ', N - F);
+    sp->dststart = dst;
+    sp->dst = dst;
+    sp->dstend = dst + dstlen;
+    sp->r = N - F;
+    sp->flags = 0;
+
+    return sp;
+}
+
+/*******************************************************************************
+*******************************************************************************/
+u_int32_t lzss_stream_feed(
+    struct lzss_stream * sp,
+    const u_int8_t     * src,
+    u_int32_t            srclen,
+    u_int32_t          * consumed)
+{
+    const u_int8_t * srcstart = src;
+    const u_int8_t * srcend = src + srclen;
+    const u_int8_t * token;
+    u_int8_t * dst = sp->dst;
+    const u_int8_t * dstend = sp->dstend;
+    int  i, j, k, r;
+    u_int8_t c;
+    unsigned int flags;
+
+    r = sp->r;
+
+    while (dst < dstend) {
+        token = src;
+        flags = sp->flags >> 1;
+        if ((flags & 0x100) == 0) {
+            if (src < srcend) c = *src++; else break;
+            flags = c | 0xFF00;  /* uses higher byte cleverly */
+        }   /* to count eight */
+        if (flags & 1) {
+            if (src < srcend) c = *src++; else { src = token; break; }
+            *dst++ = c;
+            sp->text_buf[r++] = c;
+            r &= (N - 1);
+        } else {
+            if (srcend - src >= 2) { i = *src++; j = *src++; } else { src = token; break; }
+            i |= ((j & 0xF0) << 4);
+            j  =  (j & 0x0F) + THRESHOLD;
+            for (k = 0; k <= j; k++) {
+                c = sp->text_buf[(i + k) & (N - 1)];
+                if (dst < dstend) *dst++ = c; else break;
+                sp->text_buf[r++] = c;
+                r &= (N - 1);
+            }
+        }
+        sp->flags = flags;
+    }
+
+    sp->r = r;
+    sp->dst = dst;
+    *consumed = (u_int32_t)(src - srcstart);
+    return (u_int32_t)(dst - sp->dststart);
+}
+
+/*******************************************************************************
+*******************************************************************************/
+void lzss_stream_free(struct lzss_stream *sp)
+{
+    free(sp);
+}
+
 /*
  * initialize state, mostly the trees
  *
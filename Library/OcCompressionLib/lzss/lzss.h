@@ -21,6 +21,10 @@
 
 #define compress_lzss CompressLZSS
 #define decompress_lzss DecompressLZSS
+#define lzss_stream OC_LZSS_STREAM_
+#define lzss_stream_init DecompressLZSSStreamInit
+#define lzss_stream_feed DecompressLZSSStreamFeed
+#define lzss_stream_free DecompressLZSSStreamFree
 
 #ifdef EFIUSER
 #include <stdint.h>
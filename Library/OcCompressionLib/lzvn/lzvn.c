@@ -843,3 +843,49 @@ size_t lzvn_decode_buffer(unsigned char *dst, size_t dst_size,
   // This is how much we decompressed
   return dstate.dst - dst;
 }
+
+// Resumable decoder writing to a flat destination buffer. lzvn_decode only
+// advances over complete instructions, so an instruction split between source
+// chunks is left unconsumed and is expected at the next chunk start.
+struct lzvn_stream {
+  lzvn_decoder_state state;
+};
+
+struct lzvn_stream *lzvn_stream_init(unsigned char *dst, size_t dst_size) {
+  struct lzvn_stream *stream;
+
+  if (dst_size > OC_COMPRESSION_MAX_LENGTH) {
+    return NULL;
+  }
+
+  stream = AllocateZeroPool(sizeof(*stream));
+  if (stream == NULL) {
+    return NULL;
+  }
+
+  stream->state.dst_begin = dst;
+  stream->state.dst = dst;
+  stream->state.dst_end = dst + dst_size;
+
+  return stream;
+}
+
+size_t lzvn_stream_feed(struct lzvn_stream *stream, const unsigned char *src,
+                        size_t src_size, size_t *consumed) {
+  stream->state.src = src;
+  stream->state.src_end = src + src_size;
+
+  // Run LZVN decoder
+  if (!stream->state.end_of_stream) {
+    lzvn_decode(&stream->state);
+  }
+
+  *consumed = stream->state.src - src;
+
+  // This is how much we decompressed
+  return stream->state.dst - stream->state.dst_begin;
+}
+
+void lzvn_stream_free(struct lzvn_stream *stream) {
+  FreePool(stream);
+}
@@ -16,9 +16,14 @@
 #define LZVN_H
 
 #include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcCompressionLib.h>
 
 #define lzvn_decode_buffer DecompressLZVN
+#define lzvn_stream OC_LZVN_STREAM_
+#define lzvn_stream_init DecompressLZVNStreamInit
+#define lzvn_stream_feed DecompressLZVNStreamFeed
+#define lzvn_stream_free DecompressLZVNStreamFree
 
 #ifdef EFIUSER
 #include <stdint.h>
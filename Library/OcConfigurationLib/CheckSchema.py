@@ -2,18 +2,41 @@
 
 """
 Validates schema files (e.g. OcConfigurationLib.c) for being sorted.
+Generates or verifies minimal perfect hashes for dictionary schemas.
 """
 
+import argparse
+import os
 import re
 import sys
 
-if len(sys.argv) < 2:
-    print('Please provide a file to check')
-    sys.exit(-1)
+UINT32_MASK = 0xFFFFFFFF
 
-with open(sys.argv[1], 'r', encoding='utf-8') as f:
+HASH_HEADER = """/** @file
+  Dictionary schema perfect hashes for {source}.
+  This file is generated by CheckSchema.py, do not edit manually.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef {guard}
+#define {guard}
+"""
+
+
+def check_sorted(content):
+    """
+    Check that all schema lists are sorted, matches LookupConfigSchema.
+    """
     prev = ''
-    content = [line.strip() for line in f.readlines()]
     for index, line in enumerate(content):
         if line == 'OC_SCHEMA':
             print('Checking schema {}'.format(re.match(r'^\w+', content[index + 1]).group(0)))
@@ -23,5 +46,146 @@ with open(sys.argv[1], 'r', encoding='utf-8') as f:
         if x:
             if x.group(1) < prev:
                 print(f'Error: {prev} comes before {x.group(1)}')
-                sys.exit(1)
+                return False
             prev = x.group(1)
+    return True
+
+
+def schema_hash(name):
+    """
+    32-bit FNV-1a, matches LookupDictSchema.
+    """
+    value = 2166136261
+    for char in name.encode('utf-8'):
+        value = ((value ^ char) * 16777619) & UINT32_MASK
+    return value
+
+
+def schema_slot(value, displacement, size):
+    """
+    Displaced hash slot, matches LookupDictSchema.
+    """
+    value ^= (displacement * 0x9E3779B9) & UINT32_MASK
+    value ^= value >> 16
+    value = (value * 0x85EBCA6B) & UINT32_MASK
+    value ^= value >> 13
+    return value % size
+
+
+def build_hash(keys):
+    """
+    Build hash-and-displace minimal perfect hash for a list of keys.
+    Returns displacement and slot lists or None on failure.
+    """
+    size = len(keys)
+    hashes = [schema_hash(key) for key in keys]
+    buckets = {}
+    for index, value in enumerate(hashes):
+        buckets.setdefault(value % size, []).append(index)
+
+    displacements = [0] * size
+    slots = [None] * size
+    for bucket, items in sorted(buckets.items(), key=lambda x: (-len(x[1]), x[0])):
+        for displacement in range(256):
+            taken = [schema_slot(hashes[index], displacement, size) for index in items]
+            if len(set(taken)) == len(taken) and all(slots[slot] is None for slot in taken):
+                break
+        else:
+            return None
+
+        displacements[bucket] = displacement
+        for index, slot in zip(items, taken):
+            slots[slot] = index
+
+    return displacements, slots
+
+
+def format_array(name, values):
+    lines = [f'STATIC\nCONST UINT8\n  {name}[] = {{']
+    for start in range(0, len(values), 16):
+        chunk = ', '.join(str(x) for x in values[start:start + 16])
+        lines.append(f'  {chunk},')
+    lines.append('};\n')
+    return '\n'.join(lines)
+
+
+def generate_hashes(source, header, text):
+    """
+    Generate hash header contents for all schemas used as dictionaries.
+    """
+    schemas = dict(re.findall(r'(\w+)\[\] = \{\n(.*?)\n\};', text, re.S))
+    used = re.findall(r'OC_SCHEMA_DICT(?:_OPT)? \([^,]+,\s*(\w+)\)', text)
+    used += re.findall(r'\.Dict = \{\s*(\w+),', text)
+
+    guard = re.sub(r'(?<=[a-z])(?=[A-Z])', '_', os.path.basename(header)).replace('.', '_').upper()
+    result = [HASH_HEADER.format(source=os.path.basename(source), guard=guard)]
+
+    for name in sorted(set(used), key=used.index):
+        if name not in schemas:
+            print(f'Error: Dictionary schema {name} is not found')
+            return None
+
+        keys = [re.search(r'"([^"]+)"', line).group(1) for line in schemas[name].split('\n')]
+        if len(keys) > 256 or len(set(keys)) != len(keys):
+            print(f'Error: Dictionary schema {name} cannot be hashed')
+            return None
+
+        table = build_hash(keys)
+        if table is None:
+            print(f'Error: Failed to build perfect hash for {name}')
+            return None
+
+        result.append(format_array(f'{name}HashDisplacements', table[0]))
+        result.append(format_array(f'{name}HashSlots', table[1]))
+        result.append(
+            f'STATIC\nCONST OC_SCHEMA_HASH\n  {name}Hash = {{\n'
+            f'  {name}HashDisplacements,\n'
+            f'  {name}HashSlots\n'
+            '};\n'
+            )
+
+    result.append(f'#endif // {guard}\n')
+    return '\n'.join(result)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('schema', help='schema file to check')
+    parser.add_argument('--hash', help='perfect hash header to verify')
+    parser.add_argument('--update', action='store_true', help='regenerate perfect hash header')
+    args = parser.parse_args()
+
+    with open(args.schema, 'r', encoding='utf-8') as f:
+        text = f.read()
+
+    if not check_sorted([line.strip() for line in text.splitlines()]):
+        sys.exit(1)
+
+    if args.hash is None:
+        return
+
+    generated = generate_hashes(args.schema, args.hash, text)
+    if generated is None:
+        sys.exit(1)
+
+    if args.update:
+        with open(args.hash, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(generated)
+        print(f'Updated {args.hash}')
+        return
+
+    try:
+        with open(args.hash, 'r', encoding='utf-8') as f:
+            current = f.read()
+    except OSError:
+        current = None
+
+    if current != generated:
+        print(f'Error: {args.hash} is outdated, run with --update')
+        sys.exit(1)
+
+    print(f'Checked {args.hash}')
+
+
+if __name__ == '__main__':
+    main()
@@ -14,6 +14,8 @@
 
 #include <Library/OcConfigurationLib.h>
 
+#include "OcConfigurationSchemaHash.h"
+
 OC_STRUCTORS (OC_ACPI_ADD_ENTRY, ())
 OC_ARRAY_STRUCTORS (OC_ACPI_ADD_ARRAY)
 OC_STRUCTORS (OC_ACPI_DELETE_ENTRY, ())
@@ -386,6 +388,7 @@ OC_SCHEMA
   OC_SCHEMA_BOOLEAN_IN ("FuzzyMatch",   OC_GLOBAL_CONFIG, Kernel.Scheme.FuzzyMatch),
   OC_SCHEMA_STRING_IN ("KernelArch",    OC_GLOBAL_CONFIG, Kernel.Scheme.KernelArch),
   OC_SCHEMA_STRING_IN ("KernelCache",   OC_GLOBAL_CONFIG, Kernel.Scheme.KernelCache),
+  OC_SCHEMA_BOOLEAN_IN ("LinkCache",   OC_GLOBAL_CONFIG, Kernel.Scheme.LinkCache),
 };
 
 STATIC
@@ -458,6 +461,7 @@ OC_SCHEMA
   OC_SCHEMA_INTEGER_IN ("ScanPolicy",           OC_GLOBAL_CONFIG, Misc.Security.ScanPolicy),
   OC_SCHEMA_STRING_IN ("SecureBootModel",       OC_GLOBAL_CONFIG, Misc.Security.SecureBootModel),
   OC_SCHEMA_STRING_IN ("Vault",                 OC_GLOBAL_CONFIG, Misc.Security.Vault),
+  OC_SCHEMA_BOOLEAN_IN ("VaultPrefetch",        OC_GLOBAL_CONFIG, Misc.Security.VaultPrefetch),
 };
 
 STATIC
@@ -897,7 +901,7 @@ OC_SCHEMA
 STATIC
 OC_SCHEMA_INFO
   mRootConfigurationInfo = {
-  .Dict = { mRootConfigurationNodes, ARRAY_SIZE (mRootConfigurationNodes) }
+  .Dict = { mRootConfigurationNodes, ARRAY_SIZE (mRootConfigurationNodes), &mRootConfigurationNodesHash }
 };
 
 EFI_STATUS
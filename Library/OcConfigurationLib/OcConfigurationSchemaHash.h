@@ -0,0 +1,884 @@
+/** @file
+  Dictionary schema perfect hashes for OcConfigurationLib.c.
+  This file is generated by CheckSchema.py, do not edit manually.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_CONFIGURATION_SCHEMA_HASH_H
+#define OC_CONFIGURATION_SCHEMA_HASH_H
+
+STATIC
+CONST UINT8
+  mAcpiAddSchemaEntryHashDisplacements[] = {
+  0, 0, 2,
+};
+
+STATIC
+CONST UINT8
+  mAcpiAddSchemaEntryHashSlots[] = {
+  2, 1, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mAcpiAddSchemaEntryHash = {
+  mAcpiAddSchemaEntryHashDisplacements,
+  mAcpiAddSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mAcpiDeleteSchemaEntryHashDisplacements[] = {
+  0, 3, 22, 0, 0, 5,
+};
+
+STATIC
+CONST UINT8
+  mAcpiDeleteSchemaEntryHashSlots[] = {
+  4, 2, 0, 1, 3, 5,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mAcpiDeleteSchemaEntryHash = {
+  mAcpiDeleteSchemaEntryHashDisplacements,
+  mAcpiDeleteSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mAcpiPatchSchemaEntryHashDisplacements[] = {
+  0, 0, 0, 2, 0, 0, 0, 0, 1, 2, 1, 2, 1, 0,
+};
+
+STATIC
+CONST UINT8
+  mAcpiPatchSchemaEntryHashSlots[] = {
+  1, 0, 2, 11, 5, 9, 12, 6, 3, 4, 8, 10, 13, 7,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mAcpiPatchSchemaEntryHash = {
+  mAcpiPatchSchemaEntryHashDisplacements,
+  mAcpiPatchSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mAcpiQuirksSchemaHashDisplacements[] = {
+  0, 0, 4, 0, 0, 0, 4,
+};
+
+STATIC
+CONST UINT8
+  mAcpiQuirksSchemaHashSlots[] = {
+  2, 4, 1, 0, 5, 3, 6,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mAcpiQuirksSchemaHash = {
+  mAcpiQuirksSchemaHashDisplacements,
+  mAcpiQuirksSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mBooterWhitelistEntrySchemaHashDisplacements[] = {
+  0, 0, 3,
+};
+
+STATIC
+CONST UINT8
+  mBooterWhitelistEntrySchemaHashSlots[] = {
+  1, 2, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mBooterWhitelistEntrySchemaHash = {
+  mBooterWhitelistEntrySchemaHashDisplacements,
+  mBooterWhitelistEntrySchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mBooterPatchSchemaEntryHashDisplacements[] = {
+  0, 0, 9, 4, 2, 1, 0, 0, 0, 0, 38,
+};
+
+STATIC
+CONST UINT8
+  mBooterPatchSchemaEntryHashSlots[] = {
+  2, 7, 0, 10, 6, 1, 8, 4, 3, 9, 5,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mBooterPatchSchemaEntryHash = {
+  mBooterPatchSchemaEntryHashDisplacements,
+  mBooterPatchSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mBooterQuirksSchemaHashDisplacements[] = {
+  1, 0, 3, 0, 1, 2, 0, 4, 0, 6, 5, 4, 0, 0, 2, 6,
+  0, 0, 0, 2, 0, 44, 0,
+};
+
+STATIC
+CONST UINT8
+  mBooterQuirksSchemaHashSlots[] = {
+  20, 11, 14, 9, 4, 15, 17, 13, 10, 5, 0, 19, 1, 22, 16, 6,
+  2, 12, 18, 8, 7, 21, 3,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mBooterQuirksSchemaHash = {
+  mBooterQuirksSchemaHashDisplacements,
+  mBooterQuirksSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelAddSchemaEntryHashDisplacements[] = {
+  2, 7, 0, 0, 7, 0, 4, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelAddSchemaEntryHashSlots[] = {
+  6, 0, 3, 2, 4, 5, 1, 7,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelAddSchemaEntryHash = {
+  mKernelAddSchemaEntryHashDisplacements,
+  mKernelAddSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelBlockSchemaEntryHashDisplacements[] = {
+  2, 0, 0, 0, 2, 3, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelBlockSchemaEntryHashSlots[] = {
+  1, 3, 4, 5, 2, 6, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelBlockSchemaEntryHash = {
+  mKernelBlockSchemaEntryHashDisplacements,
+  mKernelBlockSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelForceSchemaEntryHashDisplacements[] = {
+  0, 0, 2, 2, 3, 0, 0, 2, 11,
+};
+
+STATIC
+CONST UINT8
+  mKernelForceSchemaEntryHashSlots[] = {
+  8, 5, 6, 4, 0, 1, 7, 3, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelForceSchemaEntryHash = {
+  mKernelForceSchemaEntryHashDisplacements,
+  mKernelForceSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelPatchSchemaEntryHashDisplacements[] = {
+  0, 0, 7, 0, 3, 3, 0, 0, 1, 10, 0, 6, 1, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelPatchSchemaEntryHashSlots[] = {
+  2, 1, 9, 13, 5, 12, 0, 10, 8, 4, 3, 6, 7, 11,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelPatchSchemaEntryHash = {
+  mKernelPatchSchemaEntryHashDisplacements,
+  mKernelPatchSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelEmulateSchemaHashDisplacements[] = {
+  1, 0, 0, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelEmulateSchemaHashSlots[] = {
+  0, 3, 4, 1, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelEmulateSchemaHash = {
+  mKernelEmulateSchemaHashDisplacements,
+  mKernelEmulateSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelQuirksSchemaHashDisplacements[] = {
+  0, 4, 0, 0, 0, 3, 0, 3, 0, 0, 0, 6, 0, 16, 3, 2,
+  0, 1, 11, 0, 6, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelQuirksSchemaHashSlots[] = {
+  10, 14, 2, 6, 16, 3, 17, 7, 18, 20, 0, 11, 4, 22, 12, 5,
+  8, 1, 9, 21, 15, 19, 13,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelQuirksSchemaHash = {
+  mKernelQuirksSchemaHashDisplacements,
+  mKernelQuirksSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelSchemeSchemaHashDisplacements[] = {
+  0, 0, 0, 7, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelSchemeSchemaHashSlots[] = {
+  2, 4, 1, 0, 3,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelSchemeSchemaHash = {
+  mKernelSchemeSchemaHashDisplacements,
+  mKernelSchemeSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSerialCustomSchemaHashDisplacements[] = {
+  4, 0, 1, 2, 0, 1, 0, 0, 0, 0, 0, 5,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSerialCustomSchemaHashSlots[] = {
+  5, 4, 8, 11, 0, 9, 3, 10, 2, 6, 7, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationSerialCustomSchemaHash = {
+  mMiscConfigurationSerialCustomSchemaHashDisplacements,
+  mMiscConfigurationSerialCustomSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscEntriesSchemaEntryHashDisplacements[] = {
+  0, 0, 0, 4, 0, 3, 0, 2,
+};
+
+STATIC
+CONST UINT8
+  mMiscEntriesSchemaEntryHashSlots[] = {
+  1, 6, 7, 4, 2, 3, 0, 5,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscEntriesSchemaEntryHash = {
+  mMiscEntriesSchemaEntryHashDisplacements,
+  mMiscEntriesSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscToolsSchemaEntryHashDisplacements[] = {
+  1, 4, 1, 0, 2, 0, 3, 13, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mMiscToolsSchemaEntryHashSlots[] = {
+  1, 0, 8, 4, 6, 5, 9, 7, 2, 3,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscToolsSchemaEntryHash = {
+  mMiscToolsSchemaEntryHashDisplacements,
+  mMiscToolsSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationBootSchemaHashDisplacements[] = {
+  0, 2, 1, 0, 0, 0, 1, 0, 6, 5, 2, 0, 0, 0, 0, 23,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationBootSchemaHashSlots[] = {
+  6, 12, 1, 15, 5, 11, 10, 14, 7, 9, 13, 2, 3, 4, 8, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationBootSchemaHash = {
+  mMiscConfigurationBootSchemaHashDisplacements,
+  mMiscConfigurationBootSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationDebugSchemaHashDisplacements[] = {
+  0, 0, 2, 0, 0, 1, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationDebugSchemaHashSlots[] = {
+  5, 6, 0, 7, 4, 3, 1, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationDebugSchemaHash = {
+  mMiscConfigurationDebugSchemaHashDisplacements,
+  mMiscConfigurationDebugSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSecuritySchemaHashDisplacements[] = {
+  0, 4, 0, 7, 2, 1, 2, 0, 0, 0, 6, 0, 1, 1,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSecuritySchemaHashSlots[] = {
+  9, 8, 3, 5, 10, 6, 11, 12, 0, 1, 2, 4, 7, 13,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationSecuritySchemaHash = {
+  mMiscConfigurationSecuritySchemaHashDisplacements,
+  mMiscConfigurationSecuritySchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSerialSchemaHashDisplacements[] = {
+  0, 5, 2,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSerialSchemaHashSlots[] = {
+  1, 0, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationSerialSchemaHash = {
+  mMiscConfigurationSerialSchemaHashDisplacements,
+  mMiscConfigurationSerialSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationMemoryDeviceEntryHashDisplacements[] = {
+  0, 0, 0, 0, 0, 1, 0, 26,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationMemoryDeviceEntryHashSlots[] = {
+  0, 1, 3, 6, 2, 5, 7, 4,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationMemoryDeviceEntryHash = {
+  mPlatformConfigurationMemoryDeviceEntryHashDisplacements,
+  mPlatformConfigurationMemoryDeviceEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationDataHubSchemaHashDisplacements[] = {
+  0, 0, 0, 0, 0, 0, 7, 1, 4, 0, 9, 0, 85, 4,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationDataHubSchemaHashSlots[] = {
+  4, 3, 13, 8, 2, 1, 9, 10, 6, 11, 0, 12, 5, 7,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationDataHubSchemaHash = {
+  mPlatformConfigurationDataHubSchemaHashDisplacements,
+  mPlatformConfigurationDataHubSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationGenericSchemaHashDisplacements[] = {
+  0, 0, 0, 0, 3, 0, 3, 13, 2, 0,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationGenericSchemaHashSlots[] = {
+  0, 9, 1, 6, 7, 8, 5, 3, 4, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationGenericSchemaHash = {
+  mPlatformConfigurationGenericSchemaHashDisplacements,
+  mPlatformConfigurationGenericSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationMemorySchemaHashDisplacements[] = {
+  1, 0, 0, 0, 5, 1, 0, 1,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationMemorySchemaHashSlots[] = {
+  0, 1, 6, 2, 3, 4, 7, 5,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationMemorySchemaHash = {
+  mPlatformConfigurationMemorySchemaHashDisplacements,
+  mPlatformConfigurationMemorySchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationNvramSchemaHashDisplacements[] = {
+  0, 0, 1, 0, 2, 2, 0,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationNvramSchemaHashSlots[] = {
+  4, 2, 3, 1, 5, 6, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationNvramSchemaHash = {
+  mPlatformConfigurationNvramSchemaHashDisplacements,
+  mPlatformConfigurationNvramSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationSmbiosSchemaHashDisplacements[] = {
+  0, 0, 3, 0, 3, 11, 5, 2, 0, 12, 0, 0, 0, 0, 0, 0,
+  0, 0, 1, 0, 31, 15, 0, 1, 0, 0, 29,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationSmbiosSchemaHashSlots[] = {
+  2, 5, 6, 26, 23, 17, 15, 25, 11, 24, 4, 13, 1, 19, 18, 16,
+  22, 9, 12, 10, 14, 8, 0, 21, 20, 3, 7,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationSmbiosSchemaHash = {
+  mPlatformConfigurationSmbiosSchemaHashDisplacements,
+  mPlatformConfigurationSmbiosSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiDriversSchemaEntryHashDisplacements[] = {
+  0, 0, 0, 0, 3,
+};
+
+STATIC
+CONST UINT8
+  mUefiDriversSchemaEntryHashSlots[] = {
+  0, 4, 3, 2, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiDriversSchemaEntryHash = {
+  mUefiDriversSchemaEntryHashDisplacements,
+  mUefiDriversSchemaEntryHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiReservedMemoryEntrySchemaHashDisplacements[] = {
+  1, 0, 0, 0, 4,
+};
+
+STATIC
+CONST UINT8
+  mUefiReservedMemoryEntrySchemaHashSlots[] = {
+  1, 4, 3, 0, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiReservedMemoryEntrySchemaHash = {
+  mUefiReservedMemoryEntrySchemaHashDisplacements,
+  mUefiReservedMemoryEntrySchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiApfsSchemaHashDisplacements[] = {
+  0, 0, 1, 0, 0, 10,
+};
+
+STATIC
+CONST UINT8
+  mUefiApfsSchemaHashSlots[] = {
+  1, 3, 2, 4, 5, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiApfsSchemaHash = {
+  mUefiApfsSchemaHashDisplacements,
+  mUefiApfsSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiAppleInputSchemaHashDisplacements[] = {
+  0, 10, 3, 1, 7, 0, 0, 0, 23, 5, 0, 0, 6,
+};
+
+STATIC
+CONST UINT8
+  mUefiAppleInputSchemaHashSlots[] = {
+  4, 1, 2, 12, 11, 8, 0, 6, 10, 9, 3, 5, 7,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiAppleInputSchemaHash = {
+  mUefiAppleInputSchemaHashDisplacements,
+  mUefiAppleInputSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiAudioSchemaHashDisplacements[] = {
+  0, 10, 1, 7, 0, 28, 0, 0, 0, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mUefiAudioSchemaHashSlots[] = {
+  0, 3, 8, 9, 2, 4, 10, 6, 5, 7, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiAudioSchemaHash = {
+  mUefiAudioSchemaHashDisplacements,
+  mUefiAudioSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiInputSchemaHashDisplacements[] = {
+  0, 1, 0, 2, 6, 0, 4, 15,
+};
+
+STATIC
+CONST UINT8
+  mUefiInputSchemaHashSlots[] = {
+  7, 4, 1, 2, 5, 3, 0, 6,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiInputSchemaHash = {
+  mUefiInputSchemaHashDisplacements,
+  mUefiInputSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiOutputSchemaHashDisplacements[] = {
+  0, 0, 0, 0, 0, 0, 9, 0, 0, 1, 2, 0, 0, 2, 4, 0,
+  21, 1,
+};
+
+STATIC
+CONST UINT8
+  mUefiOutputSchemaHashSlots[] = {
+  3, 7, 15, 13, 2, 11, 1, 0, 17, 9, 10, 6, 8, 14, 5, 4,
+  12, 16,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiOutputSchemaHash = {
+  mUefiOutputSchemaHashDisplacements,
+  mUefiOutputSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiProtocolOverridesSchemaHashDisplacements[] = {
+  2, 0, 0, 12, 0, 0, 0, 0, 0, 0, 14, 0, 0, 1, 0, 18,
+  1, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mUefiProtocolOverridesSchemaHashSlots[] = {
+  15, 11, 4, 6, 10, 16, 12, 5, 0, 14, 8, 9, 7, 17, 1, 18,
+  3, 13, 2,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiProtocolOverridesSchemaHash = {
+  mUefiProtocolOverridesSchemaHashDisplacements,
+  mUefiProtocolOverridesSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiQuirksSchemaHashDisplacements[] = {
+  0, 1, 0, 0, 2, 1, 0, 0, 0, 0, 0, 3, 48, 12, 0, 4,
+};
+
+STATIC
+CONST UINT8
+  mUefiQuirksSchemaHashSlots[] = {
+  1, 10, 12, 2, 4, 0, 8, 6, 14, 9, 5, 13, 3, 15, 7, 11,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiQuirksSchemaHash = {
+  mUefiQuirksSchemaHashDisplacements,
+  mUefiQuirksSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mAcpiConfigurationSchemaHashDisplacements[] = {
+  1, 0, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mAcpiConfigurationSchemaHashSlots[] = {
+  2, 0, 3, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mAcpiConfigurationSchemaHash = {
+  mAcpiConfigurationSchemaHashDisplacements,
+  mAcpiConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mBooterConfigurationSchemaHashDisplacements[] = {
+  3, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mBooterConfigurationSchemaHashSlots[] = {
+  0, 2, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mBooterConfigurationSchemaHash = {
+  mBooterConfigurationSchemaHashDisplacements,
+  mBooterConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mDevicePropertiesSchemaHashDisplacements[] = {
+  0, 0,
+};
+
+STATIC
+CONST UINT8
+  mDevicePropertiesSchemaHashSlots[] = {
+  0, 1,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mDevicePropertiesSchemaHash = {
+  mDevicePropertiesSchemaHashDisplacements,
+  mDevicePropertiesSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mKernelConfigurationSchemaHashDisplacements[] = {
+  1, 1, 0, 0, 0, 2, 0,
+};
+
+STATIC
+CONST UINT8
+  mKernelConfigurationSchemaHashSlots[] = {
+  2, 4, 5, 0, 1, 3, 6,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mKernelConfigurationSchemaHash = {
+  mKernelConfigurationSchemaHashDisplacements,
+  mKernelConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSchemaHashDisplacements[] = {
+  0, 0, 0, 0, 0, 9, 2,
+};
+
+STATIC
+CONST UINT8
+  mMiscConfigurationSchemaHashSlots[] = {
+  5, 0, 2, 4, 1, 6, 3,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mMiscConfigurationSchemaHash = {
+  mMiscConfigurationSchemaHashDisplacements,
+  mMiscConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mNvramConfigurationSchemaHashDisplacements[] = {
+  0, 0, 3, 0, 0,
+};
+
+STATIC
+CONST UINT8
+  mNvramConfigurationSchemaHashSlots[] = {
+  3, 1, 4, 2, 0,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mNvramConfigurationSchemaHash = {
+  mNvramConfigurationSchemaHashDisplacements,
+  mNvramConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationSchemaHashDisplacements[] = {
+  1, 0, 2, 3, 0, 0, 6, 0, 26, 0, 3, 0,
+};
+
+STATIC
+CONST UINT8
+  mPlatformConfigurationSchemaHashSlots[] = {
+  10, 5, 6, 4, 7, 11, 1, 0, 8, 9, 2, 3,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mPlatformConfigurationSchemaHash = {
+  mPlatformConfigurationSchemaHashDisplacements,
+  mPlatformConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mUefiConfigurationSchemaHashDisplacements[] = {
+  0, 6, 0, 0, 1, 0, 9, 0, 0, 0, 7,
+};
+
+STATIC
+CONST UINT8
+  mUefiConfigurationSchemaHashSlots[] = {
+  1, 8, 4, 3, 2, 9, 0, 7, 5, 6, 10,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mUefiConfigurationSchemaHash = {
+  mUefiConfigurationSchemaHashDisplacements,
+  mUefiConfigurationSchemaHashSlots
+};
+
+STATIC
+CONST UINT8
+  mRootConfigurationNodesHashDisplacements[] = {
+  0, 1, 0, 1, 0, 0, 1, 0,
+};
+
+STATIC
+CONST UINT8
+  mRootConfigurationNodesHashSlots[] = {
+  4, 2, 0, 1, 3, 5, 7, 6,
+};
+
+STATIC
+CONST OC_SCHEMA_HASH
+  mRootConfigurationNodesHash = {
+  mRootConfigurationNodesHashDisplacements,
+  mRootConfigurationNodesHashSlots
+};
+
+#endif // OC_CONFIGURATION_SCHEMA_HASH_H
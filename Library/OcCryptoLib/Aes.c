@@ -62,7 +62,7 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 
 **/
 
-#include "CryptoInternal.h"
+#include "AesInternal.h"
 
 //
 // The number of columns comprising a state in AES (Nb). This is a CONSTant in AES. Value=4
@@ -88,6 +88,20 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 //
 typedef UINT8 AES_INTERNAL_STATE[4][4];
 
+//
+// AES-NI implementation locates IV right after the round keys.
+//
+STATIC_ASSERT (
+  OFFSET_OF (AES_CONTEXT, Iv) == (Nr + 1) * AES_BLOCK_SIZE,
+  "Unexpected AES_CONTEXT layout"
+  );
+
+//
+// AES-NI support, detected on first use.
+//
+STATIC BOOLEAN  mAesNiDetected;
+STATIC BOOLEAN  mAesNiSupported;
+
 //
 // The lookup-tables are marked CONST so they can be placed in read-only storage instead of RAM
 // The numbers below can be computed dynamically trading ROM for RAM -
@@ -578,10 +592,40 @@ XorWithIv (
   }
 }
 
+/**
+  Check whether AES-NI implementation should be used.
+
+  @retval TRUE when AES-NI is supported.
+**/
+STATIC
+BOOLEAN
+InternalAesNiSupported (
+  VOID
+  )
+{
+  if (!mAesNiDetected) {
+    mAesNiSupported = AesNiIsSupported ();
+    mAesNiDetected  = TRUE;
+  }
+
+  return mAesNiSupported;
+}
+
 //
 // Public functions
 //
 
+BOOLEAN
+AesSetAccel (
+  IN BOOLEAN  Enable
+  )
+{
+  mAesNiSupported = Enable && AesNiIsSupported ();
+  mAesNiDetected  = TRUE;
+
+  return mAesNiSupported;
+}
+
 VOID
 AesCbcEncryptBuffer (
   IN OUT AES_CONTEXT  *Context,
@@ -592,6 +636,11 @@ AesCbcEncryptBuffer (
   UINT32  I;
   UINT8   *Iv;
 
+  if (InternalAesNiSupported ()) {
+    AesNiCbcEncrypt (Context, Data, Len / AES_BLOCK_SIZE, Nr);
+    return;
+  }
+
   Iv = Context->Iv;
 
   for (I = 0; I < Len; I += AES_BLOCK_SIZE) {
@@ -617,6 +666,11 @@ AesCbcDecryptBuffer (
   UINT32  I;
   UINT8   StoreNextIv[AES_BLOCK_SIZE];
 
+  if (InternalAesNiSupported ()) {
+    AesNiCbcDecrypt (Context, Data, Len / AES_BLOCK_SIZE, Nr);
+    return;
+  }
+
   for (I = 0; I < Len; I += AES_BLOCK_SIZE) {
     CopyMem (StoreNextIv, Data, AES_BLOCK_SIZE);
     InvCipher ((AES_INTERNAL_STATE *)Data, Context->RoundKey);
@@ -640,6 +694,24 @@ AesCtrXcryptBuffer (
   UINT8   Buffer[AES_BLOCK_SIZE];
   UINT32  I;
   INT32   Bi;
+  UINT32  BlockNb;
+
+  if (InternalAesNiSupported ()) {
+    BlockNb = Len / AES_BLOCK_SIZE;
+    AesNiCtrXcrypt (Context, Data, BlockNb, Nr);
+
+    //
+    // Trailing partial block consumes a whole counter like below.
+    //
+    I = BlockNb * AES_BLOCK_SIZE;
+    if (I < Len) {
+      CopyMem (Buffer, &Data[I], Len - I);
+      AesNiCtrXcrypt (Context, Buffer, 1, Nr);
+      CopyMem (&Data[I], Buffer, Len - I);
+    }
+
+    return;
+  }
 
   for (I = 0, Bi = AES_BLOCK_SIZE; I < Len; ++I, ++Bi) {
     //
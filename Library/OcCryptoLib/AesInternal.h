@@ -0,0 +1,83 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_AES_INTERNAL_H
+#define OC_AES_INTERNAL_H
+
+#include "CryptoInternal.h"
+
+/**
+  Check whether AES-NI implementation can be used.
+
+  @retval TRUE when CPU supports AES-NI and SSE4.1.
+**/
+BOOLEAN
+EFIAPI
+AesNiIsSupported (
+  VOID
+  );
+
+/**
+  Encrypt whole blocks in place in CBC mode with AES-NI.
+  IV must immediately follow round keys in Context.
+
+  @param[in,out] Context  AES context, IV is updated.
+  @param[in,out] Data     Data to encrypt.
+  @param[in]     BlockNb  Number of AES blocks.
+  @param[in]     Rounds   Number of AES rounds.
+**/
+VOID
+EFIAPI
+AesNiCbcEncrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  );
+
+/**
+  Decrypt whole blocks in place in CBC mode with AES-NI.
+  IV must immediately follow round keys in Context.
+
+  @param[in,out] Context  AES context, IV is updated.
+  @param[in,out] Data     Data to decrypt.
+  @param[in]     BlockNb  Number of AES blocks.
+  @param[in]     Rounds   Number of AES rounds.
+**/
+VOID
+EFIAPI
+AesNiCbcDecrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  );
+
+/**
+  Encrypt or decrypt whole blocks in place in CTR mode with AES-NI.
+  Counter must immediately follow round keys in Context.
+
+  @param[in,out] Context  AES context, counter is advanced by BlockNb.
+  @param[in,out] Data     Data to process.
+  @param[in]     BlockNb  Number of AES blocks.
+  @param[in]     Rounds   Number of AES rounds.
+**/
+VOID
+EFIAPI
+AesNiCtrXcrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  );
+
+#endif // OC_AES_INTERNAL_H
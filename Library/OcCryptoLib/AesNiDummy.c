@@ -0,0 +1,70 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "AesInternal.h"
+
+BOOLEAN
+EFIAPI
+AesNiIsSupported (
+  VOID
+  )
+{
+  return FALSE;
+}
+
+VOID
+EFIAPI
+AesNiCbcEncrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  )
+{
+  (VOID)Context;
+  (VOID)Data;
+  (VOID)BlockNb;
+  (VOID)Rounds;
+  ASSERT (FALSE);
+}
+
+VOID
+EFIAPI
+AesNiCbcDecrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  )
+{
+  (VOID)Context;
+  (VOID)Data;
+  (VOID)BlockNb;
+  (VOID)Rounds;
+  ASSERT (FALSE);
+}
+
+VOID
+EFIAPI
+AesNiCtrXcrypt (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockNb,
+  IN     UINTN        Rounds
+  )
+{
+  (VOID)Context;
+  (VOID)Data;
+  (VOID)BlockNb;
+  (VOID)Rounds;
+  ASSERT (FALSE);
+}
@@ -161,8 +161,36 @@ BigNumCalculateMontParams (
   IN     OC_BN_WORD        *Scratch
   );
 
+/**
+  The maximum number of odd powers precomputed by BigNumPowMod for the
+  sliding window exponentiation.
+**/
+#define OC_BN_POW_MOD_TABLE_LEN  4U
+
+/**
+  The length, in BigNum words, of the BigNumPowMod scratch buffer: the odd
+  powers table, a temporary, and the double-width square product.
+
+  @param[in] NumWords  The number of Words of N. Must be at most
+                       OC_BN_MONT_MAX_LEN.
+**/
+#define BIG_NUM_POW_MOD_SCRATCH_LEN(NumWords) \
+  ((OC_BN_POW_MOD_TABLE_LEN + 3U) * (NumWords) + 1U)
+
+/**
+  The size, in Bytes, of the BigNumPowMod scratch buffer.
+
+  @param[in] NumWords  The number of Words of N. Must be at most
+                       OC_BN_MONT_MAX_LEN.
+**/
+#define BIG_NUM_POW_MOD_SCRATCH_SIZE(NumWords) \
+  (OC_BN_SIZE (BIG_NUM_POW_MOD_SCRATCH_LEN (NumWords)))
+
 /**
   Caulculates the exponentiation of A with B mod N.
+  Exponent 65537 uses a dedicated squaring chain, other exponents use
+  a sliding window over their bits. Only odd exponents of at least 3
+  are supported.
 
   @param[in,out] Result    The buffer to return the result into.
   @param[in]     NumWords  The number of Words of Result, A, N and RSqrMod.
@@ -171,7 +199,7 @@ BigNumCalculateMontParams (
   @param[in]     N         The modulus.
   @param[in]     N0Inv     The Montgomery Inverse of N.
   @param[in]     RSqrMod   Montgomery's R^2 mod N.
-  @param[in]     ATmp      Scratch buffer of NumWords.
+  @param[in]     Scratch   Scratch buffer BIG_NUM_POW_MOD_SCRATCH_SIZE(NumWords).
 
   @returns  Whether the operation was completes successfully.
 
@@ -185,7 +213,7 @@ BigNumPowMod (
   IN     CONST OC_BN_WORD  *N,
   IN     OC_BN_WORD        N0Inv,
   IN     CONST OC_BN_WORD  *RSqrMod,
-  IN     OC_BN_WORD        *ATmp
+  IN     OC_BN_WORD        *Scratch
   );
 
 #endif // BIG_NUM_LIB_H
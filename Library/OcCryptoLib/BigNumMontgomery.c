@@ -551,6 +551,166 @@ BigNumMontMul1 (
   //
 }
 
+/**
+  Calculates the Montgomery square of A mod N. Unlike BigNumMontMul, the
+  cross products are calculated only once and doubled, and the Montgomery
+  Reduction is performed separately on the full square.
+
+  @param[in,out] Result    The result buffer. May be the same as A.
+  @param[in]     NumWords  The number of Words of Result, A and N.
+  @param[in]     A         The number to square.
+  @param[in]     N         The modulus.
+  @param[in]     N0Inv     The Montgomery Inverse of N.
+  @param[in]     Product   Scratch buffer of 2 * NumWords + 1 Words.
+
+**/
+STATIC
+VOID
+BigNumMontSqr (
+  IN OUT OC_BN_WORD        *Result,
+  IN     OC_BN_NUM_WORDS   NumWords,
+  IN     CONST OC_BN_WORD  *A,
+  IN     CONST OC_BN_WORD  *N,
+  IN     OC_BN_WORD        N0Inv,
+  IN     OC_BN_WORD        *Product
+  )
+{
+  UINTN  RowIndex;
+  UINTN  CompIndex;
+
+  OC_BN_WORD  Carry;
+  OC_BN_WORD  SqrHi;
+  OC_BN_WORD  SqrLo;
+  OC_BN_WORD  Word;
+  OC_BN_WORD  TFirst;
+
+  ASSERT (Result != NULL);
+  ASSERT (NumWords > 0);
+  ASSERT (A != NULL);
+  ASSERT (N != NULL);
+  ASSERT (N0Inv != 0);
+  ASSERT (Product != NULL);
+
+  ZeroMem (Product, OC_BN_SIZE (2 * NumWords + 1));
+  //
+  // Calculate the cross products A[i] * A[j] with i < j.
+  //
+  for (RowIndex = 0; RowIndex < NumWords; ++RowIndex) {
+    Carry = 0;
+    for (CompIndex = RowIndex + 1; CompIndex < NumWords; ++CompIndex) {
+      Product[RowIndex + CompIndex] = BigNumWordAddMulCarry (
+                                        &Carry,
+                                        Product[RowIndex + CompIndex],
+                                        A[RowIndex],
+                                        A[CompIndex],
+                                        Carry
+                                        );
+    }
+
+    Product[RowIndex + NumWords] = Carry;
+  }
+
+  //
+  // Double the cross products. As they are less than A^2 / 2, the most
+  // significant bit is always clear.
+  //
+  Carry = 0;
+  for (CompIndex = 0; CompIndex < 2U * NumWords; ++CompIndex) {
+    Word               = Product[CompIndex];
+    Product[CompIndex] = (Word << 1U) | Carry;
+    Carry              = Word >> (OC_BN_WORD_NUM_BITS - 1);
+  }
+
+  //
+  // Add the squares A[i]^2 on the diagonal.
+  //
+  Carry = 0;
+  for (RowIndex = 0; RowIndex < NumWords; ++RowIndex) {
+    SqrLo = BigNumWordMul (&SqrHi, A[RowIndex], A[RowIndex]);
+
+    Word  = Product[2 * RowIndex] + Carry;
+    Carry = Word < Carry;
+    Word += SqrLo;
+    if (Word < SqrLo) {
+      ++Carry;
+    }
+
+    Product[2 * RowIndex] = Word;
+    //
+    // SqrHi is at most 2^#Bits(Word) - 2 and Carry at most 1 here.
+    //
+    SqrHi += Carry;
+    Word   = Product[2 * RowIndex + 1] + SqrHi;
+    Carry  = Word < SqrHi;
+
+    Product[2 * RowIndex + 1] = Word;
+  }
+
+  //
+  // Montgomery Reduction of the square, one Word per row.
+  // C = (C + t_first * N) / R
+  //
+  for (RowIndex = 0; RowIndex < NumWords; ++RowIndex) {
+    TFirst = Product[RowIndex] * N0Inv;
+    Carry  = 0;
+    for (CompIndex = 0; CompIndex < NumWords; ++CompIndex) {
+      Product[RowIndex + CompIndex] = BigNumWordAddMulCarry (
+                                        &Carry,
+                                        Product[RowIndex + CompIndex],
+                                        TFirst,
+                                        N[CompIndex],
+                                        Carry
+                                        );
+    }
+
+    for (CompIndex = RowIndex + NumWords; Carry != 0; ++CompIndex) {
+      ASSERT (CompIndex <= 2U * NumWords);
+      Product[CompIndex] += Carry;
+      Carry               = Product[CompIndex] < Carry;
+    }
+  }
+
+  CopyMem (Result, &Product[NumWords], OC_BN_SIZE (NumWords));
+  //
+  // As with BigNumMontMulRow, reduce mod N only when the result does not fit.
+  //
+  if (Product[2 * NumWords] != 0) {
+    BigNumSub (Result, NumWords, Result, N);
+  }
+}
+
+/**
+  Returns the sliding window size for exponent B.
+
+  @param[in] B  The exponent.
+
+  @returns  The window size, in bits.
+
+**/
+STATIC
+UINT8
+BigNumPowWindowBits (
+  IN UINT32  B
+  )
+{
+  INTN  NumBits;
+
+  NumBits = HighBitSet32 (B) + 1;
+  //
+  // Precomputing the odd powers costs 2^(w-1) multiplications and saves
+  // roughly NumBits * (1/2 - 1/(w+1)) of them.
+  //
+  if (NumBits > 23) {
+    return 3;
+  }
+
+  if (NumBits > 7) {
+    return 2;
+  }
+
+  return 1;
+}
+
 BOOLEAN
 BigNumPowMod (
   IN OUT OC_BN_WORD        *Result,
@@ -560,10 +720,21 @@ BigNumPowMod (
   IN     CONST OC_BN_WORD  *N,
   IN     OC_BN_WORD        N0Inv,
   IN     CONST OC_BN_WORD  *RSqrMod,
-  IN     OC_BN_WORD        *ATmp
+  IN     OC_BN_WORD        *Scratch
   )
 {
-  UINTN  Index;
+  UINTN       Index;
+  OC_BN_WORD  *Table;
+  OC_BN_WORD  *ATmp;
+  OC_BN_WORD  *Product;
+  OC_BN_WORD  *Cur;
+  OC_BN_WORD  *Other;
+  OC_BN_WORD  *Swap;
+  UINT8       WindowBits;
+  UINT32      WindowValue;
+  INTN        BitIndex;
+  INTN        WindowLow;
+  BOOLEAN     First;
 
   ASSERT (Result != NULL);
   ASSERT (NumWords > 0);
@@ -571,33 +742,38 @@ BigNumPowMod (
   ASSERT (N != NULL);
   ASSERT (N0Inv != 0);
   ASSERT (RSqrMod != NULL);
+  ASSERT (Scratch != NULL);
+
   //
-  // Currently, only the most frequent exponents are supported.
+  // Only odd exponents of at least 3 are valid RSA public exponents,
+  // with e = 1 the signature would be the padded digest itself.
   //
-  if ((B != 0x10001) && (B != 3)) {
+  if ((B < 3) || ((B & 1U) == 0)) {
     DEBUG ((DEBUG_INFO, "OCCR: Unsupported exponent: %x\n", B));
     return FALSE;
   }
 
+  //
+  // Table holds odd powers A'^1, A'^3, ..., A'^(2^w - 1) in the Montgomery
+  // Domain, followed by a temporary and the square product.
+  //
+  Table   = &Scratch[0];
+  ATmp    = &Scratch[OC_BN_POW_MOD_TABLE_LEN * NumWords];
+  Product = &ATmp[NumWords];
+
   //
   // Convert A into the Montgomery Domain.
-  // ATmp = MM (A, R^2 mod N)
+  // A' = MM (A, R^2 mod N)
   //
-  BigNumMontMul (ATmp, NumWords, A, RSqrMod, N, N0Inv);
+  BigNumMontMul (Table, NumWords, A, RSqrMod, N, N0Inv);
 
   if (B == 0x10001) {
     //
     // Squaring the intermediate results 16 times yields A'^ (2^16).
     //
-    for (Index = 0; Index < 16; Index += 2) {
-      //
-      // Result = MM (ATmp, ATmp)
-      //
-      BigNumMontMul (Result, NumWords, ATmp, ATmp, N, N0Inv);
-      //
-      // ATmp = MM (Result, Result)
-      //
-      BigNumMontMul (ATmp, NumWords, Result, Result, N, N0Inv);
+    BigNumMontSqr (ATmp, NumWords, Table, N, N0Inv, Product);
+    for (Index = 1; Index < 16; ++Index) {
+      BigNumMontSqr (ATmp, NumWords, ATmp, N, N0Inv, Product);
     }
 
     //
@@ -607,21 +783,80 @@ BigNumPowMod (
     //
     BigNumMontMul (Result, NumWords, ATmp, A, N, N0Inv);
   } else {
+    WindowBits = BigNumPowWindowBits (B);
+    ASSERT ((1U << (WindowBits - 1U)) <= OC_BN_POW_MOD_TABLE_LEN);
     //
-    // Result = MM (ATmp, ATmp)
+    // Precompute the odd powers with A'^2 in ATmp.
     //
-    BigNumMontMul (Result, NumWords, ATmp, ATmp, N, N0Inv);
+    if (WindowBits > 1) {
+      BigNumMontSqr (ATmp, NumWords, Table, N, N0Inv, Product);
+      for (Index = 1; Index < (1U << (WindowBits - 1U)); ++Index) {
+        BigNumMontMul (
+          &Table[Index * NumWords],
+          NumWords,
+          &Table[(Index - 1) * NumWords],
+          ATmp,
+          N,
+          N0Inv
+          );
+      }
+    }
+
     //
-    // ATmp = MM (Result, ATmp)
+    // Left-to-right sliding window exponentiation. Each window starts and
+    // ends with a set bit, so its value is odd and found in Table.
     //
-    BigNumMontMul (ATmp, NumWords, Result, ATmp, N, N0Inv);
+    Cur      = Result;
+    Other    = ATmp;
+    First    = TRUE;
+    BitIndex = HighBitSet32 (B);
+    while (BitIndex >= 0) {
+      if ((B & (1U << BitIndex)) == 0) {
+        BigNumMontSqr (Cur, NumWords, Cur, N, N0Inv, Product);
+        --BitIndex;
+        continue;
+      }
+
+      WindowLow = MAX (BitIndex - WindowBits + 1, 0);
+      while ((B & (1U << WindowLow)) == 0) {
+        ++WindowLow;
+      }
+
+      WindowValue = (B >> WindowLow) & ((1U << (BitIndex - WindowLow + 1)) - 1U);
+
+      if (First) {
+        CopyMem (Cur, &Table[(WindowValue >> 1U) * NumWords], OC_BN_SIZE (NumWords));
+        First = FALSE;
+      } else {
+        for (Index = 0; Index < (UINTN)(BitIndex - WindowLow + 1); ++Index) {
+          BigNumMontSqr (Cur, NumWords, Cur, N, N0Inv, Product);
+        }
+
+        BigNumMontMul (
+          Other,
+          NumWords,
+          Cur,
+          &Table[(WindowValue >> 1U) * NumWords],
+          N,
+          N0Inv
+          );
+        Swap  = Cur;
+        Cur   = Other;
+        Other = Swap;
+      }
+
+      BitIndex = WindowLow - 1;
+    }
+
     //
     // Perform a Montgomery Multiplication with 1, which effectively is a
     // division by R, taking the result out of the Montgomery Domain.
-    // C = MM (ATmp, 1)
-    // TODO: Is this needed or can we just multiply with A above?
+    // C = MM (Cur, 1)
     //
-    BigNumMontMul1 (Result, NumWords, ATmp, N, N0Inv);
+    BigNumMontMul1 (Other, NumWords, Cur, N, N0Inv);
+    if (Other != Result) {
+      CopyMem (Result, Other, OC_BN_SIZE (NumWords));
+    }
   }
 
   //
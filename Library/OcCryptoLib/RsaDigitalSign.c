@@ -154,7 +154,7 @@ SigVerifyShaHashBySize (
   @param[in] Hash           The Hash digest of the signed data.
   @param[in] HashSize       Size, in bytes, of Hash.
   @param[in] Algorithm      The RSA algorithm used.
-  @param[in] Scratch        Scratch buffer 3xModulo.
+  @param[in] Scratch        Scratch buffer RSA_SCRATCH_BUFFER_SIZE(Modulus).
 
   @returns  Whether the signature has been successfully verified as valid.
 
@@ -391,7 +391,7 @@ RsaVerifySigHashFromProcessed (
   @param[in] Data           The signed data to verify.
   @param[in] DataSize       Size, in bytes, of Data.
   @param[in] Algorithm      The RSA algorithm used.
-  @param[in] Scratch        Scratch buffer 3xModulo.
+  @param[in] Scratch        Scratch buffer RSA_SCRATCH_BUFFER_SIZE(Modulus).
 
   @returns  Whether the signature has been successfully verified as valid.
 
@@ -484,103 +484,341 @@ RsaVerifySigDataFromProcessed (
 
 #ifndef OC_CRYPTO_STATIC_MEMORY_ALLOCATION
 
-BOOLEAN
-RsaVerifySigDataFromData (
-  IN CONST UINT8       *Modulus,
-  IN UINTN             ModulusSize,
-  IN UINT32            Exponent,
-  IN CONST UINT8       *Signature,
-  IN UINTN             SignatureSize,
-  IN CONST UINT8       *Data,
-  IN UINTN             DataSize,
-  IN OC_SIG_HASH_TYPE  Algorithm
+struct OC_RSA_KEY_HANDLE_ {
+  ///
+  /// The number of Words of N and RSqrMod.
+  ///
+  OC_BN_NUM_WORDS    NumWords;
+  ///
+  /// The RSA exponent.
+  ///
+  UINT32             Exponent;
+  ///
+  /// The Montgomery Inverse of N.
+  ///
+  OC_BN_WORD         N0Inv;
+  ///
+  /// The RSA modulus.
+  ///
+  OC_BN_WORD         *N;
+  ///
+  /// Montgomery's R^2 mod N.
+  ///
+  OC_BN_WORD         *RSqrMod;
+  ///
+  /// Scratch buffer RSA_SCRATCH_BUFFER_SIZE(Modulus) for verification.
+  ///
+  OC_BN_WORD         *Scratch;
+};
+
+//
+// Number of key handles cached for RsaVerifySigDataFromData.
+//
+#define RSA_KEY_HANDLE_CACHE_SIZE  4U
+
+STATIC OC_RSA_KEY_HANDLE  *mRsaKeyHandleCache[RSA_KEY_HANDLE_CACHE_SIZE];
+STATIC UINTN              mRsaKeyHandleCacheNext;
+
+STATIC_ASSERT (
+  RSA_SCRATCH_BUFFER_SIZE (OC_BN_WORD_SIZE)
+  == 2 * OC_BN_WORD_SIZE + BIG_NUM_POW_MOD_SCRATCH_SIZE (1),
+  "RSA_SCRATCH_BUFFER_SIZE must match RsaVerifySigHashFromProcessed usage"
+  );
+
+/**
+  Allocate RSA key handle with space for N, RSqrMod, and scratch buffer.
+
+  @param[in] NumWords  The number of Words of N.
+  @param[in] Exponent  The RSA exponent.
+
+  @returns  Key handle or NULL.
+
+**/
+STATIC
+OC_RSA_KEY_HANDLE *
+InternalRsaAllocateKeyHandle (
+  IN OC_BN_NUM_WORDS  NumWords,
+  IN UINT32           Exponent
   )
 {
-  OC_BN_NUM_WORDS  ModulusNumWords;
+  OC_RSA_KEY_HANDLE  *Handle;
+  OC_BN_SIZE         ModulusSize;
+
+  ASSERT (NumWords > 0);
+  ASSERT (NumWords <= OC_BN_MONT_MAX_LEN);
 
-  OC_BN_WORD  *Memory;
-  VOID        *Mont;
-  OC_BN_WORD  *N;
-  OC_BN_WORD  *RSqrMod;
-  VOID        *Scratch;
+  ModulusSize = OC_BN_SIZE (NumWords);
 
-  OC_BN_WORD  N0Inv;
-  BOOLEAN     Result;
+  STATIC_ASSERT (
+    RSA_MOD_MAX_SIZE <= OC_BN_MONT_MAX_SIZE,
+    "The allocation size below may overflow"
+    );
+
+  Handle = AllocatePool (
+             sizeof (*Handle) + 2 * ModulusSize + RSA_SCRATCH_BUFFER_SIZE (ModulusSize)
+             );
+  if (Handle == NULL) {
+    return NULL;
+  }
+
+  Handle->NumWords = NumWords;
+  Handle->Exponent = Exponent;
+  Handle->N0Inv    = 0;
+  Handle->N        = (OC_BN_WORD *)(Handle + 1);
+  Handle->RSqrMod  = &Handle->N[NumWords];
+  Handle->Scratch  = &Handle->RSqrMod[NumWords];
+
+  return Handle;
+}
+
+OC_RSA_KEY_HANDLE *
+RsaCreateKeyHandleFromData (
+  IN CONST UINT8  *Modulus,
+  IN UINTN        ModulusSize,
+  IN UINT32       Exponent
+  )
+{
+  OC_RSA_KEY_HANDLE  *Handle;
+  OC_BN_NUM_WORDS    ModulusNumWords;
+  VOID               *Mont;
 
   ASSERT (Modulus != NULL);
   ASSERT (ModulusSize > 0);
   ASSERT (Exponent > 0);
-  ASSERT (Signature != NULL);
-  ASSERT (SignatureSize > 0);
-  ASSERT (Data != NULL);
-  ASSERT (DataSize > 0);
 
-  if (  (ModulusSize > OC_BN_MONT_MAX_SIZE)
-     || ((ModulusSize % OC_BN_WORD_SIZE) != 0))
+  if (  (ModulusSize == 0)
+     || (ModulusSize > RSA_MOD_MAX_SIZE)
+     || ((ModulusSize % OC_BN_WORD_SIZE) != 0)
+     || (Exponent < 3)
+     || ((Exponent & 1U) == 0))
   {
-    return FALSE;
+    return NULL;
   }
 
-  STATIC_ASSERT (
-    RSA_MOD_MAX_SIZE <= OC_BN_MONT_MAX_SIZE,
-    "The usage of BIG_NUM_MONT_PARAMS_SCRATCH_SIZE may be unsafe"
-    );
   //
-  // By definition: ModulusNumWords <= OC_BN_MONT_MAX_SIZE <= OC_BN_MAX_SIZE.
+  // This cannot truncate as RSA_MOD_MAX_SIZE <= OC_BN_MONT_MAX_SIZE.
   //
   ModulusNumWords = (OC_BN_NUM_WORDS)(ModulusSize / OC_BN_WORD_SIZE);
 
+  Handle = InternalRsaAllocateKeyHandle (ModulusNumWords, Exponent);
+  if (Handle == NULL) {
+    return NULL;
+  }
+
+  Mont = AllocatePool (BIG_NUM_MONT_PARAMS_SCRATCH_SIZE (ModulusNumWords));
+  if (Mont == NULL) {
+    FreePool (Handle);
+    return NULL;
+  }
+
+  BigNumParseBuffer (Handle->N, ModulusNumWords, Modulus, ModulusSize);
+
+  Handle->N0Inv = BigNumCalculateMontParams (
+                    Handle->RSqrMod,
+                    ModulusNumWords,
+                    Handle->N,
+                    Mont
+                    );
+
+  FreePool (Mont);
+
+  if (Handle->N0Inv == 0) {
+    FreePool (Handle);
+    return NULL;
+  }
+
+  return Handle;
+}
+
+OC_RSA_KEY_HANDLE *
+RsaCreateKeyHandleFromKey (
+  IN CONST OC_RSA_PUBLIC_KEY  *Key
+  )
+{
+  OC_RSA_KEY_HANDLE  *Handle;
+  OC_BN_SIZE         ModulusSize;
+
+  ASSERT (Key != NULL);
+
   STATIC_ASSERT (
-    OC_BN_MAX_SIZE <= MAX_UINTN / 2,
-    "An overflow verification must be added"
+    OC_BN_WORD_SIZE <= 8,
+    "The parentheses need to be changed to avoid truncation."
     );
 
-  Memory = AllocatePool (
-             2 * ModulusSize + BIG_NUM_MONT_PARAMS_SCRATCH_SIZE (ModulusNumWords)
+  ModulusSize = (OC_BN_SIZE)Key->Hdr.NumQwords * sizeof (UINT64);
+  if ((ModulusSize == 0) || (ModulusSize > RSA_MOD_MAX_SIZE)) {
+    return NULL;
+  }
+
+  Handle = InternalRsaAllocateKeyHandle (
+             (OC_BN_NUM_WORDS)(ModulusSize / OC_BN_WORD_SIZE),
+             0x10001
              );
-  if (Memory == NULL) {
-    return FALSE;
+  if (Handle == NULL) {
+    return NULL;
   }
 
-  N       = &Memory[0 * ModulusNumWords];
-  RSqrMod = &Memory[1 * ModulusNumWords];
-  Mont    = &Memory[2 * ModulusNumWords];
+  Handle->N0Inv = (OC_BN_WORD)Key->Hdr.N0Inv;
+  CopyMem (Handle->N, Key->Data, ModulusSize);
+  CopyMem (Handle->RSqrMod, &Key->Data[Key->Hdr.NumQwords], ModulusSize);
+
+  return Handle;
+}
 
-  BigNumParseBuffer (N, ModulusNumWords, Modulus, ModulusSize);
+BOOLEAN
+RsaVerifySigHashFromHandle (
+  IN OUT OC_RSA_KEY_HANDLE  *Handle,
+  IN     CONST UINT8        *Signature,
+  IN     UINTN              SignatureSize,
+  IN     CONST UINT8        *Hash,
+  IN     UINTN              HashSize,
+  IN     OC_SIG_HASH_TYPE   Algorithm
+  )
+{
+  ASSERT (Handle != NULL);
 
-  N0Inv = BigNumCalculateMontParams (RSqrMod, ModulusNumWords, N, Mont);
-  if (N0Inv == 0) {
-    FreePool (Memory);
-    return FALSE;
+  return RsaVerifySigHashFromProcessed (
+           Handle->N,
+           Handle->NumWords,
+           Handle->N0Inv,
+           Handle->RSqrMod,
+           Handle->Exponent,
+           Signature,
+           SignatureSize,
+           Hash,
+           HashSize,
+           Algorithm,
+           Handle->Scratch
+           );
+}
+
+BOOLEAN
+RsaVerifySigDataFromHandle (
+  IN OUT OC_RSA_KEY_HANDLE  *Handle,
+  IN     CONST UINT8        *Signature,
+  IN     UINTN              SignatureSize,
+  IN     CONST UINT8        *Data,
+  IN     UINTN              DataSize,
+  IN     OC_SIG_HASH_TYPE   Algorithm
+  )
+{
+  ASSERT (Handle != NULL);
+
+  return RsaVerifySigDataFromProcessed (
+           Handle->N,
+           Handle->NumWords,
+           Handle->N0Inv,
+           Handle->RSqrMod,
+           Handle->Exponent,
+           Signature,
+           SignatureSize,
+           Data,
+           DataSize,
+           Algorithm,
+           Handle->Scratch
+           );
+}
+
+VOID
+RsaFreeKeyHandle (
+  IN OC_RSA_KEY_HANDLE  *Handle
+  )
+{
+  ASSERT (Handle != NULL);
+
+  FreePool (Handle);
+}
+
+/**
+  Find cached key handle for the RSA modulus or create a new one,
+  evicting the oldest cached handle.
+
+  @param[in] Modulus      The RSA modulus byte array.
+  @param[in] ModulusSize  The size, in bytes, of Modulus.
+  @param[in] Exponent     The RSA exponent.
+
+  @returns  Cached key handle or NULL.
+
+**/
+STATIC
+OC_RSA_KEY_HANDLE *
+InternalRsaGetCachedKeyHandle (
+  IN CONST UINT8  *Modulus,
+  IN UINTN        ModulusSize,
+  IN UINT32       Exponent
+  )
+{
+  OC_RSA_KEY_HANDLE  *Handle;
+  UINTN              Index;
+
+  for (Index = 0; Index < RSA_KEY_HANDLE_CACHE_SIZE; ++Index) {
+    Handle = mRsaKeyHandleCache[Index];
+    if (  (Handle == NULL)
+       || (Handle->Exponent != Exponent)
+       || (OC_BN_SIZE (Handle->NumWords) != ModulusSize))
+    {
+      continue;
+    }
+
+    //
+    // Compare in parsed form, which is what the handle stores.
+    //
+    BigNumParseBuffer (Handle->Scratch, Handle->NumWords, Modulus, ModulusSize);
+    if (CompareMem (Handle->Scratch, Handle->N, ModulusSize) == 0) {
+      return Handle;
+    }
   }
 
-  //
-  // This usage of RSA_SCRATCH_BUFFER_SIZE may overflow. However, the caller
-  // will error in this case before accessing the buffer.
-  //
-  Scratch = AllocatePool (RSA_SCRATCH_BUFFER_SIZE (ModulusSize));
-  if (Scratch == NULL) {
-    FreePool (Memory);
-    return FALSE;
+  Handle = RsaCreateKeyHandleFromData (Modulus, ModulusSize, Exponent);
+  if (Handle == NULL) {
+    return NULL;
   }
 
-  Result = RsaVerifySigDataFromProcessed (
-             N,
-             ModulusNumWords,
-             N0Inv,
-             RSqrMod,
-             Exponent,
-             Signature,
-             SignatureSize,
-             Data,
-             DataSize,
-             Algorithm,
-             Scratch
-             );
+  if (mRsaKeyHandleCache[mRsaKeyHandleCacheNext] != NULL) {
+    RsaFreeKeyHandle (mRsaKeyHandleCache[mRsaKeyHandleCacheNext]);
+  }
 
-  FreePool (Scratch);
-  FreePool (Memory);
-  return Result;
+  mRsaKeyHandleCache[mRsaKeyHandleCacheNext] = Handle;
+  mRsaKeyHandleCacheNext                     = (mRsaKeyHandleCacheNext + 1) % RSA_KEY_HANDLE_CACHE_SIZE;
+
+  return Handle;
+}
+
+BOOLEAN
+RsaVerifySigDataFromData (
+  IN CONST UINT8       *Modulus,
+  IN UINTN             ModulusSize,
+  IN UINT32            Exponent,
+  IN CONST UINT8       *Signature,
+  IN UINTN             SignatureSize,
+  IN CONST UINT8       *Data,
+  IN UINTN             DataSize,
+  IN OC_SIG_HASH_TYPE  Algorithm
+  )
+{
+  OC_RSA_KEY_HANDLE  *Handle;
+
+  ASSERT (Modulus != NULL);
+  ASSERT (ModulusSize > 0);
+  ASSERT (Exponent > 0);
+  ASSERT (Signature != NULL);
+  ASSERT (SignatureSize > 0);
+  ASSERT (Data != NULL);
+  ASSERT (DataSize > 0);
+
+  Handle = InternalRsaGetCachedKeyHandle (Modulus, ModulusSize, Exponent);
+  if (Handle == NULL) {
+    return FALSE;
+  }
+
+  return RsaVerifySigDataFromHandle (
+           Handle,
+           Signature,
+           SignatureSize,
+           Data,
+           DataSize,
+           Algorithm
+           );
 }
 
 #endif
@@ -166,60 +166,101 @@ STATIC CONST UINT64  SHA512_H0[8] = {
 #endif
 
 #ifdef OC_CRYPTO_SUPPORTS_SHA256
+//
+// Accelerated Sha 256 transform, detected on first use.
+//
+STATIC BOOLEAN                 mSha256AccelDetected;
+STATIC BOOLEAN                 mSha256AccelAvx;
+STATIC SHA256_TRANSFORM_ACCEL  mSha256TransformAccel;
+
 //
 // Sha 256 functions
 //
 VOID
 Sha256Transform (
-  SHA256_CONTEXT  *Context,
-  CONST UINT8     *Data
+  UINT32       *State,
+  CONST UINT8  *Data,
+  UINTN        BlockNb
   )
 {
   UINT32  A, B, C, D, E, F, G, H, Index1, Index2, T1, T2;
   UINT32  M[64];
 
-  for (Index1 = 0, Index2 = 0; Index1 < 16; Index1++, Index2 += 4) {
-    M[Index1] = ((UINT32)Data[Index2] << 24)
-                | ((UINT32)Data[Index2 + 1] << 16)
-                | ((UINT32)Data[Index2 + 2] << 8)
-                | ((UINT32)Data[Index2 + 3]);
-  }
+  for ( ; BlockNb > 0; --BlockNb, Data += SHA256_BLOCK_SIZE) {
+    for (Index1 = 0, Index2 = 0; Index1 < 16; Index1++, Index2 += 4) {
+      M[Index1] = ((UINT32)Data[Index2] << 24)
+                  | ((UINT32)Data[Index2 + 1] << 16)
+                  | ((UINT32)Data[Index2 + 2] << 8)
+                  | ((UINT32)Data[Index2 + 3]);
+    }
 
-  for ( ; Index1 < 64; ++Index1) {
-    M[Index1] = SHA256_SIG1 (M[Index1 - 2]) + M[Index1 - 7]
-                + SHA256_SIG0 (M[Index1 - 15]) + M[Index1 - 16];
+    for ( ; Index1 < 64; ++Index1) {
+      M[Index1] = SHA256_SIG1 (M[Index1 - 2]) + M[Index1 - 7]
+                  + SHA256_SIG0 (M[Index1 - 15]) + M[Index1 - 16];
+    }
+
+    A = State[0];
+    B = State[1];
+    C = State[2];
+    D = State[3];
+    E = State[4];
+    F = State[5];
+    G = State[6];
+    H = State[7];
+
+    for (Index1 = 0; Index1 < 64; ++Index1) {
+      T1 = H + SHA256_EP1 (E) + CH (E, F, G) + SHA256_K[Index1] + M[Index1];
+      T2 = SHA256_EP0 (A) + MAJ (A, B, C);
+      H  = G;
+      G  = F;
+      F  = E;
+      E  = D + T1;
+      D  = C;
+      C  = B;
+      B  = A;
+      A  = T1 + T2;
+    }
+
+    State[0] += A;
+    State[1] += B;
+    State[2] += C;
+    State[3] += D;
+    State[4] += E;
+    State[5] += F;
+    State[6] += G;
+    State[7] += H;
   }
+}
 
-  A = Context->State[0];
-  B = Context->State[1];
-  C = Context->State[2];
-  D = Context->State[3];
-  E = Context->State[4];
-  F = Context->State[5];
-  G = Context->State[6];
-  H = Context->State[7];
-
-  for (Index1 = 0; Index1 < 64; ++Index1) {
-    T1 = H + SHA256_EP1 (E) + CH (E, F, G) + SHA256_K[Index1] + M[Index1];
-    T2 = SHA256_EP0 (A) + MAJ (A, B, C);
-    H  = G;
-    G  = F;
-    F  = E;
-    E  = D + T1;
-    D  = C;
-    C  = B;
-    B  = A;
-    A  = T1 + T2;
+/**
+  Process SHA-256 blocks with the fastest available transform.
+
+  @param[in,out] State    SHA-256 state.
+  @param[in]     Data     Message blocks.
+  @param[in]     BlockNb  Number of message blocks.
+**/
+STATIC
+VOID
+Sha256TransformBlocks (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  )
+{
+  //
+  // AVX transform becomes usable once TryEnableAccel succeeds, so redetect.
+  //
+  if (!mSha256AccelDetected || (mSha256AccelAvx != mIsAccelEnabled)) {
+    mSha256TransformAccel = Sha256GetTransformAccel ();
+    mSha256AccelAvx       = mIsAccelEnabled;
+    mSha256AccelDetected  = TRUE;
   }
 
-  Context->State[0] += A;
-  Context->State[1] += B;
-  Context->State[2] += C;
-  Context->State[3] += D;
-  Context->State[4] += E;
-  Context->State[5] += F;
-  Context->State[6] += G;
-  Context->State[7] += H;
+  if (mSha256TransformAccel != NULL) {
+    mSha256TransformAccel (State, Data, BlockNb);
+  } else {
+    Sha256Transform (State, Data, BlockNb);
+  }
 }
 
 VOID
@@ -244,17 +285,38 @@ Sha256Update (
   UINTN           Len
   )
 {
-  UINT32  Index;
-
-  for (Index = 0; Index < Len; ++Index) {
-    Context->Data[Context->DataLen] = Data[Index];
-    Context->DataLen++;
-    if (Context->DataLen == 64) {
-      Sha256Transform (Context, Context->Data);
-      Context->BitLen += 512;
-      Context->DataLen = 0;
+  UINTN  BlockNb;
+  UINTN  RemLen;
+
+  if (Context->DataLen > 0) {
+    RemLen = MIN (Len, SHA256_BLOCK_SIZE - Context->DataLen);
+    CopyMem (&Context->Data[Context->DataLen], Data, RemLen);
+    Context->DataLen += (UINT32)RemLen;
+    Data             += RemLen;
+    Len              -= RemLen;
+
+    if (Context->DataLen < SHA256_BLOCK_SIZE) {
+      return;
     }
+
+    Sha256TransformBlocks (Context->State, Context->Data, 1);
+    Context->BitLen += 512;
+    Context->DataLen = 0;
   }
+
+  //
+  // Process whole blocks directly from the message.
+  //
+  BlockNb = Len / SHA256_BLOCK_SIZE;
+  if (BlockNb > 0) {
+    Sha256TransformBlocks (Context->State, Data, BlockNb);
+    Context->BitLen += LShiftU64 (BlockNb, 9);
+    Data            += BlockNb * SHA256_BLOCK_SIZE;
+    Len             -= BlockNb * SHA256_BLOCK_SIZE;
+  }
+
+  CopyMem (Context->Data, Data, Len);
+  Context->DataLen = (UINT32)Len;
 }
 
 VOID
@@ -276,7 +338,7 @@ Sha256Final (
   } else {
     Context->Data[Index++] = 0x80;
     ZeroMem (Context->Data + Index, 64-Index);
-    Sha256Transform (Context, Context->Data);
+    Sha256TransformBlocks (Context->State, Context->Data, 1);
     ZeroMem (Context->Data, 56);
   }
 
@@ -292,7 +354,7 @@ Sha256Final (
   Context->Data[58] = (UINT8)(Context->BitLen >> 40);
   Context->Data[57] = (UINT8)(Context->BitLen >> 48);
   Context->Data[56] = (UINT8)(Context->BitLen >> 56);
-  Sha256Transform (Context, Context->Data);
+  Sha256TransformBlocks (Context->State, Context->Data, 1);
 
   //
   // Since this implementation uses little endian byte ordering and SHA uses big endian,
@@ -0,0 +1,50 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include "Sha2Internal.h"
+
+VOID
+EFIAPI
+Sha256TransformShaNi (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  )
+{
+  (VOID)State;
+  (VOID)Data;
+  (VOID)BlockNb;
+  ASSERT (FALSE);
+}
+
+VOID
+EFIAPI
+Sha256TransformAvx2 (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  )
+{
+  (VOID)State;
+  (VOID)Data;
+  (VOID)BlockNb;
+  ASSERT (FALSE);
+}
+
+SHA256_TRANSFORM_ACCEL
+EFIAPI
+Sha256GetTransformAccel (
+  VOID
+  )
+{
+  return NULL;
+}
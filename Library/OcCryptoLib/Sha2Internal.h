@@ -23,6 +23,48 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 extern BOOLEAN  mIsAccelEnabled;
 
+typedef
+VOID
+(EFIAPI *SHA256_TRANSFORM_ACCEL)(
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  );
+
+/**
+  SHA-256 transform using SHA extensions, requires SSSE3 and SSE4.1.
+**/
+VOID
+EFIAPI
+Sha256TransformShaNi (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  );
+
+/**
+  SHA-256 transform using AVX message schedule and BMI1/BMI2 rounds,
+  requires AVX2 class CPU with AVX enabled by TryEnableAccel.
+**/
+VOID
+EFIAPI
+Sha256TransformAvx2 (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockNb
+  );
+
+/**
+  Detect the fastest supported SHA-256 transform.
+
+  @retval Accelerated transform or NULL when only C one is supported.
+**/
+SHA256_TRANSFORM_ACCEL
+EFIAPI
+Sha256GetTransformAccel (
+  VOID
+  );
+
 VOID
 EFIAPI
 Sha512TransformAccel (
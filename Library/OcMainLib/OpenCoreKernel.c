@@ -29,6 +29,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 
+//
+// Link cache file on the OpenCore volume root.
+//
+#define OC_LINK_CACHE_PATH  L"opencore-link-cache.bin"
+
 STATIC OC_STORAGE_CONTEXT  *mOcStorage;
 STATIC OC_GLOBAL_CONFIG    *mOcConfiguration;
 STATIC OC_CPU_INFO         *mOcCpuInfo;
@@ -43,6 +48,28 @@ STATIC BOOLEAN            mOcCachelessInProgress;
 STATIC EFI_FILE_PROTOCOL  *mCustomKernelDirectory;
 STATIC BOOLEAN            mCustomKernelDirectoryInProgress;
 
+STATIC OC_KERNEL_PROFILE_HANDLER  mOcKernelProfileHandler;
+
+VOID
+OcKernelSetProfileHandler (
+  IN OC_KERNEL_PROFILE_HANDLER  Handler  OPTIONAL
+  )
+{
+  mOcKernelProfileHandler = Handler;
+}
+
+VOID
+OcKernelProfile (
+  IN CONST CHAR8  *Phase,
+  IN CONST CHAR8  *Item  OPTIONAL,
+  IN BOOLEAN      Start
+  )
+{
+  if (mOcKernelProfileHandler != NULL) {
+    mOcKernelProfileHandler (Phase, Item, Start);
+  }
+}
+
 STATIC
 VOID
 OcKernelConfigureCapabilities (
@@ -640,6 +667,7 @@ OcKernelInjectKext (
                BundleVersion
                );
   } else if (CacheType == CacheTypePrelinked) {
+    OcKernelProfile ("PrelinkedInjectKext", BundlePath, TRUE);
     Status = PrelinkedInjectKext (
                Context,
                IsForced ? Identifier : NULL,
@@ -651,6 +679,7 @@ OcKernelInjectKext (
                Kext->ImageDataSize,
                BundleVersion
                );
+    OcKernelProfile ("PrelinkedInjectKext", BundlePath, FALSE);
   } else {
     Status = EFI_UNSUPPORTED;
   }
@@ -696,11 +725,13 @@ OcKernelInjectKexts (
   UINT32      Index;
 
   if (CacheType == CacheTypePrelinked) {
+    OcKernelProfile ("PrelinkedInjectPrepare", NULL, TRUE);
     Status = PrelinkedInjectPrepare (
                Context,
                LinkedExpansion,
                ReservedExeSize
                );
+    OcKernelProfile ("PrelinkedInjectPrepare", NULL, FALSE);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_WARN, "OC: Prelink inject prepare error - %r\n", Status));
       return;
@@ -753,7 +784,9 @@ OcKernelInjectKexts (
       ((PRELINKED_CONTEXT *)Context)->KextsFileOffset <= ReservedExeSize
       );
 
+    OcKernelProfile ("PrelinkedInjectComplete", NULL, TRUE);
     Status = PrelinkedInjectComplete (Context);
+    OcKernelProfile ("PrelinkedInjectComplete", NULL, FALSE);
   } else {
     Status = EFI_UNSUPPORTED;
   }
@@ -763,6 +796,114 @@ OcKernelInjectKexts (
   }
 }
 
+/**
+  Check whether link cache can be used.
+
+  @param[in] Config  OpenCore configuration.
+
+  @return  TRUE when link cache is enabled.
+**/
+STATIC
+BOOLEAN
+OcKernelUseLinkCache (
+  IN OC_GLOBAL_CONFIG  *Config
+  )
+{
+  //
+  // Link cache is not covered by vault and cannot be trusted with it.
+  // Storage is also unavailable when called from userspace utilities.
+  //
+  return Config->Kernel.Scheme.LinkCache
+         && (mOcStorage != NULL)
+         && !mOcStorage->HasVault;
+}
+
+/**
+  Import link cache for prelinked dependency kexts.
+
+  @param[in]     Config   OpenCore configuration.
+  @param[in,out] Context  Prelinked context.
+**/
+STATIC
+VOID
+OcKernelLoadLinkCache (
+  IN     OC_GLOBAL_CONFIG   *Config,
+  IN OUT PRELINKED_CONTEXT  *Context
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Cache;
+  UINT32      CacheSize;
+
+  if (!OcKernelUseLinkCache (Config)) {
+    return;
+  }
+
+  Cache = OcReadFile (mOcStorage->FileSystem, OC_LINK_CACHE_PATH, &CacheSize, 0);
+  if (Cache == NULL) {
+    DEBUG ((DEBUG_INFO, "OC: Link cache is missing\n"));
+    return;
+  }
+
+  Status = PrelinkedImportLinkCache (
+             Context,
+             Cache,
+             CacheSize,
+             mKernelDigest,
+             OcMiscGetVersionString ()
+             );
+  FreePool (Cache);
+
+  DEBUG ((DEBUG_INFO, "OC: Link cache import of %u bytes - %r\n", CacheSize, Status));
+}
+
+/**
+  Export link cache for prelinked dependency kexts if it changed.
+
+  @param[in] Config   OpenCore configuration.
+  @param[in] Context  Prelinked context.
+**/
+STATIC
+VOID
+OcKernelSaveLinkCache (
+  IN OC_GLOBAL_CONFIG   *Config,
+  IN PRELINKED_CONTEXT  *Context
+  )
+{
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL  *Root;
+  VOID               *Cache;
+  UINT32             CacheSize;
+
+  if (!OcKernelUseLinkCache (Config)) {
+    return;
+  }
+
+  Status = PrelinkedExportLinkCache (
+             Context,
+             mKernelDigest,
+             OcMiscGetVersionString (),
+             &Cache,
+             &CacheSize
+             );
+  if (Status == EFI_ALREADY_STARTED) {
+    DEBUG ((DEBUG_INFO, "OC: Link cache is up to date\n"));
+    return;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = mOcStorage->FileSystem->OpenVolume (mOcStorage->FileSystem, &Root);
+    if (!EFI_ERROR (Status)) {
+      Status = OcSetFileData (Root, OC_LINK_CACHE_PATH, Cache, CacheSize);
+      Root->Close (Root);
+    }
+
+    FreePool (Cache);
+  }
+
+  DEBUG ((DEBUG_INFO, "OC: Link cache export - %r\n", Status));
+}
+
 EFI_STATUS
 OcKernelProcessPrelinked (
   IN     OC_GLOBAL_CONFIG  *Config,
@@ -778,13 +919,23 @@ OcKernelProcessPrelinked (
   EFI_STATUS         Status;
   PRELINKED_CONTEXT  Context;
 
+  OcKernelProfile ("PrelinkedContextInit", NULL, TRUE);
   Status = PrelinkedContextInit (&Context, Kernel, *KernelSize, AllocatedSize, Is32Bit);
+  OcKernelProfile ("PrelinkedContextInit", NULL, FALSE);
 
   if (!EFI_ERROR (Status)) {
+    OcKernelProfile ("LinkCacheLoad", NULL, TRUE);
+    OcKernelLoadLinkCache (Config, &Context);
+    OcKernelProfile ("LinkCacheLoad", NULL, FALSE);
+
     OcKernelBlockKexts (Config, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context);
 
     OcKernelInjectKexts (Config, CacheTypePrelinked, &Context, DarwinVersion, Is32Bit, LinkedExpansion, ReservedExeSize);
 
+    OcKernelProfile ("LinkCacheSave", NULL, TRUE);
+    OcKernelSaveLinkCache (Config, &Context);
+    OcKernelProfile ("LinkCacheSave", NULL, FALSE);
+
     OcKernelApplyPatches (Config, mOcCpuInfo, DarwinVersion, Is32Bit, CacheTypePrelinked, &Context, NULL, 0);
 
     *KernelSize = Context.PrelinkedSize;
@@ -1107,6 +1258,7 @@ OcKernelFileOpen (
   CONST CHAR8        *SecureBootModel;
   KERNEL_CACHE_TYPE  MaxCacheTypeAllowed;
   BOOLEAN            UseSecureBoot;
+  BOOLEAN            UseKernelDigest;
 
   UINT8              *Kernel;
   UINT32             KernelSize;
@@ -1142,10 +1294,11 @@ OcKernelFileOpen (
   }
 
   //
-  // We only want to calculate kernel hashes if secure boot is enabled.
+  // We only want to calculate kernel hashes if secure boot or link cache are enabled.
   //
   SecureBootModel = OC_BLOB_GET (&mOcConfiguration->Misc.Security.SecureBootModel);
   UseSecureBoot   = AsciiStrCmp (SecureBootModel, OC_SB_MODEL_DISABLED) != 0;
+  UseKernelDigest = UseSecureBoot || mOcConfiguration->Kernel.Scheme.LinkCache;
 
   //
   // Hook injected OcXXXXXXXX.kext reads from /S/L/E.
@@ -1217,7 +1370,7 @@ OcKernelFileOpen (
                &AllocatedSize,
                &ReservedExeSize,
                &LinkedExpansion,
-               UseSecureBoot ? mKernelDigest : NULL
+               UseKernelDigest ? mKernelDigest : NULL
                );
   }
 
@@ -1276,7 +1429,7 @@ OcKernelFileOpen (
                  &AllocatedSize,
                  &ReservedExeSize,
                  &LinkedExpansion,
-                 UseSecureBoot ? mKernelDigest : NULL
+                 UseKernelDigest ? mKernelDigest : NULL
                  );
 
       if (Status == EFI_NOT_FOUND) {
@@ -97,6 +97,10 @@ OcKernelApplyPatches (
   BOOLEAN                IsKernelPatch;
   UINTN                  RegisterBase;
   UINT32                 RegisterStride;
+  PATCHER_GENERIC_PATCH  *KernelPatches;
+  UINT32                 *KernelPatchIndices;
+  EFI_STATUS             *KernelPatchResults;
+  UINT32                 KernelPatchCount;
 
   IsKernelPatch = Context == NULL;
 
@@ -116,6 +120,8 @@ OcKernelApplyPatches (
     }
   }
 
+  OcKernelProfile ("Quirks", PRINT_KERNEL_CACHE_TYPE (CacheType), TRUE);
+
   //
   // Handle Quirks/Emulate here...
   //
@@ -276,6 +282,39 @@ OcKernelApplyPatches (
     }
   }
 
+  OcKernelProfile ("Quirks", PRINT_KERNEL_CACHE_TYPE (CacheType), FALSE);
+  OcKernelProfile ("Patches", PRINT_KERNEL_CACHE_TYPE (CacheType), TRUE);
+
+  //
+  // Kernel patches are collected to be applied with a single kernel scan.
+  //
+  KernelPatches      = NULL;
+  KernelPatchIndices = NULL;
+  KernelPatchResults = NULL;
+  KernelPatchCount   = 0;
+
+  if (IsKernelPatch && (Config->Kernel.Patch.Count > 0)) {
+    KernelPatches      = AllocatePool (Config->Kernel.Patch.Count * sizeof (*KernelPatches));
+    KernelPatchIndices = AllocatePool (Config->Kernel.Patch.Count * sizeof (*KernelPatchIndices));
+    KernelPatchResults = AllocatePool (Config->Kernel.Patch.Count * sizeof (*KernelPatchResults));
+    if ((KernelPatches == NULL) || (KernelPatchIndices == NULL) || (KernelPatchResults == NULL)) {
+      if (KernelPatches != NULL) {
+        FreePool (KernelPatches);
+        KernelPatches = NULL;
+      }
+
+      if (KernelPatchIndices != NULL) {
+        FreePool (KernelPatchIndices);
+        KernelPatchIndices = NULL;
+      }
+
+      if (KernelPatchResults != NULL) {
+        FreePool (KernelPatchResults);
+        KernelPatchResults = NULL;
+      }
+    }
+  }
+
   for (Index = 0; Index < Config->Kernel.Patch.Count; ++Index) {
     UserPatch = Config->Kernel.Patch.Values[Index];
     Target    = OC_BLOB_GET (&UserPatch->Identifier);
@@ -363,6 +402,13 @@ OcKernelApplyPatches (
     Patch.Skip  = UserPatch->Skip;
     Patch.Limit = UserPatch->Limit;
 
+    if (IsKernelPatch && (KernelPatches != NULL)) {
+      CopyMem (&KernelPatches[KernelPatchCount], &Patch, sizeof (Patch));
+      KernelPatchIndices[KernelPatchCount] = Index;
+      ++KernelPatchCount;
+      continue;
+    }
+
     if (IsKernelPatch) {
       Status = PatcherApplyGenericPatch (&KernelPatcher, &Patch);
     } else {
@@ -387,6 +433,30 @@ OcKernelApplyPatches (
       Status
       ));
   }
+
+  if (KernelPatches != NULL) {
+    PatcherApplyGenericPatches (&KernelPatcher, KernelPatches, KernelPatchCount, KernelPatchResults);
+
+    for (Index = 0; Index < KernelPatchCount; ++Index) {
+      UserPatch = Config->Kernel.Patch.Values[KernelPatchIndices[Index]];
+
+      DEBUG ((
+        EFI_ERROR (KernelPatchResults[Index]) ? DEBUG_WARN : DEBUG_INFO,
+        "OC: %a patcher result %u for %a (%a) - %r\n",
+        PRINT_KERNEL_CACHE_TYPE (CacheType),
+        KernelPatchIndices[Index],
+        OC_BLOB_GET (&UserPatch->Identifier),
+        OC_BLOB_GET (&UserPatch->Comment),
+        KernelPatchResults[Index]
+        ));
+    }
+
+    FreePool (KernelPatches);
+    FreePool (KernelPatchIndices);
+    FreePool (KernelPatchResults);
+  }
+
+  OcKernelProfile ("Patches", PRINT_KERNEL_CACHE_TYPE (CacheType), FALSE);
 }
 
 VOID
@@ -409,6 +479,8 @@ OcKernelBlockKexts (
   UINT32                 MaxKernel;
   UINT32                 MinKernel;
 
+  OcKernelProfile ("Block", PRINT_KERNEL_CACHE_TYPE (CacheType), TRUE);
+
   for (Index = 0; Index < Config->Kernel.Block.Count; ++Index) {
     Kext = Config->Kernel.Block.Values[Index];
 
@@ -477,4 +549,6 @@ OcKernelBlockKexts (
       Status
       ));
   }
+
+  OcKernelProfile ("Block", PRINT_KERNEL_CACHE_TYPE (CacheType), FALSE);
 }
@@ -16,8 +16,51 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcMiscLib.h>
 
+//
+// Two fully unmasked pattern bytes used to locate pattern candidates.
+//
+typedef struct {
+  UINT32    PatternIndex;
+  UINT32    AnchorOff;
+  UINT16    Key;
+} DATA_PATTERN_ANCHOR;
+
+//
+// Data size, below which compiling a pattern for a single search does not pay off.
+//
+#define DATA_PATTERN_COMPILE_THRESHOLD  4096U
+
+STATIC
+BOOLEAN
+InternalMatchPattern (
+  IN CONST UINT8   *Pattern,
+  IN CONST UINT8   *PatternMask OPTIONAL,
+  IN CONST UINT32  PatternSize,
+  IN CONST UINT8   *Data
+  )
+{
+  UINT32  Index;
+
+  if (PatternMask == NULL) {
+    for (Index = 0; Index < PatternSize; ++Index) {
+      if (Data[Index] != Pattern[Index]) {
+        return FALSE;
+      }
+    }
+  } else {
+    for (Index = 0; Index < PatternSize; ++Index) {
+      if ((Data[Index] & PatternMask[Index]) != Pattern[Index]) {
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
 STATIC
 BOOLEAN
 InternalFindPattern (
@@ -78,6 +121,120 @@ InternalFindPattern (
   return FALSE;
 }
 
+VOID
+CompilePattern (
+  IN  CONST UINT8          *Pattern,
+  IN  CONST UINT8          *PatternMask OPTIONAL,
+  IN  CONST UINT32         PatternSize,
+  OUT OC_COMPILED_PATTERN  *Compiled
+  )
+{
+  UINT32  Index;
+  UINT32  Value;
+  UINT32  RunStart;
+  UINT32  RunSize;
+  UINT32  ShiftSize;
+
+  ASSERT (Pattern != NULL);
+  ASSERT (PatternSize > 0);
+  ASSERT (Compiled != NULL);
+
+  Compiled->Pattern     = Pattern;
+  Compiled->PatternMask = PatternMask;
+  Compiled->PatternSize = PatternSize;
+
+  //
+  // Shifts are limited by the last masked byte before the tested byte,
+  // so shift on the pattern prefix ending with the longest unmasked run.
+  // The remaining pattern bytes are only compared on candidate matches.
+  //
+  ShiftSize = PatternSize;
+  if (PatternMask != NULL) {
+    RunStart = 0;
+    RunSize  = 0;
+    for (Index = 0; Index < PatternSize; ++Index) {
+      if (PatternMask[Index] != 0xFF) {
+        RunStart = Index + 1;
+      } else if (Index + 1 - RunStart > RunSize) {
+        RunSize   = Index + 1 - RunStart;
+        ShiftSize = Index + 1;
+      }
+    }
+  }
+
+  Compiled->ShiftSize = ShiftSize;
+
+  for (Value = 0; Value < ARRAY_SIZE (Compiled->Shift); ++Value) {
+    Compiled->Shift[Value] = ShiftSize;
+  }
+
+  for (Index = 0; Index + 1 < ShiftSize; ++Index) {
+    if ((PatternMask == NULL) || (PatternMask[Index] == 0xFF)) {
+      Compiled->Shift[Pattern[Index]] = ShiftSize - 1 - Index;
+    } else {
+      //
+      // Masked byte matches every value equal to the pattern byte after masking.
+      //
+      for (Value = 0; Value < ARRAY_SIZE (Compiled->Shift); ++Value) {
+        if ((Value & PatternMask[Index]) == Pattern[Index]) {
+          Compiled->Shift[Value] = ShiftSize - 1 - Index;
+        }
+      }
+    }
+  }
+}
+
+BOOLEAN
+FindCompiledPattern (
+  IN CONST OC_COMPILED_PATTERN  *Compiled,
+  IN CONST UINT8                *Data,
+  IN UINT32                     DataSize,
+  IN OUT UINT32                 *DataOff
+  )
+{
+  UINT32  LastOffset;
+  UINT32  CurrentOffset;
+  UINT32  TestIndex;
+  UINT8   TestByte;
+  UINT8   TestMask;
+  UINT8   Value;
+
+  ASSERT (Compiled != NULL);
+  ASSERT (DataOff != NULL);
+
+  if (DataSize < Compiled->PatternSize) {
+    return FALSE;
+  }
+
+  CurrentOffset = *DataOff;
+  LastOffset    = DataSize - Compiled->PatternSize;
+  TestIndex     = Compiled->ShiftSize - 1;
+  TestByte      = Compiled->Pattern[TestIndex];
+  TestMask      = Compiled->PatternMask != NULL ? Compiled->PatternMask[TestIndex] : 0xFF;
+
+  //
+  // CurrentOffset + Shift cannot wrap around, as Shift <= PatternSize.
+  //
+  while (CurrentOffset <= LastOffset) {
+    Value = Data[CurrentOffset + TestIndex];
+    if (  ((Value & TestMask) == TestByte)
+       && InternalMatchPattern (
+            Compiled->Pattern,
+            Compiled->PatternMask,
+            Compiled->PatternSize,
+            &Data[CurrentOffset]
+            ))
+    {
+      *DataOff = CurrentOffset;
+      return TRUE;
+    }
+
+    CurrentOffset += Compiled->Shift[Value];
+  }
+
+  return FALSE;
+}
+
 BOOLEAN
 FindPattern (
   IN CONST UINT8   *Pattern,
@@ -88,10 +245,20 @@ FindPattern (
   IN OUT UINT32    *DataOff
   )
 {
+  OC_COMPILED_PATTERN  Compiled;
+
   if (DataSize < PatternSize) {
     return FALSE;
   }
 
+  if (  (PatternSize > 1)
+     && (*DataOff < DataSize)
+     && (DataSize - *DataOff >= DATA_PATTERN_COMPILE_THRESHOLD))
+  {
+    CompilePattern (Pattern, PatternMask, PatternSize, &Compiled);
+    return FindCompiledPattern (&Compiled, Data, DataSize, DataOff);
+  }
+
   return InternalFindPattern (
            Pattern,
            PatternMask,
@@ -102,17 +269,19 @@ FindPattern (
            );
 }
 
+STATIC
 UINT32
-ApplyPatch (
-  IN CONST UINT8   *Pattern,
-  IN CONST UINT8   *PatternMask OPTIONAL,
-  IN CONST UINT32  PatternSize,
-  IN CONST UINT8   *Replace,
-  IN CONST UINT8   *ReplaceMask OPTIONAL,
-  IN UINT8         *Data,
-  IN UINT32        DataSize,
-  IN UINT32        Count,
-  IN UINT32        Skip
+InternalApplyPatch (
+  IN CONST UINT8                *Pattern,
+  IN CONST UINT8                *PatternMask OPTIONAL,
+  IN CONST UINT32               PatternSize,
+  IN CONST OC_COMPILED_PATTERN  *Compiled OPTIONAL,
+  IN CONST UINT8                *Replace,
+  IN CONST UINT8                *ReplaceMask OPTIONAL,
+  IN UINT8                      *Data,
+  IN UINT32                     DataSize,
+  IN UINT32                     Count,
+  IN UINT32                     Skip
   )
 {
   UINT32   ReplaceCount;
@@ -127,14 +296,23 @@ ApplyPatch (
   DataOff      = 0;
 
   while (TRUE) {
-    Found = InternalFindPattern (
-              Pattern,
-              PatternMask,
-              PatternSize,
-              Data,
-              DataSize,
-              &DataOff
-              );
+    if (Compiled != NULL) {
+      Found = FindCompiledPattern (
+                Compiled,
+                Data,
+                DataSize,
+                &DataOff
+                );
+    } else {
+      Found = InternalFindPattern (
+                Pattern,
+                PatternMask,
+                PatternSize,
+                Data,
+                DataSize,
+                &DataOff
+                );
+    }
 
     if (!Found) {
       break;
@@ -182,3 +360,278 @@ ApplyPatch (
 
   return ReplaceCount;
 }
+
+UINT32
+ApplyPatch (
+  IN CONST UINT8   *Pattern,
+  IN CONST UINT8   *PatternMask OPTIONAL,
+  IN CONST UINT32  PatternSize,
+  IN CONST UINT8   *Replace,
+  IN CONST UINT8   *ReplaceMask OPTIONAL,
+  IN UINT8         *Data,
+  IN UINT32        DataSize,
+  IN UINT32        Count,
+  IN UINT32        Skip
+  )
+{
+  OC_COMPILED_PATTERN  Compiled;
+
+  if ((PatternSize > 1) && (DataSize >= DATA_PATTERN_COMPILE_THRESHOLD)) {
+    CompilePattern (Pattern, PatternMask, PatternSize, &Compiled);
+    return InternalApplyPatch (
+             Pattern,
+             PatternMask,
+             PatternSize,
+             &Compiled,
+             Replace,
+             ReplaceMask,
+             Data,
+             DataSize,
+             Count,
+             Skip
+             );
+  }
+
+  return InternalApplyPatch (
+           Pattern,
+           PatternMask,
+           PatternSize,
+           NULL,
+           Replace,
+           ReplaceMask,
+           Data,
+           DataSize,
+           Count,
+           Skip
+           );
+}
+
+UINT32
+ApplyCompiledPatch (
+  IN CONST OC_COMPILED_PATTERN  *Compiled,
+  IN CONST UINT8                *Replace,
+  IN CONST UINT8                *ReplaceMask OPTIONAL,
+  IN UINT8                      *Data,
+  IN UINT32                     DataSize,
+  IN UINT32                     Count,
+  IN UINT32                     Skip
+  )
+{
+  ASSERT (Compiled != NULL);
+
+  return InternalApplyPatch (
+           Compiled->Pattern,
+           Compiled->PatternMask,
+           Compiled->PatternSize,
+           Compiled,
+           Replace,
+           ReplaceMask,
+           Data,
+           DataSize,
+           Count,
+           Skip
+           );
+}
+
+STATIC
+BOOLEAN
+InternalFindPatternAnchor (
+  IN  CONST OC_DATA_PATTERN  *Pattern,
+  OUT UINT32                 *AnchorOff
+  )
+{
+  UINT32   Index;
+  BOOLEAN  Found;
+
+  Found = FALSE;
+
+  for (Index = 0; Index + 1 < Pattern->PatternSize; ++Index) {
+    if (  (Pattern->PatternMask != NULL)
+       && ((Pattern->PatternMask[Index] != 0xFF) || (Pattern->PatternMask[Index + 1] != 0xFF)))
+    {
+      continue;
+    }
+
+    if (!Found) {
+      *AnchorOff = Index;
+      Found      = TRUE;
+    }
+
+    //
+    // Prefer anchors without 0x00 and 0xFF bytes, which are very common in binaries.
+    //
+    if (  (Pattern->Pattern[Index] != 0x00) && (Pattern->Pattern[Index] != 0xFF)
+       && (Pattern->Pattern[Index + 1] != 0x00) && (Pattern->Pattern[Index + 1] != 0xFF))
+    {
+      *AnchorOff = Index;
+      return TRUE;
+    }
+  }
+
+  return Found;
+}
+
+STATIC
+INTN
+EFIAPI
+InternalCompareAnchors (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST DATA_PATTERN_ANCHOR  *Anchor1;
+  CONST DATA_PATTERN_ANCHOR  *Anchor2;
+
+  Anchor1 = Buffer1;
+  Anchor2 = Buffer2;
+
+  if (Anchor1->Key != Anchor2->Key) {
+    return Anchor1->Key < Anchor2->Key ? -1 : 1;
+  }
+
+  if (Anchor1->PatternIndex != Anchor2->PatternIndex) {
+    return Anchor1->PatternIndex < Anchor2->PatternIndex ? -1 : 1;
+  }
+
+  return 0;
+}
+
+EFI_STATUS
+FindPatterns (
+  IN CONST OC_DATA_PATTERN  *Patterns,
+  IN UINT32                 PatternCount,
+  IN CONST UINT8            *Data,
+  IN UINT32                 DataSize,
+  IN OC_DATA_PATTERN_FOUND  Callback,
+  IN VOID                   *Context
+  )
+{
+  EFI_STATUS             Status;
+  DATA_PATTERN_ANCHOR    *Anchors;
+  DATA_PATTERN_ANCHOR    Scratch;
+  UINT32                 *Unanchored;
+  UINT8                  *AnchorMap;
+  UINT32                 NumAnchors;
+  UINT32                 NumUnanchored;
+  UINT32                 Index;
+  UINT32                 Low;
+  UINT32                 High;
+  UINT32                 Middle;
+  UINT32                 Offset;
+  UINT32                 DataOff;
+  UINT16                 Key;
+  CONST OC_DATA_PATTERN  *Pattern;
+
+  ASSERT (Patterns != NULL);
+  ASSERT (Data != NULL);
+  ASSERT (Callback != NULL);
+
+  if (PatternCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Anchors    = AllocatePool (PatternCount * sizeof (*Anchors));
+  Unanchored = AllocatePool (PatternCount * sizeof (*Unanchored));
+  AnchorMap  = AllocateZeroPool (BIT16 / OC_CHAR_BIT);
+  if ((Anchors == NULL) || (Unanchored == NULL) || (AnchorMap == NULL)) {
+    if (Anchors != NULL) {
+      FreePool (Anchors);
+    }
+
+    if (Unanchored != NULL) {
+      FreePool (Unanchored);
+    }
+
+    if (AnchorMap != NULL) {
+      FreePool (AnchorMap);
+    }
+
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NumAnchors    = 0;
+  NumUnanchored = 0;
+
+  for (Index = 0; Index < PatternCount; ++Index) {
+    Pattern = &Patterns[Index];
+    if ((Pattern->PatternSize == 0) || (Pattern->PatternSize > DataSize)) {
+      continue;
+    }
+
+    if (InternalFindPatternAnchor (Pattern, &Anchors[NumAnchors].AnchorOff)) {
+      Key = (UINT16)(Pattern->Pattern[Anchors[NumAnchors].AnchorOff]
+                     | (Pattern->Pattern[Anchors[NumAnchors].AnchorOff + 1] << 8U));
+      Anchors[NumAnchors].PatternIndex = Index;
+      Anchors[NumAnchors].Key          = Key;
+      AnchorMap[Key / OC_CHAR_BIT]    |= (UINT8)(1U << (Key % OC_CHAR_BIT));
+      ++NumAnchors;
+    } else {
+      Unanchored[NumUnanchored] = Index;
+      ++NumUnanchored;
+    }
+  }
+
+  QuickSort (Anchors, NumAnchors, sizeof (*Anchors), InternalCompareAnchors, &Scratch);
+
+  Status = EFI_SUCCESS;
+
+  for (Offset = 0; (Offset < DataSize) && !EFI_ERROR (Status); ++Offset) {
+    if (Offset + 1 < DataSize) {
+      Key = (UINT16)(Data[Offset] | (Data[Offset + 1] << 8U));
+      if ((AnchorMap[Key / OC_CHAR_BIT] & (1U << (Key % OC_CHAR_BIT))) != 0) {
+        Low  = 0;
+        High = NumAnchors;
+        while (Low < High) {
+          Middle = Low + (High - Low) / 2;
+          if (Anchors[Middle].Key < Key) {
+            Low = Middle + 1;
+          } else {
+            High = Middle;
+          }
+        }
+
+        for (Index = Low; (Index < NumAnchors) && (Anchors[Index].Key == Key); ++Index) {
+          if (Offset < Anchors[Index].AnchorOff) {
+            continue;
+          }
+
+          DataOff = Offset - Anchors[Index].AnchorOff;
+          Pattern = &Patterns[Anchors[Index].PatternIndex];
+          if (  (DataOff <= DataSize - Pattern->PatternSize)
+             && InternalMatchPattern (
+                  Pattern->Pattern,
+                  Pattern->PatternMask,
+                  Pattern->PatternSize,
+                  &Data[DataOff]
+                  )
+             && !Callback (Context, Anchors[Index].PatternIndex, DataOff))
+          {
+            Status = EFI_ABORTED;
+            break;
+          }
+        }
+      }
+    }
+
+    for (Index = 0; (Index < NumUnanchored) && !EFI_ERROR (Status); ++Index) {
+      Pattern = &Patterns[Unanchored[Index]];
+      if (  (Offset <= DataSize - Pattern->PatternSize)
+         && InternalMatchPattern (
+              Pattern->Pattern,
+              Pattern->PatternMask,
+              Pattern->PatternSize,
+              &Data[Offset]
+              )
+         && !Callback (Context, Unanchored[Index], Offset))
+      {
+        Status = EFI_ABORTED;
+      }
+    }
+  }
+
+  FreePool (Anchors);
+  FreePool (Unanchored);
+  FreePool (AnchorMap);
+
+  return Status;
+}
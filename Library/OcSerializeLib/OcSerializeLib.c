@@ -18,6 +18,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Library/OcSerializeLib.h>
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 
 STATIC
@@ -86,6 +87,51 @@ LookupConfigSchema (
   return NULL;
 }
 
+/**
+  Find schema in a dictionary schema list by perfect hash if available.
+
+  @param[in]  Dict  Dictionary schema information.
+  @param[in]  Name  Key name to look up.
+
+  @return  Matching schema or NULL.
+**/
+STATIC
+OC_SCHEMA *
+LookupDictSchema (
+  IN OC_SCHEMA_DICT  *Dict,
+  IN CONST CHAR8     *Name
+  )
+{
+  UINT32       Hash;
+  UINT32       Slot;
+  UINT8        Index;
+  CONST UINT8  *Walker;
+
+  if ((Dict->Hash == NULL) || (Dict->SchemaSize == 0)) {
+    return LookupConfigSchema (Dict->Schema, Dict->SchemaSize, Name);
+  }
+
+  //
+  // 32-bit FNV-1a selects the bucket, its displacement selects the slot.
+  //
+  Hash = 2166136261U;
+  for (Walker = (CONST UINT8 *)Name; *Walker != '\0'; ++Walker) {
+    Hash = (Hash ^ *Walker) * 16777619U;
+  }
+
+  Slot  = Hash ^ (Dict->Hash->Displacements[Hash % Dict->SchemaSize] * 0x9E3779B9U);
+  Slot ^= Slot >> 16U;
+  Slot *= 0x85EBCA6BU;
+  Slot ^= Slot >> 13U;
+
+  Index = Dict->Hash->Slots[Slot % Dict->SchemaSize];
+  if (AsciiStrCmp (Dict->Schema[Index].Name, Name) == 0) {
+    return &Dict->Schema[Index];
+  }
+
+  return NULL;
+}
+
 VOID
 ParseSerializedDict (
   OUT  VOID                *Serialized,
@@ -97,13 +143,17 @@ ParseSerializedDict (
 {
   UINT32       DictSize;
   UINT32       Index;
-  UINT32       Index2;
+  UINT32       SchemaIndex;
   CONST CHAR8  *CurrentKey;
   XML_NODE     *CurrentValue;
   XML_NODE     *OldValue;
   OC_SCHEMA    *NewSchema;
+  UINT8        Found[OC_SCHEMA_DICT_MAX_SIZE / 8];
+
+  ASSERT (Info->Dict.SchemaSize <= OC_SCHEMA_DICT_MAX_SIZE);
 
   DictSize = PlistDictChildren (Node);
+  ZeroMem (Found, sizeof (Found));
 
   for (Index = 0; Index < DictSize; Index++) {
     CurrentKey = PlistKeyValue (PlistDictChild (Node, Index, &CurrentValue));
@@ -129,7 +179,7 @@ ParseSerializedDict (
     //
     // We do not protect from duplicating serialized entries.
     //
-    NewSchema = LookupConfigSchema (Info->Dict.Schema, Info->Dict.SchemaSize, CurrentKey);
+    NewSchema = LookupDictSchema (&Info->Dict, CurrentKey);
 
     if (NewSchema == NULL) {
       DEBUG ((DEBUG_WARN, "警告: 发现%a选项在索引%u处，此版本没有这个选项或已移动位置, 位置: <%a>!\n", CurrentKey, Index, Context));
@@ -140,6 +190,14 @@ ParseSerializedDict (
       continue;
     }
 
+    //
+    // Remember found keys for missing key reporting.
+    //
+    SchemaIndex = (UINT32)(NewSchema - Info->Dict.Schema);
+    if (SchemaIndex < OC_SCHEMA_DICT_MAX_SIZE) {
+      Found[SchemaIndex / 8] |= (UINT8)(1U << (SchemaIndex % 8));
+    }
+
     OldValue     = CurrentValue;
     CurrentValue = PlistNodeCast (CurrentValue, NewSchema->Type);
     if (CurrentValue == NULL) {
@@ -164,33 +222,19 @@ ParseSerializedDict (
 
   DEBUG_CODE_BEGIN ();
 
-  for (Index = 0; Index < Info->Dict.SchemaSize; ++Index) {
-    if (Info->Dict.Schema[Index].Optional) {
+  for (Index = 0; Index < MIN (Info->Dict.SchemaSize, OC_SCHEMA_DICT_MAX_SIZE); ++Index) {
+    if (Info->Dict.Schema[Index].Optional || ((Found[Index / 8] & (1U << (Index % 8))) != 0)) {
       continue;
     }
 
-    for (Index2 = 0; Index2 < DictSize; ++Index2) {
-      CurrentKey = PlistKeyValue (PlistDictChild (Node, Index2, NULL));
-
-      if (CurrentKey == NULL) {
-        continue;
-      }
-
-      if (AsciiStrCmp (CurrentKey, Info->Dict.Schema[Index].Name) == 0) {
-        break;
-      }
-    }
-
-    if (Index2 == DictSize) {
-      DEBUG ((
-        DEBUG_WARN,
-        "警告: 缺少 %a 键值, 位置: <%a>!\n",
-        Info->Dict.Schema[Index].Name,
-        Context
-        ));
-      if (ErrorCount != NULL) {
-        ++*ErrorCount;
-      }
+    DEBUG ((
+      DEBUG_WARN,
+      "警告: 缺少 %a 键值, 位置: <%a>!\n",
+      Info->Dict.Schema[Index].Name,
+      Context
+      ));
+    if (ErrorCount != NULL) {
+      ++*ErrorCount;
     }
   }
 
@@ -479,7 +523,11 @@ ParseSerialized (
   XML_DOCUMENT  *Document;
   XML_NODE      *RootDict;
 
-  Document = XmlDocumentParse (PlistBuffer, PlistSize, FALSE);
+  if (PlistIsBinary (PlistBuffer, PlistSize)) {
+    Document = PlistDocumentParseBinary (PlistBuffer, PlistSize);
+  } else {
+    Document = XmlDocumentParse (PlistBuffer, PlistSize, FALSE);
+  }
 
   if (Document == NULL) {
     DEBUG ((DEBUG_INFO, "警告: 无法解析plist文件!\n"));
@@ -45,6 +45,86 @@ typedef PACKED struct {
 
 #pragma pack(pop)
 
+//
+// OC_STORAGE_CACHE_ENTRY signature for list identification.
+//
+#define OC_STORAGE_CACHE_ENTRY_SIGNATURE  SIGNATURE_32 ('O', 'S', 'C', 'E')
+
+/**
+  Gets the element in FileCache list of OC_STORAGE_CACHE_ENTRY.
+
+  @param[in] This  The current ListEntry.
+**/
+#define GET_STORAGE_CACHE_ENTRY_FROM_LINK(This)  \
+  (CR (                                          \
+    (This),                                      \
+    OC_STORAGE_CACHE_ENTRY,                      \
+    Link,                                        \
+    OC_STORAGE_CACHE_ENTRY_SIGNATURE             \
+    ))
+
+/**
+  Gets the element in FileCacheBuckets list of OC_STORAGE_CACHE_ENTRY.
+
+  @param[in] This  The current ListEntry.
+**/
+#define GET_STORAGE_CACHE_ENTRY_FROM_BUCKET_LINK(This)  \
+  (CR (                                                 \
+    (This),                                             \
+    OC_STORAGE_CACHE_ENTRY,                             \
+    BucketLink,                                         \
+    OC_STORAGE_CACHE_ENTRY_SIGNATURE                    \
+    ))
+
+/**
+  Cached storage file, path and data follow the structure.
+**/
+typedef struct {
+  UINT32        Signature;
+  LIST_ENTRY    Link;
+  LIST_ENTRY    BucketLink;
+  ///
+  /// File path hash, selects the bucket in FileCacheBuckets.
+  ///
+  UINT32        Hash;
+  ///
+  /// The full path to the file, null-terminated.
+  ///
+  CHAR16        *FilePath;
+  ///
+  /// File data with implicit double null termination.
+  ///
+  UINT8         *Data;
+  ///
+  /// File size without null termination.
+  ///
+  UINT32        Size;
+  ///
+  /// Allocation size accounted in FileCacheSize.
+  ///
+  UINTN         AllocatedSize;
+} OC_STORAGE_CACHE_ENTRY;
+
+/**
+  Vault file in prefetch order.
+**/
+typedef struct {
+  CONST CHAR8    *Path;
+  UINT32         Index;
+} OC_STORAGE_PREFETCH_FILE;
+
+/**
+  Vault file being prefetched. One file is verified while
+  the read of the next one is in flight.
+**/
+typedef struct {
+  EFI_FILE_PROTOCOL         *File;
+  EFI_FILE_IO_TOKEN         Token;
+  OC_STORAGE_CACHE_ENTRY    *Entry;
+  UINT32                    Index;
+  BOOLEAN                   Async;
+} OC_STORAGE_PREFETCH_SLOT;
+
 //
 // We do not want to expose these for the time being!.
 //
@@ -119,6 +199,149 @@ OC_SCHEMA_INFO
   .Dict = { mVaultNodesSchema, ARRAY_SIZE (mVaultNodesSchema) }
 };
 
+/**
+  Hash vault file path for vault index lookup (FNV-1a).
+
+  @param[in]  Path    Vault file path.
+  @param[in]  Length  Vault file path length.
+
+  @return  Path hash.
+**/
+STATIC
+UINT32
+OcStorageHashVaultPath (
+  IN CONST CHAR8  *Path,
+  IN UINT32       Length
+  )
+{
+  UINT32  Hash;
+  UINT32  Index;
+
+  Hash = 0x811C9DC5U;
+  for (Index = 0; Index < Length; ++Index) {
+    Hash ^= (UINT8)Path[Index];
+    Hash *= 0x01000193U;
+  }
+
+  return Hash;
+}
+
+/**
+  Hash requested file path for vault index lookup (FNV-1a).
+  The path is normalised to vault key form, i.e. every CHAR16 is
+  hashed as the CHAR8 it must match.
+
+  @param[in]  Filename  Requested file path.
+  @param[out] Length    Requested file path length.
+  @param[out] Hash      Path hash.
+
+  @retval FALSE  Path contains characters not representable in vault keys.
+**/
+STATIC
+BOOLEAN
+OcStorageHashFilename (
+  IN  CONST CHAR16  *Filename,
+  OUT UINTN         *Length,
+  OUT UINT32        *Hash
+  )
+{
+  UINTN   Index;
+  UINT32  PathHash;
+
+  PathHash = 0x811C9DC5U;
+  for (Index = 0; Filename[Index] != L'\0'; ++Index) {
+    //
+    // Vault keys are compared to CHAR16 paths per character,
+    // so anything wider than CHAR8 can never match.
+    //
+    if (Filename[Index] > MAX_UINT8) {
+      return FALSE;
+    }
+
+    PathHash ^= (UINT8)Filename[Index];
+    PathHash *= 0x01000193U;
+  }
+
+  *Length = Index;
+  *Hash   = PathHash;
+  return TRUE;
+}
+
+/**
+  Build hash index over vault file paths.
+  Failure to build the index is not fatal, linear lookup is used then.
+
+  @param[in,out] Context  Storage context with loaded vault.
+**/
+STATIC
+VOID
+OcStorageBuildVaultIndex (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  OC_STORAGE_VAULT_INDEX  *VaultIndex;
+  OC_STRING               *Key;
+  OC_STRING               *Existing;
+  UINT32                  Count;
+  UINT32                  IndexSize;
+  UINT32                  Hash;
+  UINT32                  Slot;
+  UINT32                  Index;
+
+  Count = Context->Vault.Files.Count;
+  if ((Count == 0) || (Count > MAX_UINT32 / 4)) {
+    return;
+  }
+
+  //
+  // Keep the load factor at or below 50% to make probe sequences short.
+  //
+  IndexSize = GetPowerOfTwo32 (Count * 2);
+  if (IndexSize < Count * 2) {
+    IndexSize <<= 1U;
+  }
+
+  VaultIndex = AllocateZeroPool (IndexSize * sizeof (*VaultIndex));
+  if (VaultIndex == NULL) {
+    DEBUG ((DEBUG_INFO, "OCST: No memory for vault index, using linear lookup\n"));
+    return;
+  }
+
+  for (Index = 0; Index < Count; ++Index) {
+    Key = Context->Vault.Files.Keys[Index];
+    if (Key->Size == 0) {
+      continue;
+    }
+
+    Hash = OcStorageHashVaultPath (OC_BLOB_GET (Key), Key->Size - 1);
+    Slot = Hash & (IndexSize - 1);
+
+    while (VaultIndex[Slot].Index != 0) {
+      //
+      // Keep the first occurrence of duplicate paths to match linear lookup.
+      //
+      if (VaultIndex[Slot].Hash == Hash) {
+        Existing = Context->Vault.Files.Keys[VaultIndex[Slot].Index - 1];
+        if (  (Existing->Size == Key->Size)
+           && (CompareMem (OC_BLOB_GET (Existing), OC_BLOB_GET (Key), Key->Size) == 0))
+        {
+          break;
+        }
+      }
+
+      Slot = (Slot + 1) & (IndexSize - 1);
+    }
+
+    if (VaultIndex[Slot].Index == 0) {
+      VaultIndex[Slot].Hash  = Hash;
+      VaultIndex[Slot].Index = Index + 1;
+    }
+  }
+
+  Context->VaultIndex     = VaultIndex;
+  Context->VaultIndexMask = IndexSize - 1;
+}
+
 STATIC
 EFI_STATUS
 OcStorageInitializeVault (
@@ -169,9 +392,46 @@ OcStorageInitializeVault (
 
   Context->HasVault = TRUE;
 
+  OcStorageBuildVaultIndex (Context);
+
   return EFI_SUCCESS;
 }
 
+/**
+  Compare vault file path to requested file path.
+
+  @param[in]  Key           Vault file path.
+  @param[in]  Filename      Requested file path.
+  @param[in]  FilenameSize  Requested file path length including terminator.
+
+  @retval TRUE  Paths are equal.
+**/
+STATIC
+BOOLEAN
+OcStorageMatchVaultPath (
+  IN CONST OC_STRING  *Key,
+  IN CONST CHAR16     *Filename,
+  IN UINTN            FilenameSize
+  )
+{
+  UINTN        StrIndex;
+  CONST CHAR8  *VaultFilePath;
+
+  if (Key->Size != (UINT32)FilenameSize) {
+    return FALSE;
+  }
+
+  VaultFilePath = OC_BLOB_GET (Key);
+
+  for (StrIndex = 0; StrIndex < FilenameSize; ++StrIndex) {
+    if (Filename[StrIndex] != VaultFilePath[StrIndex]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 STATIC
 UINT8 *
 OcStorageGetDigest (
@@ -180,30 +440,42 @@ OcStorageGetDigest (
   )
 {
   UINT32  Index;
-  UINTN   StrIndex;
-  CHAR8   *VaultFilePath;
+  UINT32  Hash;
+  UINT32  Slot;
   UINTN   FilenameSize;
 
   if (!Context->HasVault) {
     return NULL;
   }
 
-  FilenameSize = StrLen (Filename) + 1;
-
-  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
-    if (Context->Vault.Files.Keys[Index]->Size != (UINT32)FilenameSize) {
-      continue;
+  if (Context->VaultIndex != NULL) {
+    if (!OcStorageHashFilename (Filename, &FilenameSize, &Hash)) {
+      return NULL;
     }
 
-    VaultFilePath = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
+    ++FilenameSize;
+
+    for (Slot = Hash & Context->VaultIndexMask;
+         Context->VaultIndex[Slot].Index != 0;
+         Slot = (Slot + 1) & Context->VaultIndexMask)
+    {
+      if (Context->VaultIndex[Slot].Hash != Hash) {
+        continue;
+      }
 
-    for (StrIndex = 0; StrIndex < FilenameSize; ++StrIndex) {
-      if (Filename[StrIndex] != VaultFilePath[StrIndex]) {
-        break;
+      Index = Context->VaultIndex[Slot].Index - 1;
+      if (OcStorageMatchVaultPath (Context->Vault.Files.Keys[Index], Filename, FilenameSize)) {
+        return &Context->Vault.Files.Values[Index]->Hash[0];
       }
     }
 
-    if (StrIndex == FilenameSize) {
+    return NULL;
+  }
+
+  FilenameSize = StrLen (Filename) + 1;
+
+  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
+    if (OcStorageMatchVaultPath (Context->Vault.Files.Keys[Index], Filename, FilenameSize)) {
       return &Context->Vault.Files.Values[Index]->Hash[0];
     }
   }
@@ -330,12 +602,611 @@ OcStorageFree (
     Context->Storage = NULL;
   }
 
+  OcStorageSetCacheSize (Context, 0);
+
+  if (Context->VaultIndex != NULL) {
+    FreePool (Context->VaultIndex);
+    Context->VaultIndex     = NULL;
+    Context->VaultIndexMask = 0;
+  }
+
   if (Context->HasVault) {
     OC_STORAGE_VAULT_DESTRUCT (&Context->Vault, sizeof (Context->Vault));
     Context->HasVault = FALSE;
   }
 }
 
+/**
+  Hash file path for file cache lookup, reusing vault index hashing.
+
+  @param[in]  FilePath    The full path to the file.
+
+  @return  Path hash.
+**/
+STATIC
+UINT32
+OcStorageCacheHashPath (
+  IN CONST CHAR16  *FilePath
+  )
+{
+  UINTN   Length;
+  UINT32  Hash;
+
+  //
+  // Paths not representable in vault keys are not expected
+  // to be read and all share a single bucket.
+  //
+  if (!OcStorageHashFilename (FilePath, &Length, &Hash)) {
+    return 0;
+  }
+
+  return Hash;
+}
+
+/**
+  Get file cache bucket for the path hash.
+
+  @param[in]  Context     Storage context.
+  @param[in]  Hash        Path hash.
+
+  @return  Bucket list head.
+**/
+STATIC
+LIST_ENTRY *
+OcStorageCacheGetBucket (
+  IN OC_STORAGE_CONTEXT  *Context,
+  IN UINT32              Hash
+  )
+{
+  return &Context->FileCacheBuckets[Hash & (OC_STORAGE_CACHE_BUCKET_COUNT - 1)];
+}
+
+/**
+  Drop file cache entry.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      Entry       Cache entry to drop.
+**/
+STATIC
+VOID
+OcStorageCacheDropEntry (
+  IN OUT OC_STORAGE_CONTEXT      *Context,
+  IN     OC_STORAGE_CACHE_ENTRY  *Entry
+  )
+{
+  RemoveEntryList (&Entry->Link);
+  RemoveEntryList (&Entry->BucketLink);
+  ASSERT (Context->FileCacheSize >= Entry->AllocatedSize);
+  Context->FileCacheSize -= Entry->AllocatedSize;
+  FreePool (Entry);
+}
+
+/**
+  Evict least recently used files until file cache fits the size.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      Size        Size to fit in.
+**/
+STATIC
+VOID
+OcStorageCacheShrink (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     UINTN               Size
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+
+  while (Context->FileCacheSize > Size) {
+    ASSERT (!IsListEmpty (&Context->FileCache));
+    Entry = GET_STORAGE_CACHE_ENTRY_FROM_LINK (GetPreviousNode (&Context->FileCache, &Context->FileCache));
+    DEBUG ((DEBUG_VERBOSE, "OCST: Evicting cached %s (%u)\n", Entry->FilePath, Entry->Size));
+    OcStorageCacheDropEntry (Context, Entry);
+    ++Context->FileCacheEvictions;
+  }
+}
+
+/**
+  Find file in file cache and make it most recently used.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      FilePath    The full path to the file.
+
+  @retval Cache entry or NULL.
+**/
+STATIC
+OC_STORAGE_CACHE_ENTRY *
+OcStorageCacheLookup (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath
+  )
+{
+  LIST_ENTRY              *Bucket;
+  LIST_ENTRY              *Link;
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  UINT32                  Hash;
+
+  Hash   = OcStorageCacheHashPath (FilePath);
+  Bucket = OcStorageCacheGetBucket (Context, Hash);
+
+  for (
+       Link = GetFirstNode (Bucket);
+       !IsNull (Bucket, Link);
+       Link = GetNextNode (Bucket, Link))
+  {
+    Entry = GET_STORAGE_CACHE_ENTRY_FROM_BUCKET_LINK (Link);
+    if ((Entry->Hash == Hash) && (StrCmp (Entry->FilePath, FilePath) == 0)) {
+      RemoveEntryList (&Entry->Link);
+      InsertHeadList (&Context->FileCache, &Entry->Link);
+      return Entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Allocate file cache entry for the file. The entry is not added to the cache.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      FilePath    The full path to the file.
+  @param[in]      FileSize    File size without null termination.
+
+  @retval Cache entry or NULL when the file is too large to cache.
+**/
+STATIC
+OC_STORAGE_CACHE_ENTRY *
+OcStorageCacheAllocateEntry (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath,
+  IN     UINT32              FileSize
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  UINTN                   PathSize;
+  UINTN                   AllocatedSize;
+
+  PathSize = StrSize (FilePath);
+
+  if (  BaseOverflowAddUN (sizeof (*Entry), PathSize, &AllocatedSize)
+     || BaseOverflowAddUN (AllocatedSize, (UINTN)FileSize + 2, &AllocatedSize)
+     || (AllocatedSize > Context->FileCacheMaxSize / 4))
+  {
+    return NULL;
+  }
+
+  Entry = AllocatePool (AllocatedSize);
+  if (Entry == NULL) {
+    return NULL;
+  }
+
+  Entry->Signature     = OC_STORAGE_CACHE_ENTRY_SIGNATURE;
+  Entry->Hash          = OcStorageCacheHashPath (FilePath);
+  Entry->FilePath      = (CHAR16 *)(Entry + 1);
+  Entry->Data          = (UINT8 *)Entry->FilePath + PathSize;
+  Entry->Size          = FileSize;
+  Entry->AllocatedSize = AllocatedSize;
+  CopyMem (Entry->FilePath, FilePath, PathSize);
+
+  return Entry;
+}
+
+/**
+  Add allocated file cache entry with file data to file cache
+  as most recently used, evicting other files when necessary.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      Entry       Cache entry to add.
+**/
+STATIC
+VOID
+OcStorageCacheAddEntry (
+  IN OUT OC_STORAGE_CONTEXT      *Context,
+  IN     OC_STORAGE_CACHE_ENTRY  *Entry
+  )
+{
+  OcStorageCacheShrink (Context, Context->FileCacheMaxSize - Entry->AllocatedSize);
+
+  InsertHeadList (&Context->FileCache, &Entry->Link);
+  InsertHeadList (OcStorageCacheGetBucket (Context, Entry->Hash), &Entry->BucketLink);
+  Context->FileCacheSize += Entry->AllocatedSize;
+}
+
+/**
+  Add verified file to file cache. Failing to do so is not fatal.
+
+  @param[in,out]  Context     Storage context.
+  @param[in]      FilePath    The full path to the file.
+  @param[in]      FileBuffer  File data with implicit double null termination.
+  @param[in]      FileSize    File size without null termination.
+**/
+STATIC
+VOID
+OcStorageCacheInsert (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath,
+  IN     CONST UINT8         *FileBuffer,
+  IN     UINT32              FileSize
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+
+  Entry = OcStorageCacheAllocateEntry (Context, FilePath, FileSize);
+  if (Entry == NULL) {
+    return;
+  }
+
+  CopyMem (Entry->Data, FileBuffer, (UINTN)FileSize + 2);
+  OcStorageCacheAddEntry (Context, Entry);
+}
+
+VOID
+OcStorageSetCacheSize (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     UINTN               MaxSize
+  )
+{
+  UINT32  Index;
+
+  ASSERT (Context != NULL);
+
+  if (MaxSize == 0) {
+    OcStorageInvalidateCache (Context, NULL);
+    Context->FileCacheMaxSize = 0;
+    return;
+  }
+
+  if (Context->FileCacheMaxSize == 0) {
+    InitializeListHead (&Context->FileCache);
+    for (Index = 0; Index < OC_STORAGE_CACHE_BUCKET_COUNT; ++Index) {
+      InitializeListHead (&Context->FileCacheBuckets[Index]);
+    }
+
+    Context->FileCacheSize      = 0;
+    Context->FileCacheHits      = 0;
+    Context->FileCacheMisses    = 0;
+    Context->FileCacheEvictions = 0;
+  } else {
+    OcStorageCacheShrink (Context, MaxSize);
+  }
+
+  Context->FileCacheMaxSize = MaxSize;
+}
+
+VOID
+OcStorageInvalidateCache (
+  IN OUT OC_STORAGE_CONTEXT  *Context,
+  IN     CONST CHAR16        *FilePath  OPTIONAL
+  )
+{
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+
+  ASSERT (Context != NULL);
+
+  if (Context->FileCacheMaxSize == 0) {
+    return;
+  }
+
+  if (FilePath != NULL) {
+    Entry = OcStorageCacheLookup (Context, FilePath);
+    if (Entry != NULL) {
+      OcStorageCacheDropEntry (Context, Entry);
+    }
+
+    return;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCST: File cache %u hits, %u misses, %u evictions, %Lu/%Lu bytes\n",
+    Context->FileCacheHits,
+    Context->FileCacheMisses,
+    Context->FileCacheEvictions,
+    (UINT64)Context->FileCacheSize,
+    (UINT64)Context->FileCacheMaxSize
+    ));
+
+  while (!IsListEmpty (&Context->FileCache)) {
+    OcStorageCacheDropEntry (
+      Context,
+      GET_STORAGE_CACHE_ENTRY_FROM_LINK (GetFirstNode (&Context->FileCache))
+      );
+  }
+}
+
+/**
+  Compare vault files by path, which groups files of every directory together.
+
+  @param[in]  Buffer1   First OC_STORAGE_PREFETCH_FILE.
+  @param[in]  Buffer2   Second OC_STORAGE_PREFETCH_FILE.
+
+  @retval Comparison result.
+**/
+STATIC
+INTN
+EFIAPI
+OcStorageComparePrefetchFiles (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return AsciiStrCmp (
+           ((CONST OC_STORAGE_PREFETCH_FILE *)Buffer1)->Path,
+           ((CONST OC_STORAGE_PREFETCH_FILE *)Buffer2)->Path
+           );
+}
+
+/**
+  Open vault file and start reading it into a new cache entry.
+  The read is asynchronous when the file system supports it.
+
+  @param[in,out]  Context     Storage context.
+  @param[out]     Slot        Prefetch slot to use.
+  @param[in]      FilePath    The full path to the file.
+  @param[in]      Event       Read completion event, optional.
+  @param[in]      Budget      Maximum cache entry size.
+
+  @retval TRUE when the read was started.
+**/
+STATIC
+BOOLEAN
+OcStoragePrefetchStart (
+  IN OUT OC_STORAGE_CONTEXT        *Context,
+  OUT    OC_STORAGE_PREFETCH_SLOT  *Slot,
+  IN     CONST CHAR16              *FilePath,
+  IN     EFI_EVENT                 Event  OPTIONAL,
+  IN     UINTN                     Budget
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Size;
+
+  Status = OcSafeFileOpen (
+             Context->Storage,
+             &Slot->File,
+             (CHAR16 *)FilePath,
+             EFI_FILE_MODE_READ,
+             0
+             );
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  Status = OcGetFileSize (Slot->File, &Size);
+  if (!EFI_ERROR (Status) && (Size < MAX_UINT32 - 1)) {
+    Slot->Entry = OcStorageCacheAllocateEntry (Context, FilePath, Size);
+  } else {
+    Slot->Entry = NULL;
+  }
+
+  if ((Slot->Entry != NULL) && (Slot->Entry->AllocatedSize > Budget)) {
+    FreePool (Slot->Entry);
+    Slot->Entry = NULL;
+  }
+
+  if (Slot->Entry == NULL) {
+    Slot->File->Close (Slot->File);
+    return FALSE;
+  }
+
+  Slot->Async = FALSE;
+
+  if ((Event != NULL) && (Slot->File->Revision >= EFI_FILE_PROTOCOL_REVISION2)) {
+    Slot->Token.Event      = Event;
+    Slot->Token.Status     = EFI_NOT_READY;
+    Slot->Token.BufferSize = Size;
+    Slot->Token.Buffer     = Slot->Entry->Data;
+
+    Status = Slot->File->ReadEx (Slot->File, &Slot->Token);
+    if (!EFI_ERROR (Status)) {
+      Slot->Async = TRUE;
+      return TRUE;
+    }
+  }
+
+  Status = OcGetFileData (Slot->File, 0, Size, Slot->Entry->Data);
+  if (EFI_ERROR (Status)) {
+    FreePool (Slot->Entry);
+    Slot->File->Close (Slot->File);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Complete vault file read, verify its digest, and add it to file cache.
+
+  @param[in,out]  Context     Storage context.
+  @param[in,out]  Slot        Prefetch slot with started read.
+
+  @retval TRUE when the file was verified and cached.
+**/
+STATIC
+BOOLEAN
+OcStoragePrefetchFinish (
+  IN OUT OC_STORAGE_CONTEXT        *Context,
+  IN OUT OC_STORAGE_PREFETCH_SLOT  *Slot
+  )
+{
+  EFI_STATUS              Status;
+  UINTN                   EventIndex;
+  OC_STORAGE_CACHE_ENTRY  *Entry;
+  UINT8                   FileDigest[SHA256_DIGEST_SIZE];
+
+  Entry = Slot->Entry;
+
+  if (Slot->Async) {
+    Status = gBS->WaitForEvent (1, &Slot->Token.Event, &EventIndex);
+    if (EFI_ERROR (Status)) {
+      //
+      // The read must complete before its buffer can be released.
+      //
+      do {
+        Status = gBS->CheckEvent (Slot->Token.Event);
+      } while (Status == EFI_NOT_READY);
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = Slot->Token.Status;
+    }
+
+    if (!EFI_ERROR (Status) && (Slot->Token.BufferSize != Entry->Size)) {
+      Status = EFI_END_OF_FILE;
+    }
+  } else {
+    Status = EFI_SUCCESS;
+  }
+
+  Slot->File->Close (Slot->File);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCST: Prefetch of %s failed - %r\n", Entry->FilePath, Status));
+    FreePool (Entry);
+    return FALSE;
+  }
+
+  Sha256 (FileDigest, Entry->Data, Entry->Size);
+  if (CompareMem (FileDigest, Context->Vault.Files.Values[Slot->Index]->Hash, SHA256_DIGEST_SIZE) != 0) {
+    DEBUG ((DEBUG_WARN, "OCST: Prefetched %s is corrupted, not caching\n", Entry->FilePath));
+    FreePool (Entry);
+    return FALSE;
+  }
+
+  Entry->Data[Entry->Size]     = 0;
+  Entry->Data[Entry->Size + 1] = 0;
+  OcStorageCacheAddEntry (Context, Entry);
+  return TRUE;
+}
+
+EFI_STATUS
+OcStoragePrefetchVault (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  EFI_STATUS                Status;
+  OC_STORAGE_PREFETCH_FILE  *Files;
+  OC_STORAGE_PREFETCH_FILE  Scratch;
+  OC_STORAGE_PREFETCH_SLOT  Slots[2];
+  OC_STORAGE_PREFETCH_SLOT  *Pending;
+  UINT32                    SlotIndex;
+  EFI_EVENT                 Events[2];
+  CHAR16                    FilePath[OC_STORAGE_SAFE_PATH_MAX];
+  UINT32                    Count;
+  UINT32                    Index;
+  UINT32                    Prefetched;
+  UINTN                     Budget;
+
+  ASSERT (Context != NULL);
+
+  if (  !Context->HasVault
+     || (Context->Storage == NULL)
+     || (Context->FileCacheMaxSize == 0))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Count = Context->Vault.Files.Count;
+  if (Count == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Files = AllocatePool (Count * sizeof (*Files));
+  if (Files == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < Count; ++Index) {
+    Files[Index].Path  = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
+    Files[Index].Index = Index;
+  }
+
+  //
+  // Read files directory by directory to keep the disk access streaming.
+  //
+  QuickSort (Files, Count, sizeof (*Files), OcStorageComparePrefetchFiles, &Scratch);
+
+  //
+  // Each slot needs its own event, as both reads may be in flight.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Events[0]);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Events[1]);
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Events[0]);
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "OCST: Prefetching vault synchronously - %r\n", Status));
+    Events[0] = NULL;
+    Events[1] = NULL;
+  }
+
+  Pending    = NULL;
+  SlotIndex  = 0;
+  Prefetched = 0;
+
+  for (Index = 0; Index < Count; ++Index) {
+    Status = AsciiStrToUnicodeStrS (Files[Index].Path, FilePath, ARRAY_SIZE (FilePath));
+    if (EFI_ERROR (Status) || (OcStorageCacheLookup (Context, FilePath) != NULL)) {
+      continue;
+    }
+
+    //
+    // Never evict already cached files, and account for the file still being verified.
+    //
+    Budget = Context->FileCacheMaxSize - Context->FileCacheSize;
+    if (Pending != NULL) {
+      Budget = Budget > Pending->Entry->AllocatedSize ? Budget - Pending->Entry->AllocatedSize : 0;
+    }
+
+    Slots[SlotIndex].Index = Files[Index].Index;
+    if (!OcStoragePrefetchStart (
+           Context,
+           &Slots[SlotIndex],
+           FilePath,
+           Events[SlotIndex],
+           Budget
+           ))
+    {
+      continue;
+    }
+
+    //
+    // Verify the previous file while the current one is being read.
+    //
+    if ((Pending != NULL) && OcStoragePrefetchFinish (Context, Pending)) {
+      ++Prefetched;
+    }
+
+    Pending    = &Slots[SlotIndex];
+    SlotIndex ^= 1U;
+  }
+
+  if ((Pending != NULL) && OcStoragePrefetchFinish (Context, Pending)) {
+    ++Prefetched;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (Events); ++Index) {
+    if (Events[Index] != NULL) {
+      gBS->CloseEvent (Events[Index]);
+    }
+  }
+
+  FreePool (Files);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCST: Prefetched %u of %u vault files, %Lu/%Lu bytes cached\n",
+    Prefetched,
+    Count,
+    (UINT64)Context->FileCacheSize,
+    (UINT64)Context->FileCacheMaxSize
+    ));
+
+  return EFI_SUCCESS;
+}
+
 BOOLEAN
 OcStorageExistsFileUnicode (
   IN  OC_STORAGE_CONTEXT  *Context,
@@ -386,12 +1257,13 @@ OcStorageReadFileUnicode (
   OUT UINT32              *FileSize OPTIONAL
   )
 {
-  EFI_STATUS         Status;
-  EFI_FILE_PROTOCOL  *File;
-  UINT32             Size;
-  UINT8              *FileBuffer;
-  UINT8              *VaultDigest;
-  UINT8              FileDigest[SHA256_DIGEST_SIZE];
+  EFI_STATUS              Status;
+  EFI_FILE_PROTOCOL       *File;
+  UINT32                  Size;
+  UINT8                   *FileBuffer;
+  UINT8                   *VaultDigest;
+  UINT8                   FileDigest[SHA256_DIGEST_SIZE];
+  OC_STORAGE_CACHE_ENTRY  *CacheEntry;
 
   //
   // Using this API with empty filename is also not allowed.
@@ -407,6 +1279,23 @@ OcStorageReadFileUnicode (
     return NULL;
   }
 
+  if (Context->FileCacheMaxSize > 0) {
+    CacheEntry = OcStorageCacheLookup (Context, FilePath);
+    if (CacheEntry != NULL) {
+      ++Context->FileCacheHits;
+      DEBUG ((DEBUG_VERBOSE, "OCST: Using cached %s (%u)\n", FilePath, CacheEntry->Size));
+
+      FileBuffer = AllocateCopyPool ((UINTN)CacheEntry->Size + 2, CacheEntry->Data);
+      if ((FileBuffer != NULL) && (FileSize != NULL)) {
+        *FileSize = CacheEntry->Size;
+      }
+
+      return FileBuffer;
+    }
+
+    ++Context->FileCacheMisses;
+  }
+
   if (Context->Storage == NULL) {
     //
     // TODO: expand support for other contexts.
@@ -457,6 +1346,10 @@ OcStorageReadFileUnicode (
   FileBuffer[Size]     = 0;
   FileBuffer[Size + 1] = 0;
 
+  if (Context->FileCacheMaxSize > 0) {
+    OcStorageCacheInsert (Context, FilePath, FileBuffer, Size);
+  }
+
   if (FileSize != NULL) {
     *FileSize = Size;
   }
@@ -47,64 +47,39 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcMiscLib.h>
 #include <Library/OcStringLib.h>
 
+#include "OcXmlLibInternal.h"
+
 /**
   Minimal extra allocation size during export.
 **/
 #define XML_EXPORT_MIN_ALLOCATION_SIZE  4096
 
-#define XML_PLIST_HEADER  "<?xml version=\"1.0\" encoding=\"UTF-8\"?><!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">"
-
-struct XML_NODE_LIST_;
-struct XML_PARSER_;
-
-typedef struct XML_NODE_LIST_  XML_NODE_LIST;
-typedef struct XML_PARSER_     XML_PARSER;
-
 /**
-  An XML_NODE will always contain a tag name and possibly a list of
-  children or text content.
+  Initial size of the parser child stack in nodes.
 **/
-struct XML_NODE_ {
-  CONST CHAR8      *Name;
-  CONST CHAR8      *Attributes;
-  CONST CHAR8      *Content;
-  XML_NODE         *Real;
-  XML_NODE_LIST    *Children;
-};
+#define XML_PARSER_STACK_MIN_COUNT  64
 
-struct XML_NODE_LIST_ {
-  UINT32      NodeCount;
-  UINT32      AllocCount;
-  XML_NODE    *NodeList[];
-};
+#define XML_PLIST_HEADER  "<?xml version=\"1.0\" encoding=\"UTF-8\"?><!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">"
 
-typedef struct {
-  UINT32      RefCount;
-  UINT32      RefAllocCount;
-  XML_NODE    **RefList;
-} XML_REFLIST;
+struct XML_PARSER_;
 
-/**
-  An XML_DOCUMENT simply contains the root node and the underlying buffer.
-**/
-struct XML_DOCUMENT_ {
-  struct {
-    CHAR8     *Buffer;
-    UINT32    Length;
-  } Buffer;
-
-  XML_NODE       *Root;
-  XML_REFLIST    References;
-};
+typedef struct XML_PARSER_  XML_PARSER;
 
 /**
   Parser context.
+  Children of the nodes being parsed are collected on Stack, so that
+  child lists can be allocated with exact size once the node is closed.
 **/
 struct XML_PARSER_ {
-  CHAR8     *Buffer;
-  UINT32    Position;
-  UINT32    Length;
-  UINT32    Level;
+  CHAR8           *Buffer;
+  UINT32          Position;
+  UINT32          Length;
+  UINT32          Level;
+  UINT32          LazyLevel;
+  XML_DOCUMENT    *Document;
+  XML_NODE        **Stack;
+  UINT32          StackCount;
+  UINT32          StackAllocCount;
 };
 
 /**
@@ -134,6 +109,20 @@ CONST CHAR8 *
   "integer"
 };
 
+/**
+  Parse children of a lazy node. On failure the node is left without children
+  and the document is marked malformed.
+
+  @param[in,out]  Node  A pointer to the XML node.
+
+  @retval  TRUE on successful parsing.
+**/
+STATIC
+BOOLEAN
+XmlNodeExpand (
+  IN OUT  XML_NODE  *Node
+  );
+
 /**
   Parse the attribute number.
 
@@ -186,20 +175,86 @@ XmlParseAttributeNumber (
   return TRUE;
 }
 
-/**
-  Create a new XML node.
+VOID *
+XmlArenaAllocate (
+  IN OUT  XML_DOCUMENT  *Document,
+  IN      UINTN         Size
+  )
+{
+  XML_ARENA_SLAB  *Slab;
+  UINTN           HeaderSize;
+  UINTN           SlabSize;
+  UINTN           Pages;
+  VOID            *Memory;
+
+  ASSERT (Document != NULL);
+
+  HeaderSize = ALIGN_VALUE (sizeof (XML_ARENA_SLAB), sizeof (UINT64));
+  Size       = ALIGN_VALUE (Size, sizeof (UINT64));
+  Slab       = Document->Arena;
+
+  if ((Slab == NULL) || (EFI_PAGES_TO_SIZE (Slab->Pages) - Slab->Used < Size)) {
+    if (BaseOverflowAddUN (Size, HeaderSize, &SlabSize)) {
+      return NULL;
+    }
+
+    SlabSize = MAX (SlabSize, Document->ArenaSlabSize);
+    Pages    = EFI_SIZE_TO_PAGES (SlabSize);
+    Slab     = AllocatePages (Pages);
+    if (Slab == NULL) {
+      return NULL;
+    }
+
+    Slab->Pages = Pages;
+    Slab->Used  = HeaderSize;
+
+    if ((Document->Arena != NULL) && (SlabSize > Document->ArenaSlabSize)) {
+      //
+      // Oversized allocations get a dedicated slab, which is put behind
+      // the current one to keep using its remaining space.
+      //
+      Slab->Next            = Document->Arena->Next;
+      Document->Arena->Next = Slab;
+    } else {
+      Slab->Next              = Document->Arena;
+      Document->Arena         = Slab;
+      Document->ArenaSlabSize = MIN (Document->ArenaSlabSize * 2, XML_ARENA_MAX_SLAB_SIZE);
+    }
+  }
+
+  Memory      = (UINT8 *)Slab + Slab->Used;
+  Slab->Used += Size;
+
+  return Memory;
+}
 
-  @param[in]  Name        Name of the new node.
-  @param[in]  Attributes  Attributes of the new node. Optional.
-  @param[in]  Content     Content of the new node. Optional.
-  @param[in]  Real        Pointer to the acual content when a reference exists. Optional.
-  @param[in]  Children    Pointer to the children of the node. Optional.
+/**
+  Free all arena slabs of the document.
 
-  @return  The created XML node.
+  @param[in,out]  Document  A pointer to the XML document.
 **/
 STATIC
+VOID
+XmlArenaFree (
+  IN OUT  XML_DOCUMENT  *Document
+  )
+{
+  XML_ARENA_SLAB  *Slab;
+  XML_ARENA_SLAB  *Next;
+
+  ASSERT (Document != NULL);
+
+  for (Slab = Document->Arena; Slab != NULL; Slab = Next) {
+    Next = Slab->Next;
+    FreePages (Slab, Slab->Pages);
+  }
+
+  Document->Arena = NULL;
+}
+
 XML_NODE *
 XmlNodeCreate (
+  IN  XML_DOCUMENT   *Document,
   IN  CONST CHAR8    *Name,
   IN  CONST CHAR8    *Attributes  OPTIONAL,
   IN  CONST CHAR8    *Content     OPTIONAL,
@@ -209,9 +264,10 @@ XmlNodeCreate (
 {
   XML_NODE  *Node;
 
-  ASSERT (Name != NULL);
+  ASSERT (Document != NULL);
+  ASSERT (Name     != NULL);
 
-  Node = AllocatePool (sizeof (XML_NODE));
+  Node = XmlArenaAllocate (Document, sizeof (XML_NODE));
 
   if (Node != NULL) {
     Node->Name       = Name;
@@ -219,6 +275,10 @@ XmlNodeCreate (
     Node->Content    = Content;
     Node->Real       = Real;
     Node->Children   = Children;
+    Node->Lazy       = NULL;
+    Node->Document   = Document;
+    Node->Size       = 0;
+    Node->BinaryType = PLIST_NODE_TYPE_ANY;
   }
 
   return Node;
@@ -273,10 +333,12 @@ XmlNodeChildPush (
   //
   // Allocate three times more room.
   // This balances performance and memory usage on large files like prelinked plist.
+  // The previous list stays in the arena till the document is freed.
   //
   AllocCount *= 3;
 
-  NewList = (XML_NODE_LIST *)AllocatePool (
+  NewList = (XML_NODE_LIST *)XmlArenaAllocate (
+                               Node->Document,
                                sizeof (XML_NODE_LIST) + sizeof (NewList->NodeList[0]) * AllocCount
                                );
 
@@ -293,8 +355,6 @@ XmlNodeChildPush (
       &Node->Children->NodeList[0],
       sizeof (NewList->NodeList[0]) * NodeCount
       );
-
-    FreePool (Node->Children);
   }
 
   NewList->NodeList[NodeCount] = Child;
@@ -361,19 +421,52 @@ XmlPushReference (
   return TRUE;
 }
 
+/**
+  Drop lazy references pointing to the node.
+
+  @param[in,out]  Node  A pointer to the lazy XML node.
+**/
+STATIC
+VOID
+XmlDropLazyReferences (
+  IN OUT  XML_NODE  *Node
+  )
+{
+  XML_REFLIST  *LazyReferences;
+  UINT32       Index;
+
+  ASSERT (Node       != NULL);
+  ASSERT (Node->Lazy != NULL);
+
+  LazyReferences = &Node->Document->LazyReferences;
+
+  if (LazyReferences->RefList == NULL) {
+    return;
+  }
+
+  for (Index = Node->Lazy->RefMin; Index <= Node->Lazy->RefMax && Index < LazyReferences->RefCount; ++Index) {
+    if (LazyReferences->RefList[Index] == Node) {
+      LazyReferences->RefList[Index] = NULL;
+    }
+  }
+}
+
 /**
   Get real value from a node referencing another.
+  Lazy nodes defining the reference are parsed on demand.
 
-  @param[in]  References  A pointer to the XML references. Optional.
-  @param[in]  Attributes  XML attributes. Optional.
+  @param[in]  References      A pointer to the XML references. Optional.
+  @param[in]  LazyReferences  A pointer to the XML lazy references. Optional.
+  @param[in]  Attributes      XML attributes. Optional.
 
   @return  The real XML node from the one referencing it.
 **/
 STATIC
 XML_NODE *
 XmlNodeReal (
-  IN  CONST XML_REFLIST  *References  OPTIONAL,
-  IN  CONST CHAR8        *Attributes  OPTIONAL
+  IN  CONST XML_REFLIST  *References      OPTIONAL,
+  IN  CONST XML_REFLIST  *LazyReferences  OPTIONAL,
+  IN  CONST CHAR8        *Attributes      OPTIONAL
   )
 {
   BOOLEAN  HasArgument;
@@ -390,7 +483,19 @@ XmlNodeReal (
                   &Number
                   );
 
-  if (!HasArgument || (Number >= References->RefCount)) {
+  if (!HasArgument) {
+    return NULL;
+  }
+
+  if (  (LazyReferences != NULL)
+     && (Number < LazyReferences->RefCount)
+     && (LazyReferences->RefList[Number] != NULL)
+     && !XmlNodeExpand (LazyReferences->RefList[Number]))
+  {
+    return NULL;
+  }
+
+  if (Number >= References->RefCount) {
     return NULL;
   }
 
@@ -399,6 +504,8 @@ XmlNodeReal (
 
 /**
   Free the resources allocated by the node.
+  Node memory belongs to the document arena, so only lazy references
+  to the node and its children are dropped.
 
   @param[in,out]  Node  A pointer to the XML node to be freed.
 **/
@@ -412,15 +519,165 @@ XmlNodeFree (
 
   ASSERT (Node != NULL);
 
+  if (Node->Lazy != NULL) {
+    XmlDropLazyReferences (Node);
+    Node->Lazy = NULL;
+  }
+
   if (Node->Children != NULL) {
     for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
       XmlNodeFree (Node->Children->NodeList[Index]);
     }
+  }
+}
+
+/**
+  Push a child node onto the parser child stack.
+
+  @param[in,out]  Parser     A pointer to the XML parser.
+  @param[in]      StackBase  Stack position of the first child of the parent node.
+  @param[in]      Child      A pointer to the child XML node.
+
+  @retval  TRUE on successful pushing.
+**/
+STATIC
+BOOLEAN
+XmlParserPushChild (
+  IN OUT  XML_PARSER  *Parser,
+  IN      UINT32      StackBase,
+  IN      XML_NODE    *Child
+  )
+{
+  XML_NODE  **NewStack;
+  UINT32    NewAllocCount;
+
+  ASSERT (Parser != NULL);
+  ASSERT (Child  != NULL);
+  ASSERT (StackBase <= Parser->StackCount);
+
+  if (Parser->StackCount - StackBase >= XML_PARSER_NODE_COUNT) {
+    return FALSE;
+  }
+
+  if (Parser->StackCount == Parser->StackAllocCount) {
+    if (Parser->StackAllocCount == 0) {
+      NewAllocCount = XML_PARSER_STACK_MIN_COUNT;
+    } else if (BaseOverflowMulU32 (Parser->StackAllocCount, 2, &NewAllocCount)) {
+      return FALSE;
+    }
+
+    NewStack = AllocatePool (NewAllocCount * sizeof (Parser->Stack[0]));
+    if (NewStack == NULL) {
+      return FALSE;
+    }
+
+    if (Parser->Stack != NULL) {
+      CopyMem (NewStack, Parser->Stack, Parser->StackCount * sizeof (Parser->Stack[0]));
+      FreePool (Parser->Stack);
+    }
+
+    Parser->Stack           = NewStack;
+    Parser->StackAllocCount = NewAllocCount;
+  }
+
+  Parser->Stack[Parser->StackCount] = Child;
+  ++Parser->StackCount;
+
+  return TRUE;
+}
+
+/**
+  Move children from the parser child stack to an exactly sized child list.
+
+  @param[in,out]  Parser     A pointer to the XML parser.
+  @param[in,out]  Node       A pointer to the XML node without children.
+  @param[in]      StackBase  Stack position of the first child of the node.
+
+  @retval  TRUE on successful moving.
+**/
+STATIC
+BOOLEAN
+XmlParserPopChildren (
+  IN OUT  XML_PARSER  *Parser,
+  IN OUT  XML_NODE    *Node,
+  IN      UINT32      StackBase
+  )
+{
+  XML_NODE_LIST  *List;
+  UINT32         NodeCount;
+
+  ASSERT (Parser != NULL);
+  ASSERT (Node   != NULL);
+  ASSERT (Node->Children == NULL);
+  ASSERT (StackBase <= Parser->StackCount);
+
+  NodeCount = Parser->StackCount - StackBase;
+  if (NodeCount == 0) {
+    return TRUE;
+  }
+
+  List = (XML_NODE_LIST *)XmlArenaAllocate (
+                            Node->Document,
+                            sizeof (XML_NODE_LIST) + sizeof (List->NodeList[0]) * NodeCount
+                            );
+  if (List == NULL) {
+    return FALSE;
+  }
+
+  List->NodeCount  = NodeCount;
+  List->AllocCount = NodeCount;
+  CopyMem (&List->NodeList[0], &Parser->Stack[StackBase], sizeof (List->NodeList[0]) * NodeCount);
+
+  Node->Children     = List;
+  Parser->StackCount = StackBase;
+
+  return TRUE;
+}
+
+/**
+  Drop children left on the parser child stack after a parsing failure.
 
-    FreePool (Node->Children);
+  @param[in,out]  Parser     A pointer to the XML parser.
+  @param[in]      StackBase  Stack position of the first child to drop.
+**/
+STATIC
+VOID
+XmlParserDropChildren (
+  IN OUT  XML_PARSER  *Parser,
+  IN      UINT32      StackBase
+  )
+{
+  UINT32  Index;
+
+  ASSERT (Parser != NULL);
+  ASSERT (StackBase <= Parser->StackCount);
+
+  for (Index = StackBase; Index < Parser->StackCount; ++Index) {
+    XmlNodeFree (Parser->Stack[Index]);
   }
 
-  FreePool (Node);
+  Parser->StackCount = StackBase;
+}
+
+/**
+  Free the parser child stack.
+
+  @param[in,out]  Parser  A pointer to the XML parser.
+**/
+STATIC
+VOID
+XmlParserFreeStack (
+  IN OUT  XML_PARSER  *Parser
+  )
+{
+  ASSERT (Parser != NULL);
+
+  if (Parser->Stack != NULL) {
+    FreePool (Parser->Stack);
+    Parser->Stack           = NULL;
+    Parser->StackCount      = 0;
+    Parser->StackAllocCount = 0;
+  }
 }
 
 /**
@@ -640,6 +897,73 @@ XmlSkipWhitespace (
   }
 }
 
+/**
+  Check whether only whitespace, comments, and other control sequences
+  like `<!DOCTYPE...>' are left in the parser buffer.
+
+  @param[in]  Parser  A pointer to the XML parser.
+
+  @retval  TRUE when no more nodes are left.
+**/
+STATIC
+BOOLEAN
+XmlParserOnlyControlLeft (
+  IN  CONST XML_PARSER  *Parser
+  )
+{
+  CONST CHAR8  *Buffer;
+  UINT32       Length;
+  UINT32       Position;
+  BOOLEAN      IsComment;
+
+  ASSERT (Parser != NULL);
+
+  Buffer   = Parser->Buffer;
+  Length   = Parser->Length;
+  Position = Parser->Position;
+
+  while (TRUE) {
+    while (Position < Length && IsAsciiSpace (Buffer[Position])) {
+      ++Position;
+    }
+
+    if (Position == Length) {
+      return TRUE;
+    }
+
+    if (  (Length - Position < 2)
+       || (Buffer[Position] != '<')
+       || ((Buffer[Position + 1] != '!') && (Buffer[Position + 1] != '?')))
+    {
+      return FALSE;
+    }
+
+    IsComment = Length - Position >= 4
+                && Buffer[Position + 1] == '!'
+                && Buffer[Position + 2] == '-'
+                && Buffer[Position + 3] == '-';
+    Position += IsComment ? 4 : 2;
+
+    while (Position < Length) {
+      if (IsComment) {
+        if (  (Length - Position >= 3)
+           && (Buffer[Position] == '-')
+           && (Buffer[Position + 1] == '-')
+           && (Buffer[Position + 2] == '>'))
+        {
+          Position += 3;
+          break;
+        }
+      } else if (Buffer[Position] == '>') {
+        ++Position;
+        break;
+      }
+
+      ++Position;
+    }
+  }
+}
+
 /**
   Parse the name out of the an XML tag's ending.
 
@@ -1056,6 +1380,105 @@ XmlBufferAppend (
   *CurrentSize += DataLength;
 }
 
+/**
+  Append content of a binary plist node to growing buffer in text form.
+
+  @param[in,out]  Buffer       A pointer to the buffer holding contents exported.
+  @param[in,out]  AllocSize    Size of Buffer to be allocated.
+  @param[in,out]  CurrentSize  Current size of Buffer.
+  @param[in]      Node         A pointer to the binary plist node.
+**/
+STATIC
+VOID
+XmlBufferAppendBinaryContent (
+  IN OUT  CHAR8           **Buffer,
+  IN OUT  UINT32          *AllocSize,
+  IN OUT  UINT32          *CurrentSize,
+  IN      CONST XML_NODE  *Node
+  )
+{
+  CHAR8    *Encoded;
+  UINTN    EncodedSize;
+  CHAR8    Number[24];
+  UINT64   Value;
+  UINT32   Digit;
+  BOOLEAN  Negative;
+  UINT32   Index;
+
+  ASSERT (Node->BinaryType != PLIST_NODE_TYPE_ANY);
+
+  if (Node->BinaryType == PLIST_NODE_TYPE_DATA) {
+    EncodedSize = 0;
+    Base64Encode ((CONST UINT8 *)Node->Content, Node->Size, NULL, &EncodedSize);
+    Encoded = AllocatePool (EncodedSize);
+    if (Encoded == NULL) {
+      XML_USAGE_ERROR ("XmlBufferAppendBinaryContent::failed to allocate");
+      return;
+    }
+
+    if (!RETURN_ERROR (Base64Encode ((CONST UINT8 *)Node->Content, Node->Size, Encoded, &EncodedSize))) {
+      XmlBufferAppend (Buffer, AllocSize, CurrentSize, Encoded, (UINT32)AsciiStrLen (Encoded));
+    }
+
+    FreePool (Encoded);
+    return;
+  }
+
+  if (Node->BinaryType == PLIST_NODE_TYPE_INTEGER) {
+    Value = PlistBinaryIntegerValue (Node, &Negative);
+    if (Negative) {
+      Value = 0ULL - Value;
+    }
+
+    Index = sizeof (Number);
+    do {
+      Value           = DivU64x32Remainder (Value, 10, &Digit);
+      Number[--Index] = (CHAR8)('0' + Digit);
+    } while (Value != 0);
+
+    if (Negative) {
+      Number[--Index] = '-';
+    }
+
+    XmlBufferAppend (Buffer, AllocSize, CurrentSize, &Number[Index], sizeof (Number) - Index);
+    return;
+  }
+
+  //
+  // Strings and keys are escaped when parsed.
+  //
+  XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Content, (UINT32)AsciiStrLen (Node->Content));
+}
+
+/**
+  Copy data of a binary plist data node.
+
+  @param[in]      Node    A pointer to the binary plist data node.
+  @param[out]     Buffer  Buffer to copy the data to.
+  @param[in,out]  Size    Size of Buffer, set to data size on success and to 0 on failure.
+
+  @retval  TRUE on successful copying.
+**/
+STATIC
+BOOLEAN
+XmlNodeBinaryDataValue (
+  IN      CONST XML_NODE  *Node,
+  OUT     VOID            *Buffer,
+  IN OUT  UINT32          *Size
+  )
+{
+  ASSERT (Node->BinaryType == PLIST_NODE_TYPE_DATA);
+
+  if (Node->Size > *Size) {
+    *Size = 0;
+    return FALSE;
+  }
+
+  CopyMem (Buffer, Node->Content, Node->Size);
+  *Size = Node->Size;
+  return TRUE;
+}
+
 /**
   Print node to growing buffer always preserving one byte extra.
 
@@ -1068,11 +1491,11 @@ XmlBufferAppend (
 STATIC
 VOID
 XmlNodeExportRecursive (
-  IN      CONST XML_NODE  *Node,
-  IN OUT  CHAR8           **Buffer,
-  IN OUT  UINT32          *AllocSize,
-  IN OUT  UINT32          *CurrentSize,
-  IN      UINT32          Skip
+  IN OUT  XML_NODE  *Node,
+  IN OUT  CHAR8     **Buffer,
+  IN OUT  UINT32    *AllocSize,
+  IN OUT  UINT32    *CurrentSize,
+  IN      UINT32    Skip
   )
 {
   UINT32  Index;
@@ -1084,7 +1507,7 @@ XmlNodeExportRecursive (
   ASSERT (CurrentSize != NULL);
 
   if (Skip != 0) {
-    if (Node->Children != NULL) {
+    if (XmlNodeExpand (Node) && (Node->Children != NULL)) {
       for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
         XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, Skip - 1);
       }
@@ -1103,13 +1526,20 @@ XmlNodeExportRecursive (
     XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Attributes, (UINT32)AsciiStrLen (Node->Attributes));
   }
 
-  if ((Node->Children != NULL) || (Node->Content != NULL)) {
+  if ((Node->Children != NULL) || (Node->Content != NULL) || (Node->Lazy != NULL)) {
     XmlBufferAppend (Buffer, AllocSize, CurrentSize, ">", L_STR_LEN (">"));
 
-    if (Node->Children != NULL) {
-      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
+    if (Node->Lazy != NULL) {
+      //
+      // Lazy children are exported as is.
+      //
+      XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Lazy->Buffer, Node->Lazy->Length);
+    } else if (Node->Children != NULL) {
+      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
         XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, 0);
       }
+    } else if (Node->BinaryType != PLIST_NODE_TYPE_ANY) {
+      XmlBufferAppendBinaryContent (Buffer, AllocSize, CurrentSize, Node);
     } else {
       XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Content, (UINT32)AsciiStrLen (Node->Content));
     }
@@ -1122,6 +1552,215 @@ XmlNodeExportRecursive (
   }
 }
 
+/**
+  Remember the reference defined by an unparsed tag.
+
+  @param[in]      Tag             Tag contents after `<'.
+  @param[in]      TagLength       Length of Tag up to `>'.
+  @param[in,out]  Node            A pointer to the lazy XML node containing the tag.
+  @param[in,out]  LazyReferences  A pointer to the XML lazy references.
+
+  @retval  TRUE if the tag has no reference or it was successfully pushed.
+**/
+STATIC
+BOOLEAN
+XmlSkipReference (
+  IN      CONST CHAR8  *Tag,
+  IN      UINT32       TagLength,
+  IN OUT  XML_NODE     *Node,
+  IN OUT  XML_REFLIST  *LazyReferences
+  )
+{
+  UINT32  Index;
+  UINT32  Number;
+  UINT32  Digits;
+
+  ASSERT (Tag            != NULL);
+  ASSERT (Node           != NULL);
+  ASSERT (Node->Lazy     != NULL);
+  ASSERT (LazyReferences != NULL);
+
+  for (Index = 1; Index + L_STR_LEN ("ID=\"") < TagLength; ++Index) {
+    if (  IsAsciiSpace (Tag[Index - 1])
+       && (CompareMem (&Tag[Index], "ID=\"", L_STR_LEN ("ID=\"")) == 0))
+    {
+      break;
+    }
+  }
+
+  if (Index + L_STR_LEN ("ID=\"") >= TagLength) {
+    return TRUE;
+  }
+
+  Index += L_STR_LEN ("ID=\"");
+  Number = 0;
+  Digits = 0;
+
+  while (Index < TagLength && Tag[Index] >= '0' && Tag[Index] <= '9') {
+    if (BaseOverflowMulAddU32 (Number, 10, Tag[Index] - '0', &Number)) {
+      return FALSE;
+    }
+
+    ++Index;
+    ++Digits;
+  }
+
+  if ((Digits == 0) || (Index >= TagLength) || (Tag[Index] != '"')) {
+    return FALSE;
+  }
+
+  if (!XmlPushReference (LazyReferences, Node, Number)) {
+    return FALSE;
+  }
+
+  if (Number < Node->Lazy->RefMin) {
+    Node->Lazy->RefMin = Number;
+  }
+
+  if (Number > Node->Lazy->RefMax) {
+    Node->Lazy->RefMax = Number;
+  }
+
+  return TRUE;
+}
+
+/**
+  Locate the closing tag of a node without parsing its children.
+  Buffer contents are not modified.
+
+  @param[in]      Buffer          Buffer to scan starting after the opening tag.
+  @param[in]      Length          Length of the buffer.
+  @param[in]      Level           Nesting level of the children.
+  @param[in,out]  Node            A pointer to the lazy XML node. Optional.
+  @param[in,out]  LazyReferences  A pointer to the XML lazy references. Optional.
+  @param[out]     Offset          Offset of the closing tag in Buffer.
+
+  @retval  TRUE if the closing tag was found.
+**/
+STATIC
+BOOLEAN
+XmlScanChildren (
+  IN      CONST CHAR8  *Buffer,
+  IN      UINT32       Length,
+  IN      UINT32       Level,
+  IN OUT  XML_NODE     *Node            OPTIONAL,
+  IN OUT  XML_REFLIST  *LazyReferences  OPTIONAL,
+  OUT     UINT32       *Offset
+  )
+{
+  CONST CHAR8  *Tag;
+  CONST CHAR8  *TagEnd;
+  UINT32       Position;
+  UINT32       Depth;
+
+  ASSERT (Buffer != NULL);
+  ASSERT (Offset != NULL);
+  ASSERT (LazyReferences == NULL || Node != NULL);
+
+  Position = 0;
+  Depth    = 0;
+
+  while (Position < Length) {
+    Tag = ScanMem8 (&Buffer[Position], Length - Position, '<');
+    if (Tag == NULL) {
+      break;
+    }
+
+    Position = (UINT32)(Tag - Buffer) + 1;
+
+    if (  (Position + L_STR_LEN ("!--") <= Length)
+       && (CompareMem (&Buffer[Position], "!--", L_STR_LEN ("!--")) == 0))
+    {
+      //
+      // Comments may contain anything but `-->'.
+      //
+      Position += L_STR_LEN ("!--");
+      while (  Position + L_STR_LEN ("-->") <= Length
+            && CompareMem (&Buffer[Position], "-->", L_STR_LEN ("-->")) != 0)
+      {
+        ++Position;
+      }
+
+      Position += L_STR_LEN ("-->");
+      continue;
+    }
+
+    TagEnd = ScanMem8 (&Buffer[Position], Length - Position, '>');
+    if (TagEnd == NULL) {
+      break;
+    }
+
+    if (Buffer[Position] == '/') {
+      if (Depth == 0) {
+        *Offset = Position - 1;
+        return TRUE;
+      }
+
+      --Depth;
+    } else if ((Buffer[Position] != '?') && (Buffer[Position] != '!')) {
+      if (*(TagEnd - 1) != '/') {
+        ++Depth;
+
+        if (Level + Depth > XML_PARSER_NEST_LEVEL) {
+          XML_USAGE_ERROR ("XmlScanChildren::level overflow");
+          return FALSE;
+        }
+      }
+
+      if (  (LazyReferences != NULL)
+         && !XmlSkipReference (Tag + 1, (UINT32)(TagEnd - Tag - 1), Node, LazyReferences))
+      {
+        XML_USAGE_ERROR ("XmlScanChildren::reference");
+        return FALSE;
+      }
+    }
+
+    Position = (UINT32)(TagEnd - Buffer) + 1;
+  }
+
+  XML_USAGE_ERROR ("XmlScanChildren::expected closing tag");
+  return FALSE;
+}
+
+/**
+  Skip the children of a lazy node without parsing them, so that
+  they can be parsed or exported later.
+
+  @param[in,out]  Parser  A pointer to the XML parser at the first child.
+  @param[in,out]  Node    A pointer to the lazy XML node.
+
+  @retval  TRUE if the parser was moved to the closing tag of the node.
+**/
+STATIC
+BOOLEAN
+XmlSkipChildren (
+  IN OUT  XML_PARSER  *Parser,
+  IN OUT  XML_NODE    *Node
+  )
+{
+  UINT32  Offset;
+
+  ASSERT (Parser     != NULL);
+  ASSERT (Node       != NULL);
+  ASSERT (Node->Lazy != NULL);
+
+  if (!XmlScanChildren (
+         &Parser->Buffer[Parser->Position],
+         Parser->Length - Parser->Position,
+         Parser->Level,
+         Node,
+         Parser->Document->WithRefs ? &Parser->Document->LazyReferences : NULL,
+         &Offset
+         ))
+  {
+    XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::children");
+    return FALSE;
+  }
+
+  Parser->Position += Offset;
+  return TRUE;
+}
+
 /**
   Parse an XML fragment node.
 
@@ -1155,6 +1794,7 @@ XmlParseNode (
   XML_NODE     *Node;
   XML_NODE     *Child;
   UINT32       ReferenceNumber;
+  UINT32       StackBase;
   BOOLEAN      IsReference;
   BOOLEAN      SelfClosing;
   BOOLEAN      Unprefixed;
@@ -1184,7 +1824,18 @@ XmlParseNode (
 
   XmlSkipWhitespace (Parser);
 
-  Node = XmlNodeCreate (TagOpen, Attributes, NULL, XmlNodeReal (References, Attributes), NULL);
+  Node = XmlNodeCreate (
+           Parser->Document,
+           TagOpen,
+           Attributes,
+           NULL,
+           XmlNodeReal (
+             References,
+             References != NULL ? &Parser->Document->LazyReferences : NULL,
+             Attributes
+             ),
+           NULL
+           );
   if (Node == NULL) {
     XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::node alloc fail");
     return NULL;
@@ -1223,6 +1874,33 @@ XmlParseNode (
 
     Unprefixed = TRUE;
 
+    //
+    // Children of deep enough nodes are parsed on first access.
+    // Nodes with attributes may be referenced and are always parsed.
+    //
+  } else if (  (Parser->Level >= Parser->LazyLevel)
+            && (Attributes == NULL)
+            && ('/' != XmlParserPeek (Parser, NEXT_CHARACTER)))
+  {
+    Node->Lazy = XmlArenaAllocate (Parser->Document, sizeof (XML_NODE_LAZY));
+    if (Node->Lazy == NULL) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::lazy alloc fail");
+      XmlNodeFree (Node);
+      return NULL;
+    }
+
+    Node->Lazy->Buffer = &Parser->Buffer[Parser->Position];
+    Node->Lazy->Level  = Parser->Level + 1;
+    Node->Lazy->RefMin = MAX_UINT32;
+    Node->Lazy->RefMax = 0;
+
+    if (!XmlSkipChildren (Parser, Node)) {
+      XmlNodeFree (Node);
+      return NULL;
+    }
+
+    Node->Lazy->Length = (UINT32)(&Parser->Buffer[Parser->Position] - Node->Lazy->Buffer);
+
     //
     // Otherwise children are to be expected.
     //
@@ -1236,6 +1914,7 @@ XmlParseNode (
     }
 
     HasChildren = FALSE;
+    StackBase   = Parser->StackCount;
 
     while ('/' != XmlParserPeek (Parser, NEXT_CHARACTER)) {
       //
@@ -1250,12 +1929,14 @@ XmlParseNode (
         }
 
         XML_PARSER_ERROR (Parser, NEXT_CHARACTER, "XmlParseNode::child");
+        XmlParserDropChildren (Parser, StackBase);
         XmlNodeFree (Node);
         return NULL;
       }
 
-      if (!XmlNodeChildPush (Node, Child)) {
+      if (!XmlParserPushChild (Parser, StackBase, Child)) {
         XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::node push fail");
+        XmlParserDropChildren (Parser, StackBase);
         XmlNodeFree (Node);
         XmlNodeFree (Child);
         return NULL;
@@ -1266,6 +1947,13 @@ XmlParseNode (
 
     --Parser->Level;
 
+    if (!XmlParserPopChildren (Parser, Node, StackBase)) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::child list alloc fail");
+      XmlParserDropChildren (Parser, StackBase);
+      XmlNodeFree (Node);
+      return NULL;
+    }
+
     if (!HasChildren && (References != NULL) && (Attributes != NULL)) {
       IsReference = XmlParseAttributeNumber (
                       Node->Attributes,
@@ -1304,16 +1992,97 @@ XmlParseNode (
   return Node;
 }
 
+STATIC
+BOOLEAN
+XmlNodeExpand (
+  IN OUT  XML_NODE  *Node
+  )
+{
+  XML_NODE_LAZY  *Lazy;
+  XML_PARSER     Parser;
+  XML_NODE       *Child;
+  BOOLEAN        Result;
+
+  ASSERT (Node != NULL);
+
+  if (Node->Lazy == NULL) {
+    return TRUE;
+  }
+
+  //
+  // Detach lazy children first to never parse them twice.
+  //
+  Lazy       = Node->Lazy;
+  XmlDropLazyReferences (Node);
+  Node->Lazy = NULL;
+
+  ZeroMem (&Parser, sizeof (Parser));
+  Parser.Buffer    = Lazy->Buffer;
+  Parser.Length    = Lazy->Length;
+  Parser.Level     = Lazy->Level;
+  Parser.LazyLevel = MAX_UINT32;
+  Parser.Document  = Node->Document;
+
+  Result = TRUE;
+
+  //
+  // Unlike with eager parsing there is no closing tag after the last child,
+  // so trailing comments need to be handled separately.
+  //
+  while (!XmlParserOnlyControlLeft (&Parser)) {
+    Child = XmlParseNode (&Parser, Parser.Document->WithRefs ? &Parser.Document->References : NULL);
+    if (Child == NULL) {
+      XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlNodeExpand::child");
+      Result = FALSE;
+      break;
+    }
+
+    if (!XmlParserPushChild (&Parser, 0, Child)) {
+      XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlNodeExpand::node push fail");
+      XmlNodeFree (Child);
+      Result = FALSE;
+      break;
+    }
+  }
+
+  //
+  // Partially parsed children are dropped, as eager parsing would reject the document.
+  //
+  if (Result && !XmlParserPopChildren (&Parser, Node, 0)) {
+    XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlNodeExpand::child list alloc fail");
+    Result = FALSE;
+  }
+
+  if (!Result) {
+    XmlParserDropChildren (&Parser, 0);
+    Node->Document->Malformed = TRUE;
+  }
+
+  XmlParserFreeStack (&Parser);
+
+  return Result;
+}
+
+/**
+  Parse the XML document with optional lazy node support.
+
+  @param[in,out]  Buffer     Chunk to be parsed.
+  @param[in]      Length     Size of the buffer.
+  @param[in]      WithRefs   TRUE to enable reference lookup support.
+  @param[in]      LazyLevel  Nesting level to parse children on first access from.
+
+  @return The parsed xml fragment or NULL.
+**/
+STATIC
 XML_DOCUMENT *
-XmlDocumentParse (
+XmlDocumentParseInternal (
   IN OUT  CHAR8    *Buffer,
   IN      UINT32   Length,
-  IN      BOOLEAN  WithRefs
+  IN      BOOLEAN  WithRefs,
+  IN      UINT32   LazyLevel
   )
 {
-  XML_NODE      *Root;
   XML_DOCUMENT  *Document;
-  XML_REFLIST   References;
   XML_PARSER    Parser;
 
   ASSERT (Buffer != NULL);
@@ -1322,9 +2091,9 @@ XmlDocumentParse (
   // Initialize parser.
   //
   ZeroMem (&Parser, sizeof (Parser));
-  Parser.Buffer = Buffer;
-  Parser.Length = Length;
-  ZeroMem (&References, sizeof (References));
+  Parser.Buffer    = Buffer;
+  Parser.Length    = Length;
+  Parser.LazyLevel = LazyLevel;
 
   //
   // An empty buffer can never contain a valid document.
@@ -1334,41 +2103,82 @@ XmlDocumentParse (
     return NULL;
   }
 
+  //
+  // Lazy nodes refer to the document, so allocate it first.
+  //
+  Document = AllocateZeroPool (sizeof (XML_DOCUMENT));
+
+  if (Document == NULL) {
+    XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::document allocation failed");
+    return NULL;
+  }
+
+  Document->Buffer.Buffer = Buffer;
+  Document->Buffer.Length = Length;
+  Document->WithRefs      = WithRefs;
+  Document->ArenaSlabSize = XML_ARENA_MIN_SLAB_SIZE;
+  Parser.Document         = Document;
+
   //
   // Parse the root node.
   //
-  Root = XmlParseNode (&Parser, WithRefs ? &References : NULL);
-  if (Root == NULL) {
+  Document->Root = XmlParseNode (&Parser, WithRefs ? &Document->References : NULL);
+  XmlParserFreeStack (&Parser);
+  if (Document->Root == NULL) {
     XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::parsing document failed");
+    XmlFreeRefs (&Document->LazyReferences);
+    XmlFreeRefs (&Document->References);
+    XmlArenaFree (Document);
+    FreePool (Document);
     return NULL;
   }
 
   //
   // Return parsed document.
   //
-  Document = AllocatePool (sizeof (XML_DOCUMENT));
+  return Document;
+}
 
-  if (Document == NULL) {
-    XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::document allocation failed");
-    XmlNodeFree (Root);
-    XmlFreeRefs (&References);
-    return NULL;
-  }
+XML_DOCUMENT *
+XmlDocumentParse (
+  IN OUT  CHAR8    *Buffer,
+  IN      UINT32   Length,
+  IN      BOOLEAN  WithRefs
+  )
+{
+  return XmlDocumentParseInternal (Buffer, Length, WithRefs, MAX_UINT32);
+}
 
-  Document->Buffer.Buffer = Buffer;
-  Document->Buffer.Length = Length;
-  Document->Root          = Root;
-  CopyMem (&Document->References, &References, sizeof (References));
+XML_DOCUMENT *
+XmlDocumentParseLazy (
+  IN OUT  CHAR8    *Buffer,
+  IN      UINT32   Length,
+  IN      BOOLEAN  WithRefs,
+  IN      UINT32   LazyLevel
+  )
+{
+  return XmlDocumentParseInternal (Buffer, Length, WithRefs, LazyLevel);
+}
 
-  return Document;
+BOOLEAN
+XmlLocateClosingTag (
+  IN  CONST CHAR8  *Buffer,
+  IN  UINT32       Length,
+  OUT UINT32       *Offset
+  )
+{
+  ASSERT (Buffer != NULL);
+  ASSERT (Offset != NULL);
+
+  return XmlScanChildren (Buffer, Length, 0, NULL, NULL, Offset);
 }
 
 CHAR8 *
 XmlDocumentExport (
-  IN   CONST XML_DOCUMENT  *Document,
-  OUT  UINT32              *Length  OPTIONAL,
-  IN   UINT32              Skip,
-  IN   BOOLEAN             PrependPlistInfo
+  IN OUT  XML_DOCUMENT  *Document,
+  OUT     UINT32        *Length  OPTIONAL,
+  IN      UINT32        Skip,
+  IN      BOOLEAN       PrependPlistInfo
   )
 {
   CHAR8   *Buffer;
@@ -1379,6 +2189,11 @@ XmlDocumentExport (
 
   ASSERT (Document != NULL);
 
+  if (Document->Malformed) {
+    XML_USAGE_ERROR ("XmlDocumentExport::malformed document");
+    return NULL;
+  }
+
   AllocSize = Document->Buffer.Length + 1;
   Buffer    = AllocatePool (AllocSize);
   if (Buffer == NULL) {
@@ -1389,6 +2204,15 @@ XmlDocumentExport (
   CurrentSize = 0;
   XmlNodeExportRecursive (Document->Root, &Buffer, &AllocSize, &CurrentSize, Skip);
 
+  //
+  // Skipped levels may have been expanded during export.
+  //
+  if (Document->Malformed) {
+    XML_USAGE_ERROR ("XmlDocumentExport::malformed document");
+    FreePool (Buffer);
+    return NULL;
+  }
+
   if (PrependPlistInfo) {
     //
     // XmlNodeExportRecursive returns a size that does not include the null terminator,
@@ -1438,8 +2262,12 @@ XmlDocumentFree (
 {
   ASSERT (Document != NULL);
 
-  XmlNodeFree (Document->Root);
+  //
+  // All nodes are released with the arena, no need to walk them.
+  //
+  XmlFreeRefs (&Document->LazyReferences);
   XmlFreeRefs (&Document->References);
+  XmlArenaFree (Document);
   FreePool (Document);
 }
 
@@ -1470,6 +2298,13 @@ XmlNodeContent (
 {
   ASSERT (Node != NULL);
 
+  //
+  // Binary data and integers have no text representation.
+  //
+  if ((Node->BinaryType == PLIST_NODE_TYPE_DATA) || (Node->BinaryType == PLIST_NODE_TYPE_INTEGER)) {
+    return NULL;
+  }
+
   return Node->Real != NULL ? Node->Real->Content : Node->Content;
 }
 
@@ -1483,30 +2318,40 @@ XmlNodeChangeContent (
   ASSERT (Content != NULL);
 
   if (Node->Real != NULL) {
-    Node->Real->Content = Content;
+    Node->Real->Content    = Content;
+    Node->Real->BinaryType = PLIST_NODE_TYPE_ANY;
   }
 
-  Node->Content = Content;
+  Node->Content    = Content;
+  Node->BinaryType = PLIST_NODE_TYPE_ANY;
 }
 
 UINT32
 XmlNodeChildren (
-  IN  CONST XML_NODE  *Node
+  IN OUT  XML_NODE  *Node
   )
 {
   ASSERT (Node != NULL);
 
+  if (!XmlNodeExpand (Node)) {
+    return 0;
+  }
+
   return Node->Children ? Node->Children->NodeCount : 0;
 }
 
 XML_NODE *
 XmlNodeChild (
-  IN  CONST XML_NODE  *Node,
-  IN  UINT32          Child
+  IN OUT  XML_NODE  *Node,
+  IN      UINT32    Child
   )
 {
   ASSERT (Node != NULL);
 
+  if (!XmlNodeExpand (Node)) {
+    return NULL;
+  }
+
   return Node->Children->NodeList[Child];
 }
 
@@ -1590,7 +2435,11 @@ XmlNodeAppend (
   ASSERT (Node != NULL);
   ASSERT (Name != NULL);
 
-  NewNode = XmlNodeCreate (Name, Attributes, Content, NULL, NULL);
+  if (!XmlNodeExpand (Node)) {
+    return NULL;
+  }
+
+  NewNode = XmlNodeCreate (Node->Document, Name, Attributes, Content, NULL, NULL);
   if (NewNode == NULL) {
     return NULL;
   }
@@ -1636,6 +2485,11 @@ XmlNodeRemoveByIndex (
   )
 {
   ASSERT (Node != NULL);
+
+  if (!XmlNodeExpand (Node)) {
+    return;
+  }
+
   ASSERT (Node->Children != NULL);
   ASSERT (Index < Node->Children->NodeCount);
 
@@ -1669,6 +2523,11 @@ XmlNodeRemove (
   UINT32  Index;
 
   ASSERT (Node != NULL);
+
+  if (!XmlNodeExpand (Node)) {
+    return;
+  }
+
   ASSERT (Node->Children != NULL);
   ASSERT (ChildNode != NULL);
 
@@ -1788,7 +2647,7 @@ PlistNodeCast (
     case PLIST_NODE_TYPE_KEY:
     case PLIST_NODE_TYPE_INTEGER:
     case PLIST_NODE_TYPE_REAL:
-      if (XmlNodeContent (Node) == NULL) {
+      if ((XmlNodeContent (Node) == NULL) && (Node->BinaryType != PLIST_NODE_TYPE_INTEGER)) {
         XML_USAGE_ERROR ("PlistNodeType::key or int have no content");
         return NULL;
       }
@@ -1811,7 +2670,7 @@ PlistNodeCast (
 
 UINT32
 PlistDictChildren (
-  IN  CONST XML_NODE  *Node
+  IN OUT  XML_NODE  *Node
   )
 {
   ASSERT (Node != NULL);
@@ -1821,9 +2680,9 @@ PlistDictChildren (
 
 XML_NODE *
 PlistDictChild (
-  IN   CONST XML_NODE  *Node,
-  IN   UINT32          Child,
-  OUT  XML_NODE        **Value OPTIONAL
+  IN OUT  XML_NODE  *Node,
+  IN      UINT32    Child,
+  OUT     XML_NODE  **Value OPTIONAL
   )
 {
   ASSERT (Node != NULL);
@@ -1900,6 +2759,10 @@ PlistDataValue (
     return FALSE;
   }
 
+  if (Node->BinaryType == PLIST_NODE_TYPE_DATA) {
+    return XmlNodeBinaryDataValue (Node, Buffer, Size);
+  }
+
   Content = XmlNodeContent (Node);
   if (Content == NULL) {
     *Size = 0;
@@ -1957,33 +2820,37 @@ PlistIntegerValue (
     return FALSE;
   }
 
-  TempStr = XmlNodeContent (Node);
+  if (Node->BinaryType == PLIST_NODE_TYPE_INTEGER) {
+    Temp = PlistBinaryIntegerValue (Node, NULL);
+  } else {
+    TempStr = XmlNodeContent (Node);
 
-  while (*TempStr == ' ' || *TempStr == '\t') {
-    ++TempStr;
-  }
+    while (*TempStr == ' ' || *TempStr == '\t') {
+      ++TempStr;
+    }
 
-  Negate = *TempStr == '-';
+    Negate = *TempStr == '-';
 
-  if (Negate) {
-    ++TempStr;
-  }
+    if (Negate) {
+      ++TempStr;
+    }
 
-  if (Hex && (TempStr[0] != '0') && (TempStr[1] != 'x')) {
-    Hex = FALSE;
-  }
+    if (Hex && (TempStr[0] != '0') && (TempStr[1] != 'x')) {
+      Hex = FALSE;
+    }
 
-  if (Hex) {
-    Temp = AsciiStrHexToUint64 (TempStr);
-  } else {
-    Temp = AsciiStrDecimalToUint64 (TempStr);
-  }
+    if (Hex) {
+      Temp = AsciiStrHexToUint64 (TempStr);
+    } else {
+      Temp = AsciiStrDecimalToUint64 (TempStr);
+    }
 
-  //
-  // May produce unexpected results when the value is too large, but just do not care.
-  //
-  if (Negate) {
-    Temp = 0ULL - Temp;
+    //
+    // May produce unexpected results when the value is too large, but just do not care.
+    //
+    if (Negate) {
+      Temp = 0ULL - Temp;
+    }
   }
 
   switch (Size) {
@@ -2019,6 +2886,10 @@ PlistMultiDataValue (
   ASSERT (Size   != NULL);
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) != NULL) {
+    if (Node->BinaryType == PLIST_NODE_TYPE_DATA) {
+      return XmlNodeBinaryDataValue (Node, Buffer, Size);
+    }
+
     Content = XmlNodeContent (Node);
     if (Content != NULL) {
       Length = *Size;
@@ -2054,8 +2925,13 @@ PlistMultiDataValue (
   }
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_INTEGER) != NULL) {
-    *(UINT32 *)Buffer = (UINT32)AsciiStrDecimalToUint64 (XmlNodeContent (Node));
-    *Size             = sizeof (UINT32);
+    if (Node->BinaryType == PLIST_NODE_TYPE_INTEGER) {
+      *(UINT32 *)Buffer = (UINT32)PlistBinaryIntegerValue (Node, NULL);
+    } else {
+      *(UINT32 *)Buffer = (UINT32)AsciiStrDecimalToUint64 (XmlNodeContent (Node));
+    }
+
+    *Size = sizeof (UINT32);
     return TRUE;
   }
 
@@ -2112,6 +2988,11 @@ PlistDataSize (
     return FALSE;
   }
 
+  if (Node->BinaryType == PLIST_NODE_TYPE_DATA) {
+    *Size = Node->Size;
+    return TRUE;
+  }
+
   Content = XmlNodeContent (Node);
   if (Content != NULL) {
     *Size = (UINT32)AsciiStrLen (Content);
@@ -2133,6 +3014,11 @@ PlistMultiDataSize (
   ASSERT (Size != NULL);
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) != NULL) {
+    if (Node->BinaryType == PLIST_NODE_TYPE_DATA) {
+      *Size = Node->Size;
+      return TRUE;
+    }
+
     Content = XmlNodeContent (Node);
     if (Content != NULL) {
       *Size = (UINT32)AsciiStrLen (Content);
@@ -0,0 +1,166 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#ifndef OC_XML_LIB_INTERNAL_H
+#define OC_XML_LIB_INTERNAL_H
+
+#include <Library/OcXmlLib.h>
+
+/**
+  Initial and maximum arena slab sizes. Every new slab doubles in size
+  to keep slab count low on large documents like prelinked plist.
+**/
+#define XML_ARENA_MIN_SLAB_SIZE  SIZE_64KB
+#define XML_ARENA_MAX_SLAB_SIZE  SIZE_2MB
+
+struct XML_NODE_LIST_;
+struct XML_NODE_LAZY_;
+struct XML_ARENA_SLAB_;
+
+typedef struct XML_NODE_LIST_   XML_NODE_LIST;
+typedef struct XML_NODE_LAZY_   XML_NODE_LAZY;
+typedef struct XML_ARENA_SLAB_  XML_ARENA_SLAB;
+
+/**
+  An XML_NODE will always contain a tag name and possibly a list of
+  children or text content. Children of lazy nodes are parsed on first access.
+  Nodes are allocated from the arena of the document they belong to.
+  Nodes read from binary plists have BinaryType set to their plist type
+  and refer to their data of Size bytes in the document buffer. Content of
+  such string and key nodes is null-terminated and escaped like in XML plists.
+**/
+struct XML_NODE_ {
+  CONST CHAR8      *Name;
+  CONST CHAR8      *Attributes;
+  CONST CHAR8      *Content;
+  XML_NODE         *Real;
+  XML_NODE_LIST    *Children;
+  XML_NODE_LAZY    *Lazy;
+  XML_DOCUMENT     *Document;
+  UINT32           Size;
+  UINT8            BinaryType;
+};
+
+struct XML_NODE_LIST_ {
+  UINT32      NodeCount;
+  UINT32      AllocCount;
+  XML_NODE    *NodeList[];
+};
+
+typedef struct {
+  UINT32      RefCount;
+  UINT32      RefAllocCount;
+  XML_NODE    **RefList;
+} XML_REFLIST;
+
+/**
+  Arena slab, allocated memory follows the header.
+**/
+struct XML_ARENA_SLAB_ {
+  XML_ARENA_SLAB    *Next;
+  UINTN             Pages;
+  UINTN             Used;
+};
+
+/**
+  An XML_DOCUMENT simply contains the root node and the underlying buffer.
+  LazyReferences map references defined within unparsed lazy nodes
+  to these nodes. Nodes, child lists, and lazy node data are carved from
+  the arena slabs, which are all released at once with the document.
+**/
+struct XML_DOCUMENT_ {
+  struct {
+    CHAR8     *Buffer;
+    UINT32    Length;
+  } Buffer;
+
+  XML_NODE          *Root;
+  XML_REFLIST       References;
+  XML_REFLIST       LazyReferences;
+  XML_ARENA_SLAB    *Arena;
+  UINTN             ArenaSlabSize;
+  BOOLEAN           WithRefs;
+  //
+  // Set when a lazy node failed to parse, such document cannot be exported.
+  //
+  BOOLEAN           Malformed;
+};
+
+/**
+  Unparsed children of a lazy node.
+**/
+struct XML_NODE_LAZY_ {
+  CHAR8     *Buffer;
+  UINT32    Length;
+  UINT32    Level;
+  UINT32    RefMin;
+  UINT32    RefMax;
+};
+
+/**
+  Plist node type names, matching XML tag names.
+**/
+extern CONST CHAR8  *PlistNodeTypes[PLIST_NODE_TYPE_MAX];
+
+/**
+  Allocate memory from the document arena.
+  Arena memory is only freed together with the document.
+
+  @param[in,out]  Document  A pointer to the XML document.
+  @param[in]      Size      Size of the memory to allocate.
+
+  @return  The allocated memory aligned to 64 bits or NULL.
+**/
+VOID *
+XmlArenaAllocate (
+  IN OUT  XML_DOCUMENT  *Document,
+  IN      UINTN         Size
+  );
+
+/**
+  Create a new XML node.
+
+  @param[in]  Document    Document the new node belongs to.
+  @param[in]  Name        Name of the new node.
+  @param[in]  Attributes  Attributes of the new node. Optional.
+  @param[in]  Content     Content of the new node. Optional.
+  @param[in]  Real        Pointer to the acual content when a reference exists. Optional.
+  @param[in]  Children    Pointer to the children of the node. Optional.
+
+  @return  The created XML node.
+**/
+XML_NODE *
+XmlNodeCreate (
+  IN  XML_DOCUMENT   *Document,
+  IN  CONST CHAR8    *Name,
+  IN  CONST CHAR8    *Attributes  OPTIONAL,
+  IN  CONST CHAR8    *Content     OPTIONAL,
+  IN  XML_NODE       *Real        OPTIONAL,
+  IN  XML_NODE_LIST  *Children    OPTIONAL
+  );
+
+/**
+  Get the value of an integer node read from a binary plist.
+  Values wider than 64 bits are truncated.
+
+  @param[in]   Node      A pointer to the binary integer node.
+  @param[out]  Negative  Set to TRUE when the value is negative. Optional.
+
+  @return  The integer value.
+**/
+UINT64
+PlistBinaryIntegerValue (
+  IN   CONST XML_NODE  *Node,
+  OUT  BOOLEAN         *Negative  OPTIONAL
+  );
+
+#endif // OC_XML_LIB_INTERNAL_H
@@ -0,0 +1,1391 @@
+/** @file
+  Binary plist (bplist00) support.
+
+  Copyright (C) 2026, agent. All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseOverflowLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcStringLib.h>
+#include <Library/OcXmlLib.h>
+
+#include "OcXmlLibInternal.h"
+
+/**
+  Object markers, stored in the high nibble of the first object byte.
+  The low nibble contains the object size or count.
+**/
+#define PLIST_BINARY_MARKER_SIMPLE   0x00U
+#define PLIST_BINARY_MARKER_INTEGER  0x10U
+#define PLIST_BINARY_MARKER_DATA     0x40U
+#define PLIST_BINARY_MARKER_ASCII    0x50U
+#define PLIST_BINARY_MARKER_UNICODE  0x60U
+#define PLIST_BINARY_MARKER_ARRAY    0xA0U
+#define PLIST_BINARY_MARKER_DICT     0xD0U
+
+#define PLIST_BINARY_FALSE  0x08U
+#define PLIST_BINARY_TRUE   0x09U
+
+/**
+  Object count nibble meaning that the count follows as an integer object.
+**/
+#define PLIST_BINARY_COUNT_EXTENDED  0x0FU
+
+/**
+  Maximum number of nodes in a document read from a binary plist.
+  Objects referenced several times are expanded into separate nodes,
+  so node count of crafted plists could otherwise grow exponentially.
+**/
+#define PLIST_BINARY_MAX_NODES  (XML_PARSER_MAX_SIZE / 16)
+
+/**
+  Binary plist trailer at the end of the file, integers are big endian.
+**/
+typedef struct {
+  UINT8    Unused[5];
+  UINT8    SortVersion;
+  UINT8    OffsetIntSize;
+  UINT8    ObjectRefSize;
+  UINT8    NumObjects[8];
+  UINT8    TopObject[8];
+  UINT8    OffsetTableOffset[8];
+} PLIST_BINARY_TRAILER;
+
+/**
+  Binary plist reader context.
+**/
+typedef struct {
+  XML_DOCUMENT    *Document;
+  UINT8           *Buffer;
+  UINT32          OffsetTable;
+  UINT32          ObjectCount;
+  UINT8           OffsetSize;
+  UINT8           RefSize;
+  UINT32          NodeCount;
+  //
+  // Offsets past ASCII strings to be null-terminated after parsing.
+  //
+  UINT32          *StringEnds;
+} PLIST_BINARY_READER;
+
+/**
+  Binary plist writer context.
+**/
+typedef struct {
+  UINT8     *Buffer;
+  UINT32    Size;
+  UINT32    AllocSize;
+  UINT32    *Offsets;
+  UINT32    ObjectCount;
+  UINT32    ObjectIndex;
+  UINT8     RefSize;
+} PLIST_BINARY_WRITER;
+
+/**
+  Read big endian integer.
+
+  @param[in]  Data  Integer data.
+  @param[in]  Size  Integer size, up to 8 bytes.
+
+  @return  Integer value.
+**/
+STATIC
+UINT64
+PlistBinaryReadInteger (
+  IN  CONST UINT8  *Data,
+  IN  UINT32       Size
+  )
+{
+  UINT64  Value;
+  UINT32  Index;
+
+  ASSERT (Size <= sizeof (UINT64));
+
+  Value = 0;
+  for (Index = 0; Index < Size; ++Index) {
+    Value = LShiftU64 (Value, 8) | Data[Index];
+  }
+
+  return Value;
+}
+
+/**
+  Write big endian integer.
+
+  @param[out]  Data   Integer data.
+  @param[in]   Size   Integer size, up to 8 bytes.
+  @param[in]   Value  Integer value.
+**/
+STATIC
+VOID
+PlistBinaryWriteInteger (
+  OUT UINT8   *Data,
+  IN  UINT32  Size,
+  IN  UINT64  Value
+  )
+{
+  ASSERT (Size <= sizeof (UINT64));
+
+  while (Size > 0) {
+    Data[--Size] = (UINT8)Value;
+    Value        = RShiftU64 (Value, 8);
+  }
+}
+
+/**
+  Get the smallest integer size from 1, 2, 4, and 8 bytes fitting the value.
+
+  @param[in]  Value  Integer value.
+
+  @return  Integer size.
+**/
+STATIC
+UINT8
+PlistBinaryIntegerSize (
+  IN  UINT64  Value
+  )
+{
+  if (Value <= MAX_UINT8) {
+    return sizeof (UINT8);
+  }
+
+  if (Value <= MAX_UINT16) {
+    return sizeof (UINT16);
+  }
+
+  if (Value <= MAX_UINT32) {
+    return sizeof (UINT32);
+  }
+
+  return sizeof (UINT64);
+}
+
+UINT64
+PlistBinaryIntegerValue (
+  IN   CONST XML_NODE  *Node,
+  OUT  BOOLEAN         *Negative  OPTIONAL
+  )
+{
+  CONST UINT8  *Data;
+  UINT32       Size;
+
+  ASSERT (Node != NULL);
+  ASSERT (Node->BinaryType == PLIST_NODE_TYPE_INTEGER);
+
+  Data = (CONST UINT8 *)Node->Content;
+  Size = Node->Size;
+
+  //
+  // Only 8 and 16 byte integers are signed.
+  //
+  if (Negative != NULL) {
+    *Negative = Size >= sizeof (UINT64) && (Data[0] & BIT7) != 0;
+  }
+
+  if (Size > sizeof (UINT64)) {
+    Data += Size - sizeof (UINT64);
+    Size  = sizeof (UINT64);
+  }
+
+  return PlistBinaryReadInteger (Data, Size);
+}
+
+/**
+  Get the offset of a binary plist object.
+
+  @param[in]   Reader     A pointer to the binary plist reader.
+  @param[in]   Reference  Object reference.
+  @param[out]  Offset     Object offset.
+
+  @retval  TRUE if the reference is valid.
+**/
+STATIC
+BOOLEAN
+PlistBinaryObjectOffset (
+  IN  CONST PLIST_BINARY_READER  *Reader,
+  IN  UINT64                     Reference,
+  OUT UINT32                     *Offset
+  )
+{
+  UINT64  Value;
+
+  if (Reference >= Reader->ObjectCount) {
+    return FALSE;
+  }
+
+  Value = PlistBinaryReadInteger (
+            &Reader->Buffer[Reader->OffsetTable + (UINT32)Reference * Reader->OffsetSize],
+            Reader->OffsetSize
+            );
+
+  if ((Value < L_STR_LEN (PLIST_BINARY_SIGNATURE)) || (Value >= Reader->OffsetTable)) {
+    return FALSE;
+  }
+
+  *Offset = (UINT32)Value;
+  return TRUE;
+}
+
+/**
+  Get the size or count of a binary plist object.
+
+  @param[in]   Reader      A pointer to the binary plist reader.
+  @param[in]   Offset      Object offset.
+  @param[out]  Count       Object size or count.
+  @param[out]  DataOffset  Offset of the object data.
+
+  @retval  TRUE on successful parsing.
+**/
+STATIC
+BOOLEAN
+PlistBinaryObjectCount (
+  IN  CONST PLIST_BINARY_READER  *Reader,
+  IN  UINT32                     Offset,
+  OUT UINT32                     *Count,
+  OUT UINT32                     *DataOffset
+  )
+{
+  UINT8   Marker;
+  UINT32  Size;
+  UINT64  Value;
+
+  Marker = Reader->Buffer[Offset];
+  ++Offset;
+
+  if ((Marker & 0x0FU) != PLIST_BINARY_COUNT_EXTENDED) {
+    *Count      = Marker & 0x0FU;
+    *DataOffset = Offset;
+    return TRUE;
+  }
+
+  //
+  // Extended count is an integer object of up to 8 bytes.
+  //
+  if (Offset >= Reader->OffsetTable) {
+    return FALSE;
+  }
+
+  Marker = Reader->Buffer[Offset];
+  if (((Marker & 0xF0U) != PLIST_BINARY_MARKER_INTEGER) || ((Marker & 0x0FU) > 3)) {
+    return FALSE;
+  }
+
+  Size = 1U << (Marker & 0x0FU);
+  ++Offset;
+
+  if (Reader->OffsetTable - Offset < Size) {
+    return FALSE;
+  }
+
+  Value = PlistBinaryReadInteger (&Reader->Buffer[Offset], Size);
+  if (Value > MAX_UINT32) {
+    return FALSE;
+  }
+
+  *Count      = (UINT32)Value;
+  *DataOffset = Offset + Size;
+  return TRUE;
+}
+
+/**
+  Convert big endian UTF-16 string to UTF-8.
+
+  @param[in,out]  Document  A pointer to the document to allocate the string in.
+  @param[in]      Data      UTF-16 string data.
+  @param[in]      Count     UTF-16 string length in code units.
+
+  @return  Null-terminated UTF-8 string or NULL.
+**/
+STATIC
+CHAR8 *
+PlistBinaryUnicodeToUtf8 (
+  IN OUT  XML_DOCUMENT  *Document,
+  IN      CONST UINT8   *Data,
+  IN      UINT32        Count
+  )
+{
+  CHAR8   *String;
+  CHAR8   *Walker;
+  UINT32  Index;
+  UINT32  Char;
+  UINT32  Low;
+
+  //
+  // Each code unit takes at most 3 bytes, surrogate pairs take 4.
+  //
+  String = XmlArenaAllocate (Document, (UINTN)Count * 3 + 1);
+  if (String == NULL) {
+    return NULL;
+  }
+
+  Walker = String;
+
+  for (Index = 0; Index < Count; ++Index) {
+    Char = ((UINT32)Data[Index * 2] << 8U) | Data[Index * 2 + 1];
+
+    if ((Char >= 0xD800U) && (Char <= 0xDBFFU)) {
+      if (Index + 1 >= Count) {
+        return NULL;
+      }
+
+      ++Index;
+      Low = ((UINT32)Data[Index * 2] << 8U) | Data[Index * 2 + 1];
+      if ((Low < 0xDC00U) || (Low > 0xDFFFU)) {
+        return NULL;
+      }
+
+      Char = 0x10000U + ((Char - 0xD800U) << 10U) + (Low - 0xDC00U);
+    } else if ((Char >= 0xDC00U) && (Char <= 0xDFFFU)) {
+      return NULL;
+    }
+
+    if (Char < 0x80U) {
+      *Walker++ = (CHAR8)Char;
+    } else if (Char < 0x800U) {
+      *Walker++ = (CHAR8)(0xC0U | (Char >> 6U));
+      *Walker++ = (CHAR8)(0x80U | (Char & 0x3FU));
+    } else if (Char < 0x10000U) {
+      *Walker++ = (CHAR8)(0xE0U | (Char >> 12U));
+      *Walker++ = (CHAR8)(0x80U | ((Char >> 6U) & 0x3FU));
+      *Walker++ = (CHAR8)(0x80U | (Char & 0x3FU));
+    } else {
+      *Walker++ = (CHAR8)(0xF0U | (Char >> 18U));
+      *Walker++ = (CHAR8)(0x80U | ((Char >> 12U) & 0x3FU));
+      *Walker++ = (CHAR8)(0x80U | ((Char >> 6U) & 0x3FU));
+      *Walker++ = (CHAR8)(0x80U | (Char & 0x3FU));
+    }
+  }
+
+  *Walker = '\0';
+  return String;
+}
+
+/**
+  Escape XML special characters in binary plist string content. Plist
+  string and key nodes hold escaped content regardless of the format
+  they were read from, so consumers treat them the same way.
+
+  @param[in,out]  Document  A pointer to the document to allocate the string in.
+  @param[in]      String    String, not necessarily null-terminated.
+  @param[in,out]  Length    String length, updated to escaped string length.
+
+  @return  String itself when there is nothing to escape, escaped
+           null-terminated string, or NULL.
+**/
+STATIC
+CONST CHAR8 *
+PlistBinaryEscapeString (
+  IN OUT  XML_DOCUMENT  *Document,
+  IN      CONST CHAR8   *String,
+  IN OUT  UINT32        *Length
+  )
+{
+  CHAR8        *Escaped;
+  CHAR8        *Walker;
+  CONST CHAR8  *Escape;
+  UINT64       EscapedLength;
+  UINT32       Index;
+
+  EscapedLength = *Length;
+  for (Index = 0; Index < *Length; ++Index) {
+    if (String[Index] == '&') {
+      EscapedLength += L_STR_LEN ("&amp;") - 1;
+    } else if ((String[Index] == '<') || (String[Index] == '>')) {
+      EscapedLength += L_STR_LEN ("&lt;") - 1;
+    }
+  }
+
+  if (EscapedLength == *Length) {
+    return String;
+  }
+
+  if (EscapedLength >= MAX_UINT32) {
+    return NULL;
+  }
+
+  Escaped = XmlArenaAllocate (Document, (UINTN)EscapedLength + 1);
+  if (Escaped == NULL) {
+    return NULL;
+  }
+
+  Walker = Escaped;
+  for (Index = 0; Index < *Length; ++Index) {
+    if (String[Index] == '&') {
+      Escape = "&amp;";
+    } else if (String[Index] == '<') {
+      Escape = "&lt;";
+    } else if (String[Index] == '>') {
+      Escape = "&gt;";
+    } else {
+      *Walker++ = String[Index];
+      continue;
+    }
+
+    CopyMem (Walker, Escape, AsciiStrLen (Escape));
+    Walker += AsciiStrLen (Escape);
+  }
+
+  *Walker = '\0';
+  *Length = (UINT32)EscapedLength;
+  return Escaped;
+}
+
+/**
+  Parse a binary plist object into a node.
+
+  @param[in,out]  Reader     A pointer to the binary plist reader.
+  @param[in]      Reference  Object reference.
+  @param[in]      Level      Nesting level of the object.
+  @param[in]      Key        TRUE when the object is a dictionary key.
+
+  @return  The parsed node or NULL.
+**/
+STATIC
+XML_NODE *
+PlistBinaryParseObject (
+  IN OUT  PLIST_BINARY_READER  *Reader,
+  IN      UINT64               Reference,
+  IN      UINT32               Level,
+  IN      BOOLEAN              Key
+  )
+{
+  XML_NODE         *Node;
+  XML_NODE         *Child;
+  XML_NODE_LIST    *Children;
+  PLIST_NODE_TYPE  Type;
+  CONST CHAR8      *Content;
+  CONST CHAR8      *Escaped;
+  UINT32           Offset;
+  UINT32           DataOffset;
+  UINT32           Count;
+  UINT32           Size;
+  UINT32           Index;
+  UINT8            Marker;
+
+  if ((Level > XML_PARSER_NEST_LEVEL) || (Reader->NodeCount >= PLIST_BINARY_MAX_NODES)) {
+    return NULL;
+  }
+
+  if (!PlistBinaryObjectOffset (Reader, Reference, &Offset)) {
+    return NULL;
+  }
+
+  ++Reader->NodeCount;
+
+  Marker   = Reader->Buffer[Offset];
+  Content  = NULL;
+  Size     = 0;
+  Count    = 0;
+  Children = NULL;
+
+  switch (Marker & 0xF0U) {
+    case PLIST_BINARY_MARKER_SIMPLE:
+      if (Marker == PLIST_BINARY_TRUE) {
+        Type = PLIST_NODE_TYPE_TRUE;
+      } else if (Marker == PLIST_BINARY_FALSE) {
+        Type = PLIST_NODE_TYPE_FALSE;
+      } else {
+        return NULL;
+      }
+
+      break;
+
+    case PLIST_BINARY_MARKER_INTEGER:
+      if ((Marker & 0x0FU) > 4) {
+        return NULL;
+      }
+
+      Type = PLIST_NODE_TYPE_INTEGER;
+      Size = 1U << (Marker & 0x0FU);
+      ++Offset;
+
+      if (Reader->OffsetTable - Offset < Size) {
+        return NULL;
+      }
+
+      Content = (CONST CHAR8 *)&Reader->Buffer[Offset];
+      break;
+
+    case PLIST_BINARY_MARKER_DATA:
+    case PLIST_BINARY_MARKER_ASCII:
+      if (  !PlistBinaryObjectCount (Reader, Offset, &Size, &DataOffset)
+         || (Reader->OffsetTable - DataOffset < Size))
+      {
+        return NULL;
+      }
+
+      Content = (CONST CHAR8 *)&Reader->Buffer[DataOffset];
+
+      if ((Marker & 0xF0U) == PLIST_BINARY_MARKER_DATA) {
+        Type = PLIST_NODE_TYPE_DATA;
+      } else {
+        Type    = PLIST_NODE_TYPE_STRING;
+        Escaped = PlistBinaryEscapeString (Reader->Document, Content, &Size);
+        if (Escaped == NULL) {
+          return NULL;
+        }
+
+        if (Escaped == Content) {
+          //
+          // The byte past the string belongs to the next object or the offset table,
+          // so the terminator can only be written once everything is parsed.
+          //
+          Reader->StringEnds[(UINT32)Reference] = DataOffset + Size;
+        }
+
+        Content = Escaped;
+      }
+
+      break;
+
+    case PLIST_BINARY_MARKER_UNICODE:
+      if (  !PlistBinaryObjectCount (Reader, Offset, &Size, &DataOffset)
+         || ((Reader->OffsetTable - DataOffset) / 2 < Size))
+      {
+        return NULL;
+      }
+
+      Type    = PLIST_NODE_TYPE_STRING;
+      Content = PlistBinaryUnicodeToUtf8 (Reader->Document, &Reader->Buffer[DataOffset], Size);
+      if (Content == NULL) {
+        return NULL;
+      }
+
+      Size    = (UINT32)AsciiStrLen (Content);
+      Content = PlistBinaryEscapeString (Reader->Document, Content, &Size);
+      if (Content == NULL) {
+        return NULL;
+      }
+
+      break;
+
+    case PLIST_BINARY_MARKER_ARRAY:
+    case PLIST_BINARY_MARKER_DICT:
+      if (!PlistBinaryObjectCount (Reader, Offset, &Count, &DataOffset)) {
+        return NULL;
+      }
+
+      if ((Marker & 0xF0U) == PLIST_BINARY_MARKER_DICT) {
+        Type = PLIST_NODE_TYPE_DICT;
+        if (Count > XML_PARSER_NODE_COUNT / 2) {
+          return NULL;
+        }
+
+        Count *= 2;
+      } else {
+        Type = PLIST_NODE_TYPE_ARRAY;
+        if (Count > XML_PARSER_NODE_COUNT) {
+          return NULL;
+        }
+      }
+
+      if ((Reader->OffsetTable - DataOffset) / Reader->RefSize < Count) {
+        return NULL;
+      }
+
+      if (Count > 0) {
+        Children = XmlArenaAllocate (
+                     Reader->Document,
+                     sizeof (XML_NODE_LIST) + sizeof (Children->NodeList[0]) * Count
+                     );
+        if (Children == NULL) {
+          return NULL;
+        }
+
+        Children->NodeCount  = Count;
+        Children->AllocCount = Count;
+      }
+
+      break;
+
+    default:
+      DEBUG ((DEBUG_INFO, "OCXML: Unsupported binary plist object %X\n", Marker));
+      return NULL;
+  }
+
+  if (Key) {
+    if (Type != PLIST_NODE_TYPE_STRING) {
+      return NULL;
+    }
+
+    Type = PLIST_NODE_TYPE_KEY;
+  }
+
+  Node = XmlNodeCreate (Reader->Document, PlistNodeTypes[Type], NULL, Content, NULL, NULL);
+  if (Node == NULL) {
+    return NULL;
+  }
+
+  Node->Size       = Size;
+  Node->BinaryType = (UINT8)Type;
+
+  //
+  // Dictionaries store all key references followed by all value references.
+  //
+  for (Index = 0; Index < Count; ++Index) {
+    if (Type == PLIST_NODE_TYPE_DICT) {
+      Offset = DataOffset + ((Index % 2) * (Count / 2) + Index / 2) * Reader->RefSize;
+    } else {
+      Offset = DataOffset + Index * Reader->RefSize;
+    }
+
+    Child = PlistBinaryParseObject (
+              Reader,
+              PlistBinaryReadInteger (&Reader->Buffer[Offset], Reader->RefSize),
+              Level + 1,
+              Type == PLIST_NODE_TYPE_DICT && Index % 2 == 0
+              );
+    if (Child == NULL) {
+      return NULL;
+    }
+
+    Children->NodeList[Index] = Child;
+  }
+
+  Node->Children = Children;
+
+  return Node;
+}
+
+BOOLEAN
+PlistIsBinary (
+  IN  CONST VOID  *Buffer,
+  IN  UINT32      Length
+  )
+{
+  ASSERT (Buffer != NULL);
+
+  return Length >= L_STR_LEN (PLIST_BINARY_SIGNATURE)
+         && CompareMem (Buffer, PLIST_BINARY_SIGNATURE, L_STR_LEN (PLIST_BINARY_SIGNATURE)) == 0;
+}
+
+XML_DOCUMENT *
+PlistDocumentParseBinary (
+  IN OUT  UINT8   *Buffer,
+  IN      UINT32  Length
+  )
+{
+  PLIST_BINARY_READER   Reader;
+  PLIST_BINARY_TRAILER  *Trailer;
+  XML_DOCUMENT          *Document;
+  XML_NODE              *Root;
+  XML_NODE              *Child;
+  UINT64                ObjectCount;
+  UINT64                TopObject;
+  UINT64                OffsetTable;
+  UINT32                Index;
+
+  ASSERT (Buffer != NULL);
+
+  if (  !PlistIsBinary (Buffer, Length)
+     || (Length < L_STR_LEN (PLIST_BINARY_SIGNATURE) + sizeof (PLIST_BINARY_TRAILER) + 1)
+     || (Length > XML_PARSER_MAX_SIZE))
+  {
+    return NULL;
+  }
+
+  Trailer     = (PLIST_BINARY_TRAILER *)&Buffer[Length - sizeof (PLIST_BINARY_TRAILER)];
+  ObjectCount = PlistBinaryReadInteger (Trailer->NumObjects, sizeof (Trailer->NumObjects));
+  TopObject   = PlistBinaryReadInteger (Trailer->TopObject, sizeof (Trailer->TopObject));
+  OffsetTable = PlistBinaryReadInteger (Trailer->OffsetTableOffset, sizeof (Trailer->OffsetTableOffset));
+
+  //
+  // Offset table follows the objects and precedes the trailer.
+  //
+  if (  (Trailer->OffsetIntSize == 0) || (Trailer->OffsetIntSize > sizeof (UINT64))
+     || (Trailer->ObjectRefSize == 0) || (Trailer->ObjectRefSize > sizeof (UINT64))
+     || (ObjectCount == 0) || (TopObject >= ObjectCount)
+     || (OffsetTable <= L_STR_LEN (PLIST_BINARY_SIGNATURE))
+     || (OffsetTable > Length - sizeof (PLIST_BINARY_TRAILER))
+     || ((Length - sizeof (PLIST_BINARY_TRAILER) - OffsetTable) / Trailer->OffsetIntSize < ObjectCount))
+  {
+    DEBUG ((DEBUG_INFO, "OCXML: Invalid binary plist trailer\n"));
+    return NULL;
+  }
+
+  ZeroMem (&Reader, sizeof (Reader));
+  Reader.Buffer      = Buffer;
+  Reader.OffsetTable = (UINT32)OffsetTable;
+  Reader.ObjectCount = (UINT32)ObjectCount;
+  Reader.OffsetSize  = Trailer->OffsetIntSize;
+  Reader.RefSize     = Trailer->ObjectRefSize;
+  Reader.StringEnds  = AllocateZeroPool (Reader.ObjectCount * sizeof (Reader.StringEnds[0]));
+  if (Reader.StringEnds == NULL) {
+    return NULL;
+  }
+
+  Document = AllocateZeroPool (sizeof (XML_DOCUMENT));
+  if (Document == NULL) {
+    FreePool (Reader.StringEnds);
+    return NULL;
+  }
+
+  Document->Buffer.Buffer = (CHAR8 *)Buffer;
+  Document->Buffer.Length = Length;
+  Document->ArenaSlabSize = XML_ARENA_MIN_SLAB_SIZE;
+  Reader.Document         = Document;
+
+  //
+  // Wrap the top object in plist node to match XML documents.
+  //
+  Root = XmlNodeCreate (Document, "plist", "version=\"1.0\"", NULL, NULL, NULL);
+  if (Root != NULL) {
+    Root->Children = XmlArenaAllocate (Document, sizeof (XML_NODE_LIST) + sizeof (Root->Children->NodeList[0]));
+  }
+
+  if ((Root == NULL) || (Root->Children == NULL)) {
+    FreePool (Reader.StringEnds);
+    XmlDocumentFree (Document);
+    return NULL;
+  }
+
+  Child = PlistBinaryParseObject (&Reader, TopObject, 1, FALSE);
+  if (Child == NULL) {
+    DEBUG ((DEBUG_INFO, "OCXML: Failed to parse binary plist\n"));
+    FreePool (Reader.StringEnds);
+    XmlDocumentFree (Document);
+    return NULL;
+  }
+
+  Root->Children->NodeCount   = 1;
+  Root->Children->AllocCount  = 1;
+  Root->Children->NodeList[0] = Child;
+  Document->Root              = Root;
+
+  for (Index = 0; Index < Reader.ObjectCount; ++Index) {
+    if (Reader.StringEnds[Index] != 0) {
+      Buffer[Reader.StringEnds[Index]] = '\0';
+    }
+  }
+
+  FreePool (Reader.StringEnds);
+
+  return Document;
+}
+
+/**
+  Get plist type of the node.
+
+  @param[in]  Node  A pointer to the plist node.
+
+  @return  Plist node type or PLIST_NODE_TYPE_ANY for unknown or invalid nodes.
+**/
+STATIC
+PLIST_NODE_TYPE
+PlistBinaryNodeType (
+  IN  XML_NODE  *Node
+  )
+{
+  UINT32  Type;
+
+  for (Type = PLIST_NODE_TYPE_ARRAY; Type < PLIST_NODE_TYPE_MAX; ++Type) {
+    if (AsciiStrCmp (XmlNodeName (Node), PlistNodeTypes[Type]) == 0) {
+      if (PlistNodeCast (Node, (PLIST_NODE_TYPE)Type) == NULL) {
+        break;
+      }
+
+      return (PLIST_NODE_TYPE)Type;
+    }
+  }
+
+  return PLIST_NODE_TYPE_ANY;
+}
+
+/**
+  Count binary plist objects needed for the node and its children.
+
+  @param[in]      Node   A pointer to the plist node.
+  @param[in]      Level  Nesting level of the node.
+  @param[in,out]  Count  Object count to update.
+
+  @retval  TRUE if the node can be exported.
+**/
+STATIC
+BOOLEAN
+PlistBinaryCountObjects (
+  IN      XML_NODE  *Node,
+  IN      UINT32    Level,
+  IN OUT  UINT32    *Count
+  )
+{
+  PLIST_NODE_TYPE  Type;
+  UINT32           ChildCount;
+  UINT32           Index;
+
+  if (Level > XML_PARSER_NEST_LEVEL) {
+    return FALSE;
+  }
+
+  Type = PlistBinaryNodeType (Node);
+  if ((Type == PLIST_NODE_TYPE_ANY) || (Type == PLIST_NODE_TYPE_REAL) || (Type == PLIST_NODE_TYPE_DATE)) {
+    DEBUG ((DEBUG_INFO, "OCXML: Unsupported plist node %a for binary export\n", XmlNodeName (Node)));
+    return FALSE;
+  }
+
+  if (BaseOverflowAddU32 (*Count, 1, Count)) {
+    return FALSE;
+  }
+
+  ChildCount = XmlNodeChildren (Node);
+  for (Index = 0; Index < ChildCount; ++Index) {
+    if (  ((Type == PLIST_NODE_TYPE_DICT) && (Index % 2 == 0)
+           && (PlistNodeCast (XmlNodeChild (Node, Index), PLIST_NODE_TYPE_KEY) == NULL))
+       || !PlistBinaryCountObjects (XmlNodeChild (Node, Index), Level + 1, Count))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Append data to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Data    Data to append.
+  @param[in]      Size    Size of the data.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppend (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      CONST VOID           *Data,
+  IN      UINT32               Size
+  )
+{
+  UINT8   *NewBuffer;
+  UINT32  NewSize;
+
+  if (Writer->AllocSize - Writer->Size < Size) {
+    if (  BaseOverflowAddU32 (Writer->Size, Size, &NewSize)
+       || BaseOverflowAddU32 (NewSize, Writer->AllocSize, &NewSize))
+    {
+      return FALSE;
+    }
+
+    NewBuffer = AllocatePool (NewSize);
+    if (NewBuffer == NULL) {
+      return FALSE;
+    }
+
+    CopyMem (NewBuffer, Writer->Buffer, Writer->Size);
+    FreePool (Writer->Buffer);
+    Writer->Buffer    = NewBuffer;
+    Writer->AllocSize = NewSize;
+  }
+
+  CopyMem (&Writer->Buffer[Writer->Size], Data, Size);
+  Writer->Size += Size;
+  return TRUE;
+}
+
+/**
+  Append integer object to binary plist.
+
+  @param[in,out]  Writer    A pointer to the binary plist writer.
+  @param[in]      Value     Integer value.
+  @param[in]      Negative  TRUE when the value is negative.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendInteger (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      UINT64               Value,
+  IN      BOOLEAN              Negative
+  )
+{
+  UINT8  Data[1 + 2 * sizeof (UINT64)];
+  UINT8  Size;
+
+  //
+  // Negative integers take 8 bytes, while unsigned ones not fitting
+  // into signed 8 bytes take 16.
+  //
+  if (Negative) {
+    Size = sizeof (UINT64);
+  } else if (Value > MAX_INT64) {
+    Size = 2 * sizeof (UINT64);
+  } else {
+    Size = PlistBinaryIntegerSize (Value);
+  }
+
+  Data[0] = (UINT8)(PLIST_BINARY_MARKER_INTEGER | (HighBitSet32 (Size)));
+  ZeroMem (&Data[1], Size);
+  PlistBinaryWriteInteger (&Data[1 + Size - MIN (Size, sizeof (UINT64))], MIN (Size, sizeof (UINT64)), Value);
+
+  return PlistBinaryAppend (Writer, Data, 1 + Size);
+}
+
+/**
+  Append object marker with size or count to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Marker  Object marker.
+  @param[in]      Count   Object size or count.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendMarker (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      UINT8                Marker,
+  IN      UINT32               Count
+  )
+{
+  if (Count < PLIST_BINARY_COUNT_EXTENDED) {
+    Marker |= (UINT8)Count;
+    return PlistBinaryAppend (Writer, &Marker, sizeof (Marker));
+  }
+
+  Marker |= PLIST_BINARY_COUNT_EXTENDED;
+  return PlistBinaryAppend (Writer, &Marker, sizeof (Marker))
+         && PlistBinaryAppendInteger (Writer, Count, FALSE);
+}
+
+/**
+  Decode one UTF-8 character.
+
+  @param[in,out]  String  A pointer to the string, advanced past the character.
+  @param[out]     Char    Decoded code point.
+
+  @retval  TRUE on successful decoding.
+**/
+STATIC
+BOOLEAN
+PlistBinaryDecodeUtf8 (
+  IN OUT  CONST CHAR8  **String,
+  OUT     UINT32       *Char
+  )
+{
+  CONST UINT8  *Walker;
+  UINT32       Count;
+  UINT32       Index;
+
+  Walker = (CONST UINT8 *)*String;
+
+  if (Walker[0] < 0x80U) {
+    *Char = Walker[0];
+    Count = 0;
+  } else if ((Walker[0] & 0xE0U) == 0xC0U) {
+    *Char = Walker[0] & 0x1FU;
+    Count = 1;
+  } else if ((Walker[0] & 0xF0U) == 0xE0U) {
+    *Char = Walker[0] & 0x0FU;
+    Count = 2;
+  } else if ((Walker[0] & 0xF8U) == 0xF0U) {
+    *Char = Walker[0] & 0x07U;
+    Count = 3;
+  } else {
+    return FALSE;
+  }
+
+  for (Index = 1; Index <= Count; ++Index) {
+    if ((Walker[Index] & 0xC0U) != 0x80U) {
+      return FALSE;
+    }
+
+    *Char = (*Char << 6U) | (Walker[Index] & 0x3FU);
+  }
+
+  if (  (*Char > 0x10FFFFU)
+     || ((*Char >= 0xD800U) && (*Char <= 0xDFFFU))
+     || ((Count == 1) && (*Char < 0x80U))
+     || ((Count == 2) && (*Char < 0x800U))
+     || ((Count == 3) && (*Char < 0x10000U)))
+  {
+    return FALSE;
+  }
+
+  *String += Count + 1;
+  return TRUE;
+}
+
+/**
+  Append string object to binary plist. ASCII strings are stored as is,
+  others are converted to UTF-16.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      String  Null-terminated unescaped UTF-8 string.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendString (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      CONST CHAR8          *String
+  )
+{
+  CONST CHAR8  *Walker;
+  UINT32       Length;
+  UINT32       Count;
+  UINT32       Char;
+  UINT8        Unit[2 * sizeof (CHAR16)];
+  UINT32       UnitSize;
+  BOOLEAN      Ascii;
+
+  Ascii  = TRUE;
+  Length = 0;
+  while (String[Length] != '\0') {
+    if ((UINT8)String[Length] >= 0x80U) {
+      Ascii = FALSE;
+    }
+
+    ++Length;
+  }
+
+  if (Ascii) {
+    return PlistBinaryAppendMarker (Writer, PLIST_BINARY_MARKER_ASCII, Length)
+           && PlistBinaryAppend (Writer, String, Length);
+  }
+
+  Count  = 0;
+  Walker = String;
+  while (*Walker != '\0') {
+    if (!PlistBinaryDecodeUtf8 (&Walker, &Char)) {
+      DEBUG ((DEBUG_INFO, "OCXML: Invalid UTF-8 string %a\n", String));
+      return FALSE;
+    }
+
+    Count += Char >= 0x10000U ? 2 : 1;
+  }
+
+  if (!PlistBinaryAppendMarker (Writer, PLIST_BINARY_MARKER_UNICODE, Count)) {
+    return FALSE;
+  }
+
+  Walker = String;
+  while (*Walker != '\0') {
+    PlistBinaryDecodeUtf8 (&Walker, &Char);
+
+    if (Char >= 0x10000U) {
+      Char -= 0x10000U;
+      PlistBinaryWriteInteger (&Unit[0], sizeof (CHAR16), 0xD800U + (Char >> 10U));
+      PlistBinaryWriteInteger (&Unit[2], sizeof (CHAR16), 0xDC00U + (Char & 0x3FFU));
+      UnitSize = 2 * sizeof (CHAR16);
+    } else {
+      PlistBinaryWriteInteger (&Unit[0], sizeof (CHAR16), Char);
+      UnitSize = sizeof (CHAR16);
+    }
+
+    if (!PlistBinaryAppend (Writer, Unit, UnitSize)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Append string or key node to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Node    A pointer to the plist string or key node.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendStringNode (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      XML_NODE             *Node
+  )
+{
+  CONST CHAR8  *Content;
+  CONST CHAR8  *Unescaped;
+  BOOLEAN      Result;
+
+  Content = XmlNodeContent (Node);
+  if (Content == NULL) {
+    Content = "";
+  }
+
+  //
+  // Binary plists store unescaped strings.
+  //
+  if (AsciiStrStr (Content, "&") == NULL) {
+    return PlistBinaryAppendString (Writer, Content);
+  }
+
+  Unescaped = XmlUnescapeString (Content);
+  if (Unescaped == NULL) {
+    return FALSE;
+  }
+
+  Result = PlistBinaryAppendString (Writer, Unescaped);
+  FreePool ((VOID *)Unescaped);
+  return Result;
+}
+
+/**
+  Append data node to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Node    A pointer to the plist data node.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendDataNode (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      XML_NODE             *Node
+  )
+{
+  UINT8    *Data;
+  UINT32   Size;
+  BOOLEAN  Result;
+
+  if (!PlistDataSize (Node, &Size)) {
+    return FALSE;
+  }
+
+  Data = AllocatePool (MAX (Size, 1));
+  if (Data == NULL) {
+    return FALSE;
+  }
+
+  Result = PlistDataValue (Node, Data, &Size)
+           && PlistBinaryAppendMarker (Writer, PLIST_BINARY_MARKER_DATA, Size)
+           && PlistBinaryAppend (Writer, Data, Size);
+
+  FreePool (Data);
+  return Result;
+}
+
+/**
+  Append integer node to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Node    A pointer to the plist integer node.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendIntegerNode (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      XML_NODE             *Node
+  )
+{
+  CONST CHAR8  *Content;
+  UINT64       Value;
+  BOOLEAN      Negative;
+
+  if (Node->BinaryType == PLIST_NODE_TYPE_INTEGER) {
+    Value = PlistBinaryIntegerValue (Node, &Negative);
+  } else {
+    if (!PlistIntegerValue (Node, &Value, sizeof (Value), TRUE)) {
+      return FALSE;
+    }
+
+    Content = XmlNodeContent (Node);
+    while (*Content == ' ' || *Content == '\t') {
+      ++Content;
+    }
+
+    Negative = *Content == '-' && Value != 0;
+  }
+
+  return PlistBinaryAppendInteger (Writer, Value, Negative);
+}
+
+/**
+  Append node and its children to binary plist.
+
+  @param[in,out]  Writer  A pointer to the binary plist writer.
+  @param[in]      Node    A pointer to the plist node.
+  @param[in]      Index   Object index of the node.
+
+  @retval  TRUE on successful appending.
+**/
+STATIC
+BOOLEAN
+PlistBinaryAppendNode (
+  IN OUT  PLIST_BINARY_WRITER  *Writer,
+  IN      XML_NODE             *Node,
+  IN      UINT32               Index
+  )
+{
+  PLIST_NODE_TYPE  Type;
+  UINT32           ChildCount;
+  UINT32           ChildIndex;
+  UINT32           FirstChild;
+  UINT8            Reference[sizeof (UINT32)];
+  UINT8            Marker;
+
+  ASSERT (Index < Writer->ObjectCount);
+
+  Writer->Offsets[Index] = Writer->Size;
+
+  Type = PlistBinaryNodeType (Node);
+
+  switch (Type) {
+    case PLIST_NODE_TYPE_ARRAY:
+    case PLIST_NODE_TYPE_DICT:
+      ChildCount = XmlNodeChildren (Node);
+
+      //
+      // Children get consecutive object indices, which are written first.
+      // Dictionaries store all key references followed by all value references.
+      //
+      FirstChild           = Writer->ObjectIndex;
+      Writer->ObjectIndex += ChildCount;
+
+      if (Type == PLIST_NODE_TYPE_DICT) {
+        if (!PlistBinaryAppendMarker (Writer, PLIST_BINARY_MARKER_DICT, ChildCount / 2)) {
+          return FALSE;
+        }
+      } else if (!PlistBinaryAppendMarker (Writer, PLIST_BINARY_MARKER_ARRAY, ChildCount)) {
+        return FALSE;
+      }
+
+      for (ChildIndex = 0; ChildIndex < ChildCount; ++ChildIndex) {
+        if (Type == PLIST_NODE_TYPE_DICT) {
+          PlistBinaryWriteInteger (
+            Reference,
+            Writer->RefSize,
+            FirstChild + (ChildIndex % (ChildCount / 2)) * 2 + ChildIndex / (ChildCount / 2)
+            );
+        } else {
+          PlistBinaryWriteInteger (Reference, Writer->RefSize, FirstChild + ChildIndex);
+        }
+
+        if (!PlistBinaryAppend (Writer, Reference, Writer->RefSize)) {
+          return FALSE;
+        }
+      }
+
+      for (ChildIndex = 0; ChildIndex < ChildCount; ++ChildIndex) {
+        if (!PlistBinaryAppendNode (Writer, XmlNodeChild (Node, ChildIndex), FirstChild + ChildIndex)) {
+          return FALSE;
+        }
+      }
+
+      return TRUE;
+
+    case PLIST_NODE_TYPE_KEY:
+    case PLIST_NODE_TYPE_STRING:
+      return PlistBinaryAppendStringNode (Writer, Node);
+
+    case PLIST_NODE_TYPE_DATA:
+      return PlistBinaryAppendDataNode (Writer, Node);
+
+    case PLIST_NODE_TYPE_INTEGER:
+      return PlistBinaryAppendIntegerNode (Writer, Node);
+
+    case PLIST_NODE_TYPE_TRUE:
+    case PLIST_NODE_TYPE_FALSE:
+      Marker = Type == PLIST_NODE_TYPE_TRUE ? PLIST_BINARY_TRUE : PLIST_BINARY_FALSE;
+      return PlistBinaryAppend (Writer, &Marker, sizeof (Marker));
+
+    default:
+      return FALSE;
+  }
+}
+
+UINT8 *
+PlistDocumentExportBinary (
+  IN OUT  XML_DOCUMENT  *Document,
+  OUT     UINT32        *Length
+  )
+{
+  PLIST_BINARY_WRITER   Writer;
+  PLIST_BINARY_TRAILER  Trailer;
+  XML_NODE              *Root;
+  UINT32                OffsetTable;
+  UINT8                 OffsetSize;
+  UINT8                 Offset[sizeof (UINT32)];
+  UINT32                Index;
+  BOOLEAN               Result;
+
+  ASSERT (Document != NULL);
+  ASSERT (Length   != NULL);
+
+  Root = PlistDocumentRoot (Document);
+  if (Root == NULL) {
+    return NULL;
+  }
+
+  ZeroMem (&Writer, sizeof (Writer));
+
+  //
+  // Counting expands all lazy nodes, so malformed ones are found here.
+  //
+  if (!PlistBinaryCountObjects (Root, 1, &Writer.ObjectCount) || Document->Malformed) {
+    return NULL;
+  }
+
+  Writer.RefSize = PlistBinaryIntegerSize (Writer.ObjectCount);
+  if (Writer.RefSize > sizeof (UINT32)) {
+    return NULL;
+  }
+
+  Writer.Offsets = AllocatePool (Writer.ObjectCount * sizeof (Writer.Offsets[0]));
+  if (Writer.Offsets == NULL) {
+    return NULL;
+  }
+
+  //
+  // Binary plists are usually about half the size of XML plists.
+  //
+  Writer.AllocSize = MAX (Document->Buffer.Length / 2, SIZE_4KB);
+  Writer.Buffer    = AllocatePool (Writer.AllocSize);
+  if (Writer.Buffer == NULL) {
+    FreePool (Writer.Offsets);
+    return NULL;
+  }
+
+  Writer.ObjectIndex = 1;
+
+  Result = PlistBinaryAppend (&Writer, PLIST_BINARY_SIGNATURE, L_STR_LEN (PLIST_BINARY_SIGNATURE))
+           && PlistBinaryAppendNode (&Writer, Root, 0);
+
+  if (Result) {
+    ASSERT (Writer.ObjectIndex == Writer.ObjectCount);
+
+    OffsetTable = Writer.Size;
+    OffsetSize  = PlistBinaryIntegerSize (OffsetTable);
+
+    for (Index = 0; Result && Index < Writer.ObjectCount; ++Index) {
+      PlistBinaryWriteInteger (Offset, OffsetSize, Writer.Offsets[Index]);
+      Result = PlistBinaryAppend (&Writer, Offset, OffsetSize);
+    }
+
+    ZeroMem (&Trailer, sizeof (Trailer));
+    Trailer.OffsetIntSize = OffsetSize;
+    Trailer.ObjectRefSize = Writer.RefSize;
+    PlistBinaryWriteInteger (Trailer.NumObjects, sizeof (Trailer.NumObjects), Writer.ObjectCount);
+    PlistBinaryWriteInteger (Trailer.OffsetTableOffset, sizeof (Trailer.OffsetTableOffset), OffsetTable);
+
+    Result = Result && PlistBinaryAppend (&Writer, &Trailer, sizeof (Trailer));
+  }
+
+  FreePool (Writer.Offsets);
+
+  if (!Result) {
+    DEBUG ((DEBUG_INFO, "OCXML: Failed to export binary plist\n"));
+    FreePool (Writer.Buffer);
+    return NULL;
+  }
+
+  *Length = Writer.Size;
+  return Writer.Buffer;
+}
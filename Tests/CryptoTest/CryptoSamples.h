@@ -559,6 +559,109 @@ STATIC HASH_SAMPLE  HashSamples[4] = {
   }
 };
 
+//
+// RSA2048SHA256 signatures of Rsa2048Sha256Sample.Data with public exponents
+// other than 65537 to cover generic exponentiation.
+//
+typedef struct RSA2048SHA256_EXPONENT_SAMPLE_ {
+  UINT32    Exponent;
+  UINT8     Modulus[256];
+  UINT8     Signature[256];
+} RSA2048SHA256_EXPONENT_SAMPLE;
+
+STATIC RSA2048SHA256_EXPONENT_SAMPLE  Rsa2048Sha256ExponentSamples[] = {
+  {
+    3,
+    //
+    // Modulus
+    //
+    {
+      0xE1, 0x0C, 0x27, 0xB1, 0x56, 0x69, 0x42, 0xB0, 0xF3, 0x62, 0x01, 0x57, 0xB4, 0xAC, 0x8B, 0xA0,
+      0x0A, 0x20, 0xEF, 0xE2, 0xB8, 0x50, 0xC9, 0x1D, 0xD4, 0xB7, 0x13, 0x22, 0x37, 0x34, 0x56, 0x4B,
+      0x97, 0x46, 0x1E, 0xC9, 0x1B, 0x2B, 0xD8, 0x34, 0x03, 0xCB, 0xA0, 0x76, 0x41, 0x1C, 0x40, 0x2A,
+      0xBC, 0x96, 0xDB, 0xDC, 0x69, 0x35, 0xBB, 0x8D, 0x6B, 0x87, 0x7A, 0x24, 0xAB, 0xEC, 0xCC, 0x50,
+      0x13, 0xAD, 0x38, 0xB5, 0x1C, 0xFC, 0xDB, 0xDA, 0xC8, 0xE0, 0xF6, 0x8C, 0xF7, 0x30, 0x43, 0x69,
+      0xFA, 0x12, 0x3A, 0x06, 0xC1, 0xF1, 0x56, 0x3E, 0x23, 0xCE, 0xED, 0x3C, 0xFE, 0xA6, 0x9F, 0x43,
+      0xAB, 0x8E, 0x46, 0x85, 0x60, 0x50, 0x4B, 0x33, 0xC8, 0xF9, 0x9F, 0x8C, 0xBC, 0xA3, 0x73, 0xB7,
+      0x5D, 0x3A, 0xF5, 0xDD, 0xF6, 0x2F, 0x72, 0x1E, 0x4A, 0xF1, 0xE6, 0xE2, 0x3B, 0x2B, 0x93, 0x30,
+      0xF4, 0xB8, 0xD1, 0x8E, 0x1D, 0x77, 0x77, 0x5C, 0x54, 0x23, 0x2C, 0xFD, 0xA1, 0x31, 0x6F, 0xBF,
+      0xB8, 0xA8, 0xAE, 0x32, 0x1A, 0x95, 0x1A, 0x9F, 0x2C, 0xA4, 0xDD, 0xA2, 0x59, 0xF6, 0x61, 0xB0,
+      0xEA, 0x9D, 0x1B, 0xB4, 0x59, 0x7B, 0x2F, 0xC4, 0x76, 0xCB, 0x6D, 0x2F, 0x15, 0xAF, 0xE5, 0xC7,
+      0x47, 0x56, 0xAF, 0x5F, 0x52, 0x69, 0x35, 0x8E, 0x5B, 0xC6, 0xF6, 0xA7, 0x98, 0xFA, 0xC5, 0xCC,
+      0x4E, 0xE2, 0x78, 0x6C, 0xD9, 0xC3, 0xD4, 0x62, 0x1A, 0x75, 0xDD, 0x67, 0x98, 0x3D, 0xDC, 0xB4,
+      0x89, 0x2E, 0x0C, 0x95, 0xA4, 0x10, 0xDF, 0x39, 0xC4, 0x65, 0xAF, 0x36, 0x4E, 0x65, 0x92, 0x12,
+      0x54, 0x5D, 0x69, 0x31, 0xB8, 0xBF, 0x73, 0x45, 0x8A, 0xCD, 0x8F, 0x85, 0x4A, 0x25, 0xCC, 0x03,
+      0xC3, 0x87, 0x80, 0xB1, 0x5A, 0x10, 0x9B, 0xFD, 0x26, 0x92, 0x6E, 0xA4, 0x79, 0xF0, 0x56, 0xD3
+    },
+    //
+    // Signature
+    //
+    {
+      0x1A, 0x6B, 0x58, 0x01, 0xE2, 0x45, 0xB6, 0x7E, 0xDF, 0x3C, 0xAA, 0x0F, 0x16, 0xA5, 0x09, 0x2E,
+      0x52, 0x6D, 0x3B, 0x60, 0x7F, 0xFA, 0x5D, 0x25, 0xC2, 0x5A, 0xA7, 0xEB, 0x85, 0x66, 0x8B, 0x53,
+      0xFC, 0xB0, 0x3E, 0x0C, 0x0A, 0xDB, 0xD7, 0x90, 0x03, 0x17, 0xDB, 0xD5, 0xD9, 0xCB, 0x79, 0x2C,
+      0x03, 0x90, 0x4B, 0x51, 0x9C, 0x2F, 0x01, 0x0B, 0x1E, 0x07, 0x73, 0x12, 0xEE, 0xFE, 0xBA, 0x8F,
+      0x9D, 0xB1, 0x2B, 0x58, 0xA0, 0x9C, 0xB6, 0x45, 0x54, 0xD0, 0xF7, 0x6C, 0x97, 0x03, 0x79, 0x04,
+      0x9F, 0x40, 0xA7, 0xE7, 0x0B, 0xB4, 0x17, 0x47, 0x6A, 0x99, 0x22, 0xB2, 0x03, 0x9E, 0x9C, 0xA2,
+      0x78, 0xFE, 0x7E, 0x0D, 0x78, 0x12, 0x3E, 0x04, 0x67, 0x58, 0x27, 0xD1, 0xD5, 0x12, 0xBE, 0xE6,
+      0x5B, 0x92, 0x24, 0x83, 0x4E, 0x9C, 0x61, 0xD4, 0x80, 0x4F, 0x9A, 0xAE, 0x63, 0x5E, 0x8E, 0xC5,
+      0x0A, 0x5D, 0xFC, 0x61, 0xBF, 0x19, 0x66, 0x98, 0xAB, 0x11, 0xD0, 0x83, 0x77, 0x51, 0x15, 0x82,
+      0xF1, 0xE1, 0x00, 0x40, 0x1D, 0xF1, 0x1F, 0x6B, 0xD6, 0x98, 0x4A, 0x7C, 0x74, 0xE7, 0x98, 0x52,
+      0x97, 0x8C, 0xD2, 0xF6, 0xC6, 0xF2, 0x9A, 0xD0, 0x74, 0x70, 0x14, 0x1D, 0xAB, 0x8E, 0x80, 0xDE,
+      0x45, 0x7C, 0xCF, 0x62, 0x28, 0x43, 0x07, 0x4D, 0x98, 0x4A, 0xCA, 0x1F, 0x71, 0x2C, 0xC4, 0x04,
+      0xCE, 0xC5, 0xB8, 0x43, 0xF4, 0x97, 0xEF, 0xCA, 0x11, 0xF0, 0x1F, 0xC2, 0xB4, 0xC2, 0x14, 0xA9,
+      0xAE, 0x1F, 0x46, 0x1C, 0x62, 0xB4, 0x17, 0xAD, 0x43, 0x31, 0xC1, 0xC2, 0x06, 0x11, 0xC4, 0x88,
+      0x86, 0x98, 0x05, 0x21, 0xC2, 0x76, 0x9B, 0xCD, 0xAC, 0x42, 0x17, 0x68, 0xAD, 0xBE, 0x7F, 0x31,
+      0xB3, 0xC0, 0x8F, 0x5D, 0x98, 0x54, 0xDB, 0x4D, 0xD9, 0x20, 0x52, 0x4E, 0xE5, 0xB5, 0x61, 0x5E
+    }
+  },
+  {
+    10799,
+    //
+    // Modulus
+    //
+    {
+      0xC7, 0xFE, 0xE0, 0xEA, 0xBE, 0x7A, 0x7E, 0xC3, 0x53, 0x91, 0x12, 0x28, 0xA2, 0x85, 0x2B, 0x79,
+      0x20, 0x09, 0x25, 0xCD, 0x9C, 0x72, 0xDB, 0x08, 0x21, 0xAB, 0x60, 0x67, 0xB3, 0x3C, 0xF2, 0x5E,
+      0x9B, 0xB6, 0x4B, 0x7E, 0x0E, 0x9F, 0x0A, 0x00, 0xD4, 0xD1, 0xE0, 0xBD, 0x08, 0x41, 0x40, 0x44,
+      0x61, 0x47, 0x9F, 0xFD, 0x13, 0x00, 0xBD, 0xB1, 0x9D, 0x5E, 0x96, 0xB3, 0xB4, 0x12, 0x01, 0x8E,
+      0x14, 0x58, 0x04, 0xC3, 0x77, 0xF0, 0x5A, 0x7A, 0x94, 0x0C, 0x4A, 0x71, 0x2F, 0x35, 0x40, 0x35,
+      0xE3, 0xB2, 0xC9, 0xB6, 0xBA, 0x30, 0x3F, 0x59, 0x18, 0x9C, 0x9B, 0x41, 0x88, 0x1B, 0xFA, 0x0E,
+      0x02, 0x35, 0x58, 0x03, 0x3C, 0xC8, 0x2A, 0x09, 0xC7, 0xAF, 0xBB, 0x6A, 0xCF, 0xC6, 0x80, 0xEE,
+      0x51, 0xE4, 0xD8, 0xDB, 0xE2, 0x4D, 0x1C, 0x46, 0xA8, 0xAD, 0xC6, 0xAD, 0x7D, 0x4E, 0xAE, 0x3C,
+      0xEB, 0xC8, 0x88, 0xEB, 0x70, 0x02, 0x51, 0xB5, 0x4C, 0x65, 0x39, 0xFC, 0x8D, 0x9A, 0x97, 0x7D,
+      0x7D, 0xE6, 0x6B, 0x25, 0x63, 0xD4, 0xDA, 0x6C, 0x4D, 0x8C, 0x9E, 0xB7, 0x3C, 0x71, 0x77, 0x94,
+      0x73, 0xB0, 0xE2, 0xB4, 0x75, 0xA6, 0x59, 0xF8, 0xAE, 0x70, 0xB7, 0xC3, 0xAF, 0x09, 0x52, 0x55,
+      0x8D, 0xD0, 0x6F, 0x5C, 0x1F, 0xDF, 0x5E, 0x25, 0x34, 0x39, 0xFA, 0xF4, 0xDB, 0xD7, 0x53, 0x6E,
+      0x11, 0x2E, 0xB8, 0xD9, 0x03, 0xB4, 0xA2, 0x85, 0x1C, 0x20, 0x8B, 0x3E, 0xDE, 0xF8, 0x1D, 0x80,
+      0x47, 0x3C, 0xE3, 0x72, 0xF0, 0x88, 0x45, 0xBE, 0x1E, 0xAF, 0x22, 0x73, 0x2B, 0x37, 0xCD, 0xF5,
+      0x60, 0xF6, 0x06, 0x4A, 0x72, 0x9B, 0x5B, 0x44, 0xAD, 0xCE, 0x6A, 0xCF, 0x0D, 0x2E, 0x02, 0x4F,
+      0xB3, 0x59, 0xD8, 0x23, 0x81, 0x3A, 0xFD, 0xC8, 0x19, 0x76, 0xB0, 0xF4, 0x1A, 0x24, 0xFB, 0xF3
+    },
+    //
+    // Signature
+    //
+    {
+      0x57, 0xE6, 0xE8, 0xE1, 0x64, 0xCB, 0xBF, 0x4B, 0xC8, 0x2E, 0x05, 0xD0, 0x81, 0x01, 0x2E, 0x77,
+      0xE9, 0x9A, 0xEA, 0x86, 0x04, 0x32, 0x81, 0x25, 0xFA, 0x7D, 0x44, 0xA7, 0xC6, 0x2B, 0x1E, 0xC3,
+      0x24, 0xF6, 0x95, 0x26, 0x35, 0xD7, 0x38, 0x62, 0xE0, 0x8A, 0x75, 0x69, 0x07, 0x84, 0x4D, 0x8C,
+      0xF3, 0x23, 0x95, 0xDB, 0x9B, 0xB4, 0x84, 0x06, 0xC4, 0xAA, 0x44, 0xBA, 0x0E, 0x37, 0x23, 0x6A,
+      0x49, 0xCA, 0x6B, 0x95, 0xDE, 0x20, 0xA0, 0xE4, 0x9A, 0xC4, 0x9E, 0xA3, 0x8D, 0x02, 0xE8, 0xAF,
+      0x3C, 0x30, 0x72, 0x70, 0xD3, 0xF3, 0x48, 0xD8, 0xEF, 0x1E, 0x47, 0xA6, 0x79, 0x65, 0xC3, 0x3A,
+      0x54, 0x6C, 0x61, 0x7F, 0x2A, 0x4D, 0xA3, 0x58, 0x85, 0x09, 0x29, 0xCB, 0x86, 0xA3, 0xDB, 0x98,
+      0x3B, 0x8C, 0x6A, 0x1D, 0xBA, 0xAA, 0x75, 0x54, 0x1A, 0xF4, 0x17, 0x99, 0x3F, 0x90, 0xA8, 0x56,
+      0x92, 0x30, 0x53, 0x8B, 0xAD, 0x56, 0x67, 0xCE, 0x89, 0xB0, 0x44, 0xB1, 0x25, 0x73, 0x74, 0x67,
+      0x79, 0x07, 0xB4, 0x68, 0x93, 0xB1, 0x27, 0x9A, 0xA6, 0x94, 0x0F, 0x3B, 0x70, 0x44, 0x7D, 0x8E,
+      0xAD, 0x03, 0x68, 0x29, 0x87, 0xA4, 0xCC, 0x62, 0x32, 0x0A, 0xC4, 0x09, 0x68, 0xDF, 0xED, 0x9E,
+      0x70, 0xB7, 0x57, 0x4C, 0x42, 0x71, 0x1F, 0x76, 0x03, 0xA1, 0xA7, 0x10, 0xF2, 0x87, 0x7B, 0x23,
+      0x95, 0x2B, 0x98, 0x12, 0xF6, 0xCD, 0xE5, 0x10, 0x46, 0x1D, 0xD5, 0x67, 0xD9, 0x50, 0x95, 0x47,
+      0x16, 0x5E, 0x58, 0x31, 0x00, 0x24, 0x93, 0x61, 0x15, 0x14, 0xB6, 0x2E, 0x12, 0x06, 0x26, 0x19,
+      0x1E, 0xF6, 0x5B, 0xF5, 0x55, 0x39, 0x02, 0xE5, 0x08, 0xE1, 0x17, 0xC7, 0x12, 0x60, 0x8B, 0x03,
+      0xCE, 0x36, 0x39, 0xAE, 0x47, 0xD1, 0xE0, 0x94, 0x2C, 0x88, 0x15, 0xD2, 0x46, 0xC3, 0xE2, 0xE0
+    }
+  }
+};
+
 STATIC UINT8 CONST  ChaChaEncryptionKey[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -14,6 +14,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Uefi.h>
 #include <PiDxe.h>
+#include <Library/BaseLib.h>
 #include <Library/PcdLib.h>
 #include <Library/UefiLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -70,6 +71,129 @@ TestRsa2048Sha256Verify (
   return Status;
 }
 
+//
+// Exponent 1 makes the padded digest a valid signature, even exponents are invalid.
+//
+STATIC CONST UINT32  mRsaInvalidExponents[] = { 1, 2, 4 };
+
+/**
+  Verify RSA2048SHA256 signatures with exponents other than 65537 with and
+  without key handles, including tampered signatures and invalid exponents.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+EFIAPI
+TestRsa2048Sha256Exponents (
+  VOID
+  )
+{
+  RSA2048SHA256_EXPONENT_SAMPLE  *Sample;
+  OC_RSA_KEY_HANDLE              *Handle;
+  UINT8                          Signature[256];
+  UINTN                          Index;
+  BOOLEAN                        RsaTestPassed;
+
+  RsaTestPassed = TRUE;
+
+  for (Index = 0; Index < ARRAY_SIZE (Rsa2048Sha256ExponentSamples); ++Index) {
+    Sample = &Rsa2048Sha256ExponentSamples[Index];
+
+    CopyMem (Signature, Sample->Signature, sizeof (Signature));
+    Signature[sizeof (Signature) / 2] ^= 1U;
+
+    if (!RsaVerifySigDataFromData (
+           Sample->Modulus,
+           sizeof (Sample->Modulus),
+           Sample->Exponent,
+           Sample->Signature,
+           sizeof (Sample->Signature),
+           Rsa2048Sha256Sample.Data,
+           SIGNED_DATA_LEN,
+           OcSigHashTypeSha256
+           ))
+    {
+      Print (L"Rsa2048Sha256 e=%u signature verifying failed!\n", Sample->Exponent);
+      RsaTestPassed = FALSE;
+    }
+
+    if (RsaVerifySigDataFromData (
+          Sample->Modulus,
+          sizeof (Sample->Modulus),
+          Sample->Exponent,
+          Signature,
+          sizeof (Signature),
+          Rsa2048Sha256Sample.Data,
+          SIGNED_DATA_LEN,
+          OcSigHashTypeSha256
+          ))
+    {
+      Print (L"Rsa2048Sha256 e=%u tampered signature verified!\n", Sample->Exponent);
+      RsaTestPassed = FALSE;
+    }
+
+    Handle = RsaCreateKeyHandleFromData (
+               Sample->Modulus,
+               sizeof (Sample->Modulus),
+               Sample->Exponent
+               );
+    if (Handle == NULL) {
+      Print (L"Rsa2048Sha256 e=%u key handle creation failed!\n", Sample->Exponent);
+      RsaTestPassed = FALSE;
+      continue;
+    }
+
+    if (!RsaVerifySigDataFromHandle (
+           Handle,
+           Sample->Signature,
+           sizeof (Sample->Signature),
+           Rsa2048Sha256Sample.Data,
+           SIGNED_DATA_LEN,
+           OcSigHashTypeSha256
+           ))
+    {
+      Print (L"Rsa2048Sha256 e=%u handle signature verifying failed!\n", Sample->Exponent);
+      RsaTestPassed = FALSE;
+    }
+
+    if (RsaVerifySigDataFromHandle (
+          Handle,
+          Signature,
+          sizeof (Signature),
+          Rsa2048Sha256Sample.Data,
+          SIGNED_DATA_LEN,
+          OcSigHashTypeSha256
+          ))
+    {
+      Print (L"Rsa2048Sha256 e=%u handle tampered signature verified!\n", Sample->Exponent);
+      RsaTestPassed = FALSE;
+    }
+
+    RsaFreeKeyHandle (Handle);
+  }
+
+  Sample = &Rsa2048Sha256ExponentSamples[0];
+  for (Index = 0; Index < ARRAY_SIZE (mRsaInvalidExponents); ++Index) {
+    Handle = RsaCreateKeyHandleFromData (
+               Sample->Modulus,
+               sizeof (Sample->Modulus),
+               mRsaInvalidExponents[Index]
+               );
+    if (Handle != NULL) {
+      Print (L"Rsa2048Sha256 e=%u key handle was created!\n", mRsaInvalidExponents[Index]);
+      RsaFreeKeyHandle (Handle);
+      RsaTestPassed = FALSE;
+    }
+  }
+
+  if (!RsaTestPassed) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Print (L"Rsa2048Sha256 exponent tests passed!\n");
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 TestAesCtr (
@@ -210,6 +334,233 @@ TestAesCbc (
   return Status;
 }
 
+/**
+  Compare AES-NI and software AES CTR output for lengths which are not
+  a multiple of AES block size, continuing after the trailing partial block.
+
+  @retval EFI_SUCCESS on success or when AES-NI is not supported.
+**/
+EFI_STATUS
+EFIAPI
+TestAesCtrAccel (
+  VOID
+  )
+{
+  AES_CONTEXT  Ctx;
+  UINT8        SoftData[AES_SAMPLE_DATA_LEN];
+  UINT8        AccelData[AES_SAMPLE_DATA_LEN];
+  UINT32       Len;
+  UINT32       NextBlock;
+  BOOLEAN      AesTestPassed;
+
+  if (!AesSetAccel (TRUE)) {
+    Print (L"AES-128 CTR AES-NI test skipped, not supported\n");
+    return EFI_SUCCESS;
+  }
+
+  AesTestPassed = TRUE;
+
+  for (Len = 1; Len < AES_SAMPLE_DATA_LEN; ++Len) {
+    if (Len % AES_BLOCK_SIZE == 0) {
+      continue;
+    }
+
+    //
+    // Trailing partial block consumes a whole counter, so the second call
+    // starts from the next block.
+    //
+    NextBlock = ALIGN_VALUE (Len, AES_BLOCK_SIZE);
+
+    AesSetAccel (FALSE);
+    CopyMem (SoftData, AesCtrSample.PlainText, AES_SAMPLE_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCtrSample.Key, AesCtrSample.IV);
+    AesCtrXcryptBuffer (&Ctx, SoftData, Len);
+    AesCtrXcryptBuffer (&Ctx, SoftData + NextBlock, AES_SAMPLE_DATA_LEN - NextBlock);
+
+    AesSetAccel (TRUE);
+    CopyMem (AccelData, AesCtrSample.PlainText, AES_SAMPLE_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCtrSample.Key, AesCtrSample.IV);
+    AesCtrXcryptBuffer (&Ctx, AccelData, Len);
+    AesCtrXcryptBuffer (&Ctx, AccelData + NextBlock, AES_SAMPLE_DATA_LEN - NextBlock);
+
+    if (  (CompareMem (SoftData, AccelData, AES_SAMPLE_DATA_LEN) != 0)
+       || (CompareMem (SoftData, AesCtrSample.CipherText, Len) != 0)
+       || (CompareMem (SoftData + NextBlock, AesCtrSample.CipherText + NextBlock, AES_SAMPLE_DATA_LEN - NextBlock) != 0))
+    {
+      Print (L"AES-128 CTR AES-NI test failed for %u bytes\n", Len);
+      AesTestPassed = FALSE;
+    }
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+  ZeroMem (SoftData, sizeof (SoftData));
+  ZeroMem (AccelData, sizeof (AccelData));
+
+  if (!AesTestPassed) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Print (L"AES-128 CTR AES-NI tests passed\n");
+  return EFI_SUCCESS;
+}
+
+//
+// Two copies of the CBC sample, so that every split leaves at least
+// four blocks for either chunk.
+//
+#define AES_CBC_ACCEL_DATA_LEN  (AES_SAMPLE_DATA_LEN * 2)
+
+/**
+  Compare AES-NI and software AES CBC output for the sample split into
+  two chunks at every block boundary, checking that the IV is chained
+  between the calls.
+
+  @retval EFI_SUCCESS on success or when AES-NI is not supported.
+**/
+EFI_STATUS
+EFIAPI
+TestAesCbcAccel (
+  VOID
+  )
+{
+  AES_CONTEXT  Ctx;
+  UINT8        PlainText[AES_CBC_ACCEL_DATA_LEN];
+  UINT8        CipherText[AES_CBC_ACCEL_DATA_LEN];
+  UINT8        SoftData[AES_CBC_ACCEL_DATA_LEN];
+  UINT8        AccelData[AES_CBC_ACCEL_DATA_LEN];
+  UINT32       Split;
+  BOOLEAN      AesTestPassed;
+
+  if (!AesSetAccel (TRUE)) {
+    Print (L"AES-128 CBC AES-NI test skipped, not supported\n");
+    return EFI_SUCCESS;
+  }
+
+  AesTestPassed = TRUE;
+
+  CopyMem (PlainText, AesCbcSample.PlainText, AES_SAMPLE_DATA_LEN);
+  CopyMem (PlainText + AES_SAMPLE_DATA_LEN, AesCbcSample.PlainText, AES_SAMPLE_DATA_LEN);
+
+  //
+  // Software reference over the whole buffer, its first half must match the sample.
+  //
+  AesSetAccel (FALSE);
+  CopyMem (CipherText, PlainText, AES_CBC_ACCEL_DATA_LEN);
+  AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+  AesCbcEncryptBuffer (&Ctx, CipherText, AES_CBC_ACCEL_DATA_LEN);
+  if (CompareMem (CipherText, AesCbcSample.CipherText, AES_SAMPLE_DATA_LEN) != 0) {
+    Print (L"AES-128 CBC AES-NI reference encryption failed\n");
+    AesTestPassed = FALSE;
+  }
+
+  for (Split = AES_BLOCK_SIZE; Split < AES_CBC_ACCEL_DATA_LEN; Split += AES_BLOCK_SIZE) {
+    AesSetAccel (FALSE);
+    CopyMem (SoftData, PlainText, AES_CBC_ACCEL_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+    AesCbcEncryptBuffer (&Ctx, SoftData, Split);
+    AesCbcEncryptBuffer (&Ctx, SoftData + Split, AES_CBC_ACCEL_DATA_LEN - Split);
+
+    AesSetAccel (TRUE);
+    CopyMem (AccelData, PlainText, AES_CBC_ACCEL_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+    AesCbcEncryptBuffer (&Ctx, AccelData, Split);
+    AesCbcEncryptBuffer (&Ctx, AccelData + Split, AES_CBC_ACCEL_DATA_LEN - Split);
+
+    if (  (CompareMem (SoftData, CipherText, AES_CBC_ACCEL_DATA_LEN) != 0)
+       || (CompareMem (AccelData, CipherText, AES_CBC_ACCEL_DATA_LEN) != 0))
+    {
+      Print (L"AES-128 CBC AES-NI encryption test failed for %u byte split\n", Split);
+      AesTestPassed = FALSE;
+    }
+
+    AesSetAccel (FALSE);
+    CopyMem (SoftData, CipherText, AES_CBC_ACCEL_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+    AesCbcDecryptBuffer (&Ctx, SoftData, Split);
+    AesCbcDecryptBuffer (&Ctx, SoftData + Split, AES_CBC_ACCEL_DATA_LEN - Split);
+
+    AesSetAccel (TRUE);
+    CopyMem (AccelData, CipherText, AES_CBC_ACCEL_DATA_LEN);
+    AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+    AesCbcDecryptBuffer (&Ctx, AccelData, Split);
+    AesCbcDecryptBuffer (&Ctx, AccelData + Split, AES_CBC_ACCEL_DATA_LEN - Split);
+
+    if (  (CompareMem (SoftData, PlainText, AES_CBC_ACCEL_DATA_LEN) != 0)
+       || (CompareMem (AccelData, PlainText, AES_CBC_ACCEL_DATA_LEN) != 0))
+    {
+      Print (L"AES-128 CBC AES-NI decryption test failed for %u byte split\n", Split);
+      AesTestPassed = FALSE;
+    }
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+  ZeroMem (SoftData, sizeof (SoftData));
+  ZeroMem (AccelData, sizeof (AccelData));
+
+  if (!AesTestPassed) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Print (L"AES-128 CBC AES-NI tests passed\n");
+  return EFI_SUCCESS;
+}
+
+/**
+  Process AES samples split into single and multiple block chunks
+  to cover both serial and pipelined block processing.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+EFIAPI
+TestAesChunked (
+  VOID
+  )
+{
+  AES_CONTEXT  Ctx;
+  UINT8        Data[AES_SAMPLE_DATA_LEN];
+  BOOLEAN      AesTestPassed;
+
+  AesTestPassed = TRUE;
+
+  CopyMem (Data, AesCbcSample.PlainText, AES_SAMPLE_DATA_LEN);
+  AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+  AesCbcEncryptBuffer (&Ctx, Data, AES_BLOCK_SIZE);
+  AesCbcEncryptBuffer (&Ctx, Data + AES_BLOCK_SIZE, AES_SAMPLE_DATA_LEN - AES_BLOCK_SIZE);
+  if (CompareMem (Data, AesCbcSample.CipherText, AES_SAMPLE_DATA_LEN) != 0) {
+    Print (L"AES-128 CBC chunked encryption test failed\n");
+    AesTestPassed = FALSE;
+  }
+
+  CopyMem (Data, AesCbcSample.CipherText, AES_SAMPLE_DATA_LEN);
+  AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+  AesCbcDecryptBuffer (&Ctx, Data, AES_BLOCK_SIZE);
+  AesCbcDecryptBuffer (&Ctx, Data + AES_BLOCK_SIZE, AES_SAMPLE_DATA_LEN - AES_BLOCK_SIZE);
+  if (CompareMem (Data, AesCbcSample.PlainText, AES_SAMPLE_DATA_LEN) != 0) {
+    Print (L"AES-128 CBC chunked decryption test failed\n");
+    AesTestPassed = FALSE;
+  }
+
+  CopyMem (Data, AesCtrSample.PlainText, AES_SAMPLE_DATA_LEN);
+  AesInitCtxIv (&Ctx, AesCtrSample.Key, AesCtrSample.IV);
+  AesCtrXcryptBuffer (&Ctx, Data, AES_BLOCK_SIZE);
+  AesCtrXcryptBuffer (&Ctx, Data + AES_BLOCK_SIZE, AES_SAMPLE_DATA_LEN - AES_BLOCK_SIZE);
+  if (CompareMem (Data, AesCtrSample.CipherText, AES_SAMPLE_DATA_LEN) != 0) {
+    Print (L"AES-128 CTR chunked encryption test failed\n");
+    AesTestPassed = FALSE;
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+  ZeroMem (Data, sizeof (Data));
+
+  if (!AesTestPassed) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Print (L"AES-128 chunked tests passed\n");
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 TestChaCha (
@@ -401,6 +752,211 @@ TestHash (
   return Status;
 }
 
+#define AES_BENCHMARK_SIZE    SIZE_1MB
+#define AES_BENCHMARK_ROUNDS  4
+
+/**
+  Measure AES throughput in CPU cycles per byte, which reflects
+  the implementation selected at runtime (AES-NI or portable C).
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+EFIAPI
+BenchmarkAes (
+  VOID
+  )
+{
+  STATIC CONST CHAR16  *Modes[] = { L"CBC encryption", L"CBC decryption", L"CTR" };
+  AES_CONTEXT          Ctx;
+  UINT8                *Buffer;
+  UINTN                Mode;
+  UINTN                Index;
+  UINT64               Start;
+  UINT64               CyclesPerByte10;
+
+  Buffer = AllocateZeroPool (AES_BENCHMARK_SIZE);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Mode = 0; Mode < ARRAY_SIZE (Modes); ++Mode) {
+    AesInitCtxIv (&Ctx, AesCbcSample.Key, AesCbcSample.IV);
+
+    Start = AsmReadTsc ();
+    for (Index = 0; Index < AES_BENCHMARK_ROUNDS; ++Index) {
+      if (Mode == 0) {
+        AesCbcEncryptBuffer (&Ctx, Buffer, AES_BENCHMARK_SIZE);
+      } else if (Mode == 1) {
+        AesCbcDecryptBuffer (&Ctx, Buffer, AES_BENCHMARK_SIZE);
+      } else {
+        AesCtrXcryptBuffer (&Ctx, Buffer, AES_BENCHMARK_SIZE);
+      }
+    }
+
+    CyclesPerByte10 = DivU64x64Remainder (
+                        MultU64x32 (AsmReadTsc () - Start, 10),
+                        MultU64x32 (AES_BENCHMARK_SIZE, AES_BENCHMARK_ROUNDS),
+                        NULL
+                        );
+
+    Print (
+      L"AES-128 %s: %Lu.%Lu cycles/byte\n",
+      Modes[Mode],
+      DivU64x32 (CyclesPerByte10, 10),
+      ModU64x32 (CyclesPerByte10, 10)
+      );
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+#define SHA256_BENCHMARK_SIZE    SIZE_1MB
+#define SHA256_BENCHMARK_ROUNDS  16
+
+/**
+  Measure Sha256 throughput in CPU cycles per byte, which reflects
+  the transform selected at runtime (SHA-NI, AVX2 or portable C).
+
+  @param[in] Name  Benchmark configuration name.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+EFIAPI
+BenchmarkSha256 (
+  IN CONST CHAR16  *Name
+  )
+{
+  UINT8   *Buffer;
+  UINT8   Hash[SHA256_DIGEST_SIZE];
+  UINTN   Index;
+  UINT64  Start;
+  UINT64  Cycles;
+  UINT64  CyclesPerByte10;
+
+  Buffer = AllocatePool (SHA256_BENCHMARK_SIZE);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < SHA256_BENCHMARK_SIZE; ++Index) {
+    Buffer[Index] = (UINT8)(Index * 7);
+  }
+
+  //
+  // Warm up caches before measuring.
+  //
+  Sha256 (Hash, Buffer, SHA256_BENCHMARK_SIZE);
+
+  Start = AsmReadTsc ();
+  for (Index = 0; Index < SHA256_BENCHMARK_ROUNDS; ++Index) {
+    Sha256 (Hash, Buffer, SHA256_BENCHMARK_SIZE);
+  }
+
+  Cycles = AsmReadTsc () - Start;
+
+  CyclesPerByte10 = DivU64x64Remainder (
+                      MultU64x32 (Cycles, 10),
+                      MultU64x32 (SHA256_BENCHMARK_SIZE, SHA256_BENCHMARK_ROUNDS),
+                      NULL
+                      );
+
+  Print (
+    L"Sha256 %s: %Lu.%Lu cycles/byte\n",
+    Name,
+    DivU64x32 (CyclesPerByte10, 10),
+    ModU64x32 (CyclesPerByte10, 10)
+    );
+
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+#define RSA_BENCHMARK_ROUNDS  64
+
+/**
+  Measure Rsa2048Sha256 signature verification in CPU cycles, once
+  allocating per call and once reusing a key handle.
+
+  @retval EFI_SUCCESS on success.
+**/
+EFI_STATUS
+EFIAPI
+BenchmarkRsa (
+  VOID
+  )
+{
+  CONST OC_RSA_PUBLIC_KEY  *PubKey;
+  OC_RSA_KEY_HANDLE        *Handle;
+  UINT8                    DataSha256Hash[SHA256_DIGEST_SIZE];
+  UINTN                    Index;
+  UINT64                   Start;
+  UINT64                   CyclesDynalloc;
+  UINT64                   CyclesHandle;
+  BOOLEAN                  Verified;
+
+  PubKey = (CONST OC_RSA_PUBLIC_KEY *)Rsa2048Sha256Sample.PublicKey;
+
+  Sha256 (
+    DataSha256Hash,
+    Rsa2048Sha256Sample.Data,
+    SIGNED_DATA_LEN
+    );
+
+  Handle = RsaCreateKeyHandleFromKey (PubKey);
+  if (Handle == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Verified = TRUE;
+
+  Start = AsmReadTsc ();
+  for (Index = 0; Index < RSA_BENCHMARK_ROUNDS; ++Index) {
+    Verified &= RsaVerifySigHashFromKeyDynalloc (
+                  PubKey,
+                  Rsa2048Sha256Sample.Signature,
+                  sizeof (Rsa2048Sha256Sample.Signature),
+                  DataSha256Hash,
+                  sizeof (DataSha256Hash),
+                  OcSigHashTypeSha256
+                  );
+  }
+
+  CyclesDynalloc = DivU64x32 (AsmReadTsc () - Start, RSA_BENCHMARK_ROUNDS);
+
+  Start = AsmReadTsc ();
+  for (Index = 0; Index < RSA_BENCHMARK_ROUNDS; ++Index) {
+    Verified &= RsaVerifySigHashFromHandle (
+                  Handle,
+                  Rsa2048Sha256Sample.Signature,
+                  sizeof (Rsa2048Sha256Sample.Signature),
+                  DataSha256Hash,
+                  sizeof (DataSha256Hash),
+                  OcSigHashTypeSha256
+                  );
+  }
+
+  CyclesHandle = DivU64x32 (AsmReadTsc () - Start, RSA_BENCHMARK_ROUNDS);
+
+  RsaFreeKeyHandle (Handle);
+
+  Print (
+    L"Rsa2048Sha256 verification: %Lu cycles dynalloc, %Lu cycles handle\n",
+    CyclesDynalloc,
+    CyclesHandle
+    );
+
+  if (!Verified) {
+    Print (L"Rsa2048Sha256 benchmark signature verifying failed!\n");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 UefiDriverMain (
@@ -424,6 +980,14 @@ UefiDriverMain (
     Print (L"All hash tests passed!\n");
   }
 
+  //
+  // Benchmark Sha256 without and with AVX enabled
+  //
+  BenchmarkSha256 (L"default");
+  if (TryEnableAccel ()) {
+    BenchmarkSha256 (L"AVX enabled");
+  }
+
   //
   // Test AES-128-CBC
   //
@@ -446,6 +1010,26 @@ UefiDriverMain (
     Print (L"AES-128-CTR passed!\n");
   }
 
+  Status = TestAesChunked ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 chunked failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = TestAesCtrAccel ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 CTR AES-NI failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = TestAesCbcAccel ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 CBC AES-NI failed!\n");
+    Failure = TRUE;
+  }
+
+  BenchmarkAes ();
+
   Status = TestChaCha ();
   if (EFI_ERROR (Status)) {
     Print (L"ChaCha failed!\n");
@@ -465,6 +1049,18 @@ UefiDriverMain (
     Print (L"Rsa2048Sha256 passed!\n");
   }
 
+  Status = TestRsa2048Sha256Exponents ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 exponents failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = BenchmarkRsa ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 benchmark failed!\n");
+    Failure = TRUE;
+  }
+
   if (Failure) {
     Print (L"Some tests failed\n");
     return EFI_INVALID_PARAMETER;
@@ -499,6 +1095,14 @@ UefiAppMain (
     Print (L"All hash tests passed!\n");
   }
 
+  //
+  // Benchmark Sha256 without and with AVX enabled
+  //
+  BenchmarkSha256 (L"default");
+  if (TryEnableAccel ()) {
+    BenchmarkSha256 (L"AVX enabled");
+  }
+
   WaitForKeyPress (L"Press any key...");
 
   //
@@ -525,6 +1129,26 @@ UefiAppMain (
     Print (L"AES-128-CTR passed!\n");
   }
 
+  Status = TestAesChunked ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 chunked failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = TestAesCtrAccel ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 CTR AES-NI failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = TestAesCbcAccel ();
+  if (EFI_ERROR (Status)) {
+    Print (L"AES-128 CBC AES-NI failed!\n");
+    Failure = TRUE;
+  }
+
+  BenchmarkAes ();
+
   WaitForKeyPress (L"Press any key...");
 
   //
@@ -551,6 +1175,18 @@ UefiAppMain (
     Print (L"Rsa2048Sha256 passed!\n");
   }
 
+  Status = TestRsa2048Sha256Exponents ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 exponents failed!\n");
+    Failure = TRUE;
+  }
+
+  Status = BenchmarkRsa ();
+  if (EFI_ERROR (Status)) {
+    Print (L"Rsa2048Sha256 benchmark failed!\n");
+    Failure = TRUE;
+  }
+
   WaitForKeyPress (L"Press any key to exit");
 
   if (Failure) {
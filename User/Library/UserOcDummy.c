@@ -342,6 +342,16 @@ OcGetCurrentMemoryMap (
   return NULL;
 }
 
+VOID
+OcSortMemoryMap (
+  IN UINTN                      MemoryMapSize,
+  IN OUT EFI_MEMORY_DESCRIPTOR  *MemoryMap,
+  IN UINTN                      DescriptorSize
+  )
+{
+  ASSERT (FALSE);
+}
+
 VOID *
 OcGetFileInfo (
   IN  EFI_FILE_PROTOCOL  *File,
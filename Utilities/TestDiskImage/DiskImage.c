@@ -3,6 +3,7 @@
   SPDX-License-Identifier: BSD-3-Clause
 **/
 
+#include <Library/BaseMemoryLib.h>
 #include <Library/OcAppleChunklistLib.h>
 #include <Library/OcAppleDiskImageLib.h>
 #include <Library/OcAppleRamDiskLib.h>
@@ -11,11 +12,202 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 
+#include <sys/time.h>
+
 #include <UserFile.h>
 #include <UserMemory.h>
 
 #define  NUM_EXTENTS  20
 
+//
+// Request size of sequential read trace, similar to boot.efi reads.
+//
+#define  SEQUENTIAL_READ_SIZE  BASE_64KB
+
+typedef struct {
+  UINT32         Type;
+  CONST CHAR8    *Name;
+  UINT32         Count;
+  UINT64         CompressedSize;
+  UINT64         Size;
+  UINT64         Time;
+} CHUNK_TYPE_STATS;
+
+STATIC
+UINT64
+GetTimestampUs (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000ULL + Time.tv_usec;
+}
+
+/**
+  Decompress every chunk once with a fresh chunk cache and report
+  throughput per chunk type.
+**/
+STATIC
+VOID
+ReportChunkThroughput (
+  IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN UINT32                             DmgSize,
+  IN UINT8                              *Buffer
+  )
+{
+  CHUNK_TYPE_STATS              Stats[] = {
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_ZERO,   "ZERO",   0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_RAW,    "RAW",    0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_IGNORE, "IGNORE", 0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_ADC,    "ADC",    0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB,   "ZLIB",   0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_BZ2,    "BZ2",    0, 0, 0, 0 },
+    { APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE,  "LZFSE",  0, 0, 0, 0 }
+  };
+  OC_APPLE_DISK_IMAGE_CONTEXT   Context;
+  CONST APPLE_DISK_IMAGE_CHUNK  *Chunk;
+  UINT32                        Index;
+  UINT32                        TypeIndex;
+  UINT64                        Start;
+  UINT64                        Size;
+  BOOLEAN                       Result;
+
+  Result = OcAppleDiskImageInitializeContext (&Context, ExtentTable, DmgSize);
+  if (!Result) {
+    return;
+  }
+
+  for (Index = 0; Index < Context.ChunkCount; ++Index) {
+    Chunk = Context.Chunks[Index].Chunk;
+    Size  = Chunk->SectorCount * APPLE_DISK_IMAGE_SECTOR_SIZE;
+
+    for (TypeIndex = 0; TypeIndex < ARRAY_SIZE (Stats); ++TypeIndex) {
+      if (Stats[TypeIndex].Type == Chunk->Type) {
+        break;
+      }
+    }
+
+    Start  = GetTimestampUs ();
+    Result = OcAppleDiskImageRead (
+               &Context,
+               (UINTN)Context.Chunks[Index].SectorNumber,
+               (UINTN)Size,
+               Buffer + Context.Chunks[Index].SectorNumber * APPLE_DISK_IMAGE_SECTOR_SIZE
+               );
+    if (!Result || (TypeIndex == ARRAY_SIZE (Stats))) {
+      DEBUG ((DEBUG_ERROR, "Chunk %u of type %x read error\n", Index, Chunk->Type));
+      continue;
+    }
+
+    Stats[TypeIndex].Time           += GetTimestampUs () - Start;
+    Stats[TypeIndex].CompressedSize += Chunk->CompressedLength;
+    Stats[TypeIndex].Size           += Size;
+    ++Stats[TypeIndex].Count;
+  }
+
+  for (TypeIndex = 0; TypeIndex < ARRAY_SIZE (Stats); ++TypeIndex) {
+    if (Stats[TypeIndex].Count == 0) {
+      continue;
+    }
+
+    DEBUG ((
+      DEBUG_ERROR,
+      "Chunk type %a: %u chunks, %Lu -> %Lu bytes, %Lu us, %Lu MB/s\n",
+      Stats[TypeIndex].Name,
+      Stats[TypeIndex].Count,
+      Stats[TypeIndex].CompressedSize,
+      Stats[TypeIndex].Size,
+      Stats[TypeIndex].Time,
+      Stats[TypeIndex].Size / MAX (Stats[TypeIndex].Time, 1)
+      ));
+  }
+
+  OcAppleDiskImageFreeContext (&Context);
+}
+
+/**
+  Replay sequential read trace over the whole disk image with and without
+  read-ahead. Read-ahead work is done between the reads, as the timer does
+  while the caller consumes the data, and is timed separately.
+**/
+STATIC
+VOID
+ReportSequentialReadAhead (
+  IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN UINT32                             DmgSize,
+  IN CONST UINT8                        *Expected
+  )
+{
+  STATIC CONST UINT32          ReadAheadChunks[] = { 0, OC_APPLE_DISK_IMAGE_DEFAULT_READ_AHEAD_CHUNKS };
+  OC_APPLE_DISK_IMAGE_CONTEXT  Context;
+  UINT8                        *Buffer;
+  UINT32                       Index;
+  UINTN                        Offset;
+  UINTN                        Size;
+  UINTN                        TotalSize;
+  UINT64                       Start;
+  UINT64                       ReadTime;
+  UINT64                       ReadAheadTime;
+  UINT32                       Requests;
+  BOOLEAN                      Result;
+
+  Buffer = AllocatePool (SEQUENTIAL_READ_SIZE);
+  if (Buffer == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (ReadAheadChunks); ++Index) {
+    Result = OcAppleDiskImageInitializeContext (&Context, ExtentTable, DmgSize);
+    if (!Result) {
+      break;
+    }
+
+    Context.ReadAheadChunks = ReadAheadChunks[Index];
+    TotalSize               = Context.SectorCount * APPLE_DISK_IMAGE_SECTOR_SIZE;
+    ReadTime                = 0;
+    ReadAheadTime           = 0;
+    Requests                = 0;
+
+    for (Offset = 0; Offset < TotalSize; Offset += Size) {
+      Size = MIN (SEQUENTIAL_READ_SIZE, TotalSize - Offset);
+
+      Start  = GetTimestampUs ();
+      Result = OcAppleDiskImageRead (&Context, Offset / APPLE_DISK_IMAGE_SECTOR_SIZE, Size, Buffer);
+      ReadTime += GetTimestampUs () - Start;
+      ++Requests;
+
+      if (!Result || (CompareMem (Buffer, Expected + Offset, Size) != 0)) {
+        DEBUG ((DEBUG_ERROR, "Sequential read error at %Lx\n", (UINT64)Offset));
+        break;
+      }
+
+      Start = GetTimestampUs ();
+      while (OcAppleDiskImageReadAhead (&Context)) {
+      }
+
+      ReadAheadTime += GetTimestampUs () - Start;
+    }
+
+    DEBUG ((
+      DEBUG_ERROR,
+      "Sequential read-ahead %u: %u requests, %Lu us in reads, %Lu us in read-ahead, hits %Lu misses %Lu read-ahead %Lu\n",
+      ReadAheadChunks[Index],
+      Requests,
+      ReadTime,
+      ReadAheadTime,
+      Context.ChunkCacheHits,
+      Context.ChunkCacheMisses,
+      Context.ChunkReadAheads
+      ));
+
+    OcAppleDiskImageFreeContext (&Context);
+  }
+
+  FreePool (Buffer);
+}
+
 int
 ENTRY_POINT (
   int   argc,
@@ -123,6 +315,10 @@ ENTRY_POINT (
     }
 
     DEBUG ((DEBUG_ERROR, "Decompressed the entire DMG...\n"));
+    DEBUG ((DEBUG_ERROR, "Chunk cache hits %Lu misses %Lu\n", DmgContext.ChunkCacheHits, DmgContext.ChunkCacheMisses));
+
+    ReportChunkThroughput (&ExtentTable, DmgSize, UncompDmg);
+    ReportSequentialReadAhead (&ExtentTable, DmgSize, UncompDmg);
 
  #if 0
     UserWriteFile ("out.bin", UncompDmg, UncompSize);
@@ -196,6 +392,27 @@ LLVMFuzzerTestOneInput (
                       Data,
                       Size
                       );
+    ASSERT (CurrentLength <= Index);
+    CurrentLength = DecompressADC (
+                      Test,
+                      Index,
+                      Data,
+                      Size
+                      );
+    ASSERT (CurrentLength <= Index);
+    CurrentLength = DecompressBZIP2 (
+                      Test,
+                      Index,
+                      Data,
+                      Size
+                      );
+    ASSERT (CurrentLength <= Index);
+    CurrentLength = DecompressLZFSE (
+                      Test,
+                      Index,
+                      Data,
+                      Size
+                      );
     ASAN_UNPOISON_MEMORY_REGION (Test + Index, MAX_OUTPUT - Index);
     ASSERT (CurrentLength <= Index);
   }
@@ -18,7 +18,9 @@
 #include <Library/OcSerializeLib.h>
 #include <Library/OcMiscLib.h>
 #include <Library/OcAppleKernelLib.h>
+#include <Library/OcCryptoLib.h>
 
+#include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
 
@@ -581,6 +583,287 @@ OcGetFileSize (
   return EFI_SUCCESS;
 }
 
+STATIC
+UINT64
+GetTimestampUs (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000ULL + Time.tv_usec;
+}
+
+/**
+  Compare kext linking time with hashed and linear symbol lookup,
+  and with link cache exported by the first pass.
+  Enabled by setting KEXTINJECT_BENCHMARK environment variable.
+**/
+STATIC
+VOID
+BenchmarkKextInject (
+  IN CONST UINT8  *Prelinked,
+  IN UINT32       PrelinkedSize,
+  IN UINT32       AllocSize,
+  IN UINT32       LinkedExpansion,
+  IN UINT32       ReservedExeSize,
+  IN int          argc,
+  IN char         *argv[]
+  )
+{
+  EFI_STATUS         Status;
+  PRELINKED_CONTEXT  Context;
+  UINT8              *Buffer;
+  UINT8              *TestData;
+  UINT32             TestDataSize;
+  CHAR8              *TestPlist;
+  UINT32             TestPlistSize;
+  UINT64             Start;
+  UINT64             Elapsed[3];
+  UINT32             Pass;
+  int                argi;
+  char               KextPath[64];
+  UINT8              Digest[SHA384_DIGEST_SIZE];
+  VOID               *LinkCache;
+  UINT32             LinkCacheSize;
+
+  ZeroMem (Digest, sizeof (Digest));
+  LinkCache     = NULL;
+  LinkCacheSize = 0;
+
+  for (Pass = 0; Pass < ARRAY_SIZE (Elapsed); ++Pass) {
+    Elapsed[Pass] = 0;
+
+    Buffer = AllocateCopyPool (AllocSize, Prelinked);
+    if (Buffer == NULL) {
+      break;
+    }
+
+    Status = PrelinkedContextInit (&Context, Buffer, PrelinkedSize, AllocSize, FALSE);
+    if (EFI_ERROR (Status)) {
+      FreePool (Buffer);
+      break;
+    }
+
+    Context.LinearSymbolLookup = Pass == 1;
+
+    if ((Pass == 2) && (LinkCache != NULL)) {
+      Status = PrelinkedImportLinkCache (&Context, LinkCache, LinkCacheSize, Digest, "BENCH");
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_WARN, "[FAIL] Link cache import failed - %r\n", Status));
+        FailedToProcess = TRUE;
+      }
+    }
+
+    Status = PrelinkedInjectPrepare (&Context, LinkedExpansion, ReservedExeSize);
+    if (EFI_ERROR (Status)) {
+      PrelinkedContextFree (&Context);
+      FreePool (Buffer);
+      break;
+    }
+
+    for (argi = 2; argi < argc; argi += 2) {
+      TestData      = NULL;
+      TestDataSize  = 0;
+      TestPlist     = NULL;
+      TestPlistSize = 0;
+
+      if ((argv[argi][0] != 'n') || (argv[argi][1] != 0)) {
+        TestData = UserReadFile (argv[argi], &TestDataSize);
+      }
+
+      if (argi + 1 < argc) {
+        TestPlist = (CHAR8 *)UserReadFile (argv[argi + 1], &TestPlistSize);
+      }
+
+      snprintf (KextPath, sizeof (KextPath), "/Library/Extensions/Kex%d.kext", argi / 2 - 1);
+
+      Start  = GetTimestampUs ();
+      Status = PrelinkedInjectKext (
+                 &Context,
+                 NULL,
+                 KextPath,
+                 TestPlist,
+                 TestPlistSize,
+                 "Contents/MacOS/Kext",
+                 TestData,
+                 TestDataSize,
+                 NULL
+                 );
+      Elapsed[Pass] += GetTimestampUs () - Start;
+
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_WARN, "[BENCH] %a injection failed - %r\n", argv[argi], Status));
+      }
+
+      if (TestData != NULL) {
+        FreePool (TestData);
+      }
+
+      if (TestPlist != NULL) {
+        FreePool (TestPlist);
+      }
+    }
+
+    PrelinkedInjectComplete (&Context);
+
+    if (Pass == 0) {
+      Status = PrelinkedExportLinkCache (&Context, Digest, "BENCH", &LinkCache, &LinkCacheSize);
+      if (EFI_ERROR (Status)) {
+        LinkCache = NULL;
+      }
+    } else if ((Pass == 2) && (Context.LinkCacheMisses > 0)) {
+      DEBUG ((DEBUG_WARN, "[FAIL] Link cache missed %u kexts\n", Context.LinkCacheMisses));
+      FailedToProcess = TRUE;
+    }
+
+    PrelinkedContextFree (&Context);
+    FreePool (Buffer);
+  }
+
+  if (LinkCache != NULL) {
+    FreePool (LinkCache);
+  }
+
+  DEBUG ((
+    DEBUG_WARN,
+    "[BENCH] Kext injection took %Lu us with hashed, %Lu us with linear symbol lookup, %Lu us with link cache\n",
+    Elapsed[0],
+    Elapsed[1],
+    Elapsed[2]
+    ));
+}
+
+/**
+  Count pattern occurrences with a plain byte by byte comparison.
+  Used as a reference for compiled pattern search.
+**/
+STATIC
+UINT32
+CountPatternReference (
+  IN CONST UINT8  *Pattern,
+  IN CONST UINT8  *PatternMask OPTIONAL,
+  IN UINT32       PatternSize,
+  IN CONST UINT8  *Data,
+  IN UINT32       DataSize
+  )
+{
+  UINT32  Count;
+  UINT32  Offset;
+  UINT32  Index;
+
+  Count = 0;
+  for (Offset = 0; Offset + PatternSize <= DataSize; ++Offset) {
+    for (Index = 0; Index < PatternSize; ++Index) {
+      if ((Data[Offset + Index] & (PatternMask != NULL ? PatternMask[Index] : 0xFF)) != Pattern[Index]) {
+        break;
+      }
+    }
+
+    if (Index == PatternSize) {
+      ++Count;
+    }
+  }
+
+  return Count;
+}
+
+/**
+  Compare plain and compiled pattern search time on the kernel.
+  Enabled by setting KEXTINJECT_BENCHMARK environment variable.
+**/
+STATIC
+VOID
+BenchmarkPatternSearch (
+  IN CONST UINT8  *Data,
+  IN UINT32       DataSize
+  )
+{
+  UINT8                Pattern[4][16];
+  UINT8                PatternMask[ARRAY_SIZE (Pattern)][16];
+  BOOLEAN              Masked;
+  OC_COMPILED_PATTERN  Compiled;
+  UINT32               PatternIndex;
+  UINT32               Index;
+  UINT32               Offset;
+  UINT32               Count[2];
+  UINT64               Start;
+  UINT64               Elapsed[2];
+
+  if (DataSize < 4 * sizeof (Pattern[0])) {
+    return;
+  }
+
+  //
+  // Take patterns from the kernel itself: exact, with masked displacement,
+  // with masked opcode, and a likely missing one.
+  //
+  for (PatternIndex = 0; PatternIndex < ARRAY_SIZE (Pattern); ++PatternIndex) {
+    Offset = (DataSize / 8) * (PatternIndex + 3);
+    CopyMem (Pattern[PatternIndex], &Data[Offset], sizeof (Pattern[0]));
+    SetMem (PatternMask[PatternIndex], sizeof (PatternMask[0]), 0xFF);
+  }
+
+  SetMem (&PatternMask[1][8], 4, 0x00);
+  PatternMask[2][0] = 0xF0;
+  Pattern[3][15]   ^= 0x5A;
+
+  Elapsed[0] = 0;
+  Elapsed[1] = 0;
+
+  for (PatternIndex = 0; PatternIndex < ARRAY_SIZE (Pattern); ++PatternIndex) {
+    Masked = (PatternIndex == 1) || (PatternIndex == 2);
+    for (Index = 0; Index < sizeof (Pattern[0]); ++Index) {
+      Pattern[PatternIndex][Index] &= PatternMask[PatternIndex][Index];
+    }
+
+    Start    = GetTimestampUs ();
+    Count[0] = CountPatternReference (
+                 Pattern[PatternIndex],
+                 Masked ? PatternMask[PatternIndex] : NULL,
+                 sizeof (Pattern[0]),
+                 Data,
+                 DataSize
+                 );
+    Elapsed[0] += GetTimestampUs () - Start;
+
+    Start    = GetTimestampUs ();
+    Count[1] = 0;
+    Offset   = 0;
+    CompilePattern (
+      Pattern[PatternIndex],
+      Masked ? PatternMask[PatternIndex] : NULL,
+      sizeof (Pattern[0]),
+      &Compiled
+      );
+    while (FindCompiledPattern (&Compiled, Data, DataSize, &Offset)) {
+      ++Count[1];
+      ++Offset;
+    }
+
+    Elapsed[1] += GetTimestampUs () - Start;
+
+    if (Count[0] != Count[1]) {
+      DEBUG ((
+        DEBUG_WARN,
+        "[FAIL] Pattern %u found %u times with plain and %u times with compiled search\n",
+        PatternIndex,
+        Count[0],
+        Count[1]
+        ));
+      FailedToProcess = TRUE;
+    }
+  }
+
+  DEBUG ((
+    DEBUG_WARN,
+    "[BENCH] Pattern search took %Lu us with plain and %Lu us with compiled search\n",
+    Elapsed[0],
+    Elapsed[1]
+    ));
+}
+
 int
 WrapMain (
   int   argc,
@@ -691,6 +974,19 @@ WrapMain (
     return -1;
   }
 
+  if (getenv ("KEXTINJECT_BENCHMARK") != NULL) {
+    BenchmarkPatternSearch (mPrelinked, mPrelinkedSize);
+    BenchmarkKextInject (
+      mPrelinked,
+      mPrelinkedSize,
+      AllocSize,
+      LinkedExpansion,
+      ReservedExeSize,
+      argc,
+      argv
+      );
+  }
+
   KernelVersion = OcKernelReadDarwinVersion (mPrelinked, mPrelinkedSize);
   if (KernelVersion != 0) {
     DEBUG ((DEBUG_WARN, "[OK] Got version %u\n", KernelVersion));
@@ -0,0 +1,391 @@
+/** @file
+  Copyright (C) 2026, agent. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcMiscLib.h>
+#include <Library/OcXmlLib.h>
+
+#include <UserFile.h>
+
+//
+// Round-trip sample covering escaping, non-ASCII and surrogate pair strings,
+// negative and 16-byte integers, empty containers, and extended counts.
+//
+STATIC
+CONST CHAR8
+  mPlistSample[] =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+  "<plist version=\"1.0\">\n"
+  "<dict>\n"
+  "  <key>A&amp;B</key><string>a &amp;amp; b &lt;c&gt;</string>\n"
+  "  <key>Cyrillic</key><string>\xD0\xBA\xD0\xBB\xD1\x8E\xD1\x87</string>\n"
+  "  <key>Surrogate</key><string>\xF0\x9F\x98\x80x</string>\n"
+  "  <key>Negative</key><integer>-300</integer>\n"
+  "  <key>Unsigned</key><integer>18446744073709551615</integer>\n"
+  "  <key>Data</key><data>AQID</data>\n"
+  "  <key>EmptyData</key><data></data>\n"
+  "  <key>EmptyArray</key><array/>\n"
+  "  <key>EmptyDict</key><dict/>\n"
+  "  <key>True</key><true/>\n"
+  "  <key>Large</key>\n"
+  "  <dict>\n"
+  "    <key>K00</key><integer>0</integer><key>K01</key><integer>1</integer>\n"
+  "    <key>K02</key><integer>2</integer><key>K03</key><integer>3</integer>\n"
+  "    <key>K04</key><integer>4</integer><key>K05</key><integer>5</integer>\n"
+  "    <key>K06</key><integer>6</integer><key>K07</key><integer>7</integer>\n"
+  "    <key>K08</key><integer>8</integer><key>K09</key><integer>9</integer>\n"
+  "    <key>K10</key><integer>10</integer><key>K11</key><integer>11</integer>\n"
+  "    <key>K12</key><integer>12</integer><key>K13</key><integer>13</integer>\n"
+  "    <key>K14</key><integer>14</integer><key>K15</key><integer>15</integer>\n"
+  "  </dict>\n"
+  "</dict>\n"
+  "</plist>\n";
+
+#define PLIST_SAMPLE_LARGE_COUNT  16U
+
+STATIC
+XML_NODE *
+LookupValue (
+  IN XML_NODE     *Dict,
+  IN CONST CHAR8  *Key
+  )
+{
+  UINT32       Index;
+  XML_NODE     *Value;
+  CONST CHAR8  *Name;
+
+  for (Index = 0; Index < PlistDictChildren (Dict); ++Index) {
+    Name = PlistKeyValue (PlistDictChild (Dict, Index, &Value));
+    if ((Name != NULL) && (AsciiStrCmp (Name, Key) == 0)) {
+      return Value;
+    }
+  }
+
+  DEBUG ((DEBUG_ERROR, "Missing key %a\n", Key));
+  return NULL;
+}
+
+STATIC
+BOOLEAN
+CheckString (
+  IN XML_NODE     *Dict,
+  IN CONST CHAR8  *Key,
+  IN CONST CHAR8  *Expected
+  )
+{
+  CHAR8   Value[64];
+  UINT32  Size;
+
+  Size = sizeof (Value);
+  if (  !PlistStringValue (LookupValue (Dict, Key), Value, &Size)
+     || (AsciiStrCmp (Value, Expected) != 0))
+  {
+    DEBUG ((DEBUG_ERROR, "Mismatched string %a\n", Key));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+STATIC
+BOOLEAN
+CheckPlist (
+  IN XML_DOCUMENT  *Document
+  )
+{
+  XML_NODE     *Root;
+  XML_NODE     *Large;
+  XML_NODE     *Node;
+  CONST CHAR8  *Unescaped;
+  UINT8        Data[8];
+  UINT32       Size;
+  INT64        Integer;
+  UINT64       Unsigned;
+  BOOLEAN      Boolean;
+  BOOLEAN      Result;
+  UINT32       Index;
+  XML_NODE     *Key;
+
+  Root = PlistNodeCast (PlistDocumentRoot (Document), PLIST_NODE_TYPE_DICT);
+  if (Root == NULL) {
+    DEBUG ((DEBUG_ERROR, "Missing root dictionary\n"));
+    return FALSE;
+  }
+
+  Result = CheckString (Root, "A&amp;B", "a &amp;amp; b &lt;c&gt;")
+           && CheckString (Root, "Cyrillic", "\xD0\xBA\xD0\xBB\xD1\x8E\xD1\x87")
+           && CheckString (Root, "Surrogate", "\xF0\x9F\x98\x80x");
+  if (!Result) {
+    return FALSE;
+  }
+
+  //
+  // Strings are unescaped by consumers regardless of the plist format.
+  //
+  Unescaped = XmlUnescapeString (XmlNodeContent (LookupValue (Root, "A&amp;B")));
+  if (Unescaped == NULL) {
+    return FALSE;
+  }
+
+  Result = AsciiStrCmp (Unescaped, "a &amp; b <c>") == 0;
+  FreePool ((VOID *)Unescaped);
+  if (!Result) {
+    DEBUG ((DEBUG_ERROR, "Mismatched unescaped string\n"));
+    return FALSE;
+  }
+
+  if (  !PlistIntegerValue (LookupValue (Root, "Negative"), &Integer, sizeof (Integer), FALSE)
+     || (Integer != -300))
+  {
+    DEBUG ((DEBUG_ERROR, "Mismatched negative integer\n"));
+    return FALSE;
+  }
+
+  if (  !PlistIntegerValue (LookupValue (Root, "Unsigned"), &Unsigned, sizeof (Unsigned), FALSE)
+     || (Unsigned != MAX_UINT64))
+  {
+    DEBUG ((DEBUG_ERROR, "Mismatched unsigned integer\n"));
+    return FALSE;
+  }
+
+  Size = sizeof (Data);
+  if (  !PlistDataValue (LookupValue (Root, "Data"), Data, &Size)
+     || (Size != 3) || (Data[0] != 1) || (Data[1] != 2) || (Data[2] != 3))
+  {
+    DEBUG ((DEBUG_ERROR, "Mismatched data\n"));
+    return FALSE;
+  }
+
+  Size = sizeof (Data);
+  if (!PlistDataValue (LookupValue (Root, "EmptyData"), Data, &Size) || (Size != 0)) {
+    DEBUG ((DEBUG_ERROR, "Mismatched empty data\n"));
+    return FALSE;
+  }
+
+  Node = PlistNodeCast (LookupValue (Root, "EmptyArray"), PLIST_NODE_TYPE_ARRAY);
+  if ((Node == NULL) || (XmlNodeChildren (Node) != 0)) {
+    DEBUG ((DEBUG_ERROR, "Mismatched empty array\n"));
+    return FALSE;
+  }
+
+  Node = PlistNodeCast (LookupValue (Root, "EmptyDict"), PLIST_NODE_TYPE_DICT);
+  if ((Node == NULL) || (PlistDictChildren (Node) != 0)) {
+    DEBUG ((DEBUG_ERROR, "Mismatched empty dictionary\n"));
+    return FALSE;
+  }
+
+  if (!PlistBooleanValue (LookupValue (Root, "True"), &Boolean) || !Boolean) {
+    DEBUG ((DEBUG_ERROR, "Mismatched boolean\n"));
+    return FALSE;
+  }
+
+  Large = PlistNodeCast (LookupValue (Root, "Large"), PLIST_NODE_TYPE_DICT);
+  if ((Large == NULL) || (PlistDictChildren (Large) != PLIST_SAMPLE_LARGE_COUNT)) {
+    DEBUG ((DEBUG_ERROR, "Mismatched large dictionary\n"));
+    return FALSE;
+  }
+
+  for (Index = 0; Index < PLIST_SAMPLE_LARGE_COUNT; ++Index) {
+    Key = PlistDictChild (Large, Index, &Node);
+    if (  (Key == NULL)
+       || !PlistIntegerValue (Node, &Integer, sizeof (Integer), FALSE)
+       || (Integer != Index))
+    {
+      DEBUG ((DEBUG_ERROR, "Mismatched large dictionary value %u\n", Index));
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Convert the sample from XML to binary and back to XML checking the values.
+
+  @retval  TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestRoundTrip (
+  VOID
+  )
+{
+  CHAR8         *Xml;
+  UINT8         *Binary;
+  CHAR8         *Exported;
+  XML_DOCUMENT  *XmlDocument;
+  XML_DOCUMENT  *BinaryDocument;
+  XML_DOCUMENT  *ExportedDocument;
+  UINT32        BinarySize;
+  UINT32        ExportedSize;
+  BOOLEAN       Result;
+
+  Result           = FALSE;
+  Binary           = NULL;
+  Exported         = NULL;
+  BinaryDocument   = NULL;
+  ExportedDocument = NULL;
+
+  Xml = AllocateCopyPool (sizeof (mPlistSample), mPlistSample);
+  if (Xml == NULL) {
+    return FALSE;
+  }
+
+  XmlDocument = XmlDocumentParse (Xml, sizeof (mPlistSample) - 1, FALSE);
+  if ((XmlDocument == NULL) || !CheckPlist (XmlDocument)) {
+    DEBUG ((DEBUG_ERROR, "XML sample check failed\n"));
+    goto Done;
+  }
+
+  Binary = PlistDocumentExportBinary (XmlDocument, &BinarySize);
+  if ((Binary == NULL) || !PlistIsBinary (Binary, BinarySize)) {
+    DEBUG ((DEBUG_ERROR, "Binary export failed\n"));
+    goto Done;
+  }
+
+  BinaryDocument = PlistDocumentParseBinary (Binary, BinarySize);
+  if ((BinaryDocument == NULL) || !CheckPlist (BinaryDocument)) {
+    DEBUG ((DEBUG_ERROR, "Binary check failed\n"));
+    goto Done;
+  }
+
+  Exported = XmlDocumentExport (BinaryDocument, &ExportedSize, 0, TRUE);
+  if (Exported == NULL) {
+    DEBUG ((DEBUG_ERROR, "XML export failed\n"));
+    goto Done;
+  }
+
+  ExportedDocument = XmlDocumentParse (Exported, ExportedSize, FALSE);
+  if ((ExportedDocument == NULL) || !CheckPlist (ExportedDocument)) {
+    DEBUG ((DEBUG_ERROR, "Exported XML check failed\n"));
+    goto Done;
+  }
+
+  Result = TRUE;
+
+Done:
+  if (ExportedDocument != NULL) {
+    XmlDocumentFree (ExportedDocument);
+  }
+
+  if (Exported != NULL) {
+    FreePool (Exported);
+  }
+
+  if (BinaryDocument != NULL) {
+    XmlDocumentFree (BinaryDocument);
+  }
+
+  if (Binary != NULL) {
+    FreePool (Binary);
+  }
+
+  if (XmlDocument != NULL) {
+    XmlDocumentFree (XmlDocument);
+  }
+
+  FreePool (Xml);
+  return Result;
+}
+
+/**
+  Parse binary plist and export the result in both formats.
+
+  @param[in]  Data  Binary plist data.
+  @param[in]  Size  Binary plist size.
+**/
+STATIC
+VOID
+ProcessBinary (
+  IN CONST UINT8  *Data,
+  IN UINT32       Size
+  )
+{
+  UINT8         *Buffer;
+  XML_DOCUMENT  *Document;
+  VOID          *Exported;
+  UINT32        ExportedSize;
+
+  //
+  // Parsing modifies the buffer.
+  //
+  Buffer = AllocateCopyPool (Size, Data);
+  if (Buffer == NULL) {
+    return;
+  }
+
+  Document = PlistDocumentParseBinary (Buffer, Size);
+  if (Document != NULL) {
+    Exported = XmlDocumentExport (Document, &ExportedSize, 0, TRUE);
+    if (Exported != NULL) {
+      FreePool (Exported);
+    }
+
+    Exported = PlistDocumentExportBinary (Document, &ExportedSize);
+    if (Exported != NULL) {
+      FreePool (Exported);
+    }
+
+    XmlDocumentFree (Document);
+  }
+
+  FreePool (Buffer);
+}
+
+int
+ENTRY_POINT (
+  int   argc,
+  char  *argv[]
+  )
+{
+  UINT8   *Buffer;
+  UINT32  Size;
+
+  if (argc > 1) {
+    Buffer = UserReadFile (argv[1], &Size);
+    if (Buffer == NULL) {
+      DEBUG ((DEBUG_ERROR, "Read fail\n"));
+      return -1;
+    }
+
+    ProcessBinary (Buffer, Size);
+    FreePool (Buffer);
+    return 0;
+  }
+
+  if (!TestRoundTrip ()) {
+    DEBUG ((DEBUG_ERROR, "Plist round-trip test failed\n"));
+    return -1;
+  }
+
+  DEBUG ((DEBUG_ERROR, "Plist round-trip test passed\n"));
+  return 0;
+}
+
+int
+LLVMFuzzerTestOneInput (
+  const uint8_t  *Data,
+  size_t         Size
+  )
+{
+  if ((Size > 0) && (Size <= MAX_UINT32)) {
+    ProcessBinary (Data, (UINT32)Size);
+  }
+
+  return 0;
+}
@@ -13,6 +13,7 @@
   WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 **/
 
+#include <Library/BaseOverflowLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcTemplateLib.h>
@@ -23,10 +24,37 @@
 #include <Library/OcConfigurationLib.h>
 #include <Library/OcMainLib.h>
 
+#include <stdlib.h>
+#include <sys/time.h>
+
 #include <UserFile.h>
 
 #define  OC_USER_FULL_PATH_MAX_SIZE  256
 
+//
+// Maximum number of profiled runs, spans per run, and their nesting.
+//
+#define  PROFILE_MAX_RUNS   10000
+#define  PROFILE_MAX_SPANS  1024U
+#define  PROFILE_MAX_DEPTH  16U
+#define  PROFILE_MAX_KEYS   256U
+
+typedef struct {
+  CONST CHAR8    *Phase;
+  CONST CHAR8    *Item;
+  UINT32         Run;
+  UINT32         Depth;
+  UINT64         Start;
+  UINT64         Duration;
+} PROFILE_SPAN;
+
+STATIC PROFILE_SPAN  *mProfileSpans;
+STATIC UINT32        mProfileSpanCount;
+STATIC UINT32        mProfileSpanAllocCount;
+STATIC UINT32        mProfileStack[PROFILE_MAX_DEPTH];
+STATIC UINT32        mProfileDepth;
+STATIC UINT32        mProfileRun;
+
 STATIC CHAR8  mFullPath[OC_USER_FULL_PATH_MAX_SIZE] = { 0 };
 STATIC UINTN  mRootPathLen                          = 0;
 
@@ -75,6 +103,222 @@ UserReadFileFromRoot (
   return UserReadFile (mFullPath, Size);
 }
 
+STATIC
+UINT64
+GetTimestampUs (
+  VOID
+  )
+{
+  struct timeval  Time;
+
+  gettimeofday (&Time, NULL);
+  return Time.tv_sec * 1000000ULL + Time.tv_usec;
+}
+
+/**
+  Record kernel processing phase timing.
+  Enabled by setting PROCESSKERNEL_PROFILE environment variable to the number of runs.
+**/
+STATIC
+VOID
+ProfileHandler (
+  IN CONST CHAR8  *Phase,
+  IN CONST CHAR8  *Item  OPTIONAL,
+  IN BOOLEAN      Start
+  )
+{
+  PROFILE_SPAN  *Span;
+
+  if (mProfileSpans == NULL) {
+    return;
+  }
+
+  if (Start) {
+    if ((mProfileSpanCount == mProfileSpanAllocCount) || (mProfileDepth == PROFILE_MAX_DEPTH)) {
+      DEBUG ((DEBUG_WARN, "[FAIL] Too many profiled spans at %a\n", Phase));
+      return;
+    }
+
+    Span        = &mProfileSpans[mProfileSpanCount];
+    Span->Phase = Phase;
+    Span->Item  = Item != NULL ? Item : "";
+    Span->Run   = mProfileRun;
+    Span->Depth = mProfileDepth;
+
+    mProfileStack[mProfileDepth++] = mProfileSpanCount++;
+
+    Span->Duration = 0;
+    Span->Start    = GetTimestampUs ();
+    return;
+  }
+
+  if (mProfileDepth == 0) {
+    return;
+  }
+
+  Span = &mProfileSpans[mProfileStack[mProfileDepth - 1]];
+  if (AsciiStrCmp (Span->Phase, Phase) != 0) {
+    //
+    // Dropped start due to overflow.
+    //
+    return;
+  }
+
+  Span->Duration = GetTimestampUs () - Span->Start;
+  --mProfileDepth;
+}
+
+/**
+  Append JSON-escaped string to the buffer.
+**/
+STATIC
+UINTN
+ProfileJsonString (
+  OUT CHAR8        *Buffer,
+  IN  CONST CHAR8  *String
+  )
+{
+  UINTN  Length;
+
+  Length           = 0;
+  Buffer[Length++] = '"';
+  while (*String != '\0') {
+    if ((*String == '"') || (*String == '\\')) {
+      Buffer[Length++] = '\\';
+    }
+
+    Buffer[Length++] = *String++;
+  }
+
+  Buffer[Length++] = '"';
+  return Length;
+}
+
+/**
+  Save recorded spans as JSON and print per-phase statistics over all runs.
+**/
+STATIC
+VOID
+ProfileReport (
+  IN CONST CHAR8  *FileName,
+  IN UINT32       Runs
+  )
+{
+  CHAR8         *Json;
+  UINTN         JsonSize;
+  UINTN         Length;
+  UINT32        Index;
+  UINT32        Index2;
+  UINT32        Run;
+  PROFILE_SPAN  *Span;
+  PROFILE_SPAN  *Keys[PROFILE_MAX_KEYS];
+  UINT32        KeyCount;
+  UINT64        Total;
+  UINT64        Min;
+  UINT64        Max;
+  UINT64        Sum;
+
+  //
+  // Each span needs at most twice the size of its strings and some fixed overhead.
+  //
+  JsonSize = 256 + OC_USER_FULL_PATH_MAX_SIZE;
+  for (Index = 0; Index < mProfileSpanCount; ++Index) {
+    JsonSize += 128 + 2 * (AsciiStrLen (mProfileSpans[Index].Phase) + AsciiStrLen (mProfileSpans[Index].Item));
+  }
+
+  Json = AllocatePool (JsonSize);
+  if (Json == NULL) {
+    return;
+  }
+
+  Length = AsciiSPrint (Json, JsonSize, "{\n  \"kernel\": ");
+  Length += ProfileJsonString (&Json[Length], FileName);
+  Length += AsciiSPrint (&Json[Length], JsonSize - Length, ",\n  \"runs\": [");
+
+  Index = 0;
+  for (Run = 0; Run < Runs; ++Run) {
+    Length += AsciiSPrint (&Json[Length], JsonSize - Length, "%a\n    [", Run > 0 ? "," : "");
+
+    for (Index2 = 0; Index < mProfileSpanCount && mProfileSpans[Index].Run == Run; ++Index, ++Index2) {
+      Span    = &mProfileSpans[Index];
+      Length += AsciiSPrint (&Json[Length], JsonSize - Length, "%a\n      {\"phase\": ", Index2 > 0 ? "," : "");
+      Length += ProfileJsonString (&Json[Length], Span->Phase);
+      Length += AsciiSPrint (&Json[Length], JsonSize - Length, ", \"item\": ");
+      Length += ProfileJsonString (&Json[Length], Span->Item);
+      Length += AsciiSPrint (
+                  &Json[Length],
+                  JsonSize - Length,
+                  ", \"depth\": %u, \"start_us\": %Lu, \"duration_us\": %Lu}",
+                  Span->Depth,
+                  Span->Start,
+                  Span->Duration
+                  );
+    }
+
+    Length += AsciiSPrint (&Json[Length], JsonSize - Length, "\n    ]");
+  }
+
+  Length += AsciiSPrint (&Json[Length], JsonSize - Length, "\n  ]\n}\n");
+  ASSERT (Length < JsonSize);
+
+  UserWriteFile ("profile.json", Json, (UINT32)Length);
+  FreePool (Json);
+
+  //
+  // Collect distinct phase and item pairs in order of appearance.
+  //
+  KeyCount = 0;
+  for (Index = 0; Index < mProfileSpanCount; ++Index) {
+    for (Index2 = 0; Index2 < KeyCount; ++Index2) {
+      if (  (AsciiStrCmp (Keys[Index2]->Phase, mProfileSpans[Index].Phase) == 0)
+         && (AsciiStrCmp (Keys[Index2]->Item, mProfileSpans[Index].Item) == 0))
+      {
+        break;
+      }
+    }
+
+    if ((Index2 == KeyCount) && (KeyCount < PROFILE_MAX_KEYS)) {
+      Keys[KeyCount++] = &mProfileSpans[Index];
+    }
+  }
+
+  DEBUG ((DEBUG_WARN, "[PROFILE] %u runs, time per run in us\n", Runs));
+  DEBUG ((DEBUG_WARN, "[PROFILE] %-24a %-40a %10a %10a %10a\n", "Phase", "Item", "Min", "Avg", "Max"));
+
+  for (Index2 = 0; Index2 < KeyCount; ++Index2) {
+    Min = MAX_UINT64;
+    Max = 0;
+    Sum = 0;
+
+    for (Run = 0; Run < Runs; ++Run) {
+      Total = 0;
+      for (Index = 0; Index < mProfileSpanCount; ++Index) {
+        Span = &mProfileSpans[Index];
+        if (  (Span->Run == Run)
+           && (AsciiStrCmp (Keys[Index2]->Phase, Span->Phase) == 0)
+           && (AsciiStrCmp (Keys[Index2]->Item, Span->Item) == 0))
+        {
+          Total += Span->Duration;
+        }
+      }
+
+      Min  = MIN (Min, Total);
+      Max  = MAX (Max, Total);
+      Sum += Total;
+    }
+
+    DEBUG ((
+      DEBUG_WARN,
+      "[PROFILE] %-24a %-40a %10Lu %10Lu %10Lu\n",
+      Keys[Index2]->Phase,
+      Keys[Index2]->Item,
+      Min,
+      DivU64x32 (Sum, Runs),
+      Max
+      ));
+  }
+}
+
 STATIC BOOLEAN  FailedToProcess = FALSE;
 STATIC UINT32   KernelVersion   = 0;
 
@@ -334,6 +578,11 @@ WrapMain (
   UINT32   NewPrelinkedSize;
   UINT8    Sha384[48];
   BOOLEAN  Is32Bit;
+  UINT32   Runs;
+  long     RunsArg;
+  UINT32   ProfileSize;
+  CHAR8    *ProfileRuns;
+  CHAR8    *ProfileRunsEnd;
 
   OC_CPU_INFO  DummyCpuInfo;
 
@@ -416,35 +665,6 @@ WrapMain (
     return -1;
   }
 
-  Status = ReadAppleKernel (
-             &NilFileProtocol,
-             FALSE,
-             &Is32Bit,
-             &NewPrelinked,
-             &NewPrelinkedSize,
-             &AllocSize,
-             ReservedInfoSize + ReservedExeSize + LinkedExpansion,
-             Sha384
-             );
-  if (!EFI_ERROR (Status)) {
-    FreePool (mPrelinked);
-    mPrelinked     = NewPrelinked;
-    mPrelinkedSize = NewPrelinkedSize;
-    DEBUG ((DEBUG_WARN, "[OK] Sha384 is %02X%02X%02X%02X\n", Sha384[0], Sha384[1], Sha384[2], Sha384[3]));
-  } else {
-    DEBUG ((DEBUG_WARN, "[FAIL] Kernel unpack failure - %r\n", Status));
-    FailedToProcess = TRUE;
-    return -1;
-  }
-
-  KernelVersion = OcKernelReadDarwinVersion (mPrelinked, mPrelinkedSize);
-  if (KernelVersion != 0) {
-    DEBUG ((DEBUG_WARN, "[OK] Got version %u\n", KernelVersion));
-  } else {
-    DEBUG ((DEBUG_WARN, "[FAIL] Failed to detect version\n"));
-    FailedToProcess = TRUE;
-  }
-
   ZeroMem (&DummyCpuInfo, sizeof (DummyCpuInfo));
   //
   // Disable ProvideCurrentCpuInfo patch, as there is no CpuInfo available on userspace.
@@ -460,37 +680,113 @@ WrapMain (
   ASSERT (Config.Kernel.Force.Count == 0);
 
   //
-  // Apply patches to kernel itself, and then process prelinked.
+  // Profile kernel processing over the requested number of runs.
   //
-  OcKernelApplyPatches (
-    &Config,
-    &DummyCpuInfo,
-    KernelVersion,
-    FALSE,
-    CacheTypeNone,
-    NULL,
-    NewPrelinked,
-    NewPrelinkedSize
-    );
-  PrelinkedStatus = OcKernelProcessPrelinked (
-                      &Config,
-                      KernelVersion,
-                      FALSE,
-                      NewPrelinked,
-                      &NewPrelinkedSize,
-                      AllocSize,
-                      LinkedExpansion,
-                      ReservedExeSize
-                      );
-  if (EFI_ERROR (PrelinkedStatus)) {
-    DEBUG ((DEBUG_WARN, "[FAIL] Kernel process - %r\n", PrelinkedStatus));
-    FailedToProcess = TRUE;
-    return -1;
+  Runs        = 1;
+  ProfileRuns = getenv ("PROCESSKERNEL_PROFILE");
+  if (ProfileRuns != NULL) {
+    RunsArg = strtol (ProfileRuns, &ProfileRunsEnd, 10);
+    if ((*ProfileRunsEnd != '\0') || (RunsArg < 0) || (RunsArg > PROFILE_MAX_RUNS)) {
+      DEBUG ((DEBUG_ERROR, "PROCESSKERNEL_PROFILE must be within 0..%d runs\n", PROFILE_MAX_RUNS));
+      FailedToProcess = TRUE;
+      return -1;
+    }
+
+    if (RunsArg > 0) {
+      Runs = (UINT32)RunsArg;
+    }
+
+    if (  BaseOverflowMulU32 (Runs, PROFILE_MAX_SPANS, &mProfileSpanAllocCount)
+       || BaseOverflowMulU32 (mProfileSpanAllocCount, sizeof (*mProfileSpans), &ProfileSize))
+    {
+      FailedToProcess = TRUE;
+      return -1;
+    }
+
+    mProfileSpans = AllocatePool (ProfileSize);
+    if (mProfileSpans == NULL) {
+      FailedToProcess = TRUE;
+      return -1;
+    }
+
+    OcKernelSetProfileHandler (ProfileHandler);
   }
 
-  DEBUG ((DEBUG_INFO, "OC: Prelinked status - %r\n", PrelinkedStatus));
+  for (mProfileRun = 0; mProfileRun < Runs; ++mProfileRun) {
+    ProfileHandler ("Total", NULL, TRUE);
+    ProfileHandler ("ReadAppleKernel", NULL, TRUE);
+    Status = ReadAppleKernel (
+               &NilFileProtocol,
+               FALSE,
+               &Is32Bit,
+               &NewPrelinked,
+               &NewPrelinkedSize,
+               &AllocSize,
+               ReservedInfoSize + ReservedExeSize + LinkedExpansion,
+               Sha384
+               );
+    ProfileHandler ("ReadAppleKernel", NULL, FALSE);
+    if (!EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_WARN, "[OK] Sha384 is %02X%02X%02X%02X\n", Sha384[0], Sha384[1], Sha384[2], Sha384[3]));
+    } else {
+      DEBUG ((DEBUG_WARN, "[FAIL] Kernel unpack failure - %r\n", Status));
+      FailedToProcess = TRUE;
+      return -1;
+    }
 
-  UserWriteFile ("out.bin", NewPrelinked, NewPrelinkedSize);
+    KernelVersion = OcKernelReadDarwinVersion (NewPrelinked, NewPrelinkedSize);
+    if (KernelVersion != 0) {
+      DEBUG ((DEBUG_WARN, "[OK] Got version %u\n", KernelVersion));
+    } else {
+      DEBUG ((DEBUG_WARN, "[FAIL] Failed to detect version\n"));
+      FailedToProcess = TRUE;
+    }
+
+    //
+    // Apply patches to kernel itself, and then process prelinked.
+    //
+    OcKernelApplyPatches (
+      &Config,
+      &DummyCpuInfo,
+      KernelVersion,
+      FALSE,
+      CacheTypeNone,
+      NULL,
+      NewPrelinked,
+      NewPrelinkedSize
+      );
+    PrelinkedStatus = OcKernelProcessPrelinked (
+                        &Config,
+                        KernelVersion,
+                        FALSE,
+                        NewPrelinked,
+                        &NewPrelinkedSize,
+                        AllocSize,
+                        LinkedExpansion,
+                        ReservedExeSize
+                        );
+    ProfileHandler ("Total", NULL, FALSE);
+    if (EFI_ERROR (PrelinkedStatus)) {
+      DEBUG ((DEBUG_WARN, "[FAIL] Kernel process - %r\n", PrelinkedStatus));
+      FailedToProcess = TRUE;
+      return -1;
+    }
+
+    DEBUG ((DEBUG_INFO, "OC: Prelinked status - %r\n", PrelinkedStatus));
+
+    if (mProfileRun + 1 == Runs) {
+      UserWriteFile ("out.bin", NewPrelinked, NewPrelinkedSize);
+    }
+
+    FreePool (NewPrelinked);
+  }
+
+  if (mProfileSpans != NULL) {
+    OcKernelSetProfileHandler (NULL);
+    ProfileReport (FileName, Runs);
+    FreePool (mProfileSpans);
+    mProfileSpans = NULL;
+  }
 
   FreePool (mPrelinked);
 
@@ -17,6 +17,7 @@ UTILS=(
     "TestMacho"
     "TestMp3"
     "TestPeCoff"
+    "TestPlist"
     "TestRsaPreprocess"
     "TestSmbios"
     "TestCpuFrequency"
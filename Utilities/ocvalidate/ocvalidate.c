@@ -17,6 +17,7 @@
 #include "OcValidateLib.h"
 
 #include <Library/OcMainLib.h>
+#include <Library/OcXmlLib.h>
 
 #include <UserFile.h>
 
@@ -60,6 +61,75 @@ CheckConfig (
   return ErrorCount;
 }
 
+/**
+  Convert plist between XML and binary formats.
+
+  @param[in]  InputFileName   Path to the plist to convert.
+  @param[in]  OutputFileName  Path to write the converted plist to.
+
+  @retval  0 on success, -1 on failure.
+**/
+STATIC
+int
+ConvertPlist (
+  IN  CONST CHAR8  *InputFileName,
+  IN  CONST CHAR8  *OutputFileName
+  )
+{
+  UINT8         *InputBuffer;
+  UINT32        InputSize;
+  UINT8         *OutputBuffer;
+  UINT32        OutputSize;
+  XML_DOCUMENT  *Document;
+  BOOLEAN       IsBinary;
+
+  InputBuffer = UserReadFile (InputFileName, &InputSize);
+  if (InputBuffer == NULL) {
+    DEBUG ((DEBUG_ERROR, "读取 %a 失败\n", InputFileName));
+    return -1;
+  }
+
+  IsBinary = PlistIsBinary (InputBuffer, InputSize);
+  if (IsBinary) {
+    Document = PlistDocumentParseBinary (InputBuffer, InputSize);
+  } else {
+    Document = XmlDocumentParse ((CHAR8 *)InputBuffer, InputSize, FALSE);
+  }
+
+  if (Document == NULL) {
+    DEBUG ((DEBUG_ERROR, "无法解析plist文件 %a\n", InputFileName));
+    FreePool (InputBuffer);
+    return -1;
+  }
+
+  if (IsBinary) {
+    OutputBuffer = (UINT8 *)XmlDocumentExport (Document, &OutputSize, 0, TRUE);
+  } else {
+    OutputBuffer = PlistDocumentExportBinary (Document, &OutputSize);
+  }
+
+  XmlDocumentFree (Document);
+  FreePool (InputBuffer);
+
+  if (OutputBuffer == NULL) {
+    DEBUG ((DEBUG_ERROR, "无法转换plist文件 %a\n", InputFileName));
+    return -1;
+  }
+
+  UserWriteFile (OutputFileName, OutputBuffer, OutputSize);
+  FreePool (OutputBuffer);
+
+  DEBUG ((
+    DEBUG_ERROR,
+    "已将%a格式的%a转换为%a\n",
+    IsBinary ? "二进制" : "XML",
+    InputFileName,
+    OutputFileName
+    ));
+
+  return 0;
+}
+
 int
 ENTRY_POINT (
   int   argc,
@@ -88,8 +158,13 @@ ENTRY_POINT (
   //
   // Print usage.
   //
+  if ((argc == 4) && (AsciiStrCmp (argv[1], "--convert") == 0)) {
+    return ConvertPlist (argv[2], argv[3]);
+  }
+
   if (argc != 2) {
-    DEBUG ((DEBUG_ERROR, "用法: %a <指定路径/config.plist>\n\n", argv[0]));
+    DEBUG ((DEBUG_ERROR, "用法: %a <指定路径/config.plist>\n", argv[0]));
+    DEBUG ((DEBUG_ERROR, "      %a --convert <输入.plist> <输出.plist>\n\n", argv[0]));
     return -1;
   }
 